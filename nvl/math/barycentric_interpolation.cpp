@@ -108,8 +108,8 @@ V barycentricInterpolationBarycenterSubdivision(
 
         //Calculate the interpolated value on the best triangle
         T minDistance = maxLimitValue<T>();
-        Index bestV1;
-        Index bestV2;
+        Index bestV1 = NULL_ID;
+        Index bestV2 = NULL_ID;
         for (Index j = 0; j < polygon.size(); ++j) {
             const Index& v1 = j;
             const Index& v2 = (j + 1) % polygon.size();
@@ -182,8 +182,8 @@ V barycentricInterpolationDiagonalSubdivision(
 
         //Calculate the interpolated value on the best triangle
         T minDistance = maxLimitValue<T>();
-        Index bestV1;
-        Index bestV2;
+        Index bestV1 = NULL_ID;
+        Index bestV2 = NULL_ID;
         Index bestV3;
 
         for (Index j = 0; j < polygon.size() - 2; ++j) {
@@ -8,6 +8,8 @@
 
 #include <nvl/math/normals.h>
 #include <nvl/math/inside_test.h>
+#include <nvl/math/barycenter.h>
+#include <nvl/math/numeric_limits.h>
 
 namespace nvl {
 
@@ -192,8 +194,6 @@ Point<T,D> closestPointOnPolygonBarycenterSubdivision(
     else { //Polygon
         assert(polygon.size() > 3);
 
-        Point<T,D> queryPoint = point;
-
         //Get barycenter
         Point<T,D> pB = barycenter(polygon);
 
@@ -204,9 +204,9 @@ Point<T,D> closestPointOnPolygonBarycenterSubdivision(
             const Index& v2 = (j + 1) % polygon.size();
 
             Point<T,D> currentPoint = closestPointOnTriangle(polygon[v1], polygon[v2], pB, point);
-            T distance = (point - closestPoint).norm();
+            T distance = (point - currentPoint).norm();
             if (distance < minDistance) {
-                closestPoint = closestPointOnTriangle(polygon[v1], polygon[v2], pB, point);
+                closestPoint = currentPoint;
                 minDistance = distance;
             }
         }
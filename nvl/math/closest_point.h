@@ -61,6 +61,11 @@ Point<T,D> closestPointOnPlane(
         const Plane<T>& plane,
         const Point<T,D>& point);
 
+template<class T, EigenId D>
+Point<T,D> closestPointOnPolygonBarycenterSubdivision(
+        const std::vector<Point<T,D>>& polygon,
+        const Point<T,D>& point);
+
 }
 
 #include "closest_point.cpp"
@@ -0,0 +1,436 @@
+/*
+ * This file is part of nuvolib: https://github.com/stefanonuvoli/nuvolib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Stefano Nuvoli (stefano.nuvoli@gmail.com)
+ */
+#include "closest_point_packet.h"
+
+#include <algorithm>
+#include <limits>
+
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+namespace nvl {
+
+namespace internal {
+
+template<class T>
+void closestPointOnTrianglePacketKernel(
+        const TrianglePacket<T>& triangles,
+        const T* const points[3],
+        TriangleClosestPointPacket<T>& result);
+
+#ifdef __AVX2__
+void closestPointOnTrianglePacketKernel(
+        const TrianglePacket<double>& triangles,
+        const double* const points[3],
+        TriangleClosestPointPacket<double>& result);
+#endif
+
+}
+
+/**
+ * @brief Default constructor, the packet is empty
+ */
+template<class T>
+TrianglePacket<T>::TrianglePacket() :
+    size(0)
+{
+    std::fill(&vertices[0][0][0], &vertices[0][0][0] + 9 * NVL_TRIANGLE_PACKET_SIZE, T(0));
+}
+
+/**
+ * @brief Add a triangle in the first free lane
+ * @param p1 Vertex 1
+ * @param p2 Vertex 2
+ * @param p3 Vertex 3
+ * @return Lane of the triangle
+ */
+template<class T>
+Index TrianglePacket<T>::addTriangle(const Point3<T>& p1, const Point3<T>& p2, const Point3<T>& p3)
+{
+    assert(!isFull());
+
+    const Index lane = size;
+    setTriangle(lane, p1, p2, p3);
+    ++size;
+
+    return lane;
+}
+
+/**
+ * @brief Set the triangle of a lane
+ * @param lane Lane
+ * @param p1 Vertex 1
+ * @param p2 Vertex 2
+ * @param p3 Vertex 3
+ */
+template<class T>
+void TrianglePacket<T>::setTriangle(const Index& lane, const Point3<T>& p1, const Point3<T>& p2, const Point3<T>& p3)
+{
+    assert(lane < NVL_TRIANGLE_PACKET_SIZE);
+
+    for (Index c = 0; c < 3; ++c) {
+        vertices[0][c][lane] = p1(c);
+        vertices[1][c][lane] = p2(c);
+        vertices[2][c][lane] = p3(c);
+    }
+}
+
+/**
+ * @brief Check if all the lanes are used
+ * @return True if the packet is full
+ */
+template<class T>
+bool TrianglePacket<T>::isFull() const
+{
+    return size >= NVL_TRIANGLE_PACKET_SIZE;
+}
+
+/**
+ * @brief Check if no lane is used
+ * @return True if the packet is empty
+ */
+template<class T>
+bool TrianglePacket<T>::isEmpty() const
+{
+    return size == 0;
+}
+
+/**
+ * @brief Remove all the triangles. The lanes are not reset.
+ */
+template<class T>
+void TrianglePacket<T>::clear()
+{
+    size = 0;
+}
+
+/**
+ * @brief Closest point of a lane
+ * @param lane Lane
+ * @return Closest point
+ */
+template<class T>
+Point3<T> TriangleClosestPointPacket<T>::closestPoint(const Index& lane) const
+{
+    return Point3<T>(closestPoints[0][lane], closestPoints[1][lane], closestPoints[2][lane]);
+}
+
+/**
+ * @brief Barycentric coordinates of the closest point of a lane
+ * @param lane Lane
+ * @return Barycentric coordinates
+ */
+template<class T>
+Vector3<T> TriangleClosestPointPacket<T>::barycentricCoordinate(const Index& lane) const
+{
+    return Vector3<T>(barycentricCoordinates[0][lane], barycentricCoordinates[1][lane], barycentricCoordinates[2][lane]);
+}
+
+/**
+ * @brief Lane with the minimum squared distance
+ * @param size Number of used lanes
+ * @return Lane, NULL_ID if the size is zero
+ */
+template<class T>
+Index TriangleClosestPointPacket<T>::nearestLane(const Size& size) const
+{
+    Index nearest = NULL_ID;
+    T minDistance = std::numeric_limits<T>::max();
+
+    for (Index i = 0; i < size; ++i) {
+        if (nearest == NULL_ID || squaredDistances[i] < minDistance) {
+            nearest = i;
+            minDistance = squaredDistances[i];
+        }
+    }
+
+    return nearest;
+}
+
+/**
+ * @brief Closest points of a point on a packet of triangles. The lanes are
+ * evaluated together, with AVX2 if available.
+ * @param triangles Triangle packet
+ * @param point Target point
+ * @param result Squared distances, closest points and barycentric coordinates
+ * for each lane
+ */
+template<class T>
+void closestPointOnTrianglePacket(
+        const TrianglePacket<T>& triangles,
+        const Point3<T>& point,
+        TriangleClosestPointPacket<T>& result)
+{
+    alignas(32) T coordinates[3][NVL_TRIANGLE_PACKET_SIZE];
+    for (Index c = 0; c < 3; ++c) {
+        std::fill(coordinates[c], coordinates[c] + NVL_TRIANGLE_PACKET_SIZE, point(c));
+    }
+
+    const T* const points[3] = { coordinates[0], coordinates[1], coordinates[2] };
+
+    internal::closestPointOnTrianglePacketKernel(triangles, points, result);
+}
+
+/**
+ * @brief Closest points of many points on a triangle. The points are
+ * evaluated in packets, in parallel.
+ * @param p1 Vertex 1
+ * @param p2 Vertex 2
+ * @param p3 Vertex 3
+ * @param points Target points
+ * @param squaredDistances Squared distance of each point from the triangle
+ * @param closestPoints Closest point of each point
+ * @param barycentricCoordinates Barycentric coordinates of each closest point
+ */
+template<class T>
+void closestPointsOnTriangle(
+        const Point3<T>& p1,
+        const Point3<T>& p2,
+        const Point3<T>& p3,
+        const std::vector<Point3<T>>& points,
+        std::vector<T>& squaredDistances,
+        std::vector<Point3<T>>& closestPoints,
+        std::vector<Vector3<T>>& barycentricCoordinates)
+{
+    squaredDistances.resize(points.size());
+    closestPoints.resize(points.size());
+    barycentricCoordinates.resize(points.size());
+
+    TrianglePacket<T> triangles;
+    for (Index i = 0; i < NVL_TRIANGLE_PACKET_SIZE; ++i) {
+        triangles.addTriangle(p1, p2, p3);
+    }
+
+    const Size packetNumber = (points.size() + NVL_TRIANGLE_PACKET_SIZE - 1) / NVL_TRIANGLE_PACKET_SIZE;
+
+    #pragma omp parallel for
+    for (Index pId = 0; pId < packetNumber; ++pId) {
+        const Index begin = pId * NVL_TRIANGLE_PACKET_SIZE;
+        const Size size = std::min(static_cast<Size>(NVL_TRIANGLE_PACKET_SIZE), points.size() - begin);
+
+        alignas(32) T coordinates[3][NVL_TRIANGLE_PACKET_SIZE];
+        for (Index i = 0; i < NVL_TRIANGLE_PACKET_SIZE; ++i) {
+            const Point3<T>& point = points[begin + std::min(i, size - 1)];
+            for (Index c = 0; c < 3; ++c) {
+                coordinates[c][i] = point(c);
+            }
+        }
+
+        const T* const packetPoints[3] = { coordinates[0], coordinates[1], coordinates[2] };
+
+        TriangleClosestPointPacket<T> result;
+        internal::closestPointOnTrianglePacketKernel(triangles, packetPoints, result);
+
+        for (Index i = 0; i < size; ++i) {
+            squaredDistances[begin + i] = result.squaredDistances[i];
+            closestPoints[begin + i] = result.closestPoint(i);
+            barycentricCoordinates[begin + i] = result.barycentricCoordinate(i);
+        }
+    }
+}
+
+namespace internal {
+
+/*
+ * The closest point is the projection on the plane if it lies inside the
+ * triangle, otherwise the nearest of the closest points on the three edges.
+ * All the cases are computed and then selected, so the lanes do not branch.
+ * The edges are tested in the same order of closestPointOnTriangle.
+ */
+template<class T>
+void closestPointOnTrianglePacketKernel(
+        const TrianglePacket<T>& triangles,
+        const T* const points[3],
+        TriangleClosestPointPacket<T>& result)
+{
+    const T tiny = std::numeric_limits<T>::min();
+
+    #pragma omp simd
+    for (Index i = 0; i < NVL_TRIANGLE_PACKET_SIZE; ++i) {
+        const T ax = triangles.vertices[0][0][i], ay = triangles.vertices[0][1][i], az = triangles.vertices[0][2][i];
+        const T bx = triangles.vertices[1][0][i], by = triangles.vertices[1][1][i], bz = triangles.vertices[1][2][i];
+        const T cx = triangles.vertices[2][0][i], cy = triangles.vertices[2][1][i], cz = triangles.vertices[2][2][i];
+        const T px = points[0][i], py = points[1][i], pz = points[2][i];
+
+        const T abx = bx - ax, aby = by - ay, abz = bz - az;
+        const T acx = cx - ax, acy = cy - ay, acz = cz - az;
+        const T bcx = cx - bx, bcy = cy - by, bcz = cz - bz;
+        const T apx = px - ax, apy = py - ay, apz = pz - az;
+        const T bpx = px - bx, bpy = py - by, bpz = pz - bz;
+
+        const T d00 = abx * abx + aby * aby + abz * abz;
+        const T d01 = abx * acx + aby * acy + abz * acz;
+        const T d11 = acx * acx + acy * acy + acz * acz;
+        const T d20 = apx * abx + apy * aby + apz * abz;
+        const T d21 = apx * acx + apy * acy + apz * acz;
+        const T dbc = bcx * bcx + bcy * bcy + bcz * bcz;
+        const T dbp = bpx * bcx + bpy * bcy + bpz * bcz;
+
+        //Projection on the plane
+        const T denom = d00 * d11 - d01 * d01;
+        const T inverseDenom = denom > T(0) ? T(1) / denom : T(0);
+        const T v = (d11 * d20 - d01 * d21) * inverseDenom;
+        const T w = (d00 * d21 - d01 * d20) * inverseDenom;
+        const T u = T(1) - v - w;
+        const bool inside = denom > T(0) && u >= T(0) && v >= T(0) && w >= T(0);
+
+        const T qx = ax + v * abx + w * acx, qy = ay + v * aby + w * acy, qz = az + v * abz + w * acz;
+        const T dq = (px - qx) * (px - qx) + (py - qy) * (py - qy) + (pz - qz) * (pz - qz);
+
+        //Edges
+        const T t1 = std::min(std::max(d20 / std::max(d00, tiny), T(0)), T(1));
+        const T t2 = std::min(std::max(dbp / std::max(dbc, tiny), T(0)), T(1));
+        const T t3 = std::min(std::max(d21 / std::max(d11, tiny), T(0)), T(1));
+
+        const T q1x = ax + t1 * abx, q1y = ay + t1 * aby, q1z = az + t1 * abz;
+        const T q2x = bx + t2 * bcx, q2y = by + t2 * bcy, q2z = bz + t2 * bcz;
+        const T q3x = ax + t3 * acx, q3y = ay + t3 * acy, q3z = az + t3 * acz;
+
+        const T d1 = (px - q1x) * (px - q1x) + (py - q1y) * (py - q1y) + (pz - q1z) * (pz - q1z);
+        const T d2 = (px - q2x) * (px - q2x) + (py - q2y) * (py - q2y) + (pz - q2z) * (pz - q2z);
+        const T d3 = (px - q3x) * (px - q3x) + (py - q3y) * (py - q3y) + (pz - q3z) * (pz - q3z);
+
+        const bool use1 = d1 <= d2 && d1 <= d3;
+        const bool use2 = !use1 && d2 <= d3;
+
+        const T ex = use1 ? q1x : (use2 ? q2x : q3x);
+        const T ey = use1 ? q1y : (use2 ? q2y : q3y);
+        const T ez = use1 ? q1z : (use2 ? q2z : q3z);
+        const T ed = use1 ? d1 : (use2 ? d2 : d3);
+        const T eu = use1 ? T(1) - t1 : (use2 ? T(0) : T(1) - t3);
+        const T ev = use1 ? t1 : (use2 ? T(1) - t2 : T(0));
+        const T ew = use1 ? T(0) : (use2 ? t2 : t3);
+
+        result.squaredDistances[i] = inside ? dq : ed;
+        result.closestPoints[0][i] = inside ? qx : ex;
+        result.closestPoints[1][i] = inside ? qy : ey;
+        result.closestPoints[2][i] = inside ? qz : ez;
+        result.barycentricCoordinates[0][i] = inside ? u : eu;
+        result.barycentricCoordinates[1][i] = inside ? v : ev;
+        result.barycentricCoordinates[2][i] = inside ? w : ew;
+    }
+}
+
+#ifdef __AVX2__
+
+NVL_INLINE __m256d closestPointPacketDot(const __m256d x[3], const __m256d y[3])
+{
+    return _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(x[0], y[0]), _mm256_mul_pd(x[1], y[1])), _mm256_mul_pd(x[2], y[2]));
+}
+
+NVL_INLINE __m256d closestPointPacketSquaredDistance(const __m256d x[3], const __m256d y[3])
+{
+    __m256d d[3];
+    for (Index c = 0; c < 3; ++c) {
+        d[c] = _mm256_sub_pd(x[c], y[c]);
+    }
+
+    return closestPointPacketDot(d, d);
+}
+
+NVL_INLINE __m256d closestPointPacketClamp(const __m256d& x)
+{
+    return _mm256_min_pd(_mm256_max_pd(x, _mm256_setzero_pd()), _mm256_set1_pd(1.0));
+}
+
+/*
+ * Same algorithm of the generic kernel, on 4 lanes at a time.
+ */
+NVL_INLINE void closestPointOnTrianglePacketKernel(
+        const TrianglePacket<double>& triangles,
+        const double* const points[3],
+        TriangleClosestPointPacket<double>& result)
+{
+    const __m256d zero = _mm256_setzero_pd();
+    const __m256d one = _mm256_set1_pd(1.0);
+    const __m256d tiny = _mm256_set1_pd(std::numeric_limits<double>::min());
+
+    for (Index o = 0; o < NVL_TRIANGLE_PACKET_SIZE; o += 4) {
+        __m256d a[3], b[3], c[3], p[3];
+        __m256d ab[3], ac[3], bc[3], ap[3], bp[3];
+        for (Index k = 0; k < 3; ++k) {
+            a[k] = _mm256_load_pd(&triangles.vertices[0][k][o]);
+            b[k] = _mm256_load_pd(&triangles.vertices[1][k][o]);
+            c[k] = _mm256_load_pd(&triangles.vertices[2][k][o]);
+            p[k] = _mm256_loadu_pd(&points[k][o]);
+
+            ab[k] = _mm256_sub_pd(b[k], a[k]);
+            ac[k] = _mm256_sub_pd(c[k], a[k]);
+            bc[k] = _mm256_sub_pd(c[k], b[k]);
+            ap[k] = _mm256_sub_pd(p[k], a[k]);
+            bp[k] = _mm256_sub_pd(p[k], b[k]);
+        }
+
+        const __m256d d00 = closestPointPacketDot(ab, ab);
+        const __m256d d01 = closestPointPacketDot(ab, ac);
+        const __m256d d11 = closestPointPacketDot(ac, ac);
+        const __m256d d20 = closestPointPacketDot(ap, ab);
+        const __m256d d21 = closestPointPacketDot(ap, ac);
+        const __m256d dbc = closestPointPacketDot(bc, bc);
+        const __m256d dbp = closestPointPacketDot(bp, bc);
+
+        //Projection on the plane
+        const __m256d denom = _mm256_sub_pd(_mm256_mul_pd(d00, d11), _mm256_mul_pd(d01, d01));
+        const __m256d positive = _mm256_cmp_pd(denom, zero, _CMP_GT_OQ);
+        const __m256d inverseDenom = _mm256_and_pd(_mm256_div_pd(one, denom), positive);
+        const __m256d v = _mm256_mul_pd(_mm256_sub_pd(_mm256_mul_pd(d11, d20), _mm256_mul_pd(d01, d21)), inverseDenom);
+        const __m256d w = _mm256_mul_pd(_mm256_sub_pd(_mm256_mul_pd(d00, d21), _mm256_mul_pd(d01, d20)), inverseDenom);
+        const __m256d u = _mm256_sub_pd(_mm256_sub_pd(one, v), w);
+        const __m256d inside = _mm256_and_pd(
+                    _mm256_and_pd(positive, _mm256_cmp_pd(u, zero, _CMP_GE_OQ)),
+                    _mm256_and_pd(_mm256_cmp_pd(v, zero, _CMP_GE_OQ), _mm256_cmp_pd(w, zero, _CMP_GE_OQ)));
+
+        __m256d q[3];
+        for (Index k = 0; k < 3; ++k) {
+            q[k] = _mm256_add_pd(a[k], _mm256_add_pd(_mm256_mul_pd(v, ab[k]), _mm256_mul_pd(w, ac[k])));
+        }
+        const __m256d dq = closestPointPacketSquaredDistance(p, q);
+
+        //Edges
+        const __m256d t1 = closestPointPacketClamp(_mm256_div_pd(d20, _mm256_max_pd(d00, tiny)));
+        const __m256d t2 = closestPointPacketClamp(_mm256_div_pd(dbp, _mm256_max_pd(dbc, tiny)));
+        const __m256d t3 = closestPointPacketClamp(_mm256_div_pd(d21, _mm256_max_pd(d11, tiny)));
+
+        __m256d q1[3], q2[3], q3[3];
+        for (Index k = 0; k < 3; ++k) {
+            q1[k] = _mm256_add_pd(a[k], _mm256_mul_pd(t1, ab[k]));
+            q2[k] = _mm256_add_pd(b[k], _mm256_mul_pd(t2, bc[k]));
+            q3[k] = _mm256_add_pd(a[k], _mm256_mul_pd(t3, ac[k]));
+        }
+
+        const __m256d d1 = closestPointPacketSquaredDistance(p, q1);
+        const __m256d d2 = closestPointPacketSquaredDistance(p, q2);
+        const __m256d d3 = closestPointPacketSquaredDistance(p, q3);
+
+        const __m256d use1 = _mm256_and_pd(_mm256_cmp_pd(d1, d2, _CMP_LE_OQ), _mm256_cmp_pd(d1, d3, _CMP_LE_OQ));
+        const __m256d use2 = _mm256_cmp_pd(d2, d3, _CMP_LE_OQ);
+
+        //Selection: the edge 2 is used over the edge 3, the edge 1 over both, the plane over all
+        for (Index k = 0; k < 3; ++k) {
+            const __m256d e = _mm256_blendv_pd(_mm256_blendv_pd(q3[k], q2[k], use2), q1[k], use1);
+            _mm256_store_pd(&result.closestPoints[k][o], _mm256_blendv_pd(e, q[k], inside));
+        }
+
+        const __m256d ed = _mm256_blendv_pd(_mm256_blendv_pd(d3, d2, use2), d1, use1);
+        _mm256_store_pd(&result.squaredDistances[o], _mm256_blendv_pd(ed, dq, inside));
+
+        const __m256d eu = _mm256_blendv_pd(_mm256_blendv_pd(_mm256_sub_pd(one, t3), zero, use2), _mm256_sub_pd(one, t1), use1);
+        const __m256d ev = _mm256_blendv_pd(_mm256_blendv_pd(zero, _mm256_sub_pd(one, t2), use2), t1, use1);
+        const __m256d ew = _mm256_blendv_pd(_mm256_blendv_pd(t3, t2, use2), zero, use1);
+
+        _mm256_store_pd(&result.barycentricCoordinates[0][o], _mm256_blendv_pd(eu, u, inside));
+        _mm256_store_pd(&result.barycentricCoordinates[1][o], _mm256_blendv_pd(ev, v, inside));
+        _mm256_store_pd(&result.barycentricCoordinates[2][o], _mm256_blendv_pd(ew, w, inside));
+    }
+}
+
+#endif
+
+}
+
+}
@@ -0,0 +1,75 @@
+/*
+ * This file is part of nuvolib: https://github.com/stefanonuvoli/nuvolib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Stefano Nuvoli (stefano.nuvoli@gmail.com)
+ */
+#ifndef NVL_MATH_CLOSEST_POINT_PACKET_H
+#define NVL_MATH_CLOSEST_POINT_PACKET_H
+
+#include <nvl/nuvolib.h>
+
+#include <nvl/math/point.h>
+
+#include <vector>
+
+#define NVL_TRIANGLE_PACKET_SIZE 8
+
+namespace nvl {
+
+/**
+ * @brief Packet of triangles in a structure of arrays layout: the coordinate
+ * c (0 = x, 1 = y, 2 = z) of the vertex k of the triangle in the lane i is
+ * vertices[k][c][i]. The lanes from size to NVL_TRIANGLE_PACKET_SIZE are
+ * ignored by the results, but they are computed anyway.
+ */
+template<class T>
+struct TrianglePacket {
+    alignas(32) T vertices[3][3][NVL_TRIANGLE_PACKET_SIZE];
+    Size size;
+
+    TrianglePacket();
+
+    Index addTriangle(const Point3<T>& p1, const Point3<T>& p2, const Point3<T>& p3);
+    void setTriangle(const Index& lane, const Point3<T>& p1, const Point3<T>& p2, const Point3<T>& p3);
+    bool isFull() const;
+    bool isEmpty() const;
+    void clear();
+};
+
+/**
+ * @brief Result of a closest point packet query: for each lane, the squared
+ * distance, the closest point and its barycentric coordinates in the triangle.
+ */
+template<class T>
+struct TriangleClosestPointPacket {
+    alignas(32) T squaredDistances[NVL_TRIANGLE_PACKET_SIZE];
+    alignas(32) T closestPoints[3][NVL_TRIANGLE_PACKET_SIZE];
+    alignas(32) T barycentricCoordinates[3][NVL_TRIANGLE_PACKET_SIZE];
+
+    Point3<T> closestPoint(const Index& lane) const;
+    Vector3<T> barycentricCoordinate(const Index& lane) const;
+    Index nearestLane(const Size& size) const;
+};
+
+template<class T>
+void closestPointOnTrianglePacket(
+        const TrianglePacket<T>& triangles,
+        const Point3<T>& point,
+        TriangleClosestPointPacket<T>& result);
+
+template<class T>
+void closestPointsOnTriangle(
+        const Point3<T>& p1,
+        const Point3<T>& p2,
+        const Point3<T>& p3,
+        const std::vector<Point3<T>>& points,
+        std::vector<T>& squaredDistances,
+        std::vector<Point3<T>>& closestPoints,
+        std::vector<Vector3<T>>& barycentricCoordinates);
+
+}
+
+#include "closest_point_packet.cpp"
+
+#endif // NVL_MATH_CLOSEST_POINT_PACKET_H
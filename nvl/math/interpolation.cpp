@@ -25,7 +25,7 @@ T interpolateLinear(const T& v1, const T& v2, const W& a)
     if (epsEqual(a, 1.0))
         return v2;
 
-    return (a - 1) * v1 + a * v2;
+    return (1 - a) * v1 + a * v2;
 }
 
 /**
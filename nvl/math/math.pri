@@ -14,6 +14,7 @@ HEADERS += \
     $$PWD/principal_curvatures.h \
     $$PWD/statistics.h \
     $$PWD/closest_point.h \
+    $$PWD/closest_point_packet.h \
     $$PWD/common_functions.h \
     $$PWD/comparisons.h \
     $$PWD/constants.h \
@@ -55,6 +56,7 @@ SOURCES += \
     $$PWD/inverse_function.cpp \
     $$PWD/statistics.cpp \
     $$PWD/closest_point.cpp \
+    $$PWD/closest_point_packet.cpp \
     $$PWD/common_functions.cpp \
     $$PWD/comparisons.cpp \
     $$PWD/conversions.cpp \
@@ -6,11 +6,47 @@
  */
 #include "mesh_adjacencies.h"
 
+#include <nvl/structures/containers/concurrent_disjoint_set.h>
+
 #include <stack>
 #include <unordered_set>
+#include <algorithm>
 
 namespace nvl {
 
+namespace internal {
+
+template<class Mesh>
+void meshEdgeConnectedComponentsLabeling(
+        const Mesh& mesh,
+        const std::vector<bool>& activeFaces,
+        std::vector<Index>& faceComponentMap,
+        Size& componentNumber);
+
+template<class Mesh>
+void meshVertexConnectedComponentsLabeling(
+        const Mesh& mesh,
+        const std::vector<bool>& activeFaces,
+        std::vector<Index>& faceComponentMap,
+        std::vector<Index>& vertexComponentMap,
+        Size& componentNumber);
+
+template<class FaceId>
+std::vector<std::vector<FaceId>> meshComponentsFromComponentMap(
+        const std::vector<Index>& faceComponentMap,
+        const Size& componentNumber);
+
+template<class Mesh, class Set>
+std::vector<bool> meshActiveFaces(
+        const Mesh& mesh,
+        const Set& selectedFaces);
+
+template<class Mesh>
+std::vector<bool> meshActiveFaces(
+        const Mesh& mesh);
+
+}
+
 /**
  * @brief Mesh vertex-vertex adjacencies
  * @param mesh Mesh
@@ -179,6 +215,130 @@ std::vector<std::vector<typename Mesh::FaceId>> meshFaceFaceAdjacencies(
     return ffAdj;
 }
 
+/**
+ * @brief Unique ids of the edges of the mesh, shared by the faces incident on them
+ * (regardless of the orientation)
+ * @param mesh Mesh
+ * @return Id of the edge for each face and each position of the face
+ */
+template<class Mesh>
+std::vector<std::vector<Index>> meshFaceEdgeIds(
+        const Mesh& mesh)
+{
+    std::vector<std::pair<typename Mesh::VertexId, typename Mesh::VertexId>> edgeVertices;
+    return meshFaceEdgeIds(mesh, edgeVertices);
+}
+
+/**
+ * @brief Unique ids of the edges of the mesh, shared by the faces incident on them
+ * (regardless of the orientation). The edges are bucketed by their smallest vertex
+ * in parallel, hence they are numbered in lexicographical order of their vertices.
+ * @param mesh Mesh
+ * @param edgeVertices Output vertices of each edge, the smallest id is the first
+ * @return Id of the edge for each face and each position of the face
+ */
+template<class Mesh>
+std::vector<std::vector<Index>> meshFaceEdgeIds(
+        const Mesh& mesh,
+        std::vector<std::pair<typename Mesh::VertexId, typename Mesh::VertexId>>& edgeVertices)
+{
+    typedef typename Mesh::Face Face;
+    typedef typename Mesh::FaceId FaceId;
+    typedef typename Mesh::VertexId VertexId;
+
+    const Size faceNumber = mesh.nextFaceId();
+    const Size vertexNumber = mesh.nextVertexId();
+
+    std::vector<std::vector<Index>> faceEdgeIds(faceNumber);
+
+    //Count the face edges for each smallest vertex
+    std::vector<Index> bucketOffsets(vertexNumber + 1, 0);
+
+    #pragma omp parallel for
+    for (FaceId fId = 0; fId < faceNumber; ++fId) {
+        if (mesh.isFaceDeleted(fId))
+            continue;
+
+        const Face& face = mesh.face(fId);
+        faceEdgeIds[fId].resize(face.vertexNumber(), NULL_ID);
+
+        for (Index fePos = 0; fePos < face.vertexNumber(); ++fePos) {
+            const VertexId minId = std::min(face.vertexId(fePos), face.nextVertexId(fePos));
+
+            #pragma omp atomic
+            ++bucketOffsets[minId + 1];
+        }
+    }
+
+    for (Index i = 0; i < vertexNumber; ++i) {
+        bucketOffsets[i + 1] += bucketOffsets[i];
+    }
+
+    //Fill the buckets with the greatest vertex, the face and the position in the face
+    std::vector<std::pair<VertexId, std::pair<FaceId, Index>>> faceEdges(bucketOffsets[vertexNumber]);
+    std::vector<Index> bucketPositions(bucketOffsets.begin(), bucketOffsets.end() - 1);
+
+    #pragma omp parallel for
+    for (FaceId fId = 0; fId < faceNumber; ++fId) {
+        if (mesh.isFaceDeleted(fId))
+            continue;
+
+        const Face& face = mesh.face(fId);
+        for (Index fePos = 0; fePos < face.vertexNumber(); ++fePos) {
+            const VertexId& vId1 = face.vertexId(fePos);
+            const VertexId& vId2 = face.nextVertexId(fePos);
+
+            Index pos;
+            #pragma omp atomic capture
+            pos = bucketPositions[std::min(vId1, vId2)]++;
+
+            faceEdges[pos] = std::make_pair(std::max(vId1, vId2), std::make_pair(fId, fePos));
+        }
+    }
+
+    //Count the distinct edges in each bucket
+    std::vector<Index> edgeOffsets(vertexNumber + 1, 0);
+
+    #pragma omp parallel for schedule(dynamic, 1024)
+    for (VertexId vId = 0; vId < vertexNumber; ++vId) {
+        const Index begin = bucketOffsets[vId];
+        const Index end = bucketOffsets[vId + 1];
+
+        std::sort(faceEdges.begin() + begin, faceEdges.begin() + end);
+
+        for (Index i = begin; i < end; ++i) {
+            if (i == begin || faceEdges[i].first != faceEdges[i - 1].first) {
+                ++edgeOffsets[vId + 1];
+            }
+        }
+    }
+
+    for (Index i = 0; i < vertexNumber; ++i) {
+        edgeOffsets[i + 1] += edgeOffsets[i];
+    }
+
+    //Assign the ids
+    edgeVertices.resize(edgeOffsets[vertexNumber]);
+
+    #pragma omp parallel for schedule(dynamic, 1024)
+    for (VertexId vId = 0; vId < vertexNumber; ++vId) {
+        const Index begin = bucketOffsets[vId];
+        const Index end = bucketOffsets[vId + 1];
+
+        Index eId = edgeOffsets[vId];
+        for (Index i = begin; i < end; ++i) {
+            if (i > begin && faceEdges[i].first != faceEdges[i - 1].first) {
+                ++eId;
+            }
+
+            edgeVertices[eId] = std::make_pair(vId, faceEdges[i].first);
+            faceEdgeIds[faceEdges[i].second.first][faceEdges[i].second.second] = eId;
+        }
+    }
+
+    return faceEdgeIds;
+}
+
 /**
  * @brief Connected components of a mesh
  * @param mesh Mesh
@@ -379,4 +539,435 @@ std::vector<std::vector<typename Mesh::FaceId>> meshSubsetConnectedComponents(
     return connectedComponents;
 }
 
+/**
+ * @brief Connected components of a mesh, in which two faces are connected if
+ * they share an edge (regardless of the orientation). The labeling is computed
+ * in parallel by a concurrent union-find on the edges of the faces, and it
+ * does not require the face-face adjacencies.
+ * @param mesh Mesh
+ * @return Connected components as a vector of face ids
+ */
+template<class Mesh>
+std::vector<std::vector<typename Mesh::FaceId>> meshEdgeConnectedComponents(
+        const Mesh& mesh)
+{
+    std::vector<Index> faceComponentMap;
+    return meshEdgeConnectedComponents(mesh, faceComponentMap);
+}
+
+/**
+ * @brief Connected components of a mesh, in which two faces are connected if
+ * they share an edge (regardless of the orientation). The labeling is computed
+ * in parallel by a concurrent union-find on the edges of the faces, and it
+ * does not require the face-face adjacencies.
+ * @param mesh Mesh
+ * @param faceComponentMap Map that maps to each face the component it belongs in
+ * @return Connected components as a vector of face ids
+ */
+template<class Mesh>
+std::vector<std::vector<typename Mesh::FaceId>> meshEdgeConnectedComponents(
+        const Mesh& mesh,
+        std::vector<Index>& faceComponentMap)
+{
+    typedef typename Mesh::FaceId FaceId;
+
+    Size componentNumber;
+    internal::meshEdgeConnectedComponentsLabeling(mesh, internal::meshActiveFaces(mesh), faceComponentMap, componentNumber);
+
+    return internal::meshComponentsFromComponentMap<FaceId>(faceComponentMap, componentNumber);
+}
+
+/**
+ * @brief Connected components of a subset of faces, in which two faces are connected
+ * if they share an edge (regardless of the orientation). The labeling is computed
+ * in parallel by a concurrent union-find on the edges of the faces, and it
+ * does not require the face-face adjacencies.
+ * @param mesh Mesh
+ * @param selectedFaces Face subset on which compute the connected components
+ * @return Connected components as a vector of face ids
+ */
+template<class Mesh, class Set>
+std::vector<std::vector<typename Mesh::FaceId>> meshSubsetEdgeConnectedComponents(
+        const Mesh& mesh,
+        const Set& selectedFaces)
+{
+    std::vector<Index> faceComponentMap;
+    return meshSubsetEdgeConnectedComponents(mesh, selectedFaces, faceComponentMap);
+}
+
+/**
+ * @brief Connected components of a subset of faces, in which two faces are connected
+ * if they share an edge (regardless of the orientation). The labeling is computed
+ * in parallel by a concurrent union-find on the edges of the faces, and it
+ * does not require the face-face adjacencies.
+ * @param mesh Mesh
+ * @param selectedFaces Face subset on which compute the connected components
+ * @param faceComponentMap Map that maps to each face the component it belongs in
+ * @return Connected components as a vector of face ids
+ */
+template<class Mesh, class Set>
+std::vector<std::vector<typename Mesh::FaceId>> meshSubsetEdgeConnectedComponents(
+        const Mesh& mesh,
+        const Set& selectedFaces,
+        std::vector<Index>& faceComponentMap)
+{
+    typedef typename Mesh::FaceId FaceId;
+
+    Size componentNumber;
+    internal::meshEdgeConnectedComponentsLabeling(mesh, internal::meshActiveFaces(mesh, selectedFaces), faceComponentMap, componentNumber);
+
+    return internal::meshComponentsFromComponentMap<FaceId>(faceComponentMap, componentNumber);
+}
+
+/**
+ * @brief Connected components of a mesh, in which two faces are connected if
+ * they share a vertex. The labeling is computed in parallel by a concurrent
+ * union-find on the vertices of the faces.
+ * @param mesh Mesh
+ * @return Connected components as a vector of face ids
+ */
+template<class Mesh>
+std::vector<std::vector<typename Mesh::FaceId>> meshVertexConnectedComponents(
+        const Mesh& mesh)
+{
+    std::vector<Index> faceComponentMap;
+    return meshVertexConnectedComponents(mesh, faceComponentMap);
+}
+
+/**
+ * @brief Connected components of a mesh, in which two faces are connected if
+ * they share a vertex. The labeling is computed in parallel by a concurrent
+ * union-find on the vertices of the faces.
+ * @param mesh Mesh
+ * @param faceComponentMap Map that maps to each face the component it belongs in
+ * @return Connected components as a vector of face ids
+ */
+template<class Mesh>
+std::vector<std::vector<typename Mesh::FaceId>> meshVertexConnectedComponents(
+        const Mesh& mesh,
+        std::vector<Index>& faceComponentMap)
+{
+    std::vector<Index> vertexComponentMap;
+    return meshVertexConnectedComponents(mesh, faceComponentMap, vertexComponentMap);
+}
+
+/**
+ * @brief Connected components of a mesh, in which two faces are connected if
+ * they share a vertex. The labeling is computed in parallel by a concurrent
+ * union-find on the vertices of the faces.
+ * @param mesh Mesh
+ * @param faceComponentMap Map that maps to each face the component it belongs in
+ * @param vertexComponentMap Map that maps to each vertex the component it belongs in
+ * (NULL_ID for the vertices which are not incident to any face)
+ * @return Connected components as a vector of face ids
+ */
+template<class Mesh>
+std::vector<std::vector<typename Mesh::FaceId>> meshVertexConnectedComponents(
+        const Mesh& mesh,
+        std::vector<Index>& faceComponentMap,
+        std::vector<Index>& vertexComponentMap)
+{
+    typedef typename Mesh::FaceId FaceId;
+
+    Size componentNumber;
+    internal::meshVertexConnectedComponentsLabeling(mesh, internal::meshActiveFaces(mesh), faceComponentMap, vertexComponentMap, componentNumber);
+
+    return internal::meshComponentsFromComponentMap<FaceId>(faceComponentMap, componentNumber);
+}
+
+/**
+ * @brief Connected components of a subset of faces, in which two faces are
+ * connected if they share a vertex. The labeling is computed in parallel by
+ * a concurrent union-find on the vertices of the faces.
+ * @param mesh Mesh
+ * @param selectedFaces Face subset on which compute the connected components
+ * @return Connected components as a vector of face ids
+ */
+template<class Mesh, class Set>
+std::vector<std::vector<typename Mesh::FaceId>> meshSubsetVertexConnectedComponents(
+        const Mesh& mesh,
+        const Set& selectedFaces)
+{
+    std::vector<Index> faceComponentMap;
+    return meshSubsetVertexConnectedComponents(mesh, selectedFaces, faceComponentMap);
+}
+
+/**
+ * @brief Connected components of a subset of faces, in which two faces are
+ * connected if they share a vertex. The labeling is computed in parallel by
+ * a concurrent union-find on the vertices of the faces.
+ * @param mesh Mesh
+ * @param selectedFaces Face subset on which compute the connected components
+ * @param faceComponentMap Map that maps to each face the component it belongs in
+ * @return Connected components as a vector of face ids
+ */
+template<class Mesh, class Set>
+std::vector<std::vector<typename Mesh::FaceId>> meshSubsetVertexConnectedComponents(
+        const Mesh& mesh,
+        const Set& selectedFaces,
+        std::vector<Index>& faceComponentMap)
+{
+    std::vector<Index> vertexComponentMap;
+    return meshSubsetVertexConnectedComponents(mesh, selectedFaces, faceComponentMap, vertexComponentMap);
+}
+
+/**
+ * @brief Connected components of a subset of faces, in which two faces are
+ * connected if they share a vertex. The labeling is computed in parallel by
+ * a concurrent union-find on the vertices of the faces.
+ * @param mesh Mesh
+ * @param selectedFaces Face subset on which compute the connected components
+ * @param faceComponentMap Map that maps to each face the component it belongs in
+ * @param vertexComponentMap Map that maps to each vertex the component it belongs in
+ * (NULL_ID for the vertices which are not incident to any selected face)
+ * @return Connected components as a vector of face ids
+ */
+template<class Mesh, class Set>
+std::vector<std::vector<typename Mesh::FaceId>> meshSubsetVertexConnectedComponents(
+        const Mesh& mesh,
+        const Set& selectedFaces,
+        std::vector<Index>& faceComponentMap,
+        std::vector<Index>& vertexComponentMap)
+{
+    typedef typename Mesh::FaceId FaceId;
+
+    Size componentNumber;
+    internal::meshVertexConnectedComponentsLabeling(mesh, internal::meshActiveFaces(mesh, selectedFaces), faceComponentMap, vertexComponentMap, componentNumber);
+
+    return internal::meshComponentsFromComponentMap<FaceId>(faceComponentMap, componentNumber);
+}
+
+
+namespace internal {
+
+/**
+ * @brief Label the faces connected by an edge with a concurrent union-find.
+ * The edges are bucketed by their smallest vertex, then the faces sharing
+ * the same edge are merged in parallel over the buckets.
+ * @param mesh Mesh
+ * @param activeFaces Flag of the faces to be considered
+ * @param faceComponentMap Output map that maps to each face the component it belongs in
+ * @param componentNumber Output number of components
+ */
+template<class Mesh>
+void meshEdgeConnectedComponentsLabeling(
+        const Mesh& mesh,
+        const std::vector<bool>& activeFaces,
+        std::vector<Index>& faceComponentMap,
+        Size& componentNumber)
+{
+    typedef typename Mesh::Face Face;
+    typedef typename Mesh::FaceId FaceId;
+    typedef typename Mesh::VertexId VertexId;
+
+    const Size faceNumber = mesh.nextFaceId();
+    const Size vertexNumber = mesh.nextVertexId();
+
+    //Count the edges for each smallest vertex
+    std::vector<Index> bucketOffsets(vertexNumber + 1, 0);
+
+    #pragma omp parallel for
+    for (FaceId fId = 0; fId < faceNumber; ++fId) {
+        if (!activeFaces[fId])
+            continue;
+
+        const Face& face = mesh.face(fId);
+        for (Index fePos = 0; fePos < face.vertexNumber(); ++fePos) {
+            const VertexId minId = std::min(face.vertexId(fePos), face.nextVertexId(fePos));
+
+            #pragma omp atomic
+            ++bucketOffsets[minId + 1];
+        }
+    }
+
+    for (Index i = 0; i < vertexNumber; ++i) {
+        bucketOffsets[i + 1] += bucketOffsets[i];
+    }
+
+    //Fill the buckets with the greatest vertex and the face of the edges
+    std::vector<std::pair<VertexId, FaceId>> edges(bucketOffsets[vertexNumber]);
+    std::vector<Index> bucketPositions(bucketOffsets.begin(), bucketOffsets.end() - 1);
+
+    #pragma omp parallel for
+    for (FaceId fId = 0; fId < faceNumber; ++fId) {
+        if (!activeFaces[fId])
+            continue;
+
+        const Face& face = mesh.face(fId);
+        for (Index fePos = 0; fePos < face.vertexNumber(); ++fePos) {
+            const VertexId& vId1 = face.vertexId(fePos);
+            const VertexId& vId2 = face.nextVertexId(fePos);
+
+            const VertexId minId = std::min(vId1, vId2);
+            const VertexId maxId = std::max(vId1, vId2);
+
+            Index pos;
+            #pragma omp atomic capture
+            pos = bucketPositions[minId]++;
+
+            edges[pos] = std::make_pair(maxId, fId);
+        }
+    }
+
+    //Merge the faces sharing the same edge
+    ConcurrentDisjointSet disjointSet(faceNumber);
+
+    #pragma omp parallel for schedule(dynamic, 1024)
+    for (VertexId vId = 0; vId < vertexNumber; ++vId) {
+        const Index begin = bucketOffsets[vId];
+        const Index end = bucketOffsets[vId + 1];
+
+        if (end - begin < 2)
+            continue;
+
+        std::sort(edges.begin() + begin, edges.begin() + end);
+
+        for (Index i = begin + 1; i < end; ++i) {
+            if (edges[i].first == edges[i - 1].first) {
+                disjointSet.merge(edges[i].second, edges[i - 1].second);
+            }
+        }
+    }
+
+    faceComponentMap = disjointSet.computeSetIds(activeFaces, componentNumber);
+}
+
+/**
+ * @brief Label the faces connected by a vertex with a concurrent union-find.
+ * The vertices of each face are merged in parallel over the faces.
+ * @param mesh Mesh
+ * @param activeFaces Flag of the faces to be considered
+ * @param faceComponentMap Output map that maps to each face the component it belongs in
+ * @param vertexComponentMap Output map that maps to each vertex the component it belongs in
+ * @param componentNumber Output number of components
+ */
+template<class Mesh>
+void meshVertexConnectedComponentsLabeling(
+        const Mesh& mesh,
+        const std::vector<bool>& activeFaces,
+        std::vector<Index>& faceComponentMap,
+        std::vector<Index>& vertexComponentMap,
+        Size& componentNumber)
+{
+    typedef typename Mesh::Face Face;
+    typedef typename Mesh::FaceId FaceId;
+    typedef typename Mesh::VertexId VertexId;
+
+    const Size faceNumber = mesh.nextFaceId();
+    const Size vertexNumber = mesh.nextVertexId();
+
+    ConcurrentDisjointSet disjointSet(vertexNumber);
+
+    #pragma omp parallel for
+    for (FaceId fId = 0; fId < faceNumber; ++fId) {
+        if (!activeFaces[fId])
+            continue;
+
+        const Face& face = mesh.face(fId);
+        for (Index fePos = 1; fePos < face.vertexNumber(); ++fePos) {
+            disjointSet.merge(face.vertexId(0), face.vertexId(fePos));
+        }
+    }
+
+    //Components are numbered in the order of their smallest face
+    std::vector<Index> rootComponentMap(vertexNumber, NULL_ID);
+
+    faceComponentMap.assign(faceNumber, NULL_ID);
+    componentNumber = 0;
+    for (FaceId fId = 0; fId < faceNumber; ++fId) {
+        if (!activeFaces[fId])
+            continue;
+
+        Index& componentId = rootComponentMap[disjointSet.find(mesh.face(fId).vertexId(0))];
+        if (componentId == NULL_ID) {
+            componentId = componentNumber;
+            ++componentNumber;
+        }
+
+        faceComponentMap[fId] = componentId;
+    }
+
+    vertexComponentMap.resize(vertexNumber);
+
+    #pragma omp parallel for
+    for (VertexId vId = 0; vId < vertexNumber; ++vId) {
+        vertexComponentMap[vId] = rootComponentMap[disjointSet.find(vId)];
+    }
+}
+
+/**
+ * @brief Compute the components as vectors of face ids, given the component map
+ * @param faceComponentMap Map that maps to each face the component it belongs in
+ * @param componentNumber Number of components
+ * @return Connected components as a vector of face ids
+ */
+template<class FaceId>
+std::vector<std::vector<FaceId>> meshComponentsFromComponentMap(
+        const std::vector<Index>& faceComponentMap,
+        const Size& componentNumber)
+{
+    std::vector<Size> componentSizes(componentNumber, 0);
+    for (FaceId fId = 0; fId < faceComponentMap.size(); ++fId) {
+        if (faceComponentMap[fId] != NULL_ID) {
+            ++componentSizes[faceComponentMap[fId]];
+        }
+    }
+
+    std::vector<std::vector<FaceId>> connectedComponents(componentNumber);
+    for (Index cId = 0; cId < componentNumber; ++cId) {
+        connectedComponents[cId].reserve(componentSizes[cId]);
+    }
+
+    for (FaceId fId = 0; fId < faceComponentMap.size(); ++fId) {
+        if (faceComponentMap[fId] != NULL_ID) {
+            connectedComponents[faceComponentMap[fId]].push_back(fId);
+        }
+    }
+
+    return connectedComponents;
+}
+
+/**
+ * @brief Flag of the selected faces of a mesh
+ * @param mesh Mesh
+ * @param selectedFaces Face subset
+ * @return Flag for each face id, true if the face is selected
+ */
+template<class Mesh, class Set>
+std::vector<bool> meshActiveFaces(
+        const Mesh& mesh,
+        const Set& selectedFaces)
+{
+    typedef typename Mesh::FaceId FaceId;
+
+    std::vector<bool> activeFaces(mesh.nextFaceId(), false);
+    for (const FaceId& fId : selectedFaces) {
+        assert(!mesh.isFaceDeleted(fId));
+        activeFaces[fId] = true;
+    }
+
+    return activeFaces;
+}
+
+/**
+ * @brief Flag of the non-deleted faces of a mesh
+ * @param mesh Mesh
+ * @return Flag for each face id, true if the face is not deleted
+ */
+template<class Mesh>
+std::vector<bool> meshActiveFaces(
+        const Mesh& mesh)
+{
+    typedef typename Mesh::FaceId FaceId;
+
+    std::vector<bool> activeFaces(mesh.nextFaceId(), false);
+    for (FaceId fId = 0; fId < mesh.nextFaceId(); ++fId) {
+        activeFaces[fId] = !mesh.isFaceDeleted(fId);
+    }
+
+    return activeFaces;
+}
+
+}
+
 }
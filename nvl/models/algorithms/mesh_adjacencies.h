@@ -10,6 +10,7 @@
 #include <nvl/nuvolib.h>
 
 #include <vector>
+#include <utility>
 
 namespace nvl {
 
@@ -35,6 +36,14 @@ std::vector<std::vector<typename Mesh::FaceId>> meshFaceFaceAdjacencies(
         const Mesh& mesh,
         const std::vector<std::vector<typename Mesh::FaceId>>& vfAdj);
 
+template<class Mesh>
+std::vector<std::vector<Index>> meshFaceEdgeIds(
+        const Mesh& mesh);
+template<class Mesh>
+std::vector<std::vector<Index>> meshFaceEdgeIds(
+        const Mesh& mesh,
+        std::vector<std::pair<typename Mesh::VertexId, typename Mesh::VertexId>>& edgeVertices);
+
 template<class Mesh>
 std::vector<std::vector<typename Mesh::FaceId>> meshConnectedComponents(
         const Mesh& mesh);
@@ -73,6 +82,53 @@ std::vector<std::vector<typename Mesh::FaceId>> meshSubsetConnectedComponents(
         const std::vector<std::vector<typename Mesh::FaceId>>& ffAdj,
         std::vector<Index>& faceComponentMap);
 
+template<class Mesh>
+std::vector<std::vector<typename Mesh::FaceId>> meshEdgeConnectedComponents(
+        const Mesh& mesh);
+template<class Mesh>
+std::vector<std::vector<typename Mesh::FaceId>> meshEdgeConnectedComponents(
+        const Mesh& mesh,
+        std::vector<Index>& faceComponentMap);
+
+template<class Mesh, class Set>
+std::vector<std::vector<typename Mesh::FaceId>> meshSubsetEdgeConnectedComponents(
+        const Mesh& mesh,
+        const Set& selectedFaces);
+template<class Mesh, class Set>
+std::vector<std::vector<typename Mesh::FaceId>> meshSubsetEdgeConnectedComponents(
+        const Mesh& mesh,
+        const Set& selectedFaces,
+        std::vector<Index>& faceComponentMap);
+
+template<class Mesh>
+std::vector<std::vector<typename Mesh::FaceId>> meshVertexConnectedComponents(
+        const Mesh& mesh);
+template<class Mesh>
+std::vector<std::vector<typename Mesh::FaceId>> meshVertexConnectedComponents(
+        const Mesh& mesh,
+        std::vector<Index>& faceComponentMap);
+template<class Mesh>
+std::vector<std::vector<typename Mesh::FaceId>> meshVertexConnectedComponents(
+        const Mesh& mesh,
+        std::vector<Index>& faceComponentMap,
+        std::vector<Index>& vertexComponentMap);
+
+template<class Mesh, class Set>
+std::vector<std::vector<typename Mesh::FaceId>> meshSubsetVertexConnectedComponents(
+        const Mesh& mesh,
+        const Set& selectedFaces);
+template<class Mesh, class Set>
+std::vector<std::vector<typename Mesh::FaceId>> meshSubsetVertexConnectedComponents(
+        const Mesh& mesh,
+        const Set& selectedFaces,
+        std::vector<Index>& faceComponentMap);
+template<class Mesh, class Set>
+std::vector<std::vector<typename Mesh::FaceId>> meshSubsetVertexConnectedComponents(
+        const Mesh& mesh,
+        const Set& selectedFaces,
+        std::vector<Index>& faceComponentMap,
+        std::vector<Index>& vertexComponentMap);
+
 }
 
 #include "mesh_adjacencies.cpp"
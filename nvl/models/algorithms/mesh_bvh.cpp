@@ -0,0 +1,295 @@
+/*
+ * This file is part of nuvolib: https://github.com/stefanonuvoli/nuvolib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Stefano Nuvoli (stefano.nuvoli@gmail.com)
+ */
+#include "mesh_bvh.h"
+
+#include <nvl/math/closest_point.h>
+#include <nvl/math/closest_point_packet.h>
+
+namespace nvl {
+
+namespace internal {
+
+template<class Mesh>
+std::vector<AlignedBox3<typename Mesh::Scalar>> meshFaceBoxes(const Mesh& mesh);
+
+template<class Mesh>
+typename Mesh::Point meshFaceClosestPoint(
+        const Mesh& mesh,
+        const typename Mesh::FaceId& fId,
+        const typename Mesh::Point& point);
+
+template<class Mesh>
+typename Mesh::Scalar meshFaceLeafClosestFace(
+        const Mesh& mesh,
+        const Index* faceIds,
+        const Size number,
+        const typename Mesh::Point& point,
+        Index& closestFaceId);
+
+}
+
+/**
+ * @brief Get a bounding volume hierarchy of the faces of a mesh. The
+ * primitive ids of the hierarchy are the face ids.
+ * @param mesh Mesh
+ * @param maxLeafElements Max number of faces in each leaf
+ * @return Face BVH
+ */
+template<class Mesh>
+BVH<typename Mesh::Scalar, 3> meshFaceBVH(
+        const Mesh& mesh,
+        const Size maxLeafElements)
+{
+    return BVH<typename Mesh::Scalar, 3>(internal::meshFaceBoxes(mesh), maxLeafElements);
+}
+
+/**
+ * @brief Update a face BVH after the vertices of the mesh have been moved.
+ * The topology of the mesh must not be changed.
+ * @param mesh Mesh
+ * @param bvh Face BVH
+ */
+template<class Mesh>
+void meshFaceBVHRefit(
+        const Mesh& mesh,
+        BVH<typename Mesh::Scalar, 3>& bvh)
+{
+    bvh.refit(internal::meshFaceBoxes(mesh));
+}
+
+/**
+ * @brief Exact closest point on a mesh using a face BVH
+ * @param mesh Mesh
+ * @param bvh Face BVH
+ * @param point Point
+ * @return Closest point
+ */
+template<class Mesh>
+typename Mesh::Point meshFaceBVHClosestPoint(
+        const Mesh& mesh,
+        const BVH<typename Mesh::Scalar, 3>& bvh,
+        const typename Mesh::Point& point)
+{
+    typename Mesh::FaceId closestFaceId;
+    return meshFaceBVHClosestPoint(mesh, bvh, point, closestFaceId);
+}
+
+/**
+ * @brief Exact closest point on a mesh using a face BVH. The triangles of
+ * each leaf are evaluated in packets.
+ * @param mesh Mesh
+ * @param bvh Face BVH
+ * @param point Point
+ * @param closestFaceId Face of the closest point, NULL_ID if the mesh is empty
+ * @return Closest point
+ */
+template<class Mesh>
+typename Mesh::Point meshFaceBVHClosestPoint(
+        const Mesh& mesh,
+        const BVH<typename Mesh::Scalar, 3>& bvh,
+        const typename Mesh::Point& point,
+        typename Mesh::FaceId& closestFaceId)
+{
+    typedef typename Mesh::Scalar Scalar;
+    typedef typename Mesh::Point Point;
+
+    Scalar squaredDistance;
+    closestFaceId = bvh.closestLeaf(
+        point,
+        [&mesh](const Index* faceIds, const Size number, const Point& p, Index& leafClosestFaceId) {
+            return internal::meshFaceLeafClosestFace(mesh, faceIds, number, p, leafClosestFaceId);
+        },
+        squaredDistance);
+
+    if (closestFaceId == NULL_ID)
+        return point;
+
+    return internal::meshFaceClosestPoint(mesh, closestFaceId, point);
+}
+
+/**
+ * @brief Exact closest points on a mesh using a face BVH, computed in parallel
+ * @param mesh Mesh
+ * @param bvh Face BVH
+ * @param points Points
+ * @return Closest points
+ */
+template<class Mesh>
+std::vector<typename Mesh::Point> meshFaceBVHClosestPoints(
+        const Mesh& mesh,
+        const BVH<typename Mesh::Scalar, 3>& bvh,
+        const std::vector<typename Mesh::Point>& points)
+{
+    std::vector<typename Mesh::FaceId> closestFaceIds;
+    return meshFaceBVHClosestPoints(mesh, bvh, points, closestFaceIds);
+}
+
+/**
+ * @brief Exact closest points on a mesh using a face BVH, computed in parallel
+ * @param mesh Mesh
+ * @param bvh Face BVH
+ * @param points Points
+ * @param closestFaceIds Face of each closest point
+ * @return Closest points
+ */
+template<class Mesh>
+std::vector<typename Mesh::Point> meshFaceBVHClosestPoints(
+        const Mesh& mesh,
+        const BVH<typename Mesh::Scalar, 3>& bvh,
+        const std::vector<typename Mesh::Point>& points,
+        std::vector<typename Mesh::FaceId>& closestFaceIds)
+{
+    std::vector<typename Mesh::Point> closestPoints(points.size());
+    closestFaceIds.resize(points.size());
+
+    #pragma omp parallel for
+    for (Index i = 0; i < points.size(); ++i) {
+        closestPoints[i] = meshFaceBVHClosestPoint(mesh, bvh, points[i], closestFaceIds[i]);
+    }
+
+    return closestPoints;
+}
+
+namespace internal {
+
+/**
+ * @brief Bounding boxes of the faces of a mesh, empty for deleted faces
+ * @param mesh Mesh
+ * @return Bounding box for each face id
+ */
+template<class Mesh>
+std::vector<AlignedBox3<typename Mesh::Scalar>> meshFaceBoxes(const Mesh& mesh)
+{
+    typedef typename Mesh::FaceId FaceId;
+    typedef typename Mesh::Face Face;
+
+    std::vector<AlignedBox3<typename Mesh::Scalar>> boxes(mesh.nextFaceId());
+
+    #pragma omp parallel for
+    for (FaceId fId = 0; fId < mesh.nextFaceId(); ++fId) {
+        if (mesh.isFaceDeleted(fId))
+            continue;
+
+        const Face& face = mesh.face(fId);
+        for (Index j = 0; j < face.vertexNumber(); ++j) {
+            boxes[fId].extend(mesh.vertexPoint(face.vertexId(j)));
+        }
+    }
+
+    return boxes;
+}
+
+/**
+ * @brief Closest point on a face
+ * @param mesh Mesh
+ * @param fId Face id
+ * @param point Point
+ * @return Closest point on the face
+ */
+template<class Mesh>
+typename Mesh::Point meshFaceClosestPoint(
+        const Mesh& mesh,
+        const typename Mesh::FaceId& fId,
+        const typename Mesh::Point& point)
+{
+    typedef typename Mesh::Point Point;
+    typedef typename Mesh::Face Face;
+
+    const Face& face = mesh.face(fId);
+
+    if (face.vertexNumber() == 3) {
+        return closestPointOnTriangle(
+            mesh.vertexPoint(face.vertexId(0)),
+            mesh.vertexPoint(face.vertexId(1)),
+            mesh.vertexPoint(face.vertexId(2)),
+            point);
+    }
+
+    std::vector<Point> polygon(face.vertexNumber());
+    for (Index j = 0; j < face.vertexNumber(); ++j) {
+        polygon[j] = mesh.vertexPoint(face.vertexId(j));
+    }
+
+    return closestPointOnPolygonBarycenterSubdivision(polygon, point);
+}
+
+/**
+ * @brief Closest face to a point among the faces of a BVH leaf. The
+ * triangles are evaluated in packets, the other polygons one at a time.
+ * @param mesh Mesh
+ * @param faceIds Face ids of the leaf
+ * @param number Number of faces
+ * @param point Point
+ * @param closestFaceId Closest face, NULL_ID if there is no face
+ * @return Squared distance of the closest face
+ */
+template<class Mesh>
+typename Mesh::Scalar meshFaceLeafClosestFace(
+        const Mesh& mesh,
+        const Index* faceIds,
+        const Size number,
+        const typename Mesh::Point& point,
+        Index& closestFaceId)
+{
+    typedef typename Mesh::Scalar Scalar;
+    typedef typename Mesh::Face Face;
+
+    Scalar closestDistance = maxLimitValue<Scalar>();
+    closestFaceId = NULL_ID;
+
+    TrianglePacket<Scalar> packet;
+    TriangleClosestPointPacket<Scalar> result;
+    Index packetFaces[NVL_TRIANGLE_PACKET_SIZE];
+
+    for (Index i = 0; i <= number; ++i) {
+        //The last packet is evaluated after the last face
+        if (i < number) {
+            const Index& fId = faceIds[i];
+            if (mesh.isFaceDeleted(fId))
+                continue;
+
+            const Face& face = mesh.face(fId);
+
+            if (face.vertexNumber() != 3) {
+                const Scalar distance = (meshFaceClosestPoint(mesh, fId, point) - point).squaredNorm();
+                if (distance < closestDistance) {
+                    closestDistance = distance;
+                    closestFaceId = fId;
+                }
+                continue;
+            }
+
+            const Index lane = packet.addTriangle(
+                mesh.vertexPoint(face.vertexId(0)),
+                mesh.vertexPoint(face.vertexId(1)),
+                mesh.vertexPoint(face.vertexId(2)));
+            packetFaces[lane] = fId;
+
+            if (!packet.isFull())
+                continue;
+        }
+
+        if (packet.isEmpty())
+            continue;
+
+        closestPointOnTrianglePacket(packet, point, result);
+
+        const Index lane = result.nearestLane(packet.size);
+        if (result.squaredDistances[lane] < closestDistance) {
+            closestDistance = result.squaredDistances[lane];
+            closestFaceId = packetFaces[lane];
+        }
+
+        packet.clear();
+    }
+
+    return closestDistance;
+}
+
+}
+
+}
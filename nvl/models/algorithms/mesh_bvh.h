@@ -0,0 +1,58 @@
+/*
+ * This file is part of nuvolib: https://github.com/stefanonuvoli/nuvolib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Stefano Nuvoli (stefano.nuvoli@gmail.com)
+ */
+#ifndef NVL_MODELS_MESH_BVH_H
+#define NVL_MODELS_MESH_BVH_H
+
+#include <nvl/nuvolib.h>
+
+#include <nvl/structures/trees/bvh.h>
+
+#include <vector>
+
+namespace nvl {
+
+template<class Mesh>
+BVH<typename Mesh::Scalar, 3> meshFaceBVH(
+        const Mesh& mesh,
+        const Size maxLeafElements = NVL_BVH_DEFAULT_LEAF_ELEMENTS);
+
+template<class Mesh>
+void meshFaceBVHRefit(
+        const Mesh& mesh,
+        BVH<typename Mesh::Scalar, 3>& bvh);
+
+template<class Mesh>
+typename Mesh::Point meshFaceBVHClosestPoint(
+        const Mesh& mesh,
+        const BVH<typename Mesh::Scalar, 3>& bvh,
+        const typename Mesh::Point& point);
+
+template<class Mesh>
+typename Mesh::Point meshFaceBVHClosestPoint(
+        const Mesh& mesh,
+        const BVH<typename Mesh::Scalar, 3>& bvh,
+        const typename Mesh::Point& point,
+        typename Mesh::FaceId& closestFaceId);
+
+template<class Mesh>
+std::vector<typename Mesh::Point> meshFaceBVHClosestPoints(
+        const Mesh& mesh,
+        const BVH<typename Mesh::Scalar, 3>& bvh,
+        const std::vector<typename Mesh::Point>& points);
+
+template<class Mesh>
+std::vector<typename Mesh::Point> meshFaceBVHClosestPoints(
+        const Mesh& mesh,
+        const BVH<typename Mesh::Scalar, 3>& bvh,
+        const std::vector<typename Mesh::Point>& points,
+        std::vector<typename Mesh::FaceId>& closestFaceIds);
+
+}
+
+#include "mesh_bvh.cpp"
+
+#endif // NVL_MODELS_MESH_BVH_H
@@ -0,0 +1,1018 @@
+/*
+ * This file is part of nuvolib: https://github.com/stefanonuvoli/nuvolib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Stefano Nuvoli (stefano.nuvoli@gmail.com)
+ */
+#include "mesh_decimation.h"
+
+
+#include <nvl/math/inverse_function.h>
+#include <nvl/math/numeric_limits.h>
+
+#include <queue>
+#include <algorithm>
+#include <iterator>
+#include <cmath>
+#include <cstdint>
+
+namespace nvl {
+
+namespace internal {
+
+template<class Scalar>
+using DecimationQuadric = std::array<Scalar, 10>;
+
+template<class Scalar, class VertexId>
+struct DecimationCollapse {
+    Scalar cost;
+    VertexId vertex1;
+    VertexId vertex2;
+    std::uint32_t stamp1;
+    std::uint32_t stamp2;
+
+    bool operator>(const DecimationCollapse& other) const { return cost > other.cost; }
+};
+
+/*
+ * Flat vertex-face adjacencies of a triangle mesh: the corner j of the face
+ * fId has id fId * 3 + j, and the corners of each vertex are linked in a list.
+ * Unlike a CSR layout, lists can be merged in place when an edge collapses.
+ */
+struct DecimationCorners {
+    std::vector<Index> vertexCorner;
+    std::vector<Index> cornerNext;
+};
+
+template<class Mesh>
+void decimationBuildCorners(
+        const Mesh& mesh,
+        DecimationCorners& corners);
+
+template<class Mesh>
+bool decimationHasHalfEdge(
+        const Mesh& mesh,
+        const DecimationCorners& corners,
+        const typename Mesh::VertexId& vertex1,
+        const typename Mesh::VertexId& vertex2);
+
+template<class Mesh>
+void decimationCleanCorners(
+        const Mesh& mesh,
+        DecimationCorners& corners,
+        const typename Mesh::VertexId& vId);
+
+template<class Scalar, class Point>
+void decimationAddPlaneQuadric(
+        DecimationQuadric<Scalar>& quadric,
+        const Point& normal,
+        const Point& point,
+        const Scalar& weight);
+
+template<class Scalar, class Point>
+Scalar decimationQuadricError(
+        const DecimationQuadric<Scalar>& quadric,
+        const Point& point);
+
+template<class Scalar, class Point>
+bool decimationQuadricOptimalPoint(
+        const DecimationQuadric<Scalar>& quadric,
+        Point& point);
+
+template<class Mesh>
+bool decimationEvaluateCollapse(
+        const Mesh& mesh,
+        const std::vector<DecimationQuadric<typename Mesh::Scalar>>& quadrics,
+        const std::vector<bool>& isLocked,
+        const typename Mesh::VertexId& vertex1,
+        const typename Mesh::VertexId& vertex2,
+        typename Mesh::VertexId& removedId,
+        typename Mesh::VertexId& keptId,
+        typename Mesh::Point& point,
+        typename Mesh::Scalar& cost);
+
+template<class Mesh>
+bool decimationIsCollapseValid(
+        const Mesh& mesh,
+        const DecimationCorners& corners,
+        const std::vector<bool>& isBorder,
+        const typename Mesh::VertexId& removedId,
+        const typename Mesh::VertexId& keptId,
+        const typename Mesh::Point& point);
+
+template<class Mesh>
+Size decimationCollapse(
+        Mesh& mesh,
+        DecimationCorners& corners,
+        const typename Mesh::VertexId& removedId,
+        const typename Mesh::VertexId& keptId,
+        const typename Mesh::Point& point);
+
+template<class Mesh>
+bool decimationIsSeamVertex(
+        const Mesh& mesh,
+        const DecimationCorners& corners,
+        const typename Mesh::VertexId& vId);
+
+}
+
+/**
+ * @brief Decimate a triangle mesh by quadric error edge collapses
+ * @param mesh Triangle mesh
+ * @param targetFaceNumber Target number of faces
+ * @param preserveBorders Border vertices are not moved or removed
+ * @param preserveAttributes Vertices on wedge UV/normal seams are not moved or removed
+ * @return False if the mesh is not a triangle mesh, and it has not been modified
+ */
+template<class Mesh>
+bool meshQuadricDecimation(
+        Mesh& mesh,
+        const Size& targetFaceNumber,
+        const bool preserveBorders,
+        const bool preserveAttributes)
+{
+    std::vector<typename Mesh::VertexId> birthVertex;
+    std::vector<typename Mesh::FaceId> birthFace;
+
+    return meshQuadricDecimation(mesh, targetFaceNumber, birthVertex, birthFace, preserveBorders, preserveAttributes);
+}
+
+/**
+ * @brief Decimate a triangle mesh by quadric error edge collapses. Collapses
+ * are extracted from a heap ordered by quadric error. Entries are invalidated
+ * lazily by per-vertex stamps, and re-evaluated when extracted: a collapse is
+ * performed only if it satisfies the link condition and it does not flip
+ * the normals of the surrounding faces. Borders are kept by penalty quadrics,
+ * or fixed if preserveBorders is true. If preserveAttributes is true, the
+ * vertices on wedge UV/normal seams are not moved or removed, and the wedges
+ * and the vertex attributes are interpolated over the collapses.
+ * The heap initially holds one entry for each edge, and the vertex-face
+ * adjacencies are stored in flat arrays of corners.
+ * The mesh is compacted at the end.
+ * @param mesh Triangle mesh
+ * @param targetFaceNumber Target number of faces
+ * @param birthVertex Birth vertex of the resulting mesh
+ * @param birthFace Birth face of the resulting mesh
+ * @param preserveBorders Border vertices are not moved or removed
+ * @param preserveAttributes Vertices on wedge UV/normal seams are not moved or removed
+ * @return False if the mesh is not a triangle mesh, and it has not been modified
+ */
+template<class Mesh>
+bool meshQuadricDecimation(
+        Mesh& mesh,
+        const Size& targetFaceNumber,
+        std::vector<typename Mesh::VertexId>& birthVertex,
+        std::vector<typename Mesh::FaceId>& birthFace,
+        const bool preserveBorders,
+        const bool preserveAttributes)
+{
+    typedef typename Mesh::Scalar Scalar;
+    typedef typename Mesh::Point Point;
+    typedef typename Mesh::VertexId VertexId;
+    typedef typename Mesh::FaceId FaceId;
+    typedef typename Mesh::Face Face;
+    typedef internal::DecimationQuadric<Scalar> Quadric;
+    typedef internal::DecimationCollapse<Scalar, VertexId> Collapse;
+
+    const Scalar borderWeight = 1000;
+
+    birthVertex.clear();
+    birthFace.clear();
+
+    for (FaceId fId = 0; fId < mesh.nextFaceId(); ++fId) {
+        if (!mesh.isFaceDeleted(fId) && mesh.face(fId).vertexNumber() != 3) {
+            return false;
+        }
+    }
+
+    internal::DecimationCorners corners;
+    internal::decimationBuildCorners(mesh, corners);
+
+    //Edges of the faces: bit j if the face owns the edge j (one owner for each
+    //edge), bit j + 3 if the edge j is on the border
+    std::vector<std::uint8_t> faceEdgeFlags(mesh.nextFaceId(), 0);
+
+    #pragma omp parallel for
+    for (FaceId fId = 0; fId < mesh.nextFaceId(); ++fId) {
+        if (mesh.isFaceDeleted(fId))
+            continue;
+
+        const Face& face = mesh.face(fId);
+        for (Index j = 0; j < 3; ++j) {
+            const VertexId& vId1 = face.vertexId(j);
+            const VertexId& vId2 = face.nextVertexId(j);
+
+            const bool isBorderEdge = !internal::decimationHasHalfEdge(mesh, corners, vId2, vId1);
+            if (isBorderEdge) {
+                faceEdgeFlags[fId] |= 1 << (j + 3);
+            }
+            if (vId1 < vId2 || isBorderEdge) {
+                faceEdgeFlags[fId] |= 1 << j;
+            }
+        }
+    }
+
+    //Quadrics, borders and seams
+    std::vector<Quadric> quadrics(mesh.nextVertexId());
+    std::vector<bool> isBorder(mesh.nextVertexId(), false);
+    std::vector<bool> isLocked(mesh.nextVertexId(), false);
+    std::vector<std::uint32_t> stamps(mesh.nextVertexId(), 0);
+
+    for (FaceId fId = 0; fId < mesh.nextFaceId(); ++fId) {
+        if (mesh.isFaceDeleted(fId))
+            continue;
+
+        const Face& face = mesh.face(fId);
+        for (Index j = 0; j < 3; ++j) {
+            if (faceEdgeFlags[fId] & (1 << (j + 3))) {
+                isBorder[face.vertexId(j)] = true;
+                isBorder[face.nextVertexId(j)] = true;
+            }
+        }
+    }
+
+    #pragma omp parallel for
+    for (VertexId vId = 0; vId < mesh.nextVertexId(); ++vId) {
+        if (mesh.isVertexDeleted(vId))
+            continue;
+
+        Quadric& quadric = quadrics[vId];
+        quadric.fill(0);
+
+        for (Index c = corners.vertexCorner[vId]; c != NULL_ID; c = corners.cornerNext[c]) {
+            const FaceId fId = c / 3;
+            const Face& face = mesh.face(fId);
+
+            const Point& p0 = mesh.vertexPoint(face.vertexId(0));
+            const Point& p1 = mesh.vertexPoint(face.vertexId(1));
+            const Point& p2 = mesh.vertexPoint(face.vertexId(2));
+
+            Point normal = (p1 - p0).cross(p2 - p0);
+            const Scalar doubleArea = normal.norm();
+            if (doubleArea <= 0)
+                continue;
+
+            normal /= doubleArea;
+
+            internal::decimationAddPlaneQuadric(quadric, normal, p0, doubleArea / 2);
+
+            //Penalty quadrics on the border edges
+            for (Index j = 0; j < 3; ++j) {
+                if (!(faceEdgeFlags[fId] & (1 << (j + 3))) || (face.vertexId(j) != vId && face.nextVertexId(j) != vId))
+                    continue;
+
+                const Point& pa = mesh.vertexPoint(face.vertexId(j));
+                const Point& pb = mesh.vertexPoint(face.nextVertexId(j));
+                const Point edge = pb - pa;
+
+                Point borderNormal = edge.cross(normal);
+                const Scalar borderNormalNorm = borderNormal.norm();
+                if (borderNormalNorm <= 0)
+                    continue;
+
+                borderNormal /= borderNormalNorm;
+
+                internal::decimationAddPlaneQuadric(quadric, borderNormal, pa, borderWeight * edge.squaredNorm());
+            }
+        }
+    }
+
+    for (VertexId vId = 0; vId < mesh.nextVertexId(); ++vId) {
+        if (mesh.isVertexDeleted(vId))
+            continue;
+
+        if (preserveBorders && isBorder[vId]) {
+            isLocked[vId] = true;
+        }
+        else if (preserveAttributes && internal::decimationIsSeamVertex(mesh, corners, vId)) {
+            isLocked[vId] = true;
+        }
+    }
+
+    //Initial collapses, one for each edge
+    std::vector<Index> faceCollapseOffsets(mesh.nextFaceId() + 1, 0);
+    for (FaceId fId = 0; fId < mesh.nextFaceId(); ++fId) {
+        Size number = 0;
+        for (Index j = 0; j < 3; ++j) {
+            if (faceEdgeFlags[fId] & (1 << j)) {
+                ++number;
+            }
+        }
+        faceCollapseOffsets[fId + 1] = faceCollapseOffsets[fId] + number;
+    }
+
+    std::vector<Collapse> collapses(faceCollapseOffsets.back());
+
+    #pragma omp parallel for
+    for (FaceId fId = 0; fId < mesh.nextFaceId(); ++fId) {
+        if (mesh.isFaceDeleted(fId))
+            continue;
+
+        const Face& face = mesh.face(fId);
+
+        Index collapseId = faceCollapseOffsets[fId];
+        for (Index j = 0; j < 3; ++j) {
+            if (!(faceEdgeFlags[fId] & (1 << j)))
+                continue;
+
+            Collapse& collapse = collapses[collapseId];
+            collapse.vertex1 = NULL_ID;
+            ++collapseId;
+
+            VertexId removedId, keptId;
+            Point point;
+            Scalar cost;
+
+            if (internal::decimationEvaluateCollapse(mesh, quadrics, isLocked, face.vertexId(j), face.nextVertexId(j), removedId, keptId, point, cost)) {
+                collapse.cost = cost;
+                collapse.vertex1 = face.vertexId(j);
+                collapse.vertex2 = face.nextVertexId(j);
+                collapse.stamp1 = 0;
+                collapse.stamp2 = 0;
+            }
+        }
+    }
+
+    faceEdgeFlags = std::vector<std::uint8_t>();
+    faceCollapseOffsets = std::vector<Index>();
+
+    collapses.erase(
+        std::remove_if(collapses.begin(), collapses.end(), [](const Collapse& collapse) { return collapse.vertex1 == NULL_ID; }),
+        collapses.end());
+
+    std::priority_queue<Collapse, std::vector<Collapse>, std::greater<Collapse>> queue(std::greater<Collapse>(), std::move(collapses));
+
+    //Collapses
+    Size faceNumber = mesh.faceNumber();
+    std::vector<VertexId> neighbors;
+
+    while (faceNumber > targetFaceNumber && !queue.empty()) {
+        const Collapse collapse = queue.top();
+        queue.pop();
+
+        if (mesh.isVertexDeleted(collapse.vertex1) || mesh.isVertexDeleted(collapse.vertex2))
+            continue;
+
+        if (stamps[collapse.vertex1] != collapse.stamp1 || stamps[collapse.vertex2] != collapse.stamp2)
+            continue;
+
+        VertexId removedId, keptId;
+        Point point;
+        Scalar cost;
+
+        if (!internal::decimationEvaluateCollapse(mesh, quadrics, isLocked, collapse.vertex1, collapse.vertex2, removedId, keptId, point, cost))
+            continue;
+
+        if (!internal::decimationIsCollapseValid(mesh, corners, isBorder, removedId, keptId, point))
+            continue;
+
+        faceNumber -= internal::decimationCollapse(mesh, corners, removedId, keptId, point);
+
+        for (Index i = 0; i < quadrics[keptId].size(); ++i) {
+            quadrics[keptId][i] += quadrics[removedId][i];
+        }
+        isBorder[keptId] = isBorder[keptId] || isBorder[removedId];
+
+        ++stamps[keptId];
+
+        //New collapses on the edges of the kept vertex
+        neighbors.clear();
+        for (Index c = corners.vertexCorner[keptId]; c != NULL_ID; c = corners.cornerNext[c]) {
+            const Face& face = mesh.face(c / 3);
+            for (Index j = 0; j < 3; ++j) {
+                if (face.vertexId(j) != keptId) {
+                    neighbors.push_back(face.vertexId(j));
+                }
+            }
+        }
+        std::sort(neighbors.begin(), neighbors.end());
+        neighbors.erase(std::unique(neighbors.begin(), neighbors.end()), neighbors.end());
+
+        for (const VertexId& nId : neighbors) {
+            VertexId newRemovedId, newKeptId;
+            if (internal::decimationEvaluateCollapse(mesh, quadrics, isLocked, keptId, nId, newRemovedId, newKeptId, point, cost)) {
+                Collapse newCollapse;
+                newCollapse.cost = cost;
+                newCollapse.vertex1 = keptId;
+                newCollapse.vertex2 = nId;
+                newCollapse.stamp1 = stamps[keptId];
+                newCollapse.stamp2 = stamps[nId];
+
+                queue.push(newCollapse);
+            }
+        }
+    }
+
+    if (mesh.hasFaceNormals()) {
+        mesh.computeFaceNormals();
+    }
+
+    std::vector<VertexId> vertexMap = mesh.compactVertices();
+    std::vector<FaceId> faceMap = mesh.compactFaces();
+
+    birthVertex = inverseFunction(vertexMap, mesh.nextVertexId());
+    birthFace = inverseFunction(faceMap, mesh.nextFaceId());
+
+    return true;
+}
+
+namespace internal {
+
+/**
+ * @brief Build the corner lists of a triangle mesh
+ * @param mesh Triangle mesh
+ * @param corners Output corners
+ */
+template<class Mesh>
+void decimationBuildCorners(
+        const Mesh& mesh,
+        DecimationCorners& corners)
+{
+    typedef typename Mesh::FaceId FaceId;
+    typedef typename Mesh::Face Face;
+
+    corners.vertexCorner.assign(mesh.nextVertexId(), NULL_ID);
+    corners.cornerNext.assign(mesh.nextFaceId() * 3, NULL_ID);
+
+    for (FaceId fId = mesh.nextFaceId(); fId > 0; --fId) {
+        if (mesh.isFaceDeleted(fId - 1))
+            continue;
+
+        const Face& face = mesh.face(fId - 1);
+        for (Index j = 0; j < 3; ++j) {
+            const Index c = (fId - 1) * 3 + j;
+            const typename Mesh::VertexId& vId = face.vertexId(j);
+
+            corners.cornerNext[c] = corners.vertexCorner[vId];
+            corners.vertexCorner[vId] = c;
+        }
+    }
+}
+
+/**
+ * @brief Check if a face has the half-edge from vertex1 to vertex2
+ * @param mesh Triangle mesh
+ * @param corners Corners
+ * @param vertex1 First vertex
+ * @param vertex2 Second vertex
+ * @return True if the half-edge exists
+ */
+template<class Mesh>
+bool decimationHasHalfEdge(
+        const Mesh& mesh,
+        const DecimationCorners& corners,
+        const typename Mesh::VertexId& vertex1,
+        const typename Mesh::VertexId& vertex2)
+{
+    for (Index c = corners.vertexCorner[vertex1]; c != NULL_ID; c = corners.cornerNext[c]) {
+        if (mesh.face(c / 3).vertexId((c % 3 + 1) % 3) == vertex2) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * @brief Remove the corners of the deleted faces from the list of a vertex
+ * @param mesh Triangle mesh
+ * @param corners Corners
+ * @param vId Vertex id
+ */
+template<class Mesh>
+void decimationCleanCorners(
+        const Mesh& mesh,
+        DecimationCorners& corners,
+        const typename Mesh::VertexId& vId)
+{
+    Index* link = &corners.vertexCorner[vId];
+    while (*link != NULL_ID) {
+        if (mesh.isFaceDeleted(*link / 3)) {
+            *link = corners.cornerNext[*link];
+        }
+        else {
+            link = &corners.cornerNext[*link];
+        }
+    }
+}
+
+/**
+ * @brief Add the quadric of a plane
+ * @param quadric Quadric
+ * @param normal Unit normal of the plane
+ * @param point Point on the plane
+ * @param weight Weight of the plane quadric
+ */
+template<class Scalar, class Point>
+void decimationAddPlaneQuadric(
+        DecimationQuadric<Scalar>& quadric,
+        const Point& normal,
+        const Point& point,
+        const Scalar& weight)
+{
+    const Scalar a = normal(0);
+    const Scalar b = normal(1);
+    const Scalar c = normal(2);
+    const Scalar d = -normal.dot(point);
+
+    quadric[0] += weight * a * a;
+    quadric[1] += weight * a * b;
+    quadric[2] += weight * a * c;
+    quadric[3] += weight * a * d;
+    quadric[4] += weight * b * b;
+    quadric[5] += weight * b * c;
+    quadric[6] += weight * b * d;
+    quadric[7] += weight * c * c;
+    quadric[8] += weight * c * d;
+    quadric[9] += weight * d * d;
+}
+
+/**
+ * @brief Error of a point for a quadric
+ * @param quadric Quadric
+ * @param point Point
+ * @return Error
+ */
+template<class Scalar, class Point>
+Scalar decimationQuadricError(
+        const DecimationQuadric<Scalar>& quadric,
+        const Point& point)
+{
+    const Scalar& x = point(0);
+    const Scalar& y = point(1);
+    const Scalar& z = point(2);
+
+    Scalar error =
+            quadric[0] * x * x + 2 * quadric[1] * x * y + 2 * quadric[2] * x * z + 2 * quadric[3] * x +
+            quadric[4] * y * y + 2 * quadric[5] * y * z + 2 * quadric[6] * y +
+            quadric[7] * z * z + 2 * quadric[8] * z +
+            quadric[9];
+
+    return std::max(error, static_cast<Scalar>(0));
+}
+
+/**
+ * @brief Point which minimizes the error of a quadric
+ * @param quadric Quadric
+ * @param point Output point
+ * @return False if the system is ill-conditioned
+ */
+template<class Scalar, class Point>
+bool decimationQuadricOptimalPoint(
+        const DecimationQuadric<Scalar>& quadric,
+        Point& point)
+{
+    const Scalar& a00 = quadric[0];
+    const Scalar& a01 = quadric[1];
+    const Scalar& a02 = quadric[2];
+    const Scalar& a11 = quadric[4];
+    const Scalar& a12 = quadric[5];
+    const Scalar& a22 = quadric[7];
+
+    const Scalar c00 = a11 * a22 - a12 * a12;
+    const Scalar c01 = a02 * a12 - a01 * a22;
+    const Scalar c02 = a01 * a12 - a02 * a11;
+    const Scalar c11 = a00 * a22 - a02 * a02;
+    const Scalar c12 = a01 * a02 - a00 * a12;
+    const Scalar c22 = a00 * a11 - a01 * a01;
+
+    const Scalar det = a00 * c00 + a01 * c01 + a02 * c02;
+    const Scalar trace = (a00 + a11 + a22) / 3;
+
+    if (trace <= 0 || std::abs(det) <= 1e-6 * trace * trace * trace)
+        return false;
+
+    const Scalar& b0 = quadric[3];
+    const Scalar& b1 = quadric[6];
+    const Scalar& b2 = quadric[8];
+
+    point = Point(
+        -(c00 * b0 + c01 * b1 + c02 * b2) / det,
+        -(c01 * b0 + c11 * b1 + c12 * b2) / det,
+        -(c02 * b0 + c12 * b1 + c22 * b2) / det);
+
+    return true;
+}
+
+/**
+ * @brief Evaluate the collapse of an edge: the vertex to be removed, the
+ * vertex to be kept with its new position and the cost
+ * @param mesh Mesh
+ * @param quadrics Vertex quadrics
+ * @param isLocked Locked vertices
+ * @param vertex1 First vertex of the edge
+ * @param vertex2 Second vertex of the edge
+ * @param removedId Vertex to be removed
+ * @param keptId Vertex to be kept
+ * @param point New position of the kept vertex
+ * @param cost Cost of the collapse
+ * @return False if the edge cannot be collapsed
+ */
+template<class Mesh>
+bool decimationEvaluateCollapse(
+        const Mesh& mesh,
+        const std::vector<DecimationQuadric<typename Mesh::Scalar>>& quadrics,
+        const std::vector<bool>& isLocked,
+        const typename Mesh::VertexId& vertex1,
+        const typename Mesh::VertexId& vertex2,
+        typename Mesh::VertexId& removedId,
+        typename Mesh::VertexId& keptId,
+        typename Mesh::Point& point,
+        typename Mesh::Scalar& cost)
+{
+    typedef typename Mesh::Scalar Scalar;
+    typedef typename Mesh::Point Point;
+
+    if (isLocked[vertex1] && isLocked[vertex2])
+        return false;
+
+    DecimationQuadric<Scalar> quadric;
+    for (Index i = 0; i < quadric.size(); ++i) {
+        quadric[i] = quadrics[vertex1][i] + quadrics[vertex2][i];
+    }
+
+    const Point& p1 = mesh.vertexPoint(vertex1);
+    const Point& p2 = mesh.vertexPoint(vertex2);
+
+    if (isLocked[vertex1]) {
+        removedId = vertex2;
+        keptId = vertex1;
+        point = p1;
+    }
+    else if (isLocked[vertex2]) {
+        removedId = vertex1;
+        keptId = vertex2;
+        point = p2;
+    }
+    else {
+        removedId = vertex1;
+        keptId = vertex2;
+
+        if (!decimationQuadricOptimalPoint(quadric, point)) {
+            const std::array<Point, 3> candidates = { p1, p2, Point((p1 + p2) / 2) };
+
+            Scalar bestError = maxLimitValue<Scalar>();
+            for (const Point& candidate : candidates) {
+                Scalar error = decimationQuadricError(quadric, candidate);
+                if (error < bestError) {
+                    bestError = error;
+                    point = candidate;
+                }
+            }
+        }
+    }
+
+    cost = decimationQuadricError(quadric, point);
+
+    return true;
+}
+
+/**
+ * @brief Check if a collapse preserves the topology (link condition) and does
+ * not flip any face
+ * @param mesh Mesh
+ * @param corners Corners
+ * @param isBorder Border vertices
+ * @param removedId Vertex to be removed
+ * @param keptId Vertex to be kept
+ * @param point New position of the kept vertex
+ * @return True if the collapse is valid
+ */
+template<class Mesh>
+bool decimationIsCollapseValid(
+        const Mesh& mesh,
+        const DecimationCorners& corners,
+        const std::vector<bool>& isBorder,
+        const typename Mesh::VertexId& removedId,
+        const typename Mesh::VertexId& keptId,
+        const typename Mesh::Point& point)
+{
+    typedef typename Mesh::Point Point;
+    typedef typename Mesh::VertexId VertexId;
+    typedef typename Mesh::Face Face;
+
+    //Faces on the edge
+    std::vector<VertexId> opposite;
+    for (Index c = corners.vertexCorner[removedId]; c != NULL_ID; c = corners.cornerNext[c]) {
+        const Face& face = mesh.face(c / 3);
+        for (Index j = 0; j < face.vertexNumber(); ++j) {
+            if (face.vertexId(j) == keptId) {
+                opposite.push_back(face.nextVertexId(j) != removedId ? face.nextVertexId(j) : face.vertexId((j + 2) % 3));
+            }
+        }
+    }
+
+    if (opposite.empty() || opposite.size() > 2)
+        return false;
+
+    if (opposite.size() == 2 && opposite[0] == opposite[1])
+        return false;
+
+    //Internal edge between two border vertices
+    if (opposite.size() == 2 && isBorder[removedId] && isBorder[keptId])
+        return false;
+
+    //Link condition
+    std::vector<VertexId> removedNeighbors;
+    for (Index c = corners.vertexCorner[removedId]; c != NULL_ID; c = corners.cornerNext[c]) {
+        const Face& face = mesh.face(c / 3);
+        for (Index j = 0; j < face.vertexNumber(); ++j) {
+            if (face.vertexId(j) != removedId && face.vertexId(j) != keptId) {
+                removedNeighbors.push_back(face.vertexId(j));
+            }
+        }
+    }
+    std::sort(removedNeighbors.begin(), removedNeighbors.end());
+    removedNeighbors.erase(std::unique(removedNeighbors.begin(), removedNeighbors.end()), removedNeighbors.end());
+
+    std::vector<VertexId> keptNeighbors;
+    for (Index c = corners.vertexCorner[keptId]; c != NULL_ID; c = corners.cornerNext[c]) {
+        const Face& face = mesh.face(c / 3);
+        for (Index j = 0; j < face.vertexNumber(); ++j) {
+            if (face.vertexId(j) != removedId && face.vertexId(j) != keptId) {
+                keptNeighbors.push_back(face.vertexId(j));
+            }
+        }
+    }
+    std::sort(keptNeighbors.begin(), keptNeighbors.end());
+    keptNeighbors.erase(std::unique(keptNeighbors.begin(), keptNeighbors.end()), keptNeighbors.end());
+
+    std::vector<VertexId> commonNeighbors;
+    std::set_intersection(
+        removedNeighbors.begin(), removedNeighbors.end(),
+        keptNeighbors.begin(), keptNeighbors.end(),
+        std::back_inserter(commonNeighbors));
+
+    if (commonNeighbors.size() != opposite.size())
+        return false;
+
+    //Normal flips
+    for (const VertexId& vId : { removedId, keptId }) {
+        const VertexId& otherId = vId == removedId ? keptId : removedId;
+
+        for (Index c = corners.vertexCorner[vId]; c != NULL_ID; c = corners.cornerNext[c]) {
+            const Face& face = mesh.face(c / 3);
+
+            std::array<Point, 3> points;
+            bool onEdge = false;
+            for (Index j = 0; j < 3; ++j) {
+                points[j] = mesh.vertexPoint(face.vertexId(j));
+                if (face.vertexId(j) == otherId) {
+                    onEdge = true;
+                }
+            }
+
+            if (onEdge)
+                continue;
+
+            const Point oldNormal = (points[1] - points[0]).cross(points[2] - points[0]);
+
+            for (Index j = 0; j < 3; ++j) {
+                if (face.vertexId(j) == vId) {
+                    points[j] = point;
+                }
+            }
+
+            const Point newNormal = (points[1] - points[0]).cross(points[2] - points[0]);
+
+            if (newNormal.norm() <= 0 || oldNormal.dot(newNormal) <= 0)
+                return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief Collapse an edge. The faces on the edge are deleted, the removed
+ * vertex is replaced by the kept one and the attributes are interpolated.
+ * @param mesh Mesh
+ * @param corners Corners, updated
+ * @param removedId Vertex to be removed
+ * @param keptId Vertex to be kept
+ * @param point New position of the kept vertex
+ * @return Number of deleted faces
+ */
+template<class Mesh>
+Size decimationCollapse(
+        Mesh& mesh,
+        DecimationCorners& corners,
+        const typename Mesh::VertexId& removedId,
+        const typename Mesh::VertexId& keptId,
+        const typename Mesh::Point& point)
+{
+    typedef typename Mesh::Scalar Scalar;
+    typedef typename Mesh::Point Point;
+    typedef typename Mesh::VertexId VertexId;
+    typedef typename Mesh::FaceId FaceId;
+    typedef typename Mesh::Face Face;
+    typedef typename Mesh::VertexNormal VertexNormal;
+    typedef typename Mesh::VertexUV VertexUV;
+    typedef typename Mesh::WedgeNormalId WedgeNormalId;
+    typedef typename Mesh::WedgeUVId WedgeUVId;
+
+    const Point& removedPoint = mesh.vertexPoint(removedId);
+    const Point& keptPoint = mesh.vertexPoint(keptId);
+
+    //Interpolation parameter of the new point on the edge
+    Scalar t = 1;
+    const Scalar squaredLength = (keptPoint - removedPoint).squaredNorm();
+    if (squaredLength > 0) {
+        t = (point - removedPoint).dot(keptPoint - removedPoint) / squaredLength;
+        t = std::min(std::max(t, static_cast<Scalar>(0)), static_cast<Scalar>(1));
+    }
+
+    //Wedges of the removed and of the kept vertex in each face on the edge.
+    //Across a seam the faces have different wedges, so each corner of the
+    //removed vertex is later remapped by matching its own wedge.
+    std::array<WedgeNormalId, 2> removedWedgeNormals = { NULL_ID, NULL_ID };
+    std::array<WedgeNormalId, 2> keptWedgeNormals = { NULL_ID, NULL_ID };
+    std::array<WedgeUVId, 2> removedWedgeUVs = { NULL_ID, NULL_ID };
+    std::array<WedgeUVId, 2> keptWedgeUVs = { NULL_ID, NULL_ID };
+    Size edgeFaceNumber = 0;
+
+    for (Index c = corners.vertexCorner[removedId]; c != NULL_ID && edgeFaceNumber < 2; c = corners.cornerNext[c]) {
+        const FaceId fId = c / 3;
+        const Face& face = mesh.face(fId);
+
+        const Index removedPos = c % 3;
+        Index keptPos = NULL_ID;
+        for (Index j = 0; j < face.vertexNumber(); ++j) {
+            if (face.vertexId(j) == keptId)
+                keptPos = j;
+        }
+
+        if (keptPos == NULL_ID)
+            continue;
+
+        if (mesh.hasWedgeNormals() && !mesh.faceWedgeNormalsAreNull(fId)) {
+            removedWedgeNormals[edgeFaceNumber] = mesh.faceWedgeNormals(fId)[removedPos];
+            keptWedgeNormals[edgeFaceNumber] = mesh.faceWedgeNormals(fId)[keptPos];
+        }
+        if (mesh.hasWedgeUVs() && !mesh.faceWedgeUVsAreNull(fId)) {
+            removedWedgeUVs[edgeFaceNumber] = mesh.faceWedgeUVs(fId)[removedPos];
+            keptWedgeUVs[edgeFaceNumber] = mesh.faceWedgeUVs(fId)[keptPos];
+        }
+
+        ++edgeFaceNumber;
+    }
+
+    //Attributes
+    if (mesh.hasVertexNormals()) {
+        VertexNormal normal = (1 - t) * mesh.vertexNormal(removedId) + t * mesh.vertexNormal(keptId);
+        if (normal.norm() > 0) {
+            normal.normalize();
+        }
+        mesh.setVertexNormal(keptId, normal);
+    }
+    if (mesh.hasVertexUVs()) {
+        typedef typename VertexUV::Scalar UVScalar;
+        VertexUV uv = static_cast<UVScalar>(1 - t) * mesh.vertexUV(removedId) + static_cast<UVScalar>(t) * mesh.vertexUV(keptId);
+        mesh.setVertexUV(keptId, uv);
+    }
+    for (Index i = 0; i < edgeFaceNumber; ++i) {
+        //A kept wedge shared by both faces is interpolated once
+        const WedgeNormalId& removedWedgeNormal = removedWedgeNormals[i];
+        const WedgeNormalId& keptWedgeNormal = keptWedgeNormals[i];
+        if (removedWedgeNormal != NULL_ID && keptWedgeNormal != NULL_ID && removedWedgeNormal != keptWedgeNormal &&
+                (i == 0 || keptWedgeNormal != keptWedgeNormals[0])) {
+            VertexNormal normal = (1 - t) * mesh.wedgeNormal(removedWedgeNormal) + t * mesh.wedgeNormal(keptWedgeNormal);
+            if (normal.norm() > 0) {
+                normal.normalize();
+            }
+            mesh.wedgeNormal(keptWedgeNormal) = normal;
+        }
+
+        const WedgeUVId& removedWedgeUV = removedWedgeUVs[i];
+        const WedgeUVId& keptWedgeUV = keptWedgeUVs[i];
+        if (removedWedgeUV != NULL_ID && keptWedgeUV != NULL_ID && removedWedgeUV != keptWedgeUV &&
+                (i == 0 || keptWedgeUV != keptWedgeUVs[0])) {
+            typedef typename VertexUV::Scalar UVScalar;
+            mesh.wedgeUV(keptWedgeUV) = static_cast<UVScalar>(1 - t) * mesh.wedgeUV(removedWedgeUV) + static_cast<UVScalar>(t) * mesh.wedgeUV(keptWedgeUV);
+        }
+    }
+
+    mesh.setVertexPoint(keptId, point);
+
+    //Faces: the faces on the edge are deleted, the others are moved to the
+    //list of the kept vertex
+    Size deletedFaces = 0;
+    std::array<VertexId, 2> oppositeIds = { NULL_ID, NULL_ID };
+
+    Index c = corners.vertexCorner[removedId];
+    corners.vertexCorner[removedId] = NULL_ID;
+
+    while (c != NULL_ID) {
+        const Index next = corners.cornerNext[c];
+        const FaceId fId = c / 3;
+        const Index removedPos = c % 3;
+        const Face& face = mesh.face(fId);
+
+        bool onEdge = false;
+        for (Index j = 0; j < face.vertexNumber(); ++j) {
+            if (face.vertexId(j) == keptId)
+                onEdge = true;
+        }
+
+        if (onEdge) {
+            const VertexId& oppositeId = face.vertexId((removedPos + 1) % 3) != keptId ?
+                        face.vertexId((removedPos + 1) % 3) : face.vertexId((removedPos + 2) % 3);
+            oppositeIds[oppositeIds[0] == NULL_ID ? 0 : 1] = oppositeId;
+
+            mesh.deleteFace(fId);
+            ++deletedFaces;
+        }
+        else {
+            mesh.setFaceVertexId(fId, removedPos, keptId);
+
+            //Corners with a wedge not found on the edge keep their own wedge
+            if (mesh.hasWedgeNormals() && !mesh.faceWedgeNormalsAreNull(fId)) {
+                WedgeNormalId& wedgeNormal = mesh.faceWedgeNormals(fId)[removedPos];
+                for (Index i = 0; i < edgeFaceNumber; ++i) {
+                    if (keptWedgeNormals[i] != NULL_ID && wedgeNormal == removedWedgeNormals[i]) {
+                        wedgeNormal = keptWedgeNormals[i];
+                        break;
+                    }
+                }
+            }
+            if (mesh.hasWedgeUVs() && !mesh.faceWedgeUVsAreNull(fId)) {
+                WedgeUVId& wedgeUV = mesh.faceWedgeUVs(fId)[removedPos];
+                for (Index i = 0; i < edgeFaceNumber; ++i) {
+                    if (keptWedgeUVs[i] != NULL_ID && wedgeUV == removedWedgeUVs[i]) {
+                        wedgeUV = keptWedgeUVs[i];
+                        break;
+                    }
+                }
+            }
+
+            corners.cornerNext[c] = corners.vertexCorner[keptId];
+            corners.vertexCorner[keptId] = c;
+        }
+
+        c = next;
+    }
+
+    //Remove the corners of the deleted faces
+    decimationCleanCorners(mesh, corners, keptId);
+    for (const VertexId& oppositeId : oppositeIds) {
+        if (oppositeId != NULL_ID) {
+            decimationCleanCorners(mesh, corners, oppositeId);
+        }
+    }
+
+    mesh.deleteVertex(removedId);
+
+    return deletedFaces;
+}
+
+/**
+ * @brief Check if a vertex is on a wedge UV or wedge normal seam
+ * @param mesh Mesh
+ * @param corners Corners
+ * @param vId Vertex id
+ * @return True if the incident faces do not share the same wedges on the vertex
+ */
+template<class Mesh>
+bool decimationIsSeamVertex(
+        const Mesh& mesh,
+        const DecimationCorners& corners,
+        const typename Mesh::VertexId& vId)
+{
+    typedef typename Mesh::FaceId FaceId;
+    typedef typename Mesh::WedgeNormalId WedgeNormalId;
+    typedef typename Mesh::WedgeUVId WedgeUVId;
+
+    bool first = true;
+    WedgeNormalId wedgeNormal = NULL_ID;
+    WedgeUVId wedgeUV = NULL_ID;
+
+    for (Index c = corners.vertexCorner[vId]; c != NULL_ID; c = corners.cornerNext[c]) {
+        const FaceId fId = c / 3;
+        const Index pos = c % 3;
+
+        WedgeNormalId currentWedgeNormal = NULL_ID;
+        if (mesh.hasWedgeNormals() && !mesh.faceWedgeNormalsAreNull(fId)) {
+            currentWedgeNormal = mesh.faceWedgeNormals(fId)[pos];
+        }
+
+        WedgeUVId currentWedgeUV = NULL_ID;
+        if (mesh.hasWedgeUVs() && !mesh.faceWedgeUVsAreNull(fId)) {
+            currentWedgeUV = mesh.faceWedgeUVs(fId)[pos];
+        }
+
+        if (first) {
+            wedgeNormal = currentWedgeNormal;
+            wedgeUV = currentWedgeUV;
+            first = false;
+        }
+        else if (currentWedgeNormal != wedgeNormal || currentWedgeUV != wedgeUV) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+}
+
+}
@@ -0,0 +1,37 @@
+/*
+ * This file is part of nuvolib: https://github.com/stefanonuvoli/nuvolib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Stefano Nuvoli (stefano.nuvoli@gmail.com)
+ */
+#ifndef NVL_MODELS_MESH_DECIMATION_H
+#define NVL_MODELS_MESH_DECIMATION_H
+
+#include <nvl/nuvolib.h>
+
+#include <vector>
+#include <array>
+
+namespace nvl {
+
+template<class Mesh>
+bool meshQuadricDecimation(
+        Mesh& mesh,
+        const Size& targetFaceNumber,
+        const bool preserveBorders = false,
+        const bool preserveAttributes = true);
+
+template<class Mesh>
+bool meshQuadricDecimation(
+        Mesh& mesh,
+        const Size& targetFaceNumber,
+        std::vector<typename Mesh::VertexId>& birthVertex,
+        std::vector<typename Mesh::FaceId>& birthFace,
+        const bool preserveBorders = false,
+        const bool preserveAttributes = true);
+
+}
+
+#include "mesh_decimation.cpp"
+
+#endif // NVL_MODELS_MESH_DECIMATION_H
@@ -6,17 +6,24 @@
  */
 #include "mesh_geodesics.h"
 
-#ifdef NVL_LIBIGL_LOADED
+#include <nvl/models/algorithms/mesh_adjacencies.h>
+
+#include <nvl/math/numeric_limits.h>
 
+#include <queue>
+#include <cmath>
+
+#ifdef NVL_LIBIGL_LOADED
 #include <nvl/models/algorithms/mesh_triangulation.h>
 #include <nvl/models/algorithms/mesh_eigen_convert.h>
 
-#include <nvl/math/numeric_limits.h>
-
 #include <igl/exact_geodesic.h>
+#endif
 
 namespace nvl {
 
+#ifdef NVL_LIBIGL_LOADED
+
 /**
  * @brief Get exact geodesics given source and target vertices
  * @param m Input mesh
@@ -179,6 +186,420 @@ std::vector<typename Mesh::Scalar> heatGeodesics(
     return geodesics;
 }
 
+#endif
+
+#ifdef NVL_EIGEN_LOADED
+
+/**
+ * @brief Precompute the data for the native heat method geodesics: the Cholesky
+ * factorizations of the heat flow and of the Poisson systems, and the per-triangle
+ * gradient operators. Polygonal faces are triangulated as triangle fans.
+ * Deleted vertices and vertices without faces are skipped, the data maps the
+ * vertex ids to the system indices.
+ * @param mesh Input mesh
+ * @param precomputedData Output precomputed data
+ * @param timeFactor Factor of the time step, which is the squared average edge length
+ * @return True if the factorizations succeeded
+ */
+template<class Mesh>
+bool meshHeatGeodesicsPrecomputeData(
+        const Mesh& mesh,
+        MeshHeatGeodesicsData<Mesh>& precomputedData,
+        const typename Mesh::Scalar timeFactor)
+{
+    typedef typename Mesh::Scalar Scalar;
+    typedef typename Mesh::Face Face;
+    typedef typename Mesh::FaceId FaceId;
+    typedef typename Mesh::VertexId VertexId;
+    typedef typename Mesh::Point Point;
+    typedef Eigen::Triplet<Scalar> Triplet;
+
+    //Vertex id remapping: only the vertices of the faces are in the systems,
+    //an isolated vertex would give a zero row and column and a singular matrix
+    std::vector<VertexId>& birthVertex = precomputedData.birthVertex;
+    std::vector<Index>& vertexMap = precomputedData.vertexMap;
+
+    std::vector<bool> referencedVertex(mesh.nextVertexId(), false);
+    for (FaceId fId = 0; fId < mesh.nextFaceId(); ++fId) {
+        if (mesh.isFaceDeleted(fId))
+            continue;
+
+        for (const VertexId& vId : mesh.face(fId).vertexIds()) {
+            referencedVertex[vId] = true;
+        }
+    }
+
+    birthVertex.clear();
+    vertexMap.assign(mesh.nextVertexId(), NULL_ID);
+    for (VertexId vId = 0; vId < mesh.nextVertexId(); ++vId) {
+        if (mesh.isVertexDeleted(vId) || !referencedVertex[vId])
+            continue;
+
+        vertexMap[vId] = birthVertex.size();
+        birthVertex.push_back(vId);
+    }
+
+    const Size vertexNumber = birthVertex.size();
+
+    //Triangle fans
+    std::vector<std::array<Index, 3>>& triangles = precomputedData.triangles;
+
+    triangles.clear();
+    for (FaceId fId = 0; fId < mesh.nextFaceId(); ++fId) {
+        if (mesh.isFaceDeleted(fId))
+            continue;
+
+        const Face& face = mesh.face(fId);
+        for (Index j = 1; j < face.vertexNumber() - 1; ++j) {
+            triangles.push_back({ vertexMap[face.vertexId(0)], vertexMap[face.vertexId(j)], vertexMap[face.vertexId(j + 1)] });
+        }
+    }
+
+    const Size triangleNumber = triangles.size();
+
+    //Gradients of the hat functions (weighted by the area) and cotangents
+    std::vector<std::array<Vector3<Scalar>, 3>>& triangleGradients = precomputedData.triangleGradients;
+    std::vector<std::array<Scalar, 3>> triangleCotangents(triangleNumber);
+    std::vector<Scalar> triangleAreas(triangleNumber);
+    std::vector<Scalar> triangleEdgeLengths(triangleNumber);
+
+    triangleGradients.resize(triangleNumber);
+
+    #pragma omp parallel for
+    for (Index tId = 0; tId < triangleNumber; ++tId) {
+        const std::array<Index, 3>& triangle = triangles[tId];
+
+        std::array<Point, 3> points;
+        for (Index i = 0; i < 3; ++i) {
+            points[i] = mesh.vertexPoint(birthVertex[triangle[i]]);
+        }
+
+        const Vector3<Scalar> normal = (points[1] - points[0]).cross(points[2] - points[0]);
+        const Scalar doubleArea = normal.norm();
+
+        triangleAreas[tId] = doubleArea / 2;
+        triangleEdgeLengths[tId] = 0;
+
+        for (Index i = 0; i < 3; ++i) {
+            const Vector3<Scalar> e1 = points[(i + 1) % 3] - points[i];
+            const Vector3<Scalar> e2 = points[(i + 2) % 3] - points[i];
+            const Vector3<Scalar> opposite = points[(i + 2) % 3] - points[(i + 1) % 3];
+
+            triangleEdgeLengths[tId] += e1.norm();
+
+            if (doubleArea > 0) {
+                triangleCotangents[tId][i] = e1.dot(e2) / doubleArea;
+                triangleGradients[tId][i] = (normal / doubleArea).cross(opposite) / 2;
+            }
+            else {
+                triangleCotangents[tId][i] = 0;
+                triangleGradients[tId][i] = Vector3<Scalar>::Zero();
+            }
+        }
+    }
+
+    //Cotangent Laplacian (positive semi-definite) and lumped mass matrix
+    std::vector<Triplet> laplacianTriplets;
+    std::vector<Triplet> massTriplets;
+    laplacianTriplets.reserve(triangleNumber * 12);
+    massTriplets.reserve(triangleNumber * 3);
+
+    Scalar edgeLengthSum = 0;
+    for (Index tId = 0; tId < triangleNumber; ++tId) {
+        const std::array<Index, 3>& triangle = triangles[tId];
+
+        for (Index i = 0; i < 3; ++i) {
+            const Index& vj = triangle[(i + 1) % 3];
+            const Index& vk = triangle[(i + 2) % 3];
+            const Scalar weight = triangleCotangents[tId][i] / 2;
+
+            laplacianTriplets.push_back(Triplet(vj, vk, -weight));
+            laplacianTriplets.push_back(Triplet(vk, vj, -weight));
+            laplacianTriplets.push_back(Triplet(vj, vj, weight));
+            laplacianTriplets.push_back(Triplet(vk, vk, weight));
+
+            massTriplets.push_back(Triplet(triangle[i], triangle[i], triangleAreas[tId] / 3));
+        }
+
+        edgeLengthSum += triangleEdgeLengths[tId];
+    }
+
+    SparseMatrix<Scalar> L(vertexNumber, vertexNumber);
+    L.setFromTriplets(laplacianTriplets.begin(), laplacianTriplets.end());
+
+    SparseMatrix<Scalar> M(vertexNumber, vertexNumber);
+    M.setFromTriplets(massTriplets.begin(), massTriplets.end());
+
+    SparseMatrix<Scalar> I(vertexNumber, vertexNumber);
+    I.setIdentity();
+
+    const Scalar averageEdgeLength = triangleNumber > 0 ? edgeLengthSum / (3 * triangleNumber) : 0;
+    const Scalar t = timeFactor * averageEdgeLength * averageEdgeLength;
+
+    //Heat flow system
+    SparseMatrix<Scalar> A = M + t * L;
+    precomputedData.heatSolver.compute(A);
+
+    //Poisson system, regularized for the constant null space
+    const Scalar regularization = vertexNumber > 0 ? 1e-8 * L.diagonal().sum() / vertexNumber : 0;
+    SparseMatrix<Scalar> P = L + regularization * I;
+    precomputedData.poissonSolver.compute(P);
+
+    return precomputedData.heatSolver.info() == Eigen::Success &&
+            precomputedData.poissonSolver.info() == Eigen::Success;
+}
+
+/**
+ * @brief Get the native heat method geodesics given source vertices
+ * @param mesh Input mesh
+ * @param sourceVertices Source vertices
+ * @return Geodesic values per vertex (maximum value for deleted or isolated
+ * vertices, and for all the vertices if the factorizations failed)
+ */
+template<class Mesh>
+std::vector<typename Mesh::Scalar> meshHeatGeodesics(
+        const Mesh& mesh,
+        const std::vector<typename Mesh::VertexId>& sourceVertices)
+{
+    MeshHeatGeodesicsData<Mesh> precomputedData;
+
+    if (!meshHeatGeodesicsPrecomputeData(mesh, precomputedData)) {
+        return std::vector<typename Mesh::Scalar>(mesh.nextVertexId(), maxLimitValue<typename Mesh::Scalar>());
+    }
+
+    return meshHeatGeodesics(
+        mesh,
+        precomputedData,
+        sourceVertices);
+}
+
+/**
+ * @brief Get the native heat method geodesics given source vertices. Using the
+ * precomputed factorizations, each query costs two back-substitutions.
+ * @param mesh Input mesh
+ * @param precomputedData Precomputed heat geodesics data
+ * @param sourceVertices Source vertices
+ * @return Geodesic values per vertex (maximum value for deleted or isolated
+ * vertices, and for all the vertices if the factorizations or the solves failed)
+ */
+template<class Mesh>
+std::vector<typename Mesh::Scalar> meshHeatGeodesics(
+        const Mesh& mesh,
+        const MeshHeatGeodesicsData<Mesh>& precomputedData,
+        const std::vector<typename Mesh::VertexId>& sourceVertices)
+{
+    typedef typename Mesh::Scalar Scalar;
+    typedef Eigen::Matrix<Scalar, Eigen::Dynamic, 1> VectorX;
+
+    const std::vector<std::array<Index, 3>>& triangles = precomputedData.triangles;
+    const std::vector<std::array<Vector3<Scalar>, 3>>& triangleGradients = precomputedData.triangleGradients;
+
+    const Size vertexNumber = precomputedData.birthVertex.size();
+    const Size triangleNumber = triangles.size();
+
+    std::vector<Scalar> geodesics(mesh.nextVertexId(), maxLimitValue<Scalar>());
+
+    if (precomputedData.heatSolver.info() != Eigen::Success || precomputedData.poissonSolver.info() != Eigen::Success)
+        return geodesics;
+
+    //Heat flow, isolated sources cannot spread heat
+    VectorX u0 = VectorX::Zero(vertexNumber);
+    bool hasSource = false;
+    for (const typename Mesh::VertexId& vId : sourceVertices) {
+        if (precomputedData.vertexMap[vId] != NULL_ID) {
+            u0(precomputedData.vertexMap[vId]) = 1;
+            hasSource = true;
+        }
+    }
+
+    if (!hasSource)
+        return geodesics;
+
+    const VectorX u = precomputedData.heatSolver.solve(u0);
+    if (precomputedData.heatSolver.info() != Eigen::Success)
+        return geodesics;
+
+    //Normalized gradient field, pointing away from the sources
+    std::vector<Vector3<Scalar>> X(triangleNumber);
+
+    #pragma omp parallel for
+    for (Index tId = 0; tId < triangleNumber; ++tId) {
+        Vector3<Scalar> gradient = Vector3<Scalar>::Zero();
+        for (Index i = 0; i < 3; ++i) {
+            gradient += u(triangles[tId][i]) * triangleGradients[tId][i];
+        }
+
+        const Scalar norm = gradient.norm();
+        X[tId] = norm > 0 ? Vector3<Scalar>(-gradient / norm) : Vector3<Scalar>::Zero();
+    }
+
+    //Integrated divergence
+    VectorX divergence = VectorX::Zero(vertexNumber);
+    for (Index tId = 0; tId < triangleNumber; ++tId) {
+        for (Index i = 0; i < 3; ++i) {
+            divergence(triangles[tId][i]) += triangleGradients[tId][i].dot(X[tId]);
+        }
+    }
+
+    //Poisson
+    const VectorX phi = precomputedData.poissonSolver.solve(divergence);
+    if (precomputedData.poissonSolver.info() != Eigen::Success)
+        return geodesics;
+
+    Scalar minValue = maxLimitValue<Scalar>();
+    for (const typename Mesh::VertexId& vId : sourceVertices) {
+        if (precomputedData.vertexMap[vId] != NULL_ID) {
+            minValue = std::min(minValue, phi(precomputedData.vertexMap[vId]));
+        }
+    }
+
+    #pragma omp parallel for
+    for (Index i = 0; i < vertexNumber; ++i) {
+        geodesics[precomputedData.birthVertex[i]] = phi(i) - minValue;
+    }
+
+    return geodesics;
 }
 
 #endif
+
+/**
+ * @brief Get the geodesics given source vertices with the fast marching method.
+ * It does not need any factorization. Polygonal faces are considered as triangle fans.
+ * @param mesh Input mesh
+ * @param sourceVertices Source vertices
+ * @return Geodesic values per vertex (maximum value for unreachable vertices)
+ */
+template<class Mesh>
+std::vector<typename Mesh::Scalar> meshFastMarchingGeodesics(
+        const Mesh& mesh,
+        const std::vector<typename Mesh::VertexId>& sourceVertices)
+{
+    std::vector<std::vector<typename Mesh::FaceId>> vfAdj = meshVertexFaceAdjacencies(mesh);
+    return meshFastMarchingGeodesics(mesh, sourceVertices, vfAdj);
+}
+
+/**
+ * @brief Get the geodesics given source vertices with the fast marching method.
+ * It does not need any factorization. Polygonal faces are considered as triangle fans.
+ * A vertex is updated from the triangles with two accepted vertices if the
+ * characteristic direction lies inside the triangle, from the edges otherwise.
+ * @param mesh Input mesh
+ * @param sourceVertices Source vertices
+ * @param vfAdj Pre-computed vertex-face adjacencies
+ * @return Geodesic values per vertex (maximum value for unreachable vertices)
+ */
+template<class Mesh>
+std::vector<typename Mesh::Scalar> meshFastMarchingGeodesics(
+        const Mesh& mesh,
+        const std::vector<typename Mesh::VertexId>& sourceVertices,
+        const std::vector<std::vector<typename Mesh::FaceId>>& vfAdj)
+{
+    typedef typename Mesh::Scalar Scalar;
+    typedef typename Mesh::Face Face;
+    typedef typename Mesh::FaceId FaceId;
+    typedef typename Mesh::VertexId VertexId;
+    typedef typename Mesh::Point Point;
+    typedef std::pair<Scalar, VertexId> QueueElement;
+
+    const Scalar maxValue = maxLimitValue<Scalar>();
+
+    std::vector<Scalar> geodesics(mesh.nextVertexId(), maxValue);
+    std::vector<bool> accepted(mesh.nextVertexId(), false);
+
+    std::priority_queue<QueueElement, std::vector<QueueElement>, std::greater<QueueElement>> queue;
+    for (const VertexId& vId : sourceVertices) {
+        assert(!mesh.isVertexDeleted(vId));
+        geodesics[vId] = 0;
+        queue.push(QueueElement(0, vId));
+    }
+
+    while (!queue.empty()) {
+        const QueueElement element = queue.top();
+        queue.pop();
+
+        const VertexId vId = element.second;
+        if (accepted[vId] || element.first > geodesics[vId])
+            continue;
+
+        accepted[vId] = true;
+
+        for (const FaceId& fId : vfAdj[vId]) {
+            const Face& face = mesh.face(fId);
+            const Size n = face.vertexNumber();
+
+            for (Index j = 1; j < n - 1; ++j) {
+                const std::array<VertexId, 3> triangle = { face.vertexId(0), face.vertexId(j), face.vertexId(j + 1) };
+                if (triangle[0] != vId && triangle[1] != vId && triangle[2] != vId)
+                    continue;
+
+                for (Index i = 0; i < 3; ++i) {
+                    const VertexId& cId = triangle[i];
+                    if (accepted[cId])
+                        continue;
+
+                    const VertexId& aId = triangle[(i + 1) % 3];
+                    const VertexId& bId = triangle[(i + 2) % 3];
+
+                    const Point& c = mesh.vertexPoint(cId);
+                    const Point e1 = mesh.vertexPoint(aId) - c;
+                    const Point e2 = mesh.vertexPoint(bId) - c;
+
+                    Scalar value = maxValue;
+
+                    //Edge updates
+                    if (accepted[aId])
+                        value = std::min(value, geodesics[aId] + e1.norm());
+                    if (accepted[bId])
+                        value = std::min(value, geodesics[bId] + e2.norm());
+
+                    //Triangle update
+                    if (accepted[aId] && accepted[bId]) {
+                        const Scalar ta = geodesics[aId];
+                        const Scalar tb = geodesics[bId];
+
+                        const Scalar g11 = e1.dot(e1);
+                        const Scalar g12 = e1.dot(e2);
+                        const Scalar g22 = e2.dot(e2);
+                        const Scalar det = g11 * g22 - g12 * g12;
+
+                        if (det > 0) {
+                            //Inverse of the Gram matrix
+                            const Scalar q11 = g22 / det;
+                            const Scalar q12 = -g12 / det;
+                            const Scalar q22 = g11 / det;
+
+                            const Scalar qa = q11 * ta + q12 * tb;
+                            const Scalar qb = q12 * ta + q22 * tb;
+
+                            const Scalar a = q11 + 2 * q12 + q22;
+                            const Scalar b = -2 * (qa + qb);
+                            const Scalar d = ta * qa + tb * qb - 1;
+
+                            const Scalar discriminant = b * b - 4 * a * d;
+                            if (a > 0 && discriminant >= 0) {
+                                const Scalar p = (-b + std::sqrt(discriminant)) / (2 * a);
+
+                                //Upwind condition
+                                const Scalar n1 = q11 * (ta - p) + q12 * (tb - p);
+                                const Scalar n2 = q12 * (ta - p) + q22 * (tb - p);
+                                if (p >= std::max(ta, tb) && n1 <= 0 && n2 <= 0) {
+                                    value = std::min(value, p);
+                                }
+                            }
+                        }
+                    }
+
+                    if (value < geodesics[cId]) {
+                        geodesics[cId] = value;
+                        queue.push(QueueElement(value, cId));
+                    }
+                }
+            }
+        }
+    }
+
+    return geodesics;
+}
+
+}
@@ -9,15 +9,25 @@
 
 #include <nvl/nuvolib.h>
 
-#ifdef NVL_LIBIGL_LOADED
-
-#include <igl/heat_geodesics.h>
-
 #include <vector>
 #include <utility>
+#include <array>
+
+#ifdef NVL_EIGEN_LOADED
+#include <nvl/math/vector.h>
+#include <nvl/math/sparsematrix.h>
+
+#include <Eigen/SparseCholesky>
+#endif
+
+#ifdef NVL_LIBIGL_LOADED
+#include <igl/heat_geodesics.h>
+#endif
 
 namespace nvl {
 
+#ifdef NVL_LIBIGL_LOADED
+
 template<class Mesh>
 struct HeatGeodesicsData {
     igl::HeatGeodesicsData<typename Mesh::Scalar> data;
@@ -51,10 +61,56 @@ std::vector<typename Mesh::Scalar> heatGeodesics(
         const HeatGeodesicsData<Mesh>& precomputedData,
         const std::vector<typename Mesh::VertexId>& sourceVertices);
 
-}
+#endif
+
+#ifdef NVL_EIGEN_LOADED
+
+template<class Mesh>
+struct MeshHeatGeodesicsData {
+    typedef typename Mesh::Scalar Scalar;
+
+    Eigen::SimplicialLDLT<SparseMatrix<Scalar>> heatSolver;
+    Eigen::SimplicialLDLT<SparseMatrix<Scalar>> poissonSolver;
+
+    std::vector<std::array<Index, 3>> triangles;
+    std::vector<std::array<Vector3<Scalar>, 3>> triangleGradients;
+
+    std::vector<typename Mesh::VertexId> birthVertex;
+    std::vector<Index> vertexMap;
+};
+
+template<class Mesh>
+bool meshHeatGeodesicsPrecomputeData(
+        const Mesh& mesh,
+        MeshHeatGeodesicsData<Mesh>& precomputedData,
+        const typename Mesh::Scalar timeFactor = 1.0);
+
+template<class Mesh>
+std::vector<typename Mesh::Scalar> meshHeatGeodesics(
+        const Mesh& mesh,
+        const std::vector<typename Mesh::VertexId>& sourceVertices);
+
+template<class Mesh>
+std::vector<typename Mesh::Scalar> meshHeatGeodesics(
+        const Mesh& mesh,
+        const MeshHeatGeodesicsData<Mesh>& precomputedData,
+        const std::vector<typename Mesh::VertexId>& sourceVertices);
 
 #endif
 
+template<class Mesh>
+std::vector<typename Mesh::Scalar> meshFastMarchingGeodesics(
+        const Mesh& mesh,
+        const std::vector<typename Mesh::VertexId>& sourceVertices);
+
+template<class Mesh>
+std::vector<typename Mesh::Scalar> meshFastMarchingGeodesics(
+        const Mesh& mesh,
+        const std::vector<typename Mesh::VertexId>& sourceVertices,
+        const std::vector<std::vector<typename Mesh::FaceId>>& vfAdj);
+
+}
+
 #include "mesh_geodesics.cpp"
 
 #endif // NVL_MODELS_MESH_GEODESICS
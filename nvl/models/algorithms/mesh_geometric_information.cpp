@@ -9,9 +9,23 @@
 #include <vector>
 
 #include <nvl/math/barycenter.h>
+#include <nvl/math/numeric_limits.h>
+
+#include <algorithm>
+
+#include <omp.h>
 
 namespace nvl {
 
+namespace internal {
+
+template<class Mesh, class F>
+MeshGeometricStatistics<Mesh> meshGeometricStatistics(
+        const Mesh& mesh,
+        const F& isEdgeCounted);
+
+}
+
 /**
  * @brief Axis-aligned bounding box of a mesh
  * @param mesh Mesh
@@ -172,4 +186,316 @@ typename Mesh::Scalar meshFaceArea(const Mesh& mesh, const typename Mesh::Face&
     return area;
 }
 
+/**
+ * @brief Compute the geometric statistics of a mesh (bounding box, edge lengths,
+ * area, volume and centroid) in a single parallel pass. No adjacency is needed:
+ * a half-edge (v1, v2) is counted if v1 < v2, and a half-edge with v1 > v2 only
+ * if the opposite half-edge does not exist (border edges). On consistently
+ * oriented meshes, each edge is counted once.
+ * @param mesh Mesh
+ * @return Geometric statistics
+ */
+template<class Mesh>
+MeshGeometricStatistics<Mesh> meshGeometricStatistics(const Mesh& mesh)
+{
+    typedef typename Mesh::VertexId VertexId;
+    typedef typename Mesh::FaceId FaceId;
+    typedef typename Mesh::Face Face;
+
+    const Size faceNumber = mesh.nextFaceId();
+    const Size vertexNumber = mesh.nextVertexId();
+
+    //Half-edges (v1, v2) with v1 < v2, grouped by v1. Each thread counts the
+    //half-edges of a contiguous range of faces, then the prefix sum on the
+    //vertices and the threads gives each thread its own positions to fill
+    std::vector<Index> halfEdgeOffsets(vertexNumber + 1, 0);
+    std::vector<VertexId> halfEdgeTargets;
+    std::vector<Index> threadPositions;
+
+    #pragma omp parallel
+    {
+        const Size threadNumber = static_cast<Size>(omp_get_num_threads());
+        const Index threadId = static_cast<Index>(omp_get_thread_num());
+        const FaceId begin = faceNumber * threadId / threadNumber;
+        const FaceId end = faceNumber * (threadId + 1) / threadNumber;
+
+        #pragma omp single
+        threadPositions.resize(threadNumber * vertexNumber, 0);
+
+        Index* positions = threadPositions.data() + threadId * vertexNumber;
+
+        for (FaceId fId = begin; fId < end; ++fId) {
+            if (mesh.isFaceDeleted(fId))
+                continue;
+
+            const Face& face = mesh.face(fId);
+            const Size n = face.vertexNumber();
+            for (Index j = 0; j < n; ++j) {
+                const VertexId& vId1 = face.vertexId(j);
+                const VertexId& vId2 = face.vertexId(j + 1 < n ? j + 1 : 0);
+                positions[vId1] += static_cast<Index>(vId1 < vId2);
+            }
+        }
+
+        #pragma omp barrier
+
+        #pragma omp single
+        {
+            Index offset = 0;
+            for (VertexId vId = 0; vId < vertexNumber; ++vId) {
+                halfEdgeOffsets[vId] = offset;
+
+                for (Index t = 0; t < threadNumber; ++t) {
+                    Index& position = threadPositions[t * vertexNumber + vId];
+                    const Index count = position;
+                    position = offset;
+                    offset += count;
+                }
+            }
+            halfEdgeOffsets[vertexNumber] = offset;
+
+            //A further slot for each thread, where the other half-edges are written
+            halfEdgeTargets.resize(offset + threadNumber);
+        }
+
+        const Index otherPosition = halfEdgeOffsets[vertexNumber] + threadId;
+
+        for (FaceId fId = begin; fId < end; ++fId) {
+            if (mesh.isFaceDeleted(fId))
+                continue;
+
+            const Face& face = mesh.face(fId);
+            const Size n = face.vertexNumber();
+            for (Index j = 0; j < n; ++j) {
+                const VertexId& vId1 = face.vertexId(j);
+                const VertexId& vId2 = face.vertexId(j + 1 < n ? j + 1 : 0);
+                //No branch: the comparison of the vertex ids is not predictable
+                const bool counted = vId1 < vId2;
+                Index& position = positions[vId1];
+                halfEdgeTargets[counted ? position : otherPosition] = vId2;
+                position += static_cast<Index>(counted);
+            }
+        }
+    }
+
+    return internal::meshGeometricStatistics(mesh, [&] (const FaceId& fId, const Index& j, const VertexId& vId1, const VertexId& vId2) {
+        NVL_SUPPRESS_UNUSEDVARIABLE(fId);
+        NVL_SUPPRESS_UNUSEDVARIABLE(j);
+
+        if (vId1 < vId2)
+            return true;
+
+        bool found = false;
+        for (Index i = halfEdgeOffsets[vId2]; i < halfEdgeOffsets[vId2 + 1]; ++i) {
+            found |= halfEdgeTargets[i] == vId1;
+        }
+
+        return !found;
+    });
+}
+
+/**
+ * @brief Compute the geometric statistics of a mesh (bounding box, edge lengths,
+ * area, volume and centroid) in a single parallel pass. Each edge is counted
+ * once: an edge shared by two faces is assigned to the face with lower id.
+ * @param mesh Mesh
+ * @param ffAdj Face-face adjacencies
+ * @return Geometric statistics
+ */
+template<class Mesh>
+MeshGeometricStatistics<Mesh> meshGeometricStatistics(
+        const Mesh& mesh,
+        const std::vector<std::vector<typename Mesh::FaceId>>& ffAdj)
+{
+    typedef typename Mesh::FaceId FaceId;
+
+    typedef typename Mesh::VertexId VertexId;
+
+    return internal::meshGeometricStatistics(mesh, [&] (const FaceId& fId, const Index& j, const VertexId& vId1, const VertexId& vId2) {
+        NVL_SUPPRESS_UNUSEDVARIABLE(vId1);
+        NVL_SUPPRESS_UNUSEDVARIABLE(vId2);
+
+        const FaceId& adjId = ffAdj[fId][j];
+        return adjId == NULL_ID || fId < adjId;
+    });
+}
+
+namespace internal {
+
+/**
+ * @brief Partial geometric statistics of a block of elements
+ */
+template<class Mesh>
+struct MeshGeometricStatisticsPartial {
+    typedef typename Mesh::Scalar Scalar;
+    typedef typename Mesh::Point Point;
+
+    AlignedBox3<Scalar> boundingBox;
+
+    Size edgeNumber = 0;
+    Scalar minEdgeLength = maxLimitValue<Scalar>();
+    Scalar maxEdgeLength = 0;
+    Scalar edgeLengthSum = 0;
+
+    //The area and the volume are stored multiplied by 2 and 6, and the centroids
+    //are not divided by the number of vertices: they are normalized once at the end
+    Scalar doubleArea = 0;
+    Scalar sixfoldVolume = 0;
+    Point areaCentroid = Point::Zero();
+    Point volumeCentroid = Point::Zero();
+};
+
+/**
+ * @brief Compute the geometric statistics of a mesh given a predicate which
+ * tells if an edge of a face has to be counted. The elements are split in fixed
+ * blocks, each one accumulating its own partial statistics, which are merged in
+ * the block order: the result does not depend on the number of threads or on
+ * the scheduling. Triangles are used directly, while the other faces are
+ * decomposed in triangles from their barycenter, as in meshFaceArea. The volume is the signed volume enclosed by the surface, and the
+ * centroid is the center of mass of the volume, or the area-weighted centroid of
+ * the surface if the volume is zero (e.g. open meshes).
+ * @param mesh Mesh
+ * @param isEdgeCounted Predicate on the face id, the position of the edge and its vertex ids
+ * @return Geometric statistics
+ */
+template<class Mesh, class F>
+MeshGeometricStatistics<Mesh> meshGeometricStatistics(
+        const Mesh& mesh,
+        const F& isEdgeCounted)
+{
+    typedef typename Mesh::Scalar Scalar;
+    typedef typename Mesh::Point Point;
+    typedef typename Mesh::VertexId VertexId;
+    typedef typename Mesh::FaceId FaceId;
+    typedef typename Mesh::Face Face;
+    typedef MeshGeometricStatisticsPartial<Mesh> Partial;
+
+    const Size blockSize = NVL_MESH_GEOMETRIC_STATISTICS_BLOCK_SIZE;
+    const Size vertexBlockNumber = (mesh.nextVertexId() + blockSize - 1) / blockSize;
+    const Size faceBlockNumber = (mesh.nextFaceId() + blockSize - 1) / blockSize;
+
+    std::vector<Partial> partials(vertexBlockNumber + faceBlockNumber);
+
+    #pragma omp parallel for
+    for (Index bId = 0; bId < partials.size(); ++bId) {
+        Partial& partial = partials[bId];
+
+        if (bId < vertexBlockNumber) {
+            const VertexId begin = bId * blockSize;
+            const VertexId end = std::min(begin + blockSize, mesh.nextVertexId());
+
+            for (VertexId vId = begin; vId < end; ++vId) {
+                if (mesh.isVertexDeleted(vId))
+                    continue;
+
+                partial.boundingBox.extend(mesh.vertexPoint(vId));
+            }
+        }
+        else {
+            const FaceId begin = (bId - vertexBlockNumber) * blockSize;
+            const FaceId end = std::min(begin + blockSize, mesh.nextFaceId());
+
+            for (FaceId fId = begin; fId < end; ++fId) {
+                if (mesh.isFaceDeleted(fId))
+                    continue;
+
+                const Face& face = mesh.face(fId);
+                const Size n = face.vertexNumber();
+
+                for (Index j = 0; j < n; ++j) {
+                    const VertexId& vId1 = face.vertexId(j);
+                    const VertexId& vId2 = face.vertexId(j + 1 < n ? j + 1 : 0);
+
+                    //Edge lengths
+                    if (isEdgeCounted(fId, j, vId1, vId2)) {
+                        const Scalar length = (mesh.vertexPoint(vId2) - mesh.vertexPoint(vId1)).norm();
+
+                        partial.minEdgeLength = std::min(partial.minEdgeLength, length);
+                        partial.maxEdgeLength = std::max(partial.maxEdgeLength, length);
+                        partial.edgeLengthSum += length;
+                        ++partial.edgeNumber;
+                    }
+                }
+
+                //Area and volume: triangles are used directly, the other faces
+                //are decomposed in triangles from their barycenter
+                if (n == 3) {
+                    const Point& p1 = mesh.vertexPoint(face.vertexId(0));
+                    const Point& p2 = mesh.vertexPoint(face.vertexId(1));
+                    const Point& p3 = mesh.vertexPoint(face.vertexId(2));
+
+                    const Point sum = p1 + p2 + p3;
+                    const Scalar triangleDoubleArea = (p2 - p1).cross(p3 - p1).norm();
+                    const Scalar triangleSixfoldVolume = p1.dot(p2.cross(p3));
+
+                    partial.doubleArea += triangleDoubleArea;
+                    partial.areaCentroid += triangleDoubleArea * sum;
+                    partial.sixfoldVolume += triangleSixfoldVolume;
+                    partial.volumeCentroid += triangleSixfoldVolume * sum;
+                }
+                else {
+                    Point barycenter = Point::Zero();
+                    for (Index j = 0; j < n; ++j) {
+                        barycenter += mesh.vertexPoint(face.vertexId(j));
+                    }
+                    barycenter /= n;
+
+                    for (Index j = 0; j < n; ++j) {
+                        const Point& p1 = mesh.vertexPoint(face.vertexId(j));
+                        const Point& p2 = mesh.vertexPoint(face.vertexId(j + 1 < n ? j + 1 : 0));
+
+                        const Point sum = barycenter + p1 + p2;
+                        const Scalar triangleDoubleArea = (p1 - barycenter).cross(p2 - barycenter).norm();
+                        const Scalar triangleSixfoldVolume = barycenter.dot(p1.cross(p2));
+
+                        partial.doubleArea += triangleDoubleArea;
+                        partial.areaCentroid += triangleDoubleArea * sum;
+                        partial.sixfoldVolume += triangleSixfoldVolume;
+                        partial.volumeCentroid += triangleSixfoldVolume * sum;
+                    }
+                }
+            }
+        }
+    }
+
+    Partial result;
+    for (const Partial& partial : partials) {
+        result.boundingBox.extend(partial.boundingBox);
+
+        result.edgeNumber += partial.edgeNumber;
+        result.minEdgeLength = std::min(result.minEdgeLength, partial.minEdgeLength);
+        result.maxEdgeLength = std::max(result.maxEdgeLength, partial.maxEdgeLength);
+        result.edgeLengthSum += partial.edgeLengthSum;
+
+        result.doubleArea += partial.doubleArea;
+        result.areaCentroid += partial.areaCentroid;
+        result.sixfoldVolume += partial.sixfoldVolume;
+        result.volumeCentroid += partial.volumeCentroid;
+    }
+
+    MeshGeometricStatistics<Mesh> statistics;
+
+    statistics.boundingBox = result.boundingBox;
+
+    statistics.edgeNumber = result.edgeNumber;
+    statistics.minEdgeLength = result.edgeNumber > 0 ? result.minEdgeLength : 0;
+    statistics.averageEdgeLength = result.edgeNumber > 0 ? result.edgeLengthSum / result.edgeNumber : 0;
+    statistics.maxEdgeLength = result.maxEdgeLength;
+
+    statistics.area = result.doubleArea / 2;
+    statistics.volume = result.sixfoldVolume / 6;
+
+    //Tetrahedra with the origin have centroid (p1 + p2 + p3) / 4, triangles (p1 + p2 + p3) / 3
+    if (result.sixfoldVolume != 0) {
+        statistics.centroid = result.volumeCentroid / (4 * result.sixfoldVolume);
+    }
+    else if (result.doubleArea > 0) {
+        statistics.centroid = result.areaCentroid / (3 * result.doubleArea);
+    }
+
+    return statistics;
+}
+
+}
+
 }
@@ -11,8 +11,36 @@
 
 #include <nvl/math/alignedbox.h>
 
+#include <vector>
+
+#define NVL_MESH_GEOMETRIC_STATISTICS_BLOCK_SIZE 4096
+
 namespace nvl {
 
+template<class Mesh>
+struct MeshGeometricStatistics {
+    typedef typename Mesh::Scalar Scalar;
+    typedef typename Mesh::Point Point;
+
+    AlignedBox3<Scalar> boundingBox;
+
+    Size edgeNumber = 0;
+    Scalar minEdgeLength = 0;
+    Scalar averageEdgeLength = 0;
+    Scalar maxEdgeLength = 0;
+
+    Scalar area = 0;
+    Scalar volume = 0;
+    Point centroid = Point::Zero();
+};
+
+template<class Mesh>
+MeshGeometricStatistics<Mesh> meshGeometricStatistics(const Mesh& mesh);
+template<class Mesh>
+MeshGeometricStatistics<Mesh> meshGeometricStatistics(
+        const Mesh& mesh,
+        const std::vector<std::vector<typename Mesh::FaceId>>& ffAdj);
+
 template<class Mesh>
 AlignedBox3<typename Mesh::Scalar> meshBoundingBox(const Mesh& mesh);
 
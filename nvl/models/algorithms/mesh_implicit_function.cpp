@@ -9,6 +9,8 @@
 #include <nvl/math/comparisons.h>
 
 #include <set>
+#include <numeric>
+#include <algorithm>
 
 namespace nvl {
 
@@ -113,4 +115,281 @@ std::vector<Segment<typename Mesh::Point>> meshImplicitFunction(
     return functionSegments;
 }
 
+/**
+ * @brief Extract the isolines of a per-vertex function over a mesh
+ * @param mesh Mesh
+ * @param vertexFunction Per-vertex function
+ * @param isoValues Values of the isolines
+ * @param polylineMesh Output polyline mesh
+ */
+template<class M1, class M2, class F>
+void meshIsolines(
+        const M1& mesh,
+        const std::vector<F>& vertexFunction,
+        const std::vector<F>& isoValues,
+        M2& polylineMesh)
+{
+    std::vector<Index> polylineIsoValue;
+    return meshIsolines(mesh, vertexFunction, isoValues, polylineMesh, polylineIsoValue);
+}
+
+/**
+ * @brief Extract the isolines of a per-vertex function over a mesh
+ * @param mesh Mesh
+ * @param vertexFunction Per-vertex function
+ * @param isoValues Values of the isolines
+ * @param polylineMesh Output polyline mesh
+ * @param polylineIsoValue Index of the iso-value for each polyline
+ */
+template<class M1, class M2, class F>
+void meshIsolines(
+        const M1& mesh,
+        const std::vector<F>& vertexFunction,
+        const std::vector<F>& isoValues,
+        M2& polylineMesh,
+        std::vector<Index>& polylineIsoValue)
+{
+    typedef typename M1::VertexId VertexId;
+
+    std::vector<std::pair<VertexId, VertexId>> edgeVertices;
+    const std::vector<std::vector<Index>> faceEdgeIds = meshFaceEdgeIds(mesh, edgeVertices);
+
+    std::vector<Index> birthEdge;
+    return meshIsolines(mesh, vertexFunction, isoValues, faceEdgeIds, edgeVertices, polylineMesh, polylineIsoValue, birthEdge);
+}
+
+/**
+ * @brief Extract the isolines of a per-vertex function over a mesh, with a
+ * marching-triangles (polygons) approach. Each mesh edge crossed by an isoline
+ * generates a single vertex, shared by the faces incident on the edge, so the
+ * resulting polylines are connected: closed isolines are represented by
+ * polylines having the same first and last vertex. Vertices with a value equal to
+ * the iso-value are considered above it. All the iso-values are extracted in a
+ * single pass, which is parallel over edges and faces. Polylines are added to
+ * the polyline mesh, consistently oriented if the mesh is consistently oriented.
+ * @param mesh Mesh
+ * @param vertexFunction Per-vertex function
+ * @param isoValues Values of the isolines
+ * @param faceEdgeIds Pre-computed face edge ids
+ * @param edgeVertices Pre-computed vertices of the edges
+ * @param polylineMesh Output polyline mesh
+ * @param polylineIsoValue Index of the iso-value for each polyline
+ * @param birthEdge Birth edge for each new vertex in the polyline mesh
+ */
+template<class M1, class M2, class F>
+void meshIsolines(
+        const M1& mesh,
+        const std::vector<F>& vertexFunction,
+        const std::vector<F>& isoValues,
+        const std::vector<std::vector<Index>>& faceEdgeIds,
+        const std::vector<std::pair<typename M1::VertexId, typename M1::VertexId>>& edgeVertices,
+        M2& polylineMesh,
+        std::vector<Index>& polylineIsoValue,
+        std::vector<Index>& birthEdge)
+{
+    typedef typename M1::Face Face;
+    typedef typename M1::FaceId FaceId;
+    typedef typename M1::VertexId VertexId;
+    typedef typename M2::VertexId PolylineVertexId;
+    typedef typename M2::Polyline Polyline;
+    typedef typename M2::Point Point;
+
+    const Size edgeNumber = edgeVertices.size();
+    const Size faceNumber = mesh.nextFaceId();
+
+    //Sort iso-values
+    std::vector<Index> isoOrder(isoValues.size());
+    std::iota(isoOrder.begin(), isoOrder.end(), 0);
+    std::sort(isoOrder.begin(), isoOrder.end(), [&isoValues](const Index& a, const Index& b) {
+        return isoValues[a] < isoValues[b];
+    });
+
+    std::vector<F> sortedIsoValues(isoValues.size());
+    for (Index i = 0; i < isoOrder.size(); ++i) {
+        sortedIsoValues[i] = isoValues[isoOrder[i]];
+    }
+
+    //Iso-values crossing each edge: a value t crosses an edge if min < t <= max
+    std::vector<Index> edgeIsoBegin(edgeNumber);
+    std::vector<Index> edgeVertexOffsets(edgeNumber + 1, 0);
+
+    #pragma omp parallel for
+    for (Index eId = 0; eId < edgeNumber; ++eId) {
+        const F& f1 = vertexFunction[edgeVertices[eId].first];
+        const F& f2 = vertexFunction[edgeVertices[eId].second];
+
+        const Index begin = std::upper_bound(sortedIsoValues.begin(), sortedIsoValues.end(), std::min(f1, f2)) - sortedIsoValues.begin();
+        const Index end = std::upper_bound(sortedIsoValues.begin(), sortedIsoValues.end(), std::max(f1, f2)) - sortedIsoValues.begin();
+
+        edgeIsoBegin[eId] = begin;
+        edgeVertexOffsets[eId + 1] = end - begin;
+    }
+
+    for (Index eId = 0; eId < edgeNumber; ++eId) {
+        edgeVertexOffsets[eId + 1] += edgeVertexOffsets[eId];
+    }
+
+    //Create a vertex for each crossing
+    const Size isoVertexNumber = edgeVertexOffsets[edgeNumber];
+    const PolylineVertexId firstVertexId = polylineMesh.allocateVertices(isoVertexNumber);
+
+    birthEdge.resize(polylineMesh.nextVertexId(), NULL_ID);
+    std::vector<Index> vertexIso(isoVertexNumber);
+
+    #pragma omp parallel for
+    for (Index eId = 0; eId < edgeNumber; ++eId) {
+        const VertexId& vId1 = edgeVertices[eId].first;
+        const VertexId& vId2 = edgeVertices[eId].second;
+
+        const F& f1 = vertexFunction[vId1];
+        const F& f2 = vertexFunction[vId2];
+
+        const Point& p1 = mesh.vertexPoint(vId1);
+        const Point& p2 = mesh.vertexPoint(vId2);
+
+        for (Index i = edgeVertexOffsets[eId]; i < edgeVertexOffsets[eId + 1]; ++i) {
+            const Index k = edgeIsoBegin[eId] + (i - edgeVertexOffsets[eId]);
+            const F w = (sortedIsoValues[k] - f1) / (f2 - f1);
+
+            polylineMesh.setVertexPoint(firstVertexId + i, p1 + (p2 - p1) * w);
+            birthEdge[firstVertexId + i] = eId;
+            vertexIso[i] = k;
+        }
+    }
+
+    //Segments of each face, oriented from the crossing going below the iso-value
+    //to the next crossing going above it
+    std::vector<Index> faceSegmentOffsets(faceNumber + 1, 0);
+    std::vector<Index> segmentFrom;
+    std::vector<Index> segmentTo;
+
+    for (Index pass = 0; pass < 2; ++pass) {
+        if (pass == 1) {
+            for (FaceId fId = 0; fId < faceNumber; ++fId) {
+                faceSegmentOffsets[fId + 1] += faceSegmentOffsets[fId];
+            }
+
+            segmentFrom.resize(faceSegmentOffsets[faceNumber]);
+            segmentTo.resize(faceSegmentOffsets[faceNumber]);
+        }
+
+        #pragma omp parallel for
+        for (FaceId fId = 0; fId < faceNumber; ++fId) {
+            if (mesh.isFaceDeleted(fId))
+                continue;
+
+            const Face& face = mesh.face(fId);
+            const Size n = face.vertexNumber();
+
+            F minValue = vertexFunction[face.vertexId(0)];
+            F maxValue = minValue;
+            for (Index j = 1; j < n; ++j) {
+                minValue = std::min(minValue, vertexFunction[face.vertexId(j)]);
+                maxValue = std::max(maxValue, vertexFunction[face.vertexId(j)]);
+            }
+
+            const Index begin = std::upper_bound(sortedIsoValues.begin(), sortedIsoValues.end(), minValue) - sortedIsoValues.begin();
+            const Index end = std::upper_bound(sortedIsoValues.begin(), sortedIsoValues.end(), maxValue) - sortedIsoValues.begin();
+
+            Index segmentId = faceSegmentOffsets[fId];
+            std::vector<Index> crossings;
+            std::vector<bool> crossingDown;
+
+            for (Index k = begin; k < end; ++k) {
+                const F& t = sortedIsoValues[k];
+
+                crossings.clear();
+                crossingDown.clear();
+                for (Index j = 0; j < n; ++j) {
+                    const bool above1 = vertexFunction[face.vertexId(j)] >= t;
+                    const bool above2 = vertexFunction[face.nextVertexId(j)] >= t;
+
+                    if (above1 != above2) {
+                        const Index eId = faceEdgeIds[fId][j];
+                        crossings.push_back(edgeVertexOffsets[eId] + (k - edgeIsoBegin[eId]));
+                        crossingDown.push_back(above1);
+                    }
+                }
+
+                assert(crossings.size() % 2 == 0);
+
+                if (pass == 0) {
+                    faceSegmentOffsets[fId + 1] += crossings.size() / 2;
+                    continue;
+                }
+
+                if (crossings.empty())
+                    continue;
+
+                //Crossings alternate their direction around the face
+                Index start = 0;
+                while (!crossingDown[start]) {
+                    ++start;
+                }
+
+                for (Index c = 0; c < crossings.size(); c += 2) {
+                    segmentFrom[segmentId] = crossings[(start + c) % crossings.size()];
+                    segmentTo[segmentId] = crossings[(start + c + 1) % crossings.size()];
+                    ++segmentId;
+                }
+            }
+        }
+    }
+
+    //Link the segments, a segment which cannot be linked (non-manifold or
+    //non-oriented edges) is a polyline itself
+    std::vector<Index> nextVertex(isoVertexNumber, NULL_ID);
+    std::vector<Index> prevVertex(isoVertexNumber, NULL_ID);
+    std::vector<Index> unlinkedSegments;
+
+    for (Index sId = 0; sId < segmentFrom.size(); ++sId) {
+        const Index& from = segmentFrom[sId];
+        const Index& to = segmentTo[sId];
+
+        if (nextVertex[from] == NULL_ID && prevVertex[to] == NULL_ID) {
+            nextVertex[from] = to;
+            prevVertex[to] = from;
+        }
+        else {
+            unlinkedSegments.push_back(sId);
+        }
+    }
+
+    //Trace open chains first, then closed loops
+    polylineIsoValue.resize(polylineMesh.nextPolylineId(), NULL_ID);
+
+    std::vector<bool> visited(isoVertexNumber, false);
+    for (Index pass = 0; pass < 2; ++pass) {
+        for (Index start = 0; start < isoVertexNumber; ++start) {
+            if (visited[start] || nextVertex[start] == NULL_ID || (pass == 0 && prevVertex[start] != NULL_ID))
+                continue;
+
+            typename Polyline::Container vertexIds;
+
+            Index current = start;
+            while (current != NULL_ID && !visited[current]) {
+                visited[current] = true;
+                vertexIds.push_back(firstVertexId + current);
+                current = nextVertex[current];
+            }
+
+            //Closed loop
+            if (current == start) {
+                vertexIds.push_back(firstVertexId + start);
+            }
+
+            Polyline polyline;
+            polyline.setVertexIds(vertexIds);
+
+            polylineMesh.addPolyline(polyline);
+            polylineIsoValue.push_back(isoOrder[vertexIso[start]]);
+        }
+    }
+
+    for (const Index& sId : unlinkedSegments) {
+        polylineMesh.addPolyline(firstVertexId + segmentFrom[sId], firstVertexId + segmentTo[sId]);
+        polylineIsoValue.push_back(isoOrder[vertexIso[segmentFrom[sId]]]);
+    }
+}
+
 }
@@ -21,6 +21,32 @@ std::vector<Segment<typename Mesh::Point>> meshImplicitFunction(
         const Mesh& mesh,
         const std::vector<F>& vertexFunction);
 
+template<class M1, class M2, class F>
+void meshIsolines(
+        const M1& mesh,
+        const std::vector<F>& vertexFunction,
+        const std::vector<F>& isoValues,
+        M2& polylineMesh);
+
+template<class M1, class M2, class F>
+void meshIsolines(
+        const M1& mesh,
+        const std::vector<F>& vertexFunction,
+        const std::vector<F>& isoValues,
+        M2& polylineMesh,
+        std::vector<Index>& polylineIsoValue);
+
+template<class M1, class M2, class F>
+void meshIsolines(
+        const M1& mesh,
+        const std::vector<F>& vertexFunction,
+        const std::vector<F>& isoValues,
+        const std::vector<std::vector<Index>>& faceEdgeIds,
+        const std::vector<std::pair<typename M1::VertexId, typename M1::VertexId>>& edgeVertices,
+        M2& polylineMesh,
+        std::vector<Index>& polylineIsoValue,
+        std::vector<Index>& birthEdge);
+
 }
 
 #include "mesh_implicit_function.cpp"
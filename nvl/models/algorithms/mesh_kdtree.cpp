@@ -0,0 +1,131 @@
+/*
+ * This file is part of nuvolib: https://github.com/stefanonuvoli/nuvolib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Stefano Nuvoli (stefano.nuvoli@gmail.com)
+ */
+#include "mesh_kdtree.h"
+
+namespace nvl {
+
+/**
+ * @brief Get a kd-tree storing the vertices of a mesh. The ids of the tree
+ * are the vertex ids, deleted vertices are skipped.
+ * @param mesh Mesh
+ * @param maxLeafElements Max number of vertices in each leaf of the kd-tree
+ * @return Vertex kd-tree
+ */
+template<class Mesh>
+KDTree<typename Mesh::Scalar, 3> meshVertexKDTree(
+        const Mesh& mesh,
+        const Size maxLeafElements)
+{
+    typedef typename Mesh::VertexId VertexId;
+    typedef typename Mesh::Point Point;
+
+    std::vector<Point> points;
+    std::vector<Index> ids;
+    points.reserve(mesh.vertexNumber());
+    ids.reserve(mesh.vertexNumber());
+    for (VertexId vId = 0; vId < mesh.nextVertexId(); ++vId) {
+        if (mesh.isVertexDeleted(vId))
+            continue;
+
+        points.push_back(mesh.vertexPoint(vId));
+        ids.push_back(vId);
+    }
+
+    return KDTree<typename Mesh::Scalar, 3>(points, ids, maxLeafElements);
+}
+
+/**
+ * @brief Closest vertex in a mesh using a kd-tree
+ * @param mesh Mesh
+ * @param kdtree Vertex kd-tree
+ * @param point Point
+ * @return Closest vertex id, NULL_ID if the kd-tree is empty
+ */
+template<class Mesh>
+typename Mesh::VertexId meshVertexKDTreeClosestVertex(
+        const Mesh& mesh,
+        const KDTree<typename Mesh::Scalar, 3>& kdtree,
+        const typename Mesh::Point& point)
+{
+    NVL_SUPPRESS_UNUSEDVARIABLE(mesh);
+
+    typename Mesh::Scalar squaredDistance;
+    return kdtree.nearest(point, squaredDistance);
+}
+
+/**
+ * @brief Closest vertex in a mesh of each point using a kd-tree. The queries
+ * are computed in parallel.
+ * @param mesh Mesh
+ * @param kdtree Vertex kd-tree
+ * @param points Points
+ * @return Closest vertex id of each point, NULL_ID if the kd-tree is empty
+ */
+template<class Mesh>
+std::vector<typename Mesh::VertexId> meshVertexKDTreeClosestVertices(
+        const Mesh& mesh,
+        const KDTree<typename Mesh::Scalar, 3>& kdtree,
+        const std::vector<typename Mesh::Point>& points)
+{
+    NVL_SUPPRESS_UNUSEDVARIABLE(mesh);
+
+    std::vector<Index> ids;
+    std::vector<typename Mesh::Scalar> squaredDistances;
+    kdtree.nearest(points, ids, squaredDistances);
+
+    return std::vector<typename Mesh::VertexId>(ids.begin(), ids.end());
+}
+
+/**
+ * @brief K closest vertices in a mesh using a kd-tree
+ * @param mesh Mesh
+ * @param kdtree Vertex kd-tree
+ * @param point Point
+ * @param k Number of vertices
+ * @return Closest vertex ids, sorted by distance
+ */
+template<class Mesh>
+std::vector<typename Mesh::VertexId> meshVertexKDTreeKNN(
+        const Mesh& mesh,
+        const KDTree<typename Mesh::Scalar, 3>& kdtree,
+        const typename Mesh::Point& point,
+        const Size k)
+{
+    NVL_SUPPRESS_UNUSEDVARIABLE(mesh);
+
+    std::vector<Index> ids;
+    std::vector<typename Mesh::Scalar> squaredDistances;
+    kdtree.knn(point, k, ids, squaredDistances);
+
+    return std::vector<typename Mesh::VertexId>(ids.begin(), ids.end());
+}
+
+/**
+ * @brief Vertices of a mesh in a given radius using a kd-tree
+ * @param mesh Mesh
+ * @param kdtree Vertex kd-tree
+ * @param point Point
+ * @param radius Radius
+ * @return Vertex ids, sorted by distance
+ */
+template<class Mesh>
+std::vector<typename Mesh::VertexId> meshVertexKDTreeRadiusSearch(
+        const Mesh& mesh,
+        const KDTree<typename Mesh::Scalar, 3>& kdtree,
+        const typename Mesh::Point& point,
+        const typename Mesh::Scalar& radius)
+{
+    NVL_SUPPRESS_UNUSEDVARIABLE(mesh);
+
+    std::vector<Index> ids;
+    std::vector<typename Mesh::Scalar> squaredDistances;
+    kdtree.radiusSearch(point, radius, ids, squaredDistances);
+
+    return std::vector<typename Mesh::VertexId>(ids.begin(), ids.end());
+}
+
+}
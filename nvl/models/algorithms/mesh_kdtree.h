@@ -0,0 +1,53 @@
+/*
+ * This file is part of nuvolib: https://github.com/stefanonuvoli/nuvolib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Stefano Nuvoli (stefano.nuvoli@gmail.com)
+ */
+#ifndef NVL_MODELS_MESH_KDTREE_H
+#define NVL_MODELS_MESH_KDTREE_H
+
+#include <nvl/nuvolib.h>
+
+#include <nvl/structures/trees/kdtree.h>
+
+#include <vector>
+
+namespace nvl {
+
+template<class Mesh>
+KDTree<typename Mesh::Scalar, 3> meshVertexKDTree(
+        const Mesh& mesh,
+        const Size maxLeafElements = NVL_KDTREE_DEFAULT_LEAF_ELEMENTS);
+
+template<class Mesh>
+typename Mesh::VertexId meshVertexKDTreeClosestVertex(
+        const Mesh& mesh,
+        const KDTree<typename Mesh::Scalar, 3>& kdtree,
+        const typename Mesh::Point& point);
+
+template<class Mesh>
+std::vector<typename Mesh::VertexId> meshVertexKDTreeClosestVertices(
+        const Mesh& mesh,
+        const KDTree<typename Mesh::Scalar, 3>& kdtree,
+        const std::vector<typename Mesh::Point>& points);
+
+template<class Mesh>
+std::vector<typename Mesh::VertexId> meshVertexKDTreeKNN(
+        const Mesh& mesh,
+        const KDTree<typename Mesh::Scalar, 3>& kdtree,
+        const typename Mesh::Point& point,
+        const Size k);
+
+template<class Mesh>
+std::vector<typename Mesh::VertexId> meshVertexKDTreeRadiusSearch(
+        const Mesh& mesh,
+        const KDTree<typename Mesh::Scalar, 3>& kdtree,
+        const typename Mesh::Point& point,
+        const typename Mesh::Scalar& radius);
+
+}
+
+#include "mesh_kdtree.cpp"
+
+#endif // NVL_MODELS_MESH_KDTREE_H
@@ -222,4 +222,288 @@ void meshCloseFaceSelection(
     meshErodeFaceSelection(mesh, selectedFaces, ffAdj, fixBorders);
 }
 
+/**
+ * @brief Dilate mathematical morphological operator on a bitset selection.
+ * Only the faces on the frontier of the selection are visited, and
+ * the operator is applied for a given number of rings in a single call.
+ * @param mesh Mesh
+ * @param selectedFaces Selected faces (input and output)
+ * @param rings Number of rings
+ */
+template<class Mesh>
+void meshDilateFaceSelection(
+        const Mesh& mesh,
+        BitSet& selectedFaces,
+        const Size rings)
+{
+    typedef typename Mesh::FaceId FaceId;
+
+    const std::vector<std::vector<FaceId>> vfAdj = meshVertexFaceAdjacencies(mesh);
+    const std::vector<std::vector<FaceId>> ffAdj = meshFaceFaceAdjacencies(mesh, vfAdj);
+    return meshDilateFaceSelection(mesh, selectedFaces, vfAdj, ffAdj, rings);
+}
+
+/**
+ * @brief Dilate mathematical morphological operator on a bitset selection.
+ * Only the faces on the frontier of the selection are visited, and
+ * the operator is applied for a given number of rings in a single call.
+ * @param mesh Mesh
+ * @param selectedFaces Selected faces (input and output)
+ * @param vfAdj Pre-computed vertex-face adjacencies
+ * @param ffAdj Pre-computed face-face adjacencies
+ * @param rings Number of rings
+ */
+template<class Mesh>
+void meshDilateFaceSelection(
+        const Mesh& mesh,
+        BitSet& selectedFaces,
+        const std::vector<std::vector<typename Mesh::FaceId>>& vfAdj,
+        const std::vector<std::vector<typename Mesh::FaceId>>& ffAdj,
+        const Size rings)
+{
+    typedef typename Mesh::FaceId FaceId;
+    typedef typename Mesh::Face Face;
+    typedef typename Mesh::VertexId VertexId;
+
+    //At the first ring every selected face can be on the frontier
+    std::vector<FaceId> frontier(selectedFaces.begin(), selectedFaces.end());
+
+    //A vertex on the border of the selection is surrounded after its dilation,
+    //so it cannot be on the border again in the next rings
+    BitSet visitedVertices(mesh.nextVertexId());
+
+    std::vector<VertexId> verticesOnBorder;
+    std::vector<FaceId> newFrontier;
+
+    for (Index r = 0; r < rings && !frontier.empty(); ++r) {
+        verticesOnBorder.clear();
+
+        for (const FaceId& fId : frontier) {
+            assert(!mesh.isFaceDeleted(fId));
+
+            const Face& face = mesh.face(fId);
+            for (Index fePos = 0; fePos < face.vertexNumber(); ++fePos) {
+                if (!meshIsBorderFaceEdge(mesh, fId, fePos, ffAdj) && !selectedFaces.contains(ffAdj[fId][fePos])) {
+                    const VertexId& vId1 = face.vertexId(fePos);
+                    const VertexId& vId2 = face.nextVertexId(fePos);
+
+                    if (visitedVertices.insert(vId1).second)
+                        verticesOnBorder.push_back(vId1);
+                    if (visitedVertices.insert(vId2).second)
+                        verticesOnBorder.push_back(vId2);
+                }
+            }
+        }
+
+        newFrontier.clear();
+        for (const VertexId& vId : verticesOnBorder) {
+            for (const FaceId& adjId : vfAdj[vId]) {
+                if (selectedFaces.insert(adjId).second) {
+                    newFrontier.push_back(adjId);
+                }
+            }
+        }
+
+        frontier.swap(newFrontier);
+    }
+}
+
+/**
+ * @brief Erode mathematical morphological operator on a bitset selection.
+ * Only the faces on the frontier of the selection are visited, and
+ * the operator is applied for a given number of rings in a single call.
+ * @param mesh Mesh
+ * @param selectedFaces Selected faces (input and output)
+ * @param fixBorders Fix border of the mesh
+ * @param rings Number of rings
+ */
+template<class Mesh>
+void meshErodeFaceSelection(
+        const Mesh& mesh,
+        BitSet& selectedFaces,
+        const bool fixBorders,
+        const Size rings)
+{
+    typedef typename Mesh::FaceId FaceId;
+
+    const std::vector<std::vector<FaceId>> vfAdj = meshVertexFaceAdjacencies(mesh);
+    const std::vector<std::vector<FaceId>> ffAdj = meshFaceFaceAdjacencies(mesh, vfAdj);
+    return meshErodeFaceSelection(mesh, selectedFaces, vfAdj, ffAdj, fixBorders, rings);
+}
+
+/**
+ * @brief Erode mathematical morphological operator on a bitset selection.
+ * Only the faces on the frontier of the selection are visited, and
+ * the operator is applied for a given number of rings in a single call.
+ * @param mesh Mesh
+ * @param selectedFaces Selected faces (input and output)
+ * @param vfAdj Pre-computed vertex-face adjacencies
+ * @param ffAdj Pre-computed face-face adjacencies
+ * @param fixBorders Fix border of the mesh
+ * @param rings Number of rings
+ */
+template<class Mesh>
+void meshErodeFaceSelection(
+        const Mesh& mesh,
+        BitSet& selectedFaces,
+        const std::vector<std::vector<typename Mesh::FaceId>>& vfAdj,
+        const std::vector<std::vector<typename Mesh::FaceId>>& ffAdj,
+        const bool fixBorders,
+        const Size rings)
+{
+    typedef typename Mesh::FaceId FaceId;
+    typedef typename Mesh::Face Face;
+    typedef typename Mesh::VertexId VertexId;
+
+    //At the first ring every selected face can be on the frontier
+    std::vector<FaceId> frontier(selectedFaces.begin(), selectedFaces.end());
+
+    //A vertex non-surrounded has no selected faces after the erosion,
+    //so it cannot be non-surrounded again in the next rings
+    BitSet visitedVertices(mesh.nextVertexId());
+    BitSet frontierFaces(mesh.nextFaceId());
+
+    std::vector<VertexId> verticesNonSurrounded;
+    std::vector<FaceId> removedFaces;
+
+    for (Index r = 0; r < rings && !frontier.empty(); ++r) {
+        verticesNonSurrounded.clear();
+
+        for (const FaceId& fId : frontier) {
+            assert(!mesh.isFaceDeleted(fId));
+
+            const Face& face = mesh.face(fId);
+            for (Index fePos = 0; fePos < face.vertexNumber(); ++fePos) {
+                const bool isBorder = meshIsBorderFaceEdge(mesh, fId, fePos, ffAdj);
+
+                bool nonSurrounded;
+                if (fixBorders) {
+                    nonSurrounded = !isBorder && !selectedFaces.contains(ffAdj[fId][fePos]);
+                }
+                else {
+                    nonSurrounded = isBorder || !selectedFaces.contains(ffAdj[fId][fePos]);
+                }
+
+                if (nonSurrounded) {
+                    const VertexId& vId1 = face.vertexId(fePos);
+                    const VertexId& vId2 = face.nextVertexId(fePos);
+
+                    if (visitedVertices.insert(vId1).second)
+                        verticesNonSurrounded.push_back(vId1);
+                    if (visitedVertices.insert(vId2).second)
+                        verticesNonSurrounded.push_back(vId2);
+                }
+            }
+        }
+
+        removedFaces.clear();
+        for (const VertexId& vId : verticesNonSurrounded) {
+            for (const FaceId& adjId : vfAdj[vId]) {
+                if (selectedFaces.erase(adjId) > 0) {
+                    removedFaces.push_back(adjId);
+                }
+            }
+        }
+
+        //The new frontier is composed of the selected faces adjacent to the removed ones
+        frontier.clear();
+        for (const FaceId& fId : removedFaces) {
+            for (const FaceId& adjId : ffAdj[fId]) {
+                if (adjId != NULL_ID && selectedFaces.contains(adjId) && frontierFaces.insert(adjId).second) {
+                    frontier.push_back(adjId);
+                }
+            }
+        }
+        for (const FaceId& fId : frontier) {
+            frontierFaces.erase(fId);
+        }
+    }
+}
+
+/**
+ * @brief Open mathematical morphological operator on a bitset selection
+ * @param mesh Mesh
+ * @param selectedFaces Selected faces (input and output)
+ * @param fixBorders Fix border of the mesh
+ * @param rings Number of rings
+ */
+template<class Mesh>
+void meshOpenFaceSelection(
+        const Mesh& mesh,
+        BitSet& selectedFaces,
+        const bool fixBorders,
+        const Size rings)
+{
+    typedef typename Mesh::FaceId FaceId;
+
+    const std::vector<std::vector<FaceId>> vfAdj = meshVertexFaceAdjacencies(mesh);
+    const std::vector<std::vector<FaceId>> ffAdj = meshFaceFaceAdjacencies(mesh, vfAdj);
+    return meshOpenFaceSelection(mesh, selectedFaces, vfAdj, ffAdj, fixBorders, rings);
+}
+
+/**
+ * @brief Open mathematical morphological operator on a bitset selection
+ * @param mesh Mesh
+ * @param selectedFaces Selected faces (input and output)
+ * @param vfAdj Pre-computed vertex-face adjacencies
+ * @param ffAdj Pre-computed face-face adjacencies
+ * @param fixBorders Fix border of the mesh
+ * @param rings Number of rings
+ */
+template<class Mesh>
+void meshOpenFaceSelection(
+        const Mesh& mesh,
+        BitSet& selectedFaces,
+        const std::vector<std::vector<typename Mesh::FaceId>>& vfAdj,
+        const std::vector<std::vector<typename Mesh::FaceId>>& ffAdj,
+        const bool fixBorders,
+        const Size rings)
+{
+    meshErodeFaceSelection(mesh, selectedFaces, vfAdj, ffAdj, fixBorders, rings);
+    meshDilateFaceSelection(mesh, selectedFaces, vfAdj, ffAdj, rings);
+}
+
+/**
+ * @brief Close mathematical morphological operator on a bitset selection
+ * @param mesh Mesh
+ * @param selectedFaces Selected faces (input and output)
+ * @param fixBorders Fix border of the mesh
+ * @param rings Number of rings
+ */
+template<class Mesh>
+void meshCloseFaceSelection(
+        const Mesh& mesh,
+        BitSet& selectedFaces,
+        const bool fixBorders,
+        const Size rings)
+{
+    typedef typename Mesh::FaceId FaceId;
+
+    const std::vector<std::vector<FaceId>> vfAdj = meshVertexFaceAdjacencies(mesh);
+    const std::vector<std::vector<FaceId>> ffAdj = meshFaceFaceAdjacencies(mesh, vfAdj);
+    return meshCloseFaceSelection(mesh, selectedFaces, vfAdj, ffAdj, fixBorders, rings);
+}
+
+/**
+ * @brief Close mathematical morphological operator on a bitset selection
+ * @param mesh Mesh
+ * @param selectedFaces Selected faces (input and output)
+ * @param vfAdj Pre-computed vertex-face adjacencies
+ * @param ffAdj Pre-computed face-face adjacencies
+ * @param fixBorders Fix border of the mesh
+ * @param rings Number of rings
+ */
+template<class Mesh>
+void meshCloseFaceSelection(
+        const Mesh& mesh,
+        BitSet& selectedFaces,
+        const std::vector<std::vector<typename Mesh::FaceId>>& vfAdj,
+        const std::vector<std::vector<typename Mesh::FaceId>>& ffAdj,
+        const bool fixBorders,
+        const Size rings)
+{
+    meshDilateFaceSelection(mesh, selectedFaces, vfAdj, ffAdj, rings);
+    meshErodeFaceSelection(mesh, selectedFaces, vfAdj, ffAdj, fixBorders, rings);
+}
+
 }
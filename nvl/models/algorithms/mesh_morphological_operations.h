@@ -9,6 +9,8 @@
 
 #include <nvl/nuvolib.h>
 
+#include <nvl/structures/containers/bitset.h>
+
 #include <vector>
 
 namespace nvl {
@@ -63,6 +65,68 @@ void meshCloseFaceSelection(
         const std::vector<std::vector<typename Mesh::FaceId>>& ffAdj,
         const bool fixBorders = false);
 
+template<class Mesh>
+void meshDilateFaceSelection(
+        const Mesh& mesh,
+        BitSet& selectedFaces,
+        const Size rings = 1);
+
+template<class Mesh>
+void meshDilateFaceSelection(
+        const Mesh& mesh,
+        BitSet& selectedFaces,
+        const std::vector<std::vector<typename Mesh::FaceId>>& vfAdj,
+        const std::vector<std::vector<typename Mesh::FaceId>>& ffAdj,
+        const Size rings = 1);
+
+template<class Mesh>
+void meshErodeFaceSelection(
+        const Mesh& mesh,
+        BitSet& selectedFaces,
+        const bool fixBorders = false,
+        const Size rings = 1);
+
+template<class Mesh>
+void meshErodeFaceSelection(
+        const Mesh& mesh,
+        BitSet& selectedFaces,
+        const std::vector<std::vector<typename Mesh::FaceId>>& vfAdj,
+        const std::vector<std::vector<typename Mesh::FaceId>>& ffAdj,
+        const bool fixBorders = false,
+        const Size rings = 1);
+
+template<class Mesh>
+void meshOpenFaceSelection(
+        const Mesh& mesh,
+        BitSet& selectedFaces,
+        const bool fixBorders = false,
+        const Size rings = 1);
+
+template<class Mesh>
+void meshOpenFaceSelection(
+        const Mesh& mesh,
+        BitSet& selectedFaces,
+        const std::vector<std::vector<typename Mesh::FaceId>>& vfAdj,
+        const std::vector<std::vector<typename Mesh::FaceId>>& ffAdj,
+        const bool fixBorders = false,
+        const Size rings = 1);
+
+template<class Mesh>
+void meshCloseFaceSelection(
+        const Mesh& mesh,
+        BitSet& selectedFaces,
+        const bool fixBorders = false,
+        const Size rings = 1);
+
+template<class Mesh>
+void meshCloseFaceSelection(
+        const Mesh& mesh,
+        BitSet& selectedFaces,
+        const std::vector<std::vector<typename Mesh::FaceId>>& vfAdj,
+        const std::vector<std::vector<typename Mesh::FaceId>>& ffAdj,
+        const bool fixBorders = false,
+        const Size rings = 1);
+
 }
 
 #include "mesh_morphological_operations.cpp"
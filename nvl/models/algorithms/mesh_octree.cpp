@@ -8,6 +8,7 @@
 
 #include <nvl/math/numeric_limits.h>
 #include <nvl/math/closest_point.h>
+#include <nvl/math/closest_point_packet.h>
 #include <nvl/models/algorithms/mesh_geometric_information.h>
 #include <nvl/models/algorithms/mesh_adjacencies.h>
 
@@ -33,13 +34,17 @@ Octree<typename Mesh::Point, typename Mesh::VertexId> meshVertexOctree(
     o.setMaxBoxElements(maxBoxElements);
     o.setMaxBoxRadius(maxBoxRadius);
 
+    std::vector<std::pair<typename Mesh::Point, VertexId>> values;
+    values.reserve(mesh.vertexNumber());
     for (VertexId vId = 0; vId < mesh.nextVertexId(); ++vId) {
         if (mesh.isVertexDeleted(vId))
             continue;
 
-        o.insert(mesh.vertexPoint(vId), vId);
+        values.push_back(std::make_pair(mesh.vertexPoint(vId), vId));
     }
 
+    o.construction(values);
+
     return o;
 }
 
@@ -110,7 +115,7 @@ typename Mesh::Point meshVertexOctreeClosestPoint(
         const Octree<typename Mesh::Point, typename Mesh::VertexId>& octree,
         const typename Mesh::Point& point)
 {
-    return meshVertexOctreeClosestPoint(mesh, octree, nvl::meshVertexFaceAdjacencies(mesh), point);
+    return meshVertexOctreeClosestPoint(mesh, octree, point, nvl::meshVertexFaceAdjacencies(mesh));
 }
 
 /**
@@ -140,16 +145,20 @@ typename Mesh::Point meshVertexOctreeClosestPoint(
 
     if (closestVId != NULL_ID) {
         Scalar bestClosestDistance = nvl::maxLimitValue<Scalar>();
-        for (const FaceId& fId : vfAdj[closestVId]) {
-            const Face& face = mesh.face(fId);
 
-            Point p;
+        //Triangles are evaluated in packets
+        TrianglePacket<Scalar> triangles;
+        TriangleClosestPointPacket<Scalar> result;
+
+        const std::vector<FaceId>& faces = vfAdj[closestVId];
+        for (Index i = 0; i < faces.size(); ++i) {
+            const Face& face = mesh.face(faces[i]);
+
             if (face.vertexNumber() == 3) {
-                p = closestPointOnTriangle(
+                triangles.addTriangle(
                     mesh.vertexPoint(face.vertexId(0)),
                     mesh.vertexPoint(face.vertexId(1)),
-                    mesh.vertexPoint(face.vertexId(2)),
-                    point);
+                    mesh.vertexPoint(face.vertexId(2)));
             }
             else {
                 std::vector<Point> polygon(face.vertexNumber());
@@ -157,13 +166,25 @@ typename Mesh::Point meshVertexOctreeClosestPoint(
                     polygon[j] = mesh.vertexPoint(face.vertexId(j));
                 }
 
-                p = closestPointOnPolygonBarycenterSubdivision(polygon, point);
+                Point p = closestPointOnPolygonBarycenterSubdivision(polygon, point);
+
+                Scalar dist = (point - p).squaredNorm();
+                if (dist < bestClosestDistance) {
+                    closestPoint = p;
+                    bestClosestDistance = dist;
+                }
             }
 
-            Scalar dist = (point - p).norm();
-            if (dist < bestClosestDistance) {
-                closestPoint = p;
-                bestClosestDistance = dist;
+            if (triangles.isFull() || (i == faces.size() - 1 && !triangles.isEmpty())) {
+                closestPointOnTrianglePacket(triangles, point, result);
+
+                const Index lane = result.nearestLane(triangles.size);
+                if (result.squaredDistances[lane] < bestClosestDistance) {
+                    closestPoint = result.closestPoint(lane);
+                    bestClosestDistance = result.squaredDistances[lane];
+                }
+
+                triangles.clear();
             }
         }
     }
@@ -6,6 +6,13 @@
  */
 #include "mesh_remeshing.h"
 
+#include <nvl/models/algorithms/mesh_bvh.h>
+
+#include <algorithm>
+#include <array>
+#include <tuple>
+#include <utility>
+
 #ifdef NVL_VCGLIB_LOADED
 
 #include <vcg/complex/algorithms/isotropic_remeshing.h>
@@ -13,8 +20,356 @@
 #include <nvl/models/algorithms/mesh_vcg_convert.h>
 #include <nvl/models/structures/vcg_triangle_mesh.h>
 
+#endif
+
 namespace nvl {
 
+namespace internal {
+
+template<class Point>
+struct RemeshingTopology {
+    std::vector<Point> points;
+    std::vector<Index> vertexHalfEdge;
+    std::vector<Index> halfEdgeVertex;
+    std::vector<Index> halfEdgeTwin;
+    std::vector<bool> faceDeleted;
+    std::vector<bool> vertexFixed;
+    std::vector<bool> vertexNonManifold;
+};
+
+Index remeshingNext(const Index& h);
+Index remeshingPrev(const Index& h);
+
+template<class Point>
+bool remeshingVertexStar(
+        const RemeshingTopology<Point>& topology,
+        const Index& vId,
+        std::vector<Index>& outgoing,
+        std::vector<Index>& neighbors);
+
+template<class Point>
+Point remeshingFaceNormal(
+        const RemeshingTopology<Point>& topology,
+        const Index& fId);
+
+template<class Point>
+void remeshingSplitEdge(
+        RemeshingTopology<Point>& topology,
+        const Index& h,
+        const Point& point);
+
+template<class Point>
+bool remeshingCollapseEdge(
+        RemeshingTopology<Point>& topology,
+        const Index& h,
+        const Point& point,
+        const typename Point::Scalar& maxLength);
+
+template<class Point>
+bool remeshingFlipEdge(
+        RemeshingTopology<Point>& topology,
+        const Index& h);
+
+}
+
+/**
+ * @brief Isotropic remeshing, native implementation (split long edges,
+ * collapse short edges, flip edges to equalize the valences, tangential
+ * relaxation and reprojection on the input surface)
+ * @param mesh Triangle mesh
+ * @param edgeSize Target edge size
+ * @param iterations Number of iterations
+ * @param fixBorders Fix borders
+ * @return Resulting mesh
+ */
+template<class Mesh>
+Mesh meshIsotropicRemeshing(
+        const Mesh& mesh,
+        const double& edgeSize,
+        const unsigned int& iterations,
+        const bool& fixBorders)
+{
+    std::vector<typename Mesh::VertexId> birthVertex;
+    return meshIsotropicRemeshing(mesh, edgeSize, iterations, fixBorders, birthVertex);
+}
+
+/**
+ * @brief Isotropic remeshing, native implementation (split long edges,
+ * collapse short edges, flip edges to equalize the valences, tangential
+ * relaxation and reprojection on the input surface). The operations are
+ * performed on a half-edge topology indexed by the corners of the triangles,
+ * the relaxation and the reprojection are computed in parallel and the
+ * closest points are found exactly using a face BVH of the input mesh.
+ * @param mesh Triangle mesh
+ * @param edgeSize Target edge size
+ * @param iterations Number of iterations
+ * @param fixBorders Fix borders
+ * @param birthVertex Birth vertex of the resulting mesh (NULL_ID for new vertices)
+ * @return Resulting mesh
+ */
+template<class Mesh>
+Mesh meshIsotropicRemeshing(
+        const Mesh& mesh,
+        const double& edgeSize,
+        const unsigned int& iterations,
+        const bool& fixBorders,
+        std::vector<typename Mesh::VertexId>& birthVertex)
+{
+    typedef typename Mesh::Scalar Scalar;
+    typedef typename Mesh::Point Point;
+    typedef typename Mesh::VertexId VertexId;
+    typedef typename Mesh::FaceId FaceId;
+    typedef typename Mesh::Face Face;
+    typedef std::tuple<Index, Index, Index> EdgeKey;
+
+    const Scalar maxLength = static_cast<Scalar>(4.0 / 3.0 * edgeSize);
+    const Scalar minLength = static_cast<Scalar>(4.0 / 5.0 * edgeSize);
+
+    birthVertex.clear();
+
+    //Topology
+    internal::RemeshingTopology<Point> topology;
+
+    std::vector<Index> vertexMap(mesh.nextVertexId(), NULL_ID);
+    std::vector<VertexId> topologyBirthVertex;
+    for (VertexId vId = 0; vId < mesh.nextVertexId(); ++vId) {
+        if (mesh.isVertexDeleted(vId))
+            continue;
+
+        vertexMap[vId] = topology.points.size();
+        topology.points.push_back(mesh.vertexPoint(vId));
+        topologyBirthVertex.push_back(vId);
+    }
+
+    for (FaceId fId = 0; fId < mesh.nextFaceId(); ++fId) {
+        if (mesh.isFaceDeleted(fId))
+            continue;
+
+        const Face& face = mesh.face(fId);
+        assert(face.vertexNumber() == 3);
+
+        for (Index j = 0; j < 3; ++j) {
+            topology.halfEdgeVertex.push_back(vertexMap[face.vertexId(j)]);
+        }
+        topology.faceDeleted.push_back(false);
+    }
+
+    const Size halfEdgeNumber = topology.halfEdgeVertex.size();
+
+    topology.halfEdgeTwin.resize(halfEdgeNumber, NULL_ID);
+    topology.vertexHalfEdge.resize(topology.points.size(), NULL_ID);
+
+    std::vector<EdgeKey> edgeKeys(halfEdgeNumber);
+
+    #pragma omp parallel for
+    for (Index h = 0; h < halfEdgeNumber; ++h) {
+        const Index& v1 = topology.halfEdgeVertex[h];
+        const Index& v2 = topology.halfEdgeVertex[internal::remeshingNext(h)];
+        edgeKeys[h] = std::make_tuple(std::min(v1, v2), std::max(v1, v2), h);
+    }
+
+    std::sort(edgeKeys.begin(), edgeKeys.end());
+
+    for (Index i = 0; i < halfEdgeNumber; ) {
+        Index j = i + 1;
+        while (j < halfEdgeNumber && std::get<0>(edgeKeys[j]) == std::get<0>(edgeKeys[i]) && std::get<1>(edgeKeys[j]) == std::get<1>(edgeKeys[i])) {
+            ++j;
+        }
+
+        //Only manifold and consistently oriented edges are linked
+        if (j - i == 2) {
+            const Index& h1 = std::get<2>(edgeKeys[i]);
+            const Index& h2 = std::get<2>(edgeKeys[i + 1]);
+            if (topology.halfEdgeVertex[h1] != topology.halfEdgeVertex[h2]) {
+                topology.halfEdgeTwin[h1] = h2;
+                topology.halfEdgeTwin[h2] = h1;
+            }
+        }
+
+        i = j;
+    }
+
+    edgeKeys.clear();
+
+    std::vector<Size> vertexOutgoingNumber(topology.points.size(), 0);
+    for (Index h = 0; h < halfEdgeNumber; ++h) {
+        topology.vertexHalfEdge[topology.halfEdgeVertex[h]] = h;
+        vertexOutgoingNumber[topology.halfEdgeVertex[h]]++;
+    }
+
+    //Vertices with more than one fan of triangles are never modified,
+    //border vertices are never moved if the borders are fixed
+    topology.vertexFixed.resize(topology.points.size(), false);
+    topology.vertexNonManifold.resize(topology.points.size(), false);
+
+    std::vector<Index> outgoing;
+    std::vector<Index> neighbors;
+
+    for (Index vId = 0; vId < topology.points.size(); ++vId) {
+        if (topology.vertexHalfEdge[vId] == NULL_ID)
+            continue;
+
+        const bool border = internal::remeshingVertexStar(topology, vId, outgoing, neighbors);
+        if (outgoing.size() != vertexOutgoingNumber[vId]) {
+            topology.vertexNonManifold[vId] = true;
+            topology.vertexFixed[vId] = true;
+        }
+        else if (border && fixBorders) {
+            topology.vertexFixed[vId] = true;
+        }
+    }
+
+    //Input surface for the reprojection
+    BVH<Scalar, 3> bvh = meshFaceBVH(mesh);
+
+    for (unsigned int it = 0; it < iterations; ++it) {
+        //Split long edges, only the edges existing before the split are considered
+        const Size splitHalfEdgeNumber = topology.halfEdgeVertex.size();
+        for (Index h = 0; h < splitHalfEdgeNumber; ++h) {
+            if (topology.faceDeleted[h / 3])
+                continue;
+
+            const Index t = topology.halfEdgeTwin[h];
+            if (t != NULL_ID && t < h)
+                continue;
+            if (t == NULL_ID && fixBorders)
+                continue;
+
+            const Point& p1 = topology.points[topology.halfEdgeVertex[h]];
+            const Point& p2 = topology.points[topology.halfEdgeVertex[internal::remeshingNext(h)]];
+
+            if ((p2 - p1).norm() > maxLength) {
+                internal::remeshingSplitEdge(topology, h, Point((p1 + p2) / 2));
+            }
+        }
+
+        //Collapse short edges
+        for (Index h = 0; h < topology.halfEdgeVertex.size(); ++h) {
+            if (topology.faceDeleted[h / 3])
+                continue;
+
+            const Index t = topology.halfEdgeTwin[h];
+            if (t != NULL_ID && t < h)
+                continue;
+
+            const Index a = topology.halfEdgeVertex[h];
+            const Index b = topology.halfEdgeVertex[internal::remeshingNext(h)];
+
+            if ((topology.points[b] - topology.points[a]).norm() >= minLength)
+                continue;
+
+            if (topology.vertexNonManifold[a] || topology.vertexNonManifold[b])
+                continue;
+            if (topology.vertexFixed[a] && topology.vertexFixed[b])
+                continue;
+
+            const bool aBorder = internal::remeshingVertexStar(topology, a, outgoing, neighbors);
+            const bool bBorder = internal::remeshingVertexStar(topology, b, outgoing, neighbors);
+
+            if (aBorder && bBorder && t != NULL_ID)
+                continue;
+
+            //Fixed and border vertices are kept in their position
+            if (topology.vertexFixed[a] || (aBorder && !bBorder)) {
+                internal::remeshingCollapseEdge(topology, t, Point(topology.points[a]), maxLength);
+            }
+            else if (topology.vertexFixed[b] || (bBorder && !aBorder)) {
+                internal::remeshingCollapseEdge(topology, h, Point(topology.points[b]), maxLength);
+            }
+            else {
+                internal::remeshingCollapseEdge(topology, h, Point((topology.points[a] + topology.points[b]) / 2), maxLength);
+            }
+        }
+
+        //Flip edges to equalize the valences
+        for (Index h = 0; h < topology.halfEdgeVertex.size(); ++h) {
+            if (topology.faceDeleted[h / 3])
+                continue;
+
+            const Index t = topology.halfEdgeTwin[h];
+            if (t == NULL_ID || t < h)
+                continue;
+
+            internal::remeshingFlipEdge(topology, h);
+        }
+
+        //Tangential relaxation
+        std::vector<Point> relaxedPoints = topology.points;
+
+        #pragma omp parallel for
+        for (Index vId = 0; vId < topology.points.size(); ++vId) {
+            std::vector<Index> vOutgoing;
+            std::vector<Index> vNeighbors;
+
+            if (topology.vertexHalfEdge[vId] == NULL_ID || topology.vertexFixed[vId])
+                continue;
+
+            const bool border = internal::remeshingVertexStar(topology, vId, vOutgoing, vNeighbors);
+            if (border || vNeighbors.empty())
+                continue;
+
+            const Point& p = topology.points[vId];
+
+            Point q = Point::Zero();
+            for (const Index& nId : vNeighbors) {
+                q += topology.points[nId];
+            }
+            q /= static_cast<Scalar>(vNeighbors.size());
+
+            Point normal = Point::Zero();
+            for (const Index& h : vOutgoing) {
+                normal += internal::remeshingFaceNormal(topology, h / 3);
+            }
+
+            const Scalar normalNorm = normal.norm();
+            if (normalNorm > 0) {
+                normal /= normalNorm;
+                relaxedPoints[vId] = q + normal * normal.dot(p - q);
+            }
+            else {
+                relaxedPoints[vId] = q;
+            }
+        }
+
+        topology.points = std::move(relaxedPoints);
+
+        //Reprojection
+        #pragma omp parallel for
+        for (Index vId = 0; vId < topology.points.size(); ++vId) {
+            if (topology.vertexHalfEdge[vId] == NULL_ID || topology.vertexFixed[vId])
+                continue;
+
+            topology.points[vId] = meshFaceBVHClosestPoint(mesh, bvh, topology.points[vId]);
+        }
+    }
+
+    //Resulting mesh
+    Mesh resultMesh;
+
+    std::vector<VertexId> resultVertexMap(topology.points.size(), NULL_ID);
+    for (Index vId = 0; vId < topology.points.size(); ++vId) {
+        if (topology.vertexHalfEdge[vId] == NULL_ID)
+            continue;
+
+        resultVertexMap[vId] = resultMesh.addVertex(topology.points[vId]);
+        birthVertex.push_back(vId < topologyBirthVertex.size() ? topologyBirthVertex[vId] : NULL_ID);
+    }
+
+    for (Index fId = 0; fId < topology.faceDeleted.size(); ++fId) {
+        if (topology.faceDeleted[fId])
+            continue;
+
+        resultMesh.addFace(
+            resultVertexMap[topology.halfEdgeVertex[3 * fId]],
+            resultVertexMap[topology.halfEdgeVertex[3 * fId + 1]],
+            resultVertexMap[topology.halfEdgeVertex[3 * fId + 2]]);
+    }
+
+    return resultMesh;
+}
+
+#ifdef NVL_VCGLIB_LOADED
+
 /**
  * @brief Isotropic remeshing
  * @param mesh Mesh
@@ -113,4 +468,438 @@ void vcgIsotropicRemeshing(
 
 #endif
 
+namespace internal {
+
+/**
+ * @brief Next half-edge in the triangle
+ * @param h Half-edge
+ * @return Next half-edge
+ */
+NVL_INLINE Index remeshingNext(const Index& h)
+{
+    return 3 * (h / 3) + (h + 1) % 3;
+}
+
+/**
+ * @brief Previous half-edge in the triangle
+ * @param h Half-edge
+ * @return Previous half-edge
+ */
+NVL_INLINE Index remeshingPrev(const Index& h)
+{
+    return 3 * (h / 3) + (h + 2) % 3;
+}
+
+/**
+ * @brief Get the star of a vertex, rotating in both directions from its
+ * half-edge, so that the star of border vertices is complete
+ * @param topology Topology
+ * @param vId Vertex id
+ * @param outgoing Outgoing half-edges of the vertex
+ * @param neighbors Adjacent vertices
+ * @return True if the vertex is on the border
+ */
+template<class Point>
+bool remeshingVertexStar(
+        const RemeshingTopology<Point>& topology,
+        const Index& vId,
+        std::vector<Index>& outgoing,
+        std::vector<Index>& neighbors)
+{
+    outgoing.clear();
+    neighbors.clear();
+
+    const Index start = topology.vertexHalfEdge[vId];
+    if (start == NULL_ID)
+        return false;
+
+    bool border = false;
+
+    Index h = start;
+    do {
+        outgoing.push_back(h);
+        neighbors.push_back(topology.halfEdgeVertex[remeshingNext(h)]);
+
+        const Index p = remeshingPrev(h);
+        const Index& t = topology.halfEdgeTwin[p];
+        if (t == NULL_ID) {
+            neighbors.push_back(topology.halfEdgeVertex[p]);
+            border = true;
+            break;
+        }
+
+        h = t;
+    } while (h != start);
+
+    if (border) {
+        Index t = topology.halfEdgeTwin[start];
+        while (t != NULL_ID) {
+            h = remeshingNext(t);
+            if (h == start)
+                break;
+
+            outgoing.push_back(h);
+            neighbors.push_back(topology.halfEdgeVertex[remeshingNext(h)]);
+
+            t = topology.halfEdgeTwin[h];
+        }
+    }
+
+    return border;
+}
+
+/**
+ * @brief Normal of a triangle, weighted by its double area
+ * @param topology Topology
+ * @param fId Face id
+ * @return Normal
+ */
+template<class Point>
+Point remeshingFaceNormal(
+        const RemeshingTopology<Point>& topology,
+        const Index& fId)
+{
+    const Point& p0 = topology.points[topology.halfEdgeVertex[3 * fId]];
+    const Point& p1 = topology.points[topology.halfEdgeVertex[3 * fId + 1]];
+    const Point& p2 = topology.points[topology.halfEdgeVertex[3 * fId + 2]];
+
+    return (p1 - p0).cross(p2 - p0);
+}
+
+/**
+ * @brief Split an edge, adding a vertex and one or two triangles
+ * @param topology Topology
+ * @param h Half-edge of the edge
+ * @param point Position of the new vertex
+ */
+template<class Point>
+void remeshingSplitEdge(
+        RemeshingTopology<Point>& topology,
+        const Index& h,
+        const Point& point)
+{
+    std::vector<Index>& V = topology.halfEdgeVertex;
+    std::vector<Index>& T = topology.halfEdgeTwin;
+
+    const Index t = T[h];
+
+    const Index hn = remeshingNext(h);
+    const Index b = V[hn];
+    const Index c = V[remeshingPrev(h)];
+    const Index hnTwin = T[hn];
+
+    //New vertex
+    const Index m = topology.points.size();
+    topology.points.push_back(point);
+    topology.vertexHalfEdge.push_back(NULL_ID);
+    topology.vertexFixed.push_back(false);
+    topology.vertexNonManifold.push_back(false);
+
+    //Face (a,b,c) becomes (a,m,c), new face (m,b,c)
+    const Index g = V.size();
+    V.push_back(m);
+    V.push_back(b);
+    V.push_back(c);
+    T.push_back(NULL_ID);
+    T.push_back(hnTwin);
+    T.push_back(hn);
+    topology.faceDeleted.push_back(false);
+
+    V[hn] = m;
+    T[hn] = g + 2;
+    if (hnTwin != NULL_ID) {
+        T[hnTwin] = g + 1;
+    }
+
+    topology.vertexHalfEdge[m] = g;
+    topology.vertexHalfEdge[b] = g + 1;
+
+    if (t != NULL_ID) {
+        const Index tp = remeshingPrev(t);
+        const Index d = V[tp];
+        const Index tpTwin = T[tp];
+
+        //Face (b,a,d) becomes (m,a,d), new face (b,m,d)
+        const Index k = V.size();
+        V.push_back(b);
+        V.push_back(m);
+        V.push_back(d);
+        T.push_back(g);
+        T.push_back(tp);
+        T.push_back(tpTwin);
+        topology.faceDeleted.push_back(false);
+
+        V[t] = m;
+        T[tp] = k + 1;
+        if (tpTwin != NULL_ID) {
+            T[tpTwin] = k + 2;
+        }
+
+        T[g] = k;
+    }
+}
+
+/**
+ * @brief Collapse an edge, removing the origin of the half-edge. The collapse
+ * is performed only if it satisfies the link condition, it does not create
+ * edges longer than the given length and it does not flip any triangle.
+ * @param topology Topology
+ * @param h Half-edge of the edge
+ * @param point New position of the kept vertex
+ * @param maxLength Max length of the resulting edges
+ * @return True if the edge has been collapsed
+ */
+template<class Point>
+bool remeshingCollapseEdge(
+        RemeshingTopology<Point>& topology,
+        const Index& h,
+        const Point& point,
+        const typename Point::Scalar& maxLength)
+{
+    std::vector<Index>& V = topology.halfEdgeVertex;
+    std::vector<Index>& T = topology.halfEdgeTwin;
+
+    const Index t = T[h];
+
+    const Index a = V[h];
+    const Index b = V[remeshingNext(h)];
+    const Index c = V[remeshingPrev(h)];
+    const Index d = t != NULL_ID ? V[remeshingPrev(t)] : NULL_ID;
+
+    if (topology.vertexNonManifold[c] || (d != NULL_ID && topology.vertexNonManifold[d]))
+        return false;
+
+    //Isolated triangle
+    if (t == NULL_ID && T[remeshingNext(h)] == NULL_ID && T[remeshingPrev(h)] == NULL_ID)
+        return false;
+
+    std::vector<Index> aOutgoing, aNeighbors;
+    std::vector<Index> bOutgoing, bNeighbors;
+    remeshingVertexStar(topology, a, aOutgoing, aNeighbors);
+    remeshingVertexStar(topology, b, bOutgoing, bNeighbors);
+
+    //Link condition
+    Size common = 0;
+    for (const Index& n : aNeighbors) {
+        if (n != b && std::find(bNeighbors.begin(), bNeighbors.end(), n) != bNeighbors.end()) {
+            if (n != c && n != d)
+                return false;
+            ++common;
+        }
+    }
+    if (common != (t != NULL_ID ? 2 : 1))
+        return false;
+
+    //Long edges
+    for (const std::vector<Index>* neighbors : { &aNeighbors, &bNeighbors }) {
+        for (const Index& n : *neighbors) {
+            if (n != a && n != b && (topology.points[n] - point).norm() > maxLength)
+                return false;
+        }
+    }
+
+    //Flipped triangles
+    const Index f0 = h / 3;
+    const Index f1 = t != NULL_ID ? t / 3 : NULL_ID;
+    for (const std::vector<Index>* vOutgoing : { &aOutgoing, &bOutgoing }) {
+        for (const Index& o : *vOutgoing) {
+            const Index fId = o / 3;
+            if (fId == f0 || fId == f1)
+                continue;
+
+            const Point oldNormal = remeshingFaceNormal(topology, fId);
+
+            const Point& p1 = topology.points[V[remeshingNext(o)]];
+            const Point& p2 = topology.points[V[remeshingPrev(o)]];
+            const Point newNormal = (p1 - point).cross(p2 - point);
+
+            if (newNormal.norm() <= 0 || oldNormal.dot(newNormal) <= 0)
+                return false;
+        }
+    }
+
+    //Half-edges to glue
+    const Index hn = remeshingNext(h);
+    const Index hp = remeshingPrev(h);
+    const Index hnTwin = T[hn];
+    const Index hpTwin = T[hp];
+
+    Index tnTwin = NULL_ID;
+    Index tpTwin = NULL_ID;
+    if (t != NULL_ID) {
+        tnTwin = T[remeshingNext(t)];
+        tpTwin = T[remeshingPrev(t)];
+    }
+
+    //Relabel the removed vertex
+    for (const Index& o : aOutgoing) {
+        V[o] = b;
+    }
+
+    if (hnTwin != NULL_ID)
+        T[hnTwin] = hpTwin;
+    if (hpTwin != NULL_ID)
+        T[hpTwin] = hnTwin;
+    if (tnTwin != NULL_ID)
+        T[tnTwin] = tpTwin;
+    if (tpTwin != NULL_ID)
+        T[tpTwin] = tnTwin;
+
+    topology.faceDeleted[f0] = true;
+    if (f1 != NULL_ID)
+        topology.faceDeleted[f1] = true;
+
+    topology.points[b] = point;
+    topology.vertexHalfEdge[a] = NULL_ID;
+
+    //Update the half-edges of the vertices of the deleted faces
+    if (hpTwin != NULL_ID)
+        topology.vertexHalfEdge[b] = hpTwin;
+    else if (hnTwin != NULL_ID)
+        topology.vertexHalfEdge[b] = remeshingNext(hnTwin);
+    else if (tpTwin != NULL_ID)
+        topology.vertexHalfEdge[b] = tpTwin;
+    else if (tnTwin != NULL_ID)
+        topology.vertexHalfEdge[b] = remeshingNext(tnTwin);
+    else
+        topology.vertexHalfEdge[b] = NULL_ID;
+
+    if (hnTwin != NULL_ID)
+        topology.vertexHalfEdge[c] = hnTwin;
+    else if (hpTwin != NULL_ID)
+        topology.vertexHalfEdge[c] = remeshingNext(hpTwin);
+    else
+        topology.vertexHalfEdge[c] = NULL_ID;
+
+    if (d != NULL_ID) {
+        if (tnTwin != NULL_ID)
+            topology.vertexHalfEdge[d] = tnTwin;
+        else if (tpTwin != NULL_ID)
+            topology.vertexHalfEdge[d] = remeshingNext(tpTwin);
+        else
+            topology.vertexHalfEdge[d] = NULL_ID;
+    }
+
+    return true;
+}
+
+/**
+ * @brief Flip an internal edge if it reduces the deviation of the valences
+ * of the four vertices from the optimal ones (6 inside, 4 on the borders)
+ * and it does not flip any triangle
+ * @param topology Topology
+ * @param h Half-edge of the edge
+ * @return True if the edge has been flipped
+ */
+template<class Point>
+bool remeshingFlipEdge(
+        RemeshingTopology<Point>& topology,
+        const Index& h)
+{
+    typedef typename Point::Scalar Scalar;
+
+    std::vector<Index>& V = topology.halfEdgeVertex;
+    std::vector<Index>& T = topology.halfEdgeTwin;
+
+    const Index t = T[h];
+    assert(t != NULL_ID);
+
+    const Index hn = remeshingNext(h);
+    const Index hp = remeshingPrev(h);
+    const Index tn = remeshingNext(t);
+    const Index tp = remeshingPrev(t);
+
+    const Index a = V[h];
+    const Index b = V[hn];
+    const Index c = V[hp];
+    const Index d = V[tp];
+
+    if (c == d)
+        return false;
+
+    if (topology.vertexNonManifold[a] || topology.vertexNonManifold[b] ||
+            topology.vertexNonManifold[c] || topology.vertexNonManifold[d])
+        return false;
+
+    //Valences
+    std::vector<Index> outgoing, neighbors;
+
+    const std::array<Index, 4> vertices = { a, b, c, d };
+    std::array<long long int, 4> deviations;
+    Scalar deviationBefore = 0;
+    Scalar deviationAfter = 0;
+    for (Index i = 0; i < 4; ++i) {
+        const bool border = remeshingVertexStar(topology, vertices[i], outgoing, neighbors);
+        const long long int valence = static_cast<long long int>(neighbors.size());
+        const long long int target = border ? 4 : 6;
+
+        //Edge c-d already exists
+        if (i == 2 && std::find(neighbors.begin(), neighbors.end(), d) != neighbors.end())
+            return false;
+
+        deviations[i] = valence - target;
+    }
+
+    deviationBefore =
+            std::abs(deviations[0]) + std::abs(deviations[1]) +
+            std::abs(deviations[2]) + std::abs(deviations[3]);
+    deviationAfter =
+            std::abs(deviations[0] - 1) + std::abs(deviations[1] - 1) +
+            std::abs(deviations[2] + 1) + std::abs(deviations[3] + 1);
+
+    if (deviationAfter >= deviationBefore)
+        return false;
+
+    //Flipped triangles
+    const Point& pa = topology.points[a];
+    const Point& pb = topology.points[b];
+    const Point& pc = topology.points[c];
+    const Point& pd = topology.points[d];
+
+    const Point oldNormal = (pb - pa).cross(pc - pa) + (pa - pb).cross(pd - pb);
+    const Point newNormal1 = (pb - pd).cross(pc - pd);
+    const Point newNormal2 = (pa - pc).cross(pd - pc);
+
+    if (newNormal1.norm() <= 0 || newNormal2.norm() <= 0)
+        return false;
+    if (oldNormal.dot(newNormal1) <= 0 || oldNormal.dot(newNormal2) <= 0)
+        return false;
+
+    const Index hnTwin = T[hn];
+    const Index hpTwin = T[hp];
+    const Index tnTwin = T[tn];
+    const Index tpTwin = T[tp];
+
+    //Face (a,b,c) becomes (c,d,b), face (b,a,d) becomes (d,c,a)
+    V[h] = c;
+    V[hn] = d;
+    V[hp] = b;
+    V[t] = d;
+    V[tn] = c;
+    V[tp] = a;
+
+    T[hn] = tpTwin;
+    T[hp] = hnTwin;
+    T[tn] = hpTwin;
+    T[tp] = tnTwin;
+
+    if (tpTwin != NULL_ID)
+        T[tpTwin] = hn;
+    if (hnTwin != NULL_ID)
+        T[hnTwin] = hp;
+    if (hpTwin != NULL_ID)
+        T[hpTwin] = tn;
+    if (tnTwin != NULL_ID)
+        T[tnTwin] = tp;
+
+    topology.vertexHalfEdge[a] = tp;
+    topology.vertexHalfEdge[b] = hp;
+    topology.vertexHalfEdge[c] = h;
+    topology.vertexHalfEdge[d] = t;
+
+    return true;
+}
+
+}
+
 }
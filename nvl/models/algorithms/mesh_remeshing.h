@@ -9,6 +9,27 @@
 
 #include <nvl/nuvolib.h>
 
+#include <vector>
+
+namespace nvl {
+
+template<class Mesh>
+Mesh meshIsotropicRemeshing(
+        const Mesh& mesh,
+        const double& edgeSize,
+        const unsigned int& iterations,
+        const bool& fixBorders);
+
+template<class Mesh>
+Mesh meshIsotropicRemeshing(
+        const Mesh& mesh,
+        const double& edgeSize,
+        const unsigned int& iterations,
+        const bool& fixBorders,
+        std::vector<typename Mesh::VertexId>& birthVertex);
+
+}
+
 #ifdef NVL_VCGLIB_LOADED
 
 namespace nvl {
@@ -8,8 +8,28 @@
 
 #include <nvl/models/algorithms/mesh_adjacencies.h>
 
+#include <algorithm>
+
 namespace nvl {
 
+namespace internal {
+
+template<class VertexId>
+Index meshSplitFindEdge(
+        const std::vector<std::pair<VertexId, VertexId>>& edges,
+        const std::vector<Index>& vertexOffsets,
+        const VertexId& vertex1,
+        const VertexId& vertex2);
+
+template<class VertexId>
+void meshSplitPolygons(
+        std::vector<std::vector<VertexId>>& polygons,
+        const VertexId& vertex1,
+        const VertexId& vertex2,
+        const VertexId& newVertexId);
+
+}
+
 /**
  * @brief Split an edge of a mesh
  * @param mesh Mesh
@@ -125,4 +145,318 @@ typename Mesh::VertexId meshSplitEdge(
     return newVertexId;
 }
 
+/**
+ * @brief Split a set of edges of a mesh in a single pass. Splits on the same
+ * edge are merged (the point of the first one is used), and each face is split
+ * as it would be by calling meshSplitEdge for each of its edges, following the
+ * order of its vertices. The new vertices and faces are allocated once, and the
+ * faces are rewritten in parallel.
+ * @param mesh Mesh
+ * @param edges Vertex ids of the edges to split
+ * @param newVertexPoints Point where to split each edge
+ * @return New vertex id for each split, NULL_ID if the edge is not in the mesh
+ */
+template<class Mesh>
+std::vector<typename Mesh::VertexId> meshSplitEdges(
+        Mesh& mesh,
+        const std::vector<std::pair<typename Mesh::VertexId, typename Mesh::VertexId>>& edges,
+        const std::vector<typename Mesh::Point>& newVertexPoints)
+{
+    std::vector<typename Mesh::VertexId> birthVertex;
+    std::vector<typename Mesh::FaceId> birthFace;
+    return meshSplitEdges(mesh, edges, newVertexPoints, birthVertex, birthFace);
+}
+
+/**
+ * @brief Split a set of edges of a mesh in a single pass. Splits on the same
+ * edge are merged (the point of the first one is used), and each face is split
+ * as it would be by calling meshSplitEdge for each of its edges, following the
+ * order of its vertices. The new vertices and faces are allocated once, and the
+ * faces are rewritten in parallel.
+ * @param mesh Mesh
+ * @param edges Vertex ids of the edges to split
+ * @param newVertexPoints Point where to split each edge
+ * @param birthVertex Birth vertex of the resulting mesh (NULL_ID for new vertices)
+ * @param birthFace Birth face of the resulting mesh
+ * @return New vertex id for each split, NULL_ID if the edge is not in the mesh
+ */
+template<class Mesh>
+std::vector<typename Mesh::VertexId> meshSplitEdges(
+        Mesh& mesh,
+        const std::vector<std::pair<typename Mesh::VertexId, typename Mesh::VertexId>>& edges,
+        const std::vector<typename Mesh::Point>& newVertexPoints,
+        std::vector<typename Mesh::VertexId>& birthVertex,
+        std::vector<typename Mesh::FaceId>& birthFace)
+{
+    typedef typename Mesh::VertexId VertexId;
+    typedef typename Mesh::FaceId FaceId;
+    typedef typename Mesh::Face Face;
+    typedef std::pair<VertexId, VertexId> Edge;
+    typedef std::pair<Edge, Index> EdgeKey;
+
+    assert(edges.size() == newVertexPoints.size());
+
+    const Size vertexNumber = mesh.nextVertexId();
+    const Size faceNumber = mesh.nextFaceId();
+
+    std::vector<VertexId> splitVertices(edges.size(), NULL_ID);
+
+    //Merge the splits on the same edge
+    std::vector<EdgeKey> edgeKeys(edges.size());
+
+    #pragma omp parallel for
+    for (Index i = 0; i < edges.size(); ++i) {
+        const VertexId& v1 = edges[i].first;
+        const VertexId& v2 = edges[i].second;
+        edgeKeys[i] = std::make_pair(std::make_pair(std::min(v1, v2), std::max(v1, v2)), i);
+    }
+
+    std::sort(edgeKeys.begin(), edgeKeys.end());
+
+    std::vector<Edge> uniqueEdges;
+    std::vector<Index> uniqueEdgeSplit;
+    std::vector<Index> splitUniqueEdge(edges.size());
+    for (Index i = 0; i < edgeKeys.size(); ++i) {
+        if (i == 0 || edgeKeys[i].first != edgeKeys[i - 1].first) {
+            uniqueEdges.push_back(edgeKeys[i].first);
+            uniqueEdgeSplit.push_back(edgeKeys[i].second);
+        }
+        splitUniqueEdge[edgeKeys[i].second] = uniqueEdges.size() - 1;
+    }
+
+    edgeKeys.clear();
+
+    //Bucket the edges by their smallest vertex
+    std::vector<Index> vertexOffsets(vertexNumber + 1, 0);
+    for (const Edge& edge : uniqueEdges) {
+        if (edge.first < vertexNumber) {
+            vertexOffsets[edge.first + 1]++;
+        }
+    }
+    for (Index i = 0; i < vertexNumber; ++i) {
+        vertexOffsets[i + 1] += vertexOffsets[i];
+    }
+
+    //Find the faces to split
+    std::vector<Size> faceSplitNumber(faceNumber, 0);
+
+    #pragma omp parallel for
+    for (FaceId fId = 0; fId < faceNumber; ++fId) {
+        if (mesh.isFaceDeleted(fId))
+            continue;
+
+        const Face& face = mesh.face(fId);
+        for (Index pos = 0; pos < face.vertexNumber(); ++pos) {
+            const VertexId& v1 = face.vertexId(pos);
+            const VertexId& v2 = face.nextVertexId(pos);
+            if (internal::meshSplitFindEdge(uniqueEdges, vertexOffsets, v1, v2) != NULL_ID) {
+                faceSplitNumber[fId]++;
+            }
+        }
+    }
+
+    std::vector<FaceId> splitFaces;
+    for (FaceId fId = 0; fId < faceNumber; ++fId) {
+        if (faceSplitNumber[fId] > 0) {
+            splitFaces.push_back(fId);
+        }
+    }
+
+    //Allocate the new vertices, only for the edges found in the mesh
+    std::vector<VertexId> uniqueEdgeVertex(uniqueEdges.size(), NULL_ID);
+    for (const FaceId& fId : splitFaces) {
+        const Face& face = mesh.face(fId);
+        for (Index pos = 0; pos < face.vertexNumber(); ++pos) {
+            const VertexId& v1 = face.vertexId(pos);
+            const VertexId& v2 = face.nextVertexId(pos);
+
+            const Index u = internal::meshSplitFindEdge(uniqueEdges, vertexOffsets, v1, v2);
+            if (u != NULL_ID) {
+                uniqueEdgeVertex[u] = 0;
+            }
+        }
+    }
+
+    Size newVertexNumber = 0;
+    for (Index u = 0; u < uniqueEdges.size(); ++u) {
+        if (uniqueEdgeVertex[u] != NULL_ID) {
+            uniqueEdgeVertex[u] = vertexNumber + newVertexNumber;
+            newVertexNumber++;
+        }
+    }
+
+    if (newVertexNumber > 0) {
+        VertexId firstVertexId = mesh.allocateVertices(newVertexNumber);
+        assert(firstVertexId == vertexNumber);
+        NVL_SUPPRESS_UNUSEDVARIABLE(firstVertexId);
+    }
+
+    #pragma omp parallel for
+    for (Index u = 0; u < uniqueEdges.size(); ++u) {
+        if (uniqueEdgeVertex[u] != NULL_ID) {
+            mesh.setVertexPoint(uniqueEdgeVertex[u], newVertexPoints[uniqueEdgeSplit[u]]);
+        }
+    }
+
+    #pragma omp parallel for
+    for (Index i = 0; i < edges.size(); ++i) {
+        splitVertices[i] = uniqueEdgeVertex[splitUniqueEdge[i]];
+    }
+
+    //Split the faces locally
+    std::vector<std::vector<std::vector<VertexId>>> splitPolygons(splitFaces.size());
+
+    #pragma omp parallel for
+    for (Index i = 0; i < splitFaces.size(); ++i) {
+        const Face& face = mesh.face(splitFaces[i]);
+
+        std::vector<std::vector<VertexId>>& polygons = splitPolygons[i];
+        polygons.reserve(2 * faceSplitNumber[splitFaces[i]] + 1);
+        polygons.push_back(std::vector<VertexId>(face.vertexIds().begin(), face.vertexIds().end()));
+
+        for (Index pos = 0; pos < face.vertexNumber(); ++pos) {
+            const VertexId& v1 = face.vertexId(pos);
+            const VertexId& v2 = face.nextVertexId(pos);
+
+            const Index u = internal::meshSplitFindEdge(uniqueEdges, vertexOffsets, v1, v2);
+            if (u != NULL_ID) {
+                internal::meshSplitPolygons(polygons, v1, v2, uniqueEdgeVertex[u]);
+            }
+        }
+    }
+
+    //Allocate the new faces
+    std::vector<Index> faceOffsets(splitFaces.size() + 1, 0);
+    for (Index i = 0; i < splitFaces.size(); ++i) {
+        faceOffsets[i + 1] = faceOffsets[i] + splitPolygons[i].size() - 1;
+    }
+
+    const Size newFaceNumber = faceOffsets[splitFaces.size()];
+    if (newFaceNumber > 0) {
+        FaceId firstFaceId = mesh.allocateFaces(newFaceNumber);
+        assert(firstFaceId == faceNumber);
+        NVL_SUPPRESS_UNUSEDVARIABLE(firstFaceId);
+    }
+
+    birthVertex.resize(mesh.nextVertexId());
+    birthFace.resize(mesh.nextFaceId());
+
+    #pragma omp parallel for
+    for (VertexId vId = 0; vId < birthVertex.size(); ++vId) {
+        birthVertex[vId] = vId < vertexNumber ? vId : NULL_ID;
+    }
+
+    #pragma omp parallel for
+    for (FaceId fId = 0; fId < faceNumber; ++fId) {
+        birthFace[fId] = fId;
+    }
+
+    //Rewrite the faces
+    #pragma omp parallel for
+    for (Index i = 0; i < splitFaces.size(); ++i) {
+        const FaceId& fId = splitFaces[i];
+        const std::vector<std::vector<VertexId>>& polygons = splitPolygons[i];
+
+        mesh.setFaceVertexIds(fId, polygons[0]);
+
+        for (Index j = 1; j < polygons.size(); ++j) {
+            const FaceId newFaceId = faceNumber + faceOffsets[i] + j - 1;
+            mesh.setFaceVertexIds(newFaceId, polygons[j]);
+            birthFace[newFaceId] = fId;
+        }
+    }
+
+    return splitVertices;
+}
+
+namespace internal {
+
+/**
+ * @brief Find an edge in a sorted set of edges, bucketed by their smallest vertex
+ * @param edges Edges, sorted and with the smallest vertex as first
+ * @param vertexOffsets Offset of the edges of each vertex
+ * @param vertex1 First vertex id of the edge
+ * @param vertex2 Second vertex id of the edge
+ * @return Index of the edge, NULL_ID if it is not found
+ */
+template<class VertexId>
+Index meshSplitFindEdge(
+        const std::vector<std::pair<VertexId, VertexId>>& edges,
+        const std::vector<Index>& vertexOffsets,
+        const VertexId& vertex1,
+        const VertexId& vertex2)
+{
+    const VertexId minId = std::min(vertex1, vertex2);
+    const VertexId maxId = std::max(vertex1, vertex2);
+
+    for (Index i = vertexOffsets[minId]; i < vertexOffsets[minId + 1]; ++i) {
+        if (edges[i].second == maxId)
+            return i;
+    }
+
+    return NULL_ID;
+}
+
+/**
+ * @brief Split the edge of a set of polygons, resulting from the split of a face,
+ * in the same way as meshSplitEdge does
+ * @param polygons Polygons
+ * @param vertex1 First vertex id of the edge
+ * @param vertex2 Second vertex id of the edge
+ * @param newVertexId New vertex id
+ */
+template<class VertexId>
+void meshSplitPolygons(
+        std::vector<std::vector<VertexId>>& polygons,
+        const VertexId& vertex1,
+        const VertexId& vertex2,
+        const VertexId& newVertexId)
+{
+    for (Index i = 0; i < polygons.size(); ++i) {
+        const Size vertexNumber = polygons[i].size();
+
+        for (Index pos = 0; pos < vertexNumber; ++pos) {
+            const VertexId v1 = polygons[i][pos];
+            const VertexId v2 = polygons[i][(pos + 1) % vertexNumber];
+            if (!((v1 == vertex1 && v2 == vertex2) || (v2 == vertex1 && v1 == vertex2)))
+                continue;
+
+            const std::vector<VertexId> polygon = std::move(polygons[i]);
+
+            std::vector<VertexId> faceVertices1(3);
+            Index pos1 = (pos + 1) % vertexNumber;
+            faceVertices1[0] = newVertexId;
+            faceVertices1[1] = polygon[pos1];
+            faceVertices1[2] = polygon[(pos1 + 1) % vertexNumber];
+
+            std::vector<VertexId> faceVertices2(3);
+            Index pos2 = pos > 0 ? pos - 1 : vertexNumber - 1;
+            faceVertices2[0] = newVertexId;
+            faceVertices2[1] = polygon[pos2];
+            faceVertices2[2] = polygon[(pos2 + 1) % vertexNumber];
+
+            std::vector<VertexId> faceVertices3(vertexNumber - 1);
+            faceVertices3[0] = newVertexId;
+            for (Index j = 1; j < vertexNumber - 1; j++) {
+                Index pos3 = (pos + 1 + j) % vertexNumber;
+                faceVertices3[j] = polygon[pos3];
+            }
+
+            if (faceVertices3.size() < 3) {
+                polygons[i] = faceVertices2;
+                polygons.push_back(faceVertices1);
+            }
+            else {
+                polygons[i] = faceVertices3;
+                polygons.push_back(faceVertices1);
+                polygons.push_back(faceVertices2);
+            }
+
+            return;
+        }
+    }
+}
+
+}
+
 }
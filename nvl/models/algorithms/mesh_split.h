@@ -10,6 +10,7 @@
 #include <nvl/nuvolib.h>
 
 #include <vector>
+#include <utility>
 
 namespace nvl {
 
@@ -28,6 +29,20 @@ typename Mesh::VertexId meshSplitEdge(
         const typename Mesh::Point& newVertexPoint,
         std::vector<std::vector<typename Mesh::FaceId>>& vfAdj);
 
+template<class Mesh>
+std::vector<typename Mesh::VertexId> meshSplitEdges(
+        Mesh& mesh,
+        const std::vector<std::pair<typename Mesh::VertexId, typename Mesh::VertexId>>& edges,
+        const std::vector<typename Mesh::Point>& newVertexPoints);
+
+template<class Mesh>
+std::vector<typename Mesh::VertexId> meshSplitEdges(
+        Mesh& mesh,
+        const std::vector<std::pair<typename Mesh::VertexId, typename Mesh::VertexId>>& edges,
+        const std::vector<typename Mesh::Point>& newVertexPoints,
+        std::vector<typename Mesh::VertexId>& birthVertex,
+        std::vector<typename Mesh::FaceId>& birthFace);
+
 }
 
 #include "mesh_split.cpp"
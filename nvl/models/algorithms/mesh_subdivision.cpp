@@ -12,6 +12,14 @@
 
 #include <nvl/models/algorithms/mesh_geometric_information.h>
 
+#include <nvl/math/constants.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <tuple>
+#include <utility>
+
 namespace nvl {
 
 /**
@@ -108,4 +116,724 @@ std::vector<typename Mesh::FaceId> meshSubdivideInBarycenterWithTriangles(
     return resultingFaces;
 }
 
+#ifdef NVL_EIGEN_LOADED
+
+namespace internal {
+
+struct SubdivisionTopology {
+    std::vector<std::pair<Index, Index>> edgeVertices;
+    std::vector<std::array<Index, 2>> edgeFaces;
+    std::vector<Size> edgeFaceNumber;
+    std::vector<std::vector<Index>> faceEdges;
+    std::vector<Index> vertexEdgeOffsets;
+    std::vector<Index> vertexEdges;
+    std::vector<Index> vertexFaceOffsets;
+    std::vector<Index> vertexFaces;
+};
+
+void subdivisionTopology(
+        const Size vertexNumber,
+        const std::vector<std::vector<Index>>& faces,
+        SubdivisionTopology& topology);
+
+template<class Scalar>
+void subdivisionVertexBorderStencil(
+        const SubdivisionTopology& topology,
+        const Index& vId,
+        const Index& row,
+        std::vector<Eigen::Triplet<Scalar>>& triplets);
+
+template<class Mesh>
+void subdivisionInitializeData(
+        const Mesh& mesh,
+        MeshSubdivisionData<Mesh>& precomputedData);
+
+template<class Mesh>
+void loopSubdivisionLevel(
+        MeshSubdivisionData<Mesh>& precomputedData,
+        const Size vertexNumber);
+
+template<class Mesh>
+void catmullClarkSubdivisionLevel(
+        MeshSubdivisionData<Mesh>& precomputedData,
+        const Size vertexNumber);
+
+}
+
+/**
+ * @brief Precompute the stencils of Loop subdivision. The new points are
+ * linear combinations of the points of the input mesh, hence the topology
+ * is computed only once and each level is stored as a sparse matrix.
+ * @param mesh Triangle mesh
+ * @param precomputedData Output data
+ * @param iterations Number of subdivision levels
+ */
+template<class Mesh>
+void meshLoopSubdivisionPrecomputeData(
+        const Mesh& mesh,
+        MeshSubdivisionData<Mesh>& precomputedData,
+        const unsigned int iterations)
+{
+    internal::subdivisionInitializeData(mesh, precomputedData);
+
+    Size vertexNumber = mesh.nextVertexId();
+    for (unsigned int it = 0; it < iterations; ++it) {
+        internal::loopSubdivisionLevel(precomputedData, vertexNumber);
+        vertexNumber = precomputedData.stencils.back().rows();
+    }
+}
+
+/**
+ * @brief Precompute the stencils of Catmull-Clark subdivision. The new points
+ * are linear combinations of the points of the input mesh, hence the topology
+ * is computed only once and each level is stored as a sparse matrix.
+ * @param mesh Polygon mesh
+ * @param precomputedData Output data
+ * @param iterations Number of subdivision levels
+ */
+template<class Mesh>
+void meshCatmullClarkSubdivisionPrecomputeData(
+        const Mesh& mesh,
+        MeshSubdivisionData<Mesh>& precomputedData,
+        const unsigned int iterations)
+{
+    internal::subdivisionInitializeData(mesh, precomputedData);
+
+    Size vertexNumber = mesh.nextVertexId();
+    for (unsigned int it = 0; it < iterations; ++it) {
+        internal::catmullClarkSubdivisionLevel(precomputedData, vertexNumber);
+        vertexNumber = precomputedData.stencils.back().rows();
+    }
+}
+
+/**
+ * @brief Apply the precomputed stencils to per-vertex values (points, normals,
+ * colors, etc.) of the input mesh. Each level is a sparse matrix-vector product,
+ * computed in parallel over the rows.
+ * @param precomputedData Precomputed data
+ * @param values Values for each vertex id of the input mesh
+ * @return Values for each vertex of the subdivided mesh
+ */
+template<class Mesh, class T>
+std::vector<T> meshSubdivisionApply(
+        const MeshSubdivisionData<Mesh>& precomputedData,
+        const std::vector<T>& values)
+{
+    typedef typename Mesh::Scalar Scalar;
+    typedef Eigen::SparseMatrix<Scalar, Eigen::RowMajor> Stencil;
+
+    std::vector<T> result = values;
+
+    for (const Stencil& stencil : precomputedData.stencils) {
+        assert(static_cast<Size>(stencil.cols()) == result.size());
+
+        std::vector<T> levelResult(stencil.rows());
+
+        #pragma omp parallel for
+        for (Index row = 0; row < static_cast<Size>(stencil.rows()); ++row) {
+            typename Stencil::InnerIterator it(stencil, row);
+
+            T value = it.value() * result[it.col()];
+            for (++it; it; ++it) {
+                value += it.value() * result[it.col()];
+            }
+
+            levelResult[row] = value;
+        }
+
+        result = std::move(levelResult);
+    }
+
+    return result;
+}
+
+/**
+ * @brief Create the subdivided mesh from the precomputed data
+ * @param mesh Input mesh
+ * @param precomputedData Precomputed data
+ * @return Subdivided mesh
+ */
+template<class Mesh>
+Mesh meshSubdivide(
+        const Mesh& mesh,
+        const MeshSubdivisionData<Mesh>& precomputedData)
+{
+    typedef typename Mesh::VertexId VertexId;
+    typedef typename Mesh::Point Point;
+
+    Mesh subdividedMesh;
+
+    std::vector<Point> points(mesh.nextVertexId(), Point::Zero());
+    for (VertexId vId = 0; vId < mesh.nextVertexId(); ++vId) {
+        if (!mesh.isVertexDeleted(vId)) {
+            points[vId] = mesh.vertexPoint(vId);
+        }
+    }
+
+    const std::vector<Point> subdividedPoints = meshSubdivisionApply(precomputedData, points);
+
+    for (const Point& point : subdividedPoints) {
+        subdividedMesh.addVertex(point);
+    }
+    for (const std::vector<Index>& face : precomputedData.faces) {
+        subdividedMesh.addFace(face);
+    }
+
+    return subdividedMesh;
+}
+
+/**
+ * @brief Update the points of a subdivided mesh, created by meshSubdivide,
+ * after the points of the input mesh have been changed
+ * @param mesh Input mesh
+ * @param precomputedData Precomputed data
+ * @param subdividedMesh Subdivided mesh
+ */
+template<class Mesh>
+void meshSubdivisionUpdatePoints(
+        const Mesh& mesh,
+        const MeshSubdivisionData<Mesh>& precomputedData,
+        Mesh& subdividedMesh)
+{
+    typedef typename Mesh::VertexId VertexId;
+    typedef typename Mesh::Point Point;
+
+    std::vector<Point> points(mesh.nextVertexId(), Point::Zero());
+
+    #pragma omp parallel for
+    for (VertexId vId = 0; vId < mesh.nextVertexId(); ++vId) {
+        if (!mesh.isVertexDeleted(vId)) {
+            points[vId] = mesh.vertexPoint(vId);
+        }
+    }
+
+    const std::vector<Point> subdividedPoints = meshSubdivisionApply(precomputedData, points);
+    assert(subdividedPoints.size() == subdividedMesh.nextVertexId());
+
+    #pragma omp parallel for
+    for (VertexId vId = 0; vId < subdividedPoints.size(); ++vId) {
+        subdividedMesh.setVertexPoint(vId, subdividedPoints[vId]);
+    }
+}
+
+/**
+ * @brief Loop subdivision
+ * @param mesh Triangle mesh
+ * @param iterations Number of subdivision levels
+ * @return Subdivided mesh
+ */
+template<class Mesh>
+Mesh meshLoopSubdivision(
+        const Mesh& mesh,
+        const unsigned int iterations)
+{
+    std::vector<typename Mesh::VertexId> birthVertex;
+    std::vector<typename Mesh::FaceId> birthFace;
+    return meshLoopSubdivision(mesh, iterations, birthVertex, birthFace);
+}
+
+/**
+ * @brief Loop subdivision
+ * @param mesh Triangle mesh
+ * @param iterations Number of subdivision levels
+ * @param birthVertex Birth vertex of the resulting mesh (NULL_ID for new vertices)
+ * @param birthFace Birth face of the resulting mesh
+ * @return Subdivided mesh
+ */
+template<class Mesh>
+Mesh meshLoopSubdivision(
+        const Mesh& mesh,
+        const unsigned int iterations,
+        std::vector<typename Mesh::VertexId>& birthVertex,
+        std::vector<typename Mesh::FaceId>& birthFace)
+{
+    MeshSubdivisionData<Mesh> precomputedData;
+    meshLoopSubdivisionPrecomputeData(mesh, precomputedData, iterations);
+
+    birthVertex = precomputedData.birthVertex;
+    birthFace = precomputedData.birthFace;
+
+    return meshSubdivide(mesh, precomputedData);
+}
+
+/**
+ * @brief Catmull-Clark subdivision. The resulting faces are quads, so the
+ * mesh type must support polygonal faces.
+ * @param mesh Polygon mesh
+ * @param iterations Number of subdivision levels
+ * @return Subdivided mesh
+ */
+template<class Mesh>
+Mesh meshCatmullClarkSubdivision(
+        const Mesh& mesh,
+        const unsigned int iterations)
+{
+    std::vector<typename Mesh::VertexId> birthVertex;
+    std::vector<typename Mesh::FaceId> birthFace;
+    return meshCatmullClarkSubdivision(mesh, iterations, birthVertex, birthFace);
+}
+
+/**
+ * @brief Catmull-Clark subdivision. The resulting faces are quads, so the
+ * mesh type must support polygonal faces.
+ * @param mesh Polygon mesh
+ * @param iterations Number of subdivision levels
+ * @param birthVertex Birth vertex of the resulting mesh (NULL_ID for new vertices)
+ * @param birthFace Birth face of the resulting mesh
+ * @return Subdivided mesh
+ */
+template<class Mesh>
+Mesh meshCatmullClarkSubdivision(
+        const Mesh& mesh,
+        const unsigned int iterations,
+        std::vector<typename Mesh::VertexId>& birthVertex,
+        std::vector<typename Mesh::FaceId>& birthFace)
+{
+    MeshSubdivisionData<Mesh> precomputedData;
+    meshCatmullClarkSubdivisionPrecomputeData(mesh, precomputedData, iterations);
+
+    birthVertex = precomputedData.birthVertex;
+    birthFace = precomputedData.birthFace;
+
+    return meshSubdivide(mesh, precomputedData);
+}
+
+namespace internal {
+
+/**
+ * @brief Compute the edges of a set of faces, with the incident faces of
+ * each edge and the incident edges and faces of each vertex
+ * @param vertexNumber Number of vertices
+ * @param faces Faces
+ * @param topology Output topology
+ */
+NVL_INLINE void subdivisionTopology(
+        const Size vertexNumber,
+        const std::vector<std::vector<Index>>& faces,
+        SubdivisionTopology& topology)
+{
+    typedef std::tuple<Index, Index, Index, Index> CornerKey;
+
+    //Sort the corners by their edge
+    std::vector<CornerKey> cornerKeys;
+    topology.faceEdges.resize(faces.size());
+    for (Index fId = 0; fId < faces.size(); ++fId) {
+        const std::vector<Index>& face = faces[fId];
+        topology.faceEdges[fId].resize(face.size());
+
+        for (Index j = 0; j < face.size(); ++j) {
+            const Index& v1 = face[j];
+            const Index& v2 = face[(j + 1) % face.size()];
+            cornerKeys.push_back(std::make_tuple(std::min(v1, v2), std::max(v1, v2), fId, j));
+        }
+    }
+
+    std::sort(cornerKeys.begin(), cornerKeys.end());
+
+    topology.edgeVertices.clear();
+    topology.edgeFaces.clear();
+    topology.edgeFaceNumber.clear();
+    for (Index i = 0; i < cornerKeys.size(); ++i) {
+        const Index& fId = std::get<2>(cornerKeys[i]);
+        const Index& pos = std::get<3>(cornerKeys[i]);
+
+        if (i == 0 || std::get<0>(cornerKeys[i]) != std::get<0>(cornerKeys[i - 1]) || std::get<1>(cornerKeys[i]) != std::get<1>(cornerKeys[i - 1])) {
+            topology.edgeVertices.push_back(std::make_pair(std::get<0>(cornerKeys[i]), std::get<1>(cornerKeys[i])));
+            topology.edgeFaces.push_back({ NULL_ID, NULL_ID });
+            topology.edgeFaceNumber.push_back(0);
+        }
+
+        const Index eId = topology.edgeVertices.size() - 1;
+        if (topology.edgeFaceNumber[eId] < 2) {
+            topology.edgeFaces[eId][topology.edgeFaceNumber[eId]] = fId;
+        }
+        topology.edgeFaceNumber[eId]++;
+
+        topology.faceEdges[fId][pos] = eId;
+    }
+
+    //Incident edges of the vertices
+    topology.vertexEdgeOffsets.assign(vertexNumber + 1, 0);
+    for (const std::pair<Index, Index>& edge : topology.edgeVertices) {
+        topology.vertexEdgeOffsets[edge.first + 1]++;
+        topology.vertexEdgeOffsets[edge.second + 1]++;
+    }
+    for (Index vId = 0; vId < vertexNumber; ++vId) {
+        topology.vertexEdgeOffsets[vId + 1] += topology.vertexEdgeOffsets[vId];
+    }
+
+    topology.vertexEdges.resize(topology.vertexEdgeOffsets[vertexNumber]);
+    std::vector<Index> edgePositions(topology.vertexEdgeOffsets.begin(), topology.vertexEdgeOffsets.end() - 1);
+    for (Index eId = 0; eId < topology.edgeVertices.size(); ++eId) {
+        topology.vertexEdges[edgePositions[topology.edgeVertices[eId].first]++] = eId;
+        topology.vertexEdges[edgePositions[topology.edgeVertices[eId].second]++] = eId;
+    }
+
+    //Incident faces of the vertices
+    topology.vertexFaceOffsets.assign(vertexNumber + 1, 0);
+    for (const std::vector<Index>& face : faces) {
+        for (const Index& vId : face) {
+            topology.vertexFaceOffsets[vId + 1]++;
+        }
+    }
+    for (Index vId = 0; vId < vertexNumber; ++vId) {
+        topology.vertexFaceOffsets[vId + 1] += topology.vertexFaceOffsets[vId];
+    }
+
+    topology.vertexFaces.resize(topology.vertexFaceOffsets[vertexNumber]);
+    std::vector<Index> facePositions(topology.vertexFaceOffsets.begin(), topology.vertexFaceOffsets.end() - 1);
+    for (Index fId = 0; fId < faces.size(); ++fId) {
+        for (const Index& vId : faces[fId]) {
+            topology.vertexFaces[facePositions[vId]++] = fId;
+        }
+    }
+}
+
+/**
+ * @brief Stencil of a vertex which is not in the interior of the surface.
+ * Vertices on a manifold border are smoothed along the border, while corners
+ * and non-manifold vertices are kept in their position.
+ * @param topology Topology
+ * @param vId Vertex id
+ * @param row Row of the new vertex in the stencil matrix
+ * @param triplets Output triplets
+ */
+template<class Scalar>
+void subdivisionVertexBorderStencil(
+        const SubdivisionTopology& topology,
+        const Index& vId,
+        const Index& row,
+        std::vector<Eigen::Triplet<Scalar>>& triplets)
+{
+    std::vector<Index> borderNeighbors;
+    bool nonManifold = false;
+    for (Index i = topology.vertexEdgeOffsets[vId]; i < topology.vertexEdgeOffsets[vId + 1]; ++i) {
+        const Index& eId = topology.vertexEdges[i];
+        if (topology.edgeFaceNumber[eId] > 2) {
+            nonManifold = true;
+        }
+        else if (topology.edgeFaceNumber[eId] == 1) {
+            const std::pair<Index, Index>& edge = topology.edgeVertices[eId];
+            borderNeighbors.push_back(edge.first == vId ? edge.second : edge.first);
+        }
+    }
+
+    if (nonManifold || borderNeighbors.size() != 2) {
+        triplets.push_back(Eigen::Triplet<Scalar>(row, vId, 1.0));
+    }
+    else {
+        triplets.push_back(Eigen::Triplet<Scalar>(row, vId, 0.75));
+        triplets.push_back(Eigen::Triplet<Scalar>(row, borderNeighbors[0], 0.125));
+        triplets.push_back(Eigen::Triplet<Scalar>(row, borderNeighbors[1], 0.125));
+    }
+}
+
+/**
+ * @brief Initialize the subdivision data with the topology of the input mesh
+ * @param mesh Input mesh
+ * @param precomputedData Subdivision data
+ */
+template<class Mesh>
+void subdivisionInitializeData(
+        const Mesh& mesh,
+        MeshSubdivisionData<Mesh>& precomputedData)
+{
+    typedef typename Mesh::VertexId VertexId;
+    typedef typename Mesh::FaceId FaceId;
+    typedef typename Mesh::Face Face;
+
+    precomputedData.stencils.clear();
+    precomputedData.faces.clear();
+    precomputedData.birthFace.clear();
+
+    for (FaceId fId = 0; fId < mesh.nextFaceId(); ++fId) {
+        if (mesh.isFaceDeleted(fId))
+            continue;
+
+        const Face& face = mesh.face(fId);
+        precomputedData.faces.push_back(std::vector<Index>(face.vertexIds().begin(), face.vertexIds().end()));
+        precomputedData.birthFace.push_back(fId);
+    }
+
+    precomputedData.birthVertex.resize(mesh.nextVertexId());
+    for (VertexId vId = 0; vId < mesh.nextVertexId(); ++vId) {
+        precomputedData.birthVertex[vId] = vId;
+    }
+}
+
+/**
+ * @brief Compute a level of Loop subdivision: the stencils of the new vertices
+ * (vertex points, then edge points) and the resulting triangles
+ * @param precomputedData Subdivision data, updated with the new level
+ * @param vertexNumber Number of vertices of the current level
+ */
+template<class Mesh>
+void loopSubdivisionLevel(
+        MeshSubdivisionData<Mesh>& precomputedData,
+        const Size vertexNumber)
+{
+    typedef typename Mesh::Scalar Scalar;
+    typedef typename Mesh::VertexId VertexId;
+    typedef typename Mesh::FaceId FaceId;
+    typedef Eigen::Triplet<Scalar> Triplet;
+
+    const std::vector<std::vector<Index>>& faces = precomputedData.faces;
+
+    SubdivisionTopology topology;
+    subdivisionTopology(vertexNumber, faces, topology);
+
+    //Only the vertices of the faces are kept
+    std::vector<Index> vertexMap(vertexNumber, NULL_ID);
+    Size newVertexNumber = 0;
+    for (Index vId = 0; vId < vertexNumber; ++vId) {
+        if (topology.vertexFaceOffsets[vId + 1] > topology.vertexFaceOffsets[vId]) {
+            vertexMap[vId] = newVertexNumber++;
+        }
+    }
+
+    const Size edgeNumber = topology.edgeVertices.size();
+
+    std::vector<Triplet> triplets;
+    triplets.reserve(newVertexNumber * 7 + edgeNumber * 4);
+
+    //Vertex points
+    std::vector<VertexId> birthVertex(newVertexNumber + edgeNumber, NULL_ID);
+    for (Index vId = 0; vId < vertexNumber; ++vId) {
+        if (vertexMap[vId] == NULL_ID)
+            continue;
+
+        const Index& row = vertexMap[vId];
+        birthVertex[row] = precomputedData.birthVertex[vId];
+
+        bool isInterior = true;
+        for (Index i = topology.vertexEdgeOffsets[vId]; i < topology.vertexEdgeOffsets[vId + 1]; ++i) {
+            if (topology.edgeFaceNumber[topology.vertexEdges[i]] != 2) {
+                isInterior = false;
+            }
+        }
+
+        if (isInterior) {
+            const Size n = topology.vertexEdgeOffsets[vId + 1] - topology.vertexEdgeOffsets[vId];
+            const Scalar c = 3.0 / 8.0 + std::cos(2.0 * PI / n) / 4.0;
+            const Scalar beta = (5.0 / 8.0 - c * c) / n;
+
+            triplets.push_back(Triplet(row, vId, 1.0 - n * beta));
+            for (Index i = topology.vertexEdgeOffsets[vId]; i < topology.vertexEdgeOffsets[vId + 1]; ++i) {
+                const std::pair<Index, Index>& edge = topology.edgeVertices[topology.vertexEdges[i]];
+                triplets.push_back(Triplet(row, edge.first == vId ? edge.second : edge.first, beta));
+            }
+        }
+        else {
+            subdivisionVertexBorderStencil(topology, vId, row, triplets);
+        }
+    }
+
+    //Edge points
+    for (Index eId = 0; eId < edgeNumber; ++eId) {
+        const Index row = newVertexNumber + eId;
+        const Index& v1 = topology.edgeVertices[eId].first;
+        const Index& v2 = topology.edgeVertices[eId].second;
+
+        if (topology.edgeFaceNumber[eId] == 2) {
+            triplets.push_back(Triplet(row, v1, 3.0 / 8.0));
+            triplets.push_back(Triplet(row, v2, 3.0 / 8.0));
+
+            for (const Index& fId : topology.edgeFaces[eId]) {
+                for (const Index& vId : faces[fId]) {
+                    if (vId != v1 && vId != v2) {
+                        triplets.push_back(Triplet(row, vId, 1.0 / 8.0));
+                    }
+                }
+            }
+        }
+        else {
+            triplets.push_back(Triplet(row, v1, 0.5));
+            triplets.push_back(Triplet(row, v2, 0.5));
+        }
+    }
+
+    Eigen::SparseMatrix<Scalar, Eigen::RowMajor> stencil(newVertexNumber + edgeNumber, vertexNumber);
+    stencil.setFromTriplets(triplets.begin(), triplets.end());
+
+    //Resulting triangles
+    std::vector<std::vector<Index>> newFaces(faces.size() * 4, std::vector<Index>(3));
+    std::vector<FaceId> birthFace(faces.size() * 4);
+
+    #pragma omp parallel for
+    for (Index fId = 0; fId < faces.size(); ++fId) {
+        const std::vector<Index>& face = faces[fId];
+        assert(face.size() == 3);
+
+        const Index a = vertexMap[face[0]];
+        const Index b = vertexMap[face[1]];
+        const Index c = vertexMap[face[2]];
+        const Index ab = newVertexNumber + topology.faceEdges[fId][0];
+        const Index bc = newVertexNumber + topology.faceEdges[fId][1];
+        const Index ca = newVertexNumber + topology.faceEdges[fId][2];
+
+        newFaces[4 * fId] = { a, ab, ca };
+        newFaces[4 * fId + 1] = { ab, b, bc };
+        newFaces[4 * fId + 2] = { ca, bc, c };
+        newFaces[4 * fId + 3] = { ab, bc, ca };
+
+        for (Index j = 0; j < 4; ++j) {
+            birthFace[4 * fId + j] = precomputedData.birthFace[fId];
+        }
+    }
+
+    precomputedData.stencils.push_back(std::move(stencil));
+    precomputedData.faces = std::move(newFaces);
+    precomputedData.birthVertex = std::move(birthVertex);
+    precomputedData.birthFace = std::move(birthFace);
+}
+
+/**
+ * @brief Compute a level of Catmull-Clark subdivision: the stencils of the new
+ * vertices (vertex points, then edge points, then face points) and the resulting quads
+ * @param precomputedData Subdivision data, updated with the new level
+ * @param vertexNumber Number of vertices of the current level
+ */
+template<class Mesh>
+void catmullClarkSubdivisionLevel(
+        MeshSubdivisionData<Mesh>& precomputedData,
+        const Size vertexNumber)
+{
+    typedef typename Mesh::Scalar Scalar;
+    typedef typename Mesh::VertexId VertexId;
+    typedef typename Mesh::FaceId FaceId;
+    typedef Eigen::Triplet<Scalar> Triplet;
+
+    const std::vector<std::vector<Index>>& faces = precomputedData.faces;
+
+    SubdivisionTopology topology;
+    subdivisionTopology(vertexNumber, faces, topology);
+
+    //Only the vertices of the faces are kept
+    std::vector<Index> vertexMap(vertexNumber, NULL_ID);
+    Size newVertexNumber = 0;
+    for (Index vId = 0; vId < vertexNumber; ++vId) {
+        if (topology.vertexFaceOffsets[vId + 1] > topology.vertexFaceOffsets[vId]) {
+            vertexMap[vId] = newVertexNumber++;
+        }
+    }
+
+    const Size edgeNumber = topology.edgeVertices.size();
+    const Size faceNumber = faces.size();
+    const Index edgeOffset = newVertexNumber;
+    const Index faceOffset = newVertexNumber + edgeNumber;
+
+    std::vector<Triplet> triplets;
+    triplets.reserve(newVertexNumber * 17 + edgeNumber * 10 + faceNumber * 4);
+
+    //Vertex points
+    std::vector<VertexId> birthVertex(newVertexNumber + edgeNumber + faceNumber, NULL_ID);
+    for (Index vId = 0; vId < vertexNumber; ++vId) {
+        if (vertexMap[vId] == NULL_ID)
+            continue;
+
+        const Index& row = vertexMap[vId];
+        birthVertex[row] = precomputedData.birthVertex[vId];
+
+        bool isInterior = true;
+        for (Index i = topology.vertexEdgeOffsets[vId]; i < topology.vertexEdgeOffsets[vId + 1]; ++i) {
+            if (topology.edgeFaceNumber[topology.vertexEdges[i]] != 2) {
+                isInterior = false;
+            }
+        }
+
+        if (isInterior) {
+            //(F + 2R + (n - 3)P) / n, F average of the face points, R average of the edge midpoints
+            const Scalar n = topology.vertexEdgeOffsets[vId + 1] - topology.vertexEdgeOffsets[vId];
+            const Scalar m = topology.vertexFaceOffsets[vId + 1] - topology.vertexFaceOffsets[vId];
+
+            triplets.push_back(Triplet(row, vId, (n - 3.0) / n));
+
+            for (Index i = topology.vertexEdgeOffsets[vId]; i < topology.vertexEdgeOffsets[vId + 1]; ++i) {
+                const std::pair<Index, Index>& edge = topology.edgeVertices[topology.vertexEdges[i]];
+                triplets.push_back(Triplet(row, edge.first, 1.0 / (n * n)));
+                triplets.push_back(Triplet(row, edge.second, 1.0 / (n * n)));
+            }
+
+            for (Index i = topology.vertexFaceOffsets[vId]; i < topology.vertexFaceOffsets[vId + 1]; ++i) {
+                const std::vector<Index>& face = faces[topology.vertexFaces[i]];
+                for (const Index& fvId : face) {
+                    triplets.push_back(Triplet(row, fvId, 1.0 / (n * m * face.size())));
+                }
+            }
+        }
+        else {
+            subdivisionVertexBorderStencil(topology, vId, row, triplets);
+        }
+    }
+
+    //Edge points
+    for (Index eId = 0; eId < edgeNumber; ++eId) {
+        const Index row = edgeOffset + eId;
+        const Index& v1 = topology.edgeVertices[eId].first;
+        const Index& v2 = topology.edgeVertices[eId].second;
+
+        if (topology.edgeFaceNumber[eId] == 2) {
+            triplets.push_back(Triplet(row, v1, 0.25));
+            triplets.push_back(Triplet(row, v2, 0.25));
+
+            for (const Index& fId : topology.edgeFaces[eId]) {
+                for (const Index& vId : faces[fId]) {
+                    triplets.push_back(Triplet(row, vId, 0.25 / faces[fId].size()));
+                }
+            }
+        }
+        else {
+            triplets.push_back(Triplet(row, v1, 0.5));
+            triplets.push_back(Triplet(row, v2, 0.5));
+        }
+    }
+
+    //Face points
+    for (Index fId = 0; fId < faceNumber; ++fId) {
+        const Index row = faceOffset + fId;
+        for (const Index& vId : faces[fId]) {
+            triplets.push_back(Triplet(row, vId, 1.0 / faces[fId].size()));
+        }
+    }
+
+    Eigen::SparseMatrix<Scalar, Eigen::RowMajor> stencil(newVertexNumber + edgeNumber + faceNumber, vertexNumber);
+    stencil.setFromTriplets(triplets.begin(), triplets.end());
+
+    //Resulting quads
+    std::vector<Index> faceQuadOffsets(faceNumber + 1, 0);
+    for (Index fId = 0; fId < faceNumber; ++fId) {
+        faceQuadOffsets[fId + 1] = faceQuadOffsets[fId] + faces[fId].size();
+    }
+
+    std::vector<std::vector<Index>> newFaces(faceQuadOffsets[faceNumber], std::vector<Index>(4));
+    std::vector<FaceId> birthFace(faceQuadOffsets[faceNumber]);
+
+    #pragma omp parallel for
+    for (Index fId = 0; fId < faceNumber; ++fId) {
+        const std::vector<Index>& face = faces[fId];
+        const Size k = face.size();
+
+        for (Index j = 0; j < k; ++j) {
+            const Index quadId = faceQuadOffsets[fId] + j;
+
+            newFaces[quadId] = {
+                vertexMap[face[j]],
+                edgeOffset + topology.faceEdges[fId][j],
+                faceOffset + fId,
+                edgeOffset + topology.faceEdges[fId][(j + k - 1) % k]
+            };
+            birthFace[quadId] = precomputedData.birthFace[fId];
+        }
+    }
+
+    precomputedData.stencils.push_back(std::move(stencil));
+    precomputedData.faces = std::move(newFaces);
+    precomputedData.birthVertex = std::move(birthVertex);
+    precomputedData.birthFace = std::move(birthFace);
+}
+
+}
+
+#endif
+
 }
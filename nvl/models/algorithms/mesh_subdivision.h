@@ -11,6 +11,10 @@
 
 #include <vector>
 
+#ifdef NVL_EIGEN_LOADED
+#include <Eigen/Sparse>
+#endif
+
 namespace nvl {
 
 template<class Mesh>
@@ -25,6 +29,73 @@ std::vector<typename Mesh::FaceId> meshSubdivideInBarycenterWithTriangles(
         Mesh& mesh,
         const typename Mesh::FaceId& fId);
 
+#ifdef NVL_EIGEN_LOADED
+
+template<class Mesh>
+struct MeshSubdivisionData {
+    typedef typename Mesh::Scalar Scalar;
+
+    std::vector<Eigen::SparseMatrix<Scalar, Eigen::RowMajor>> stencils;
+    std::vector<std::vector<Index>> faces;
+
+    std::vector<typename Mesh::VertexId> birthVertex;
+    std::vector<typename Mesh::FaceId> birthFace;
+};
+
+template<class Mesh>
+void meshLoopSubdivisionPrecomputeData(
+        const Mesh& mesh,
+        MeshSubdivisionData<Mesh>& precomputedData,
+        const unsigned int iterations = 1);
+
+template<class Mesh>
+void meshCatmullClarkSubdivisionPrecomputeData(
+        const Mesh& mesh,
+        MeshSubdivisionData<Mesh>& precomputedData,
+        const unsigned int iterations = 1);
+
+template<class Mesh, class T>
+std::vector<T> meshSubdivisionApply(
+        const MeshSubdivisionData<Mesh>& precomputedData,
+        const std::vector<T>& values);
+
+template<class Mesh>
+Mesh meshSubdivide(
+        const Mesh& mesh,
+        const MeshSubdivisionData<Mesh>& precomputedData);
+
+template<class Mesh>
+void meshSubdivisionUpdatePoints(
+        const Mesh& mesh,
+        const MeshSubdivisionData<Mesh>& precomputedData,
+        Mesh& subdividedMesh);
+
+template<class Mesh>
+Mesh meshLoopSubdivision(
+        const Mesh& mesh,
+        const unsigned int iterations = 1);
+
+template<class Mesh>
+Mesh meshLoopSubdivision(
+        const Mesh& mesh,
+        const unsigned int iterations,
+        std::vector<typename Mesh::VertexId>& birthVertex,
+        std::vector<typename Mesh::FaceId>& birthFace);
+
+template<class Mesh>
+Mesh meshCatmullClarkSubdivision(
+        const Mesh& mesh,
+        const unsigned int iterations = 1);
+
+template<class Mesh>
+Mesh meshCatmullClarkSubdivision(
+        const Mesh& mesh,
+        const unsigned int iterations,
+        std::vector<typename Mesh::VertexId>& birthVertex,
+        std::vector<typename Mesh::FaceId>& birthFace);
+
+#endif
+
 }
 
 #include "mesh_subdivision.cpp"
@@ -8,6 +8,13 @@
 
 #include <nvl/models/algorithms/mesh_transfer.h>
 #include <nvl/models/algorithms/skeleton_transfer.h>
+#include <nvl/models/algorithms/mesh_bvh.h>
+
+#include <nvl/models/structures/skinning_weights_builder.h>
+
+#include <nvl/math/barycentric_interpolation.h>
+
+#include <Eigen/Sparse>
 
 namespace nvl {
 
@@ -38,7 +45,9 @@ void modelTransfer(
 }
 
 /**
- * @brief Transfer skinning weights from a model to another
+ * @brief Transfer skinning weights from a model to another. Only the non-zero
+ * weights of the source vertices are visited, so the non-zero weights of the
+ * source model must be updated. The target vertices are processed in parallel.
  * @param model Model
  * @param birthVertex Birth vertex of the resulting model
  * @param birthJoint Birth joint of the resulting model
@@ -53,26 +62,40 @@ void modelSkinningWeightsTransfer(
 {
     typedef typename Model::Mesh::VertexId VertexId;
     typedef typename Model::Skeleton::JointId JointId;
+    typedef typename Model::SkinningWeights::Scalar Scalar;
+
+    //Joint of the target model for each joint of the source model
+    std::vector<JointId> targetJoint(model.skeleton.jointNumber(), NULL_ID);
+    for (JointId jId = 0; jId < targetModel.skeleton.jointNumber(); ++jId) {
+        if (birthJoint[jId] == NULL_ID)
+            continue;
+
+        targetJoint[birthJoint[jId]] = jId;
+    }
 
-    targetModel.initializeSkinningWeights();
+    SkinningWeightsBuilder<Scalar> builder(targetModel.mesh.nextVertexId(), targetModel.skeleton.jointNumber());
 
+    #pragma omp parallel for
     for (VertexId vId = 0; vId < targetModel.mesh.nextVertexId(); ++vId) {
         if (targetModel.mesh.isVertexDeleted(vId) || birthVertex[vId] == NULL_ID)
             continue;
 
-        for (JointId jId = 0; jId < targetModel.skeleton.jointNumber(); ++jId) {
-            if (birthJoint[jId] == NULL_ID)
+        for (const JointId& sourceJointId : model.skinningWeights.nonZeroWeights(birthVertex[vId])) {
+            if (targetJoint[sourceJointId] == NULL_ID)
                 continue;
 
-            targetModel.skinningWeights.setWeight(vId, jId, model.skinningWeights.weight(birthVertex[vId], birthJoint[jId]));
+            builder.addWeight(vId, targetJoint[sourceJointId], model.skinningWeights.weight(birthVertex[vId], sourceJointId));
         }
     }
 
-    targetModel.skinningWeights.updateNonZeros();
+    builder.build(targetModel.skinningWeights);
 }
 
 /**
- * @brief Transfer skinning weights of all vertices from a model to another
+ * @brief Transfer skinning weights of all vertices from a model to another.
+ * Only the non-zero weights of the source vertices are visited, so the
+ * non-zero weights of the source model must be updated. The target vertices
+ * are processed in parallel.
  * @param model Model
  * @param birthVertex Birth vertex of the resulting model
  * @param targetModel Target model
@@ -83,25 +106,30 @@ void modelSkinningWeightsTransferVertices(
         const std::vector<typename Model::Mesh::VertexId>& birthVertex,
         Model& targetModel)
 {
-    typedef typename Model::Mesh::FaceId FaceId;
+    typedef typename Model::Mesh::VertexId VertexId;
     typedef typename Model::Skeleton::JointId JointId;
+    typedef typename Model::SkinningWeights::Scalar Scalar;
 
-    targetModel.initializeSkinningWeights();
+    SkinningWeightsBuilder<Scalar> builder(targetModel.mesh.nextVertexId(), targetModel.skeleton.jointNumber());
 
-    for (FaceId vId = 0; vId < targetModel.mesh.nextVertexId(); ++vId) {
+    #pragma omp parallel for
+    for (VertexId vId = 0; vId < targetModel.mesh.nextVertexId(); ++vId) {
         if (targetModel.mesh.isVertexDeleted(vId) || birthVertex[vId] == NULL_ID)
             continue;
 
-        for (JointId jId = 0; jId < targetModel.skeleton.jointNumber(); ++jId) {
-            targetModel.skinningWeights.setWeight(vId, jId, model.skinningWeights.weight(birthVertex[vId], jId));
+        for (const JointId& jId : model.skinningWeights.nonZeroWeights(birthVertex[vId])) {
+            builder.addWeight(vId, jId, model.skinningWeights.weight(birthVertex[vId], jId));
         }
     }
 
-    targetModel.skinningWeights.updateNonZeros();
+    builder.build(targetModel.skinningWeights);
 }
 
 /**
- * @brief Transfer skinning weights of all skeleton joints from a model to another
+ * @brief Transfer skinning weights of all skeleton joints from a model to
+ * another. Only the non-zero weights of the source vertices are visited, so
+ * the non-zero weights of the source model must be updated. The vertices are
+ * processed in parallel.
  * @param model Model
  * @param birthJoint Birth joint of the resulting model
  * @param targetModel Target model
@@ -112,24 +140,142 @@ void modelSkinningWeightsTransferJoints(
         const std::vector<Index>& birthJoint,
         Model& targetModel)
 {
-    typedef typename Model::Mesh::FaceId FaceId;
+    typedef typename Model::Mesh::VertexId VertexId;
     typedef typename Model::Skeleton::JointId JointId;
+    typedef typename Model::SkinningWeights::Scalar Scalar;
+
+    //Joint of the target model for each joint of the source model
+    std::vector<JointId> targetJoint(model.skeleton.jointNumber(), NULL_ID);
+    for (JointId jId = 0; jId < targetModel.skeleton.jointNumber(); ++jId) {
+        if (birthJoint[jId] == NULL_ID)
+            continue;
 
-    targetModel.initializeSkinningWeights();
+        targetJoint[birthJoint[jId]] = jId;
+    }
+
+    SkinningWeightsBuilder<Scalar> builder(targetModel.mesh.nextVertexId(), targetModel.skeleton.jointNumber());
 
-    for (FaceId vId = 0; vId < targetModel.mesh.nextVertexId(); ++vId) {
+    #pragma omp parallel for
+    for (VertexId vId = 0; vId < targetModel.mesh.nextVertexId(); ++vId) {
         if (targetModel.mesh.isVertexDeleted(vId))
             continue;
 
-        for (JointId jId = 0; jId < targetModel.skeleton.jointNumber(); ++jId) {
-            if (birthJoint[jId] == NULL_ID)
+        for (const JointId& sourceJointId : model.skinningWeights.nonZeroWeights(vId)) {
+            if (targetJoint[sourceJointId] == NULL_ID)
                 continue;
 
-            targetModel.skinningWeights.setWeight(vId, birthJoint[jId], model.skinningWeights.weight(vId, birthJoint(jId)));
+            builder.addWeight(vId, targetJoint[sourceJointId], model.skinningWeights.weight(vId, sourceJointId));
+        }
+    }
+
+    builder.build(targetModel.skinningWeights);
+}
+
+/**
+ * @brief Transfer skinning weights from a model to another by projection: the
+ * weights of each target vertex are interpolated on the closest point of the
+ * source mesh, and then normalized. The models must be in the same space and
+ * have the same skeleton, the non-zero weights of the source model must be
+ * updated.
+ * @param model Model
+ * @param targetModel Target model
+ */
+template<class Model>
+void modelSkinningWeightsTransferClosestPoint(
+        const Model& model,
+        Model& targetModel)
+{
+    modelSkinningWeightsTransferClosestPoint(model, meshFaceBVH(model.mesh), targetModel);
+}
+
+/**
+ * @brief Transfer skinning weights from a model to another by projection: the
+ * weights of each target vertex are interpolated on the closest point of the
+ * source mesh, and then normalized. The models must be in the same space and
+ * have the same skeleton, the non-zero weights of the source model must be
+ * updated. The closest points are queried in a single parallel batch.
+ * @param model Model
+ * @param bvh Face bounding volume hierarchy of the source mesh
+ * @param targetModel Target model
+ */
+template<class Model>
+void modelSkinningWeightsTransferClosestPoint(
+        const Model& model,
+        const BVH<typename Model::Mesh::Scalar, 3>& bvh,
+        Model& targetModel)
+{
+    typedef typename Model::Mesh Mesh;
+    typedef typename Mesh::Point Point;
+    typedef typename Mesh::VertexId VertexId;
+    typedef typename Mesh::FaceId FaceId;
+    typedef typename Mesh::Face Face;
+    typedef typename Model::Skeleton::JointId JointId;
+    typedef typename Model::SkinningWeights::Scalar Scalar;
+    typedef Eigen::SparseVector<Scalar> WeightVector;
+
+    const Mesh& mesh = model.mesh;
+    const Mesh& targetMesh = targetModel.mesh;
+    const Size jointNumber = targetModel.skeleton.jointNumber();
+
+    std::vector<VertexId> vertices;
+    std::vector<Point> points;
+    vertices.reserve(targetMesh.vertexNumber());
+    points.reserve(targetMesh.vertexNumber());
+    for (VertexId vId = 0; vId < targetMesh.nextVertexId(); ++vId) {
+        if (targetMesh.isVertexDeleted(vId))
+            continue;
+
+        vertices.push_back(vId);
+        points.push_back(targetMesh.vertexPoint(vId));
+    }
+
+    std::vector<FaceId> closestFaceIds;
+    const std::vector<Point> closestPoints = meshFaceBVHClosestPoints(mesh, bvh, points, closestFaceIds);
+
+    SkinningWeightsBuilder<Scalar> builder(targetMesh.nextVertexId(), jointNumber);
+
+    #pragma omp parallel for
+    for (Index i = 0; i < vertices.size(); ++i) {
+        if (closestFaceIds[i] == NULL_ID)
+            continue;
+
+        const Face& face = mesh.face(closestFaceIds[i]);
+
+        std::vector<Point> polygon(face.vertexNumber());
+        std::vector<WeightVector> values(face.vertexNumber(), WeightVector(static_cast<EigenId>(jointNumber)));
+        for (Index j = 0; j < face.vertexNumber(); ++j) {
+            const VertexId& faceVertexId = face.vertexId(j);
+
+            polygon[j] = mesh.vertexPoint(faceVertexId);
+            for (const JointId& jId : model.skinningWeights.nonZeroWeights(faceVertexId)) {
+                values[j].insert(static_cast<EigenId>(jId)) = model.skinningWeights.weight(faceVertexId, jId);
+            }
+        }
+
+        WeightVector weights;
+        if (face.vertexNumber() == 3) {
+            weights = barycentricInterpolation(polygon[0], polygon[1], polygon[2], closestPoints[i], values[0], values[1], values[2], true);
+        }
+        else {
+            weights = barycentricInterpolationBarycenterSubdivision(polygon, closestPoints[i], values, true);
+        }
+
+        Scalar sum = 0;
+        for (typename WeightVector::InnerIterator it(weights); it; ++it) {
+            sum += it.value();
+        }
+
+        if (sum <= 0)
+            continue;
+
+        for (typename WeightVector::InnerIterator it(weights); it; ++it) {
+            if (it.value() > 0) {
+                builder.addWeight(vertices[i], static_cast<JointId>(it.index()), it.value() / sum);
+            }
         }
     }
 
-    targetModel.skinningWeights.updateNonZeros();
+    builder.build(targetModel.skinningWeights);
 }
 
 /**
@@ -152,7 +298,8 @@ void modelAnimationTransfer(
 }
 
 /**
- * @brief Transfer animation from a model to another
+ * @brief Transfer animation from a model to another. The frames are
+ * transferred in parallel.
  * @param model Model
  * @param animationId Input animation
  * @param birthJoint Birth joint of the resulting model
@@ -167,16 +314,21 @@ void modelAnimationTransfer(
 {
     typedef typename Model::Animation Animation;
     typedef typename Model::Animation::Frame AnimationFrame;
+    typedef typename Model::Animation::FrameId FrameId;
 
     const Animation& animation = model.animation(animationId);
     Animation newAnimation;
 
     newAnimation.setName(animation.name());
 
-    for (const AnimationFrame& frame : animation.keyframes()) {
-        AnimationFrame newFrame;
-        modelAnimationFrameTransfer(model, frame, birthJoint, targetModel, newFrame);
-        newAnimation.addKeyframe(newFrame);
+    const std::vector<AnimationFrame>& frames = animation.keyframes();
+    std::vector<AnimationFrame>& newFrames = newAnimation.keyframes();
+
+    newFrames.resize(frames.size());
+
+    #pragma omp parallel for
+    for (FrameId fId = 0; fId < frames.size(); ++fId) {
+        modelAnimationFrameTransfer(model, frames[fId], birthJoint, targetModel, newFrames[fId]);
     }
 
     targetModel.addAnimation(newAnimation);
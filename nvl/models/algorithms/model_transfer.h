@@ -9,6 +9,8 @@
 
 #include <nvl/nuvolib.h>
 
+#include <nvl/structures/trees/bvh.h>
+
 #include <vector>
 
 namespace nvl {
@@ -30,6 +32,29 @@ void modelSkinningWeightsTransfer(
         const std::vector<typename Model::Skeleton::JointId>& birthJoint,
         Model& targetModel);
 
+template<class Model>
+void modelSkinningWeightsTransferVertices(
+        const Model& model,
+        const std::vector<typename Model::Mesh::VertexId>& birthVertex,
+        Model& targetModel);
+
+template<class Model>
+void modelSkinningWeightsTransferJoints(
+        const Model& model,
+        const std::vector<Index>& birthJoint,
+        Model& targetModel);
+
+template<class Model>
+void modelSkinningWeightsTransferClosestPoint(
+        const Model& model,
+        Model& targetModel);
+
+template<class Model>
+void modelSkinningWeightsTransferClosestPoint(
+        const Model& model,
+        const BVH<typename Model::Mesh::Scalar, 3>& bvh,
+        Model& targetModel);
+
 template<class Model>
 void modelAnimationTransfer(
         const Model& model,
@@ -57,10 +57,10 @@ void skeletonTransferJoints(
             JointId newJId = NULL_ID;
             if (skeleton.isRoot(jId) || jointSet.find(parent) == jointSet.end()) {
                 if (targetParentId == NULL_ID) {
-                    newJId = skeleton.addRoot(joint);
+                    newJId = targetSkeleton.addRoot(joint);
                 }
                 else {
-                    newJId = skeleton.addChild(joint, targetParentId);
+                    newJId = targetSkeleton.addChild(joint, targetParentId);
                 }
             }
             else if (jointMap[parent] != NULL_ID) {
@@ -8,6 +8,8 @@
 
 #include <nvl/models/io/skinning_weights_io_skw.h>
 
+#include <nvl/models/structures/skinning_weights_builder.h>
+
 #include <nvl/utilities/string_utils.h>
 
 namespace nvl {
@@ -94,11 +96,16 @@ void skinningWeightsLoadData(
 {
     NVL_SUPPRESS_UNUSEDVARIABLE(mode);
 
+    const SparseMatrixd& matrix = skinningWeights.eigenMatrix();
+
+    SkinningWeightsBuilder<W> builder(static_cast<Size>(matrix.rows()), static_cast<Size>(matrix.cols()));
+    builder.reserve(skinningWeightsData.weights.size());
+
     for (const std::tuple<Index, Index, W>& tuple : skinningWeightsData.weights) {
-        skinningWeights.setWeight(std::get<0>(tuple), std::get<1>(tuple), std::get<2>(tuple));
+        builder.addWeight(std::get<0>(tuple), std::get<1>(tuple), std::get<2>(tuple));
     }
 
-    skinningWeights.updateNonZeros();
+    builder.build(skinningWeights);
 }
 
 /**
@@ -8,11 +8,13 @@ HEADERS += \
     $$PWD/algorithms/animation_transformations.h \
     $$PWD/algorithms/mesh_adjacencies.h \
     $$PWD/algorithms/mesh_borders.h \
+    $$PWD/algorithms/mesh_bvh.h \
     $$PWD/algorithms/mesh_cleaning.h \
     $$PWD/algorithms/mesh_collapse_borders.h \
     $$PWD/algorithms/mesh_consistency.h \
     $$PWD/algorithms/mesh_curvature.h \
     $$PWD/algorithms/mesh_curve_on_manifold.h \
+    $$PWD/algorithms/mesh_decimation.h \
     $$PWD/algorithms/mesh_differentiation.h \
     $$PWD/algorithms/mesh_eigen_convert.h \
     $$PWD/algorithms/mesh_geodesics.h \
@@ -20,6 +22,7 @@ HEADERS += \
     $$PWD/algorithms/mesh_graph.h \
     $$PWD/algorithms/mesh_grid.h \
     $$PWD/algorithms/mesh_implicit_function.h \
+    $$PWD/algorithms/mesh_kdtree.h \
     $$PWD/algorithms/mesh_morphological_operations.h \
     $$PWD/algorithms/mesh_normals.h \
     $$PWD/algorithms/mesh_octree.h \
@@ -99,6 +102,7 @@ HEADERS += \
     $$PWD/structures/skeleton.h \
     $$PWD/structures/skeleton_joint.h \
     $$PWD/structures/skinning_weights.h \
+    $$PWD/structures/skinning_weights_builder.h \
     $$PWD/structures/vertex_mesh.h
 
 SOURCES += \
@@ -111,11 +115,13 @@ SOURCES += \
     $$PWD/algorithms/animation_transformations.cpp \
     $$PWD/algorithms/mesh_adjacencies.cpp \
     $$PWD/algorithms/mesh_borders.cpp \
+    $$PWD/algorithms/mesh_bvh.cpp \
     $$PWD/algorithms/mesh_cleaning.cpp \
     $$PWD/algorithms/mesh_collapse_borders.cpp \
     $$PWD/algorithms/mesh_consistency.cpp \
     $$PWD/algorithms/mesh_curvature.cpp \
     $$PWD/algorithms/mesh_curve_on_manifold.cpp \
+    $$PWD/algorithms/mesh_decimation.cpp \
     $$PWD/algorithms/mesh_differentiation.cpp \
     $$PWD/algorithms/mesh_eigen_convert.cpp \
     $$PWD/algorithms/mesh_geodesics.cpp \
@@ -123,6 +129,7 @@ SOURCES += \
     $$PWD/algorithms/mesh_graph.cpp \
     $$PWD/algorithms/mesh_grid.cpp \
     $$PWD/algorithms/mesh_implicit_function.cpp \
+    $$PWD/algorithms/mesh_kdtree.cpp \
     $$PWD/algorithms/mesh_morphological_operations.cpp \
     $$PWD/algorithms/mesh_normals.cpp \
     $$PWD/algorithms/mesh_octree.cpp \
@@ -195,4 +202,5 @@ SOURCES += \
     $$PWD/structures/skeleton.cpp \
     $$PWD/structures/skeleton_joint.cpp \
     $$PWD/structures/skinning_weights.cpp \
+    $$PWD/structures/skinning_weights_builder.cpp \
     $$PWD/structures/vertex_mesh.cpp
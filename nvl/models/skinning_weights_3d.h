@@ -10,12 +10,14 @@
 #include <nvl/nuvolib.h>
 
 #include <nvl/models/structures/skinning_weights.h>
+#include <nvl/models/structures/skinning_weights_builder.h>
 
 #include <vector>
 
 namespace nvl {
 
 typedef SkinningWeights<double> SkinningWeightsd;
+typedef SkinningWeightsBuilder<double> SkinningWeightsBuilderd;
 
 }
 
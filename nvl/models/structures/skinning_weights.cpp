@@ -18,6 +18,7 @@ template<class T>
 void SkinningWeights<T>::clear()
 {
     vSparseMatrix.resize(0,0);
+    vNonZero.clear();
 }
 
 template<class T>
@@ -52,6 +53,17 @@ void SkinningWeights<T>::setWeight(const Index& vertexId, const Index& jointId,
     vSparseMatrix.coeffRef(vertexId, jointId) = weight;
 }
 
+template<class T>
+void SkinningWeights<T>::setFromTriplets(const Size& vertexNumber, const Size& jointNumber, const std::vector<Triplet>& triplets)
+{
+    vSparseMatrix.resize(static_cast<EigenId>(vertexNumber), static_cast<EigenId>(jointNumber));
+
+    //The last value of duplicated weights is kept, as in setWeight
+    vSparseMatrix.setFromTriplets(triplets.begin(), triplets.end(), [](const T&, const T& b) { return b; });
+
+    updateNonZeros();
+}
+
 template<class T>
 const SparseMatrixd& SkinningWeights<T>::eigenMatrix() const
 {
@@ -62,10 +74,22 @@ template<class T>
 void SkinningWeights<T>::updateNonZeros()
 {
     vSparseMatrix.prune(0.0);
+    vSparseMatrix.makeCompressed();
 
     vNonZero.clear();
     vNonZero.resize(vSparseMatrix.innerSize(), std::vector<Index>());
 
+    //Count the non-zeros of each vertex to allocate them once
+    std::vector<Size> nonZeroNumber(vNonZero.size(), 0);
+    for (EigenId i = 0; i < vSparseMatrix.nonZeros(); ++i) {
+        nonZeroNumber[vSparseMatrix.innerIndexPtr()[i]]++;
+    }
+
+    #pragma omp parallel for
+    for (Index vId = 0; vId < vNonZero.size(); ++vId) {
+        vNonZero[vId].reserve(nonZeroNumber[vId]);
+    }
+
     for (EigenId col = 0; col < vSparseMatrix.outerSize(); ++col) {
         for (SparseMatrix<double>::InnerIterator it(vSparseMatrix, col); it; ++it) {
             EigenId row = it.row();
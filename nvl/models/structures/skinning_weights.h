@@ -22,6 +22,7 @@ class SkinningWeights
 public:
 
     typedef T Scalar;
+    typedef Eigen::Triplet<T> Triplet;
 
     SkinningWeights();
 
@@ -33,6 +34,8 @@ public:
     T& weight(const Index& vertexId, const Index& jointId);
     void setWeight(const Index& vertexId, const Index& jointId, const T& weight);
 
+    void setFromTriplets(const Size& vertexNumber, const Size& jointNumber, const std::vector<Triplet>& triplets);
+
     const SparseMatrixd& eigenMatrix() const;
 
     void updateNonZeros();
@@ -0,0 +1,201 @@
+/*
+ * This file is part of nuvolib: https://github.com/stefanonuvoli/nuvolib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Stefano Nuvoli (stefano.nuvoli@gmail.com)
+ */
+#include "skinning_weights_builder.h"
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include <atomic>
+
+namespace nvl {
+
+/**
+ * @brief Default constructor
+ */
+template<class T>
+SkinningWeightsBuilder<T>::SkinningWeightsBuilder() :
+    SkinningWeightsBuilder(0, 0)
+{
+
+}
+
+/**
+ * @brief Constructor with the size of the skinning weights
+ * @param vertexNumber Number of vertices
+ * @param jointNumber Number of joints
+ */
+template<class T>
+SkinningWeightsBuilder<T>::SkinningWeightsBuilder(const Size& vertexNumber, const Size& jointNumber)
+{
+    initialize(vertexNumber, jointNumber);
+}
+
+/**
+ * @brief Remove the added weights and set the size of the skinning weights
+ * @param vertexNumber Number of vertices
+ * @param jointNumber Number of joints
+ */
+template<class T>
+void SkinningWeightsBuilder<T>::initialize(const Size& vertexNumber, const Size& jointNumber)
+{
+    vVertexNumber = vertexNumber;
+    vJointNumber = jointNumber;
+    vThreadReserve = 0;
+
+    //A new session invalidates the buffers cached by the threads
+    vThreadTriplets.clear();
+    vSession = newSession();
+}
+
+/**
+ * @brief Reserve memory for an expected number of weights, split among the
+ * threads. The buffers are reserved when they are created.
+ * @param weightNumber Number of weights
+ */
+template<class T>
+void SkinningWeightsBuilder<T>::reserve(const Size& weightNumber)
+{
+    vThreadReserve = weightNumber / threadNumber() + 1;
+    for (std::vector<Triplet>& triplets : vThreadTriplets) {
+        triplets.reserve(vThreadReserve);
+    }
+}
+
+/**
+ * @brief Remove the added weights
+ */
+template<class T>
+void SkinningWeightsBuilder<T>::clear()
+{
+    for (std::vector<Triplet>& triplets : vThreadTriplets) {
+        triplets.clear();
+    }
+}
+
+/**
+ * @brief Number of vertices of the skinning weights
+ * @return Number of vertices
+ */
+template<class T>
+Size SkinningWeightsBuilder<T>::vertexNumber() const
+{
+    return vVertexNumber;
+}
+
+/**
+ * @brief Number of joints of the skinning weights
+ * @return Number of joints
+ */
+template<class T>
+Size SkinningWeightsBuilder<T>::jointNumber() const
+{
+    return vJointNumber;
+}
+
+/**
+ * @brief Number of weights added
+ * @return Number of triplets
+ */
+template<class T>
+Size SkinningWeightsBuilder<T>::tripletNumber() const
+{
+    Size number = 0;
+    for (const std::vector<Triplet>& triplets : vThreadTriplets) {
+        number += triplets.size();
+    }
+    return number;
+}
+
+/**
+ * @brief Add a weight. It can be called concurrently by the threads of an
+ * OpenMP parallel region. A zero weight overrides a previous value of the
+ * same weight, and it is removed when the skinning weights are built.
+ * @param vertexId Vertex id
+ * @param jointId Joint id
+ * @param weight Weight
+ */
+template<class T>
+void SkinningWeightsBuilder<T>::addWeight(const Index& vertexId, const Index& jointId, const T& weight)
+{
+    assert(vertexId < vVertexNumber && jointId < vJointNumber);
+
+    threadTriplets().push_back(Triplet(static_cast<EigenId>(vertexId), static_cast<EigenId>(jointId), weight));
+}
+
+/**
+ * @brief Assemble the added weights in the skinning weights, replacing
+ * their previous content. The non-zero weights of each vertex are
+ * computed in the same pass. The builder is cleared.
+ * @param skinningWeights Skinning weights
+ */
+template<class T>
+void SkinningWeightsBuilder<T>::build(SkinningWeights<T>& skinningWeights)
+{
+    std::vector<Triplet> triplets;
+
+    //The buffers stay allocated (empty), the threads may still refer to them
+    if (vThreadTriplets.size() == 1) {
+        triplets.swap(vThreadTriplets[0]);
+    }
+    else {
+        triplets.reserve(tripletNumber());
+        for (std::vector<Triplet>& threadTriplets : vThreadTriplets) {
+            triplets.insert(triplets.end(), threadTriplets.begin(), threadTriplets.end());
+            std::vector<Triplet>().swap(threadTriplets);
+        }
+    }
+
+    skinningWeights.setFromTriplets(vVertexNumber, vJointNumber, triplets);
+
+    clear();
+}
+
+/**
+ * @brief Buffer of the calling thread, created the first time the thread
+ * adds a weight in the current session. The buffer is cached by the thread,
+ * so the lock is taken only once for each thread.
+ * @return Triplets of the thread
+ */
+template<class T>
+std::vector<typename SkinningWeightsBuilder<T>::Triplet>& SkinningWeightsBuilder<T>::threadTriplets()
+{
+    thread_local Size cachedSession = 0;
+    thread_local std::vector<Triplet>* cachedTriplets = nullptr;
+
+    if (cachedSession != vSession) {
+        std::lock_guard<std::mutex> lock(vMutex);
+
+        //Elements of a deque are not moved when new ones are added
+        vThreadTriplets.emplace_back();
+        vThreadTriplets.back().reserve(vThreadReserve);
+
+        cachedTriplets = &vThreadTriplets.back();
+        cachedSession = vSession;
+    }
+
+    return *cachedTriplets;
+}
+
+template<class T>
+Size SkinningWeightsBuilder<T>::threadNumber()
+{
+#ifdef _OPENMP
+    return static_cast<Size>(omp_get_max_threads());
+#else
+    return 1;
+#endif
+}
+
+template<class T>
+Size SkinningWeightsBuilder<T>::newSession()
+{
+    static std::atomic<Size> lastSession(0);
+    return ++lastSession;
+}
+
+}
@@ -0,0 +1,76 @@
+/*
+ * This file is part of nuvolib: https://github.com/stefanonuvoli/nuvolib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Stefano Nuvoli (stefano.nuvoli@gmail.com)
+ */
+#ifndef NVL_MODELS_SKINNING_WEIGHTS_BUILDER_H
+#define NVL_MODELS_SKINNING_WEIGHTS_BUILDER_H
+
+#include <nvl/nuvolib.h>
+
+#include <nvl/models/structures/skinning_weights.h>
+
+#include <vector>
+#include <deque>
+#include <mutex>
+
+namespace nvl {
+
+/**
+ * @brief Bulk builder of skinning weights. The weights are accumulated as
+ * triplets, in a separate buffer for each thread, so they can be added
+ * inside an OpenMP parallel region without locking. The buffer of a thread
+ * is created the first time it adds a weight, so any number of threads and
+ * nested regions are supported. The skinning weights are then assembled in
+ * a single pass.
+ * If a weight is added more than once, the last added value is kept (the
+ * order is not defined between different threads). Zero weights are removed
+ * when the skinning weights are built.
+ */
+template<class T = double>
+class SkinningWeightsBuilder
+{
+
+public:
+
+    typedef T Scalar;
+    typedef typename SkinningWeights<T>::Triplet Triplet;
+
+    SkinningWeightsBuilder();
+    SkinningWeightsBuilder(const Size& vertexNumber, const Size& jointNumber);
+
+    void initialize(const Size& vertexNumber, const Size& jointNumber);
+    void reserve(const Size& weightNumber);
+    void clear();
+
+    Size vertexNumber() const;
+    Size jointNumber() const;
+    Size tripletNumber() const;
+
+    void addWeight(const Index& vertexId, const Index& jointId, const T& weight);
+
+    void build(SkinningWeights<T>& skinningWeights);
+
+protected:
+
+    Size vVertexNumber;
+    Size vJointNumber;
+    Size vThreadReserve;
+
+    std::deque<std::vector<Triplet>> vThreadTriplets;
+    Size vSession;
+    std::mutex vMutex;
+
+    std::vector<Triplet>& threadTriplets();
+
+    static Size threadNumber();
+    static Size newSession();
+
+};
+
+}
+
+#include "skinning_weights_builder.cpp"
+
+#endif // NVL_MODELS_SKINNING_WEIGHTS_BUILDER_H
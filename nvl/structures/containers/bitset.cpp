@@ -0,0 +1,286 @@
+/*
+ * This file is part of nuvolib: https://github.com/stefanonuvoli/nuvolib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Stefano Nuvoli (stefano.nuvoli@gmail.com)
+ */
+#include "bitset.h"
+
+namespace nvl {
+
+namespace internal {
+
+/**
+ * @brief Position of the least significant set bit of a non-zero word
+ * @param word Word
+ * @return Position of the bit
+ */
+NVL_INLINE Index bitSetLowestBit(const BitSet::Word& word)
+{
+    assert(word != 0);
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<Index>(__builtin_ctzll(word));
+#else
+    Index pos = 0;
+    BitSet::Word w = word;
+    while ((w & 1) == 0) {
+        w >>= 1;
+        ++pos;
+    }
+    return pos;
+#endif
+}
+
+}
+
+/**
+ * @brief Default constructor
+ */
+NVL_INLINE BitSet::BitSet() :
+    vUniverseSize(0),
+    vNumberElements(0)
+{
+
+}
+
+/**
+ * @brief Constructor with the size of the universe
+ * @param universeSize Number of indices that can be stored without resizing
+ */
+NVL_INLINE BitSet::BitSet(const Size universeSize) :
+    BitSet()
+{
+    resize(universeSize);
+}
+
+/**
+ * @brief Get the number of indices in the set
+ * @return Number of elements
+ */
+NVL_INLINE Size BitSet::size() const
+{
+    return vNumberElements;
+}
+
+/**
+ * @brief Check if the set is empty
+ * @return True if the set is empty, false otherwise
+ */
+NVL_INLINE bool BitSet::empty() const
+{
+    return vNumberElements == 0;
+}
+
+/**
+ * @brief Remove all the elements, keeping the size of the universe
+ */
+NVL_INLINE void BitSet::clear()
+{
+    std::fill(vWords.begin(), vWords.end(), 0);
+    vNumberElements = 0;
+}
+
+/**
+ * @brief Get the size of the universe (maximum index + 1)
+ * @return Size of the universe
+ */
+NVL_INLINE Size BitSet::universeSize() const
+{
+    return vUniverseSize;
+}
+
+/**
+ * @brief Resize the universe. Elements outside the new universe are removed.
+ * @param universeSize New size of the universe
+ */
+NVL_INLINE void BitSet::resize(const Size universeSize)
+{
+    if (universeSize < vUniverseSize) {
+        for (Index id = nextId(universeSize); id != NULL_ID; id = nextId(id + 1)) {
+            --vNumberElements;
+        }
+    }
+
+    vWords.resize((universeSize + WORD_BITS - 1) / WORD_BITS, 0);
+    vUniverseSize = universeSize;
+
+    const Size remainder = vUniverseSize % WORD_BITS;
+    if (remainder > 0) {
+        vWords.back() &= (static_cast<Word>(1) << remainder) - 1;
+    }
+}
+
+/**
+ * @brief Check if an index is in the set
+ * @param id Index
+ * @return True if the index is in the set, false otherwise
+ */
+NVL_INLINE bool BitSet::contains(const Index& id) const
+{
+    if (id >= vUniverseSize)
+        return false;
+
+    return (vWords[id / WORD_BITS] >> (id % WORD_BITS)) & 1;
+}
+
+/**
+ * @brief Count the occurrences of an index in the set
+ * @param id Index
+ * @return 1 if the index is in the set, 0 otherwise
+ */
+NVL_INLINE Size BitSet::count(const Index& id) const
+{
+    return contains(id) ? 1 : 0;
+}
+
+/**
+ * @brief Insert an index. The universe is enlarged if the index is out of it.
+ * @param id Index
+ * @return Iterator to the index and a flag which is true if the index was
+ * not already in the set
+ */
+NVL_INLINE std::pair<BitSet::iterator, bool> BitSet::insert(const Index& id)
+{
+    assert(id != NULL_ID);
+
+    if (id >= vUniverseSize) {
+        resize(id + 1);
+    }
+
+    Word& word = vWords[id / WORD_BITS];
+    const Word mask = static_cast<Word>(1) << (id % WORD_BITS);
+
+    bool inserted = (word & mask) == 0;
+    if (inserted) {
+        word |= mask;
+        ++vNumberElements;
+    }
+
+    return std::make_pair(iterator(this, id), inserted);
+}
+
+/**
+ * @brief Insert a range of indices
+ * @param first First iterator
+ * @param last Last iterator
+ */
+template<class InputIterator>
+void BitSet::insert(InputIterator first, InputIterator last)
+{
+    for (InputIterator it = first; it != last; ++it) {
+        insert(*it);
+    }
+}
+
+/**
+ * @brief Remove an index
+ * @param id Index
+ * @return Number of elements removed
+ */
+NVL_INLINE Size BitSet::erase(const Index& id)
+{
+    if (!contains(id))
+        return 0;
+
+    vWords[id / WORD_BITS] &= ~(static_cast<Word>(1) << (id % WORD_BITS));
+    --vNumberElements;
+
+    return 1;
+}
+
+/**
+ * @brief Remove the element pointed by an iterator
+ * @param it Iterator
+ * @return Iterator to the next element
+ */
+NVL_INLINE BitSet::iterator BitSet::erase(const_iterator it)
+{
+    const Index id = *it;
+    erase(id);
+    return iterator(this, nextId(id + 1));
+}
+
+/**
+ * @brief Find an index
+ * @param id Index
+ * @return Iterator to the index, end() if the index is not in the set
+ */
+NVL_INLINE BitSet::iterator BitSet::find(const Index& id) const
+{
+    if (contains(id))
+        return iterator(this, id);
+
+    return end();
+}
+
+/**
+ * @brief Get the first index in the set which is greater or equal than a given one
+ * @param id Index
+ * @return Next index, NULL_ID if there are no other indices
+ */
+NVL_INLINE Index BitSet::nextId(const Index& id) const
+{
+    if (id >= vUniverseSize)
+        return NULL_ID;
+
+    Index wordId = id / WORD_BITS;
+    Word word = vWords[wordId] & (~static_cast<Word>(0) << (id % WORD_BITS));
+
+    while (word == 0) {
+        ++wordId;
+        if (wordId >= vWords.size())
+            return NULL_ID;
+
+        word = vWords[wordId];
+    }
+
+    return wordId * WORD_BITS + internal::bitSetLowestBit(word);
+}
+
+/**
+ * @brief Get the words of the bitset
+ * @return Words
+ */
+NVL_INLINE const std::vector<BitSet::Word>& BitSet::words() const
+{
+    return vWords;
+}
+
+/**
+ * @brief Begin iterator
+ * @return Iterator to the smallest index
+ */
+NVL_INLINE BitSet::const_iterator BitSet::begin() const
+{
+    return const_iterator(this, nextId(0));
+}
+
+/**
+ * @brief End iterator
+ * @return Iterator to the end
+ */
+NVL_INLINE BitSet::const_iterator BitSet::end() const
+{
+    return const_iterator(this, NULL_ID);
+}
+
+/**
+ * @brief Output stream operator
+ * @param output Output stream
+ * @param bitset Bitset
+ * @return Stream
+ */
+NVL_INLINE std::ostream& operator<<(std::ostream& output, const BitSet& bitset)
+{
+    output << "{";
+    for (BitSet::const_iterator it = bitset.begin(); it != bitset.end(); ++it) {
+        if (it != bitset.begin())
+            output << ", ";
+        output << *it;
+    }
+    output << "}";
+
+    return output;
+}
+
+}
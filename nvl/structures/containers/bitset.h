@@ -0,0 +1,98 @@
+/*
+ * This file is part of nuvolib: https://github.com/stefanonuvoli/nuvolib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Stefano Nuvoli (stefano.nuvoli@gmail.com)
+ */
+#ifndef NVL_STRUCTURES_BITSET_H
+#define NVL_STRUCTURES_BITSET_H
+
+#include <nvl/nuvolib.h>
+
+#include "internal/bitset_iterator.h"
+
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <cstdint>
+#include <ostream>
+
+namespace nvl {
+
+/**
+ * @brief Dense set of indices backed by a bitset. Membership test, insertion
+ * and removal are constant time, and iteration visits the indices in
+ * increasing order. It exposes the same interface of std::set/unordered_set
+ * (insert, erase, find, count), so it can be used where a Set of ids is expected.
+ */
+class BitSet
+{
+
+public:
+
+    /* Typedefs */
+
+    typedef uint64_t Word;
+
+    typedef Index value_type;
+    typedef Index key_type;
+    typedef Size size_type;
+
+    typedef internal::BitSetIterator<BitSet> iterator;
+    typedef internal::BitSetIterator<BitSet> const_iterator;
+
+
+    /* Constructors */
+
+    BitSet();
+    BitSet(const Size universeSize);
+
+
+    /* Methods */
+
+    Size size() const;
+    bool empty() const;
+    void clear();
+
+    Size universeSize() const;
+    void resize(const Size universeSize);
+
+    bool contains(const Index& id) const;
+    Size count(const Index& id) const;
+
+    std::pair<iterator, bool> insert(const Index& id);
+    template<class InputIterator>
+    void insert(InputIterator first, InputIterator last);
+    Size erase(const Index& id);
+    iterator erase(const_iterator it);
+
+    iterator find(const Index& id) const;
+
+    Index nextId(const Index& id) const;
+
+    const std::vector<Word>& words() const;
+
+
+    /* Iterators */
+
+    const_iterator begin() const;
+    const_iterator end() const;
+
+
+protected:
+
+    static const Size WORD_BITS = 64;
+
+    std::vector<Word> vWords;
+    Size vUniverseSize;
+    Size vNumberElements;
+
+};
+
+std::ostream& operator<<(std::ostream& output, const BitSet& bitset);
+
+}
+
+#include "bitset.cpp"
+
+#endif // NVL_STRUCTURES_BITSET_H
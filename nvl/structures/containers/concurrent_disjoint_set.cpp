@@ -0,0 +1,162 @@
+/*
+ * This file is part of nuvolib: https://github.com/stefanonuvoli/nuvolib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Stefano Nuvoli (stefano.nuvoli@gmail.com)
+ */
+#include "concurrent_disjoint_set.h"
+
+namespace nvl {
+
+/**
+ * @brief Default constructor
+ */
+NVL_INLINE ConcurrentDisjointSet::ConcurrentDisjointSet()
+{
+
+}
+
+/**
+ * @brief Constructor with the number of elements, each one in its own set
+ * @param size Number of elements
+ */
+NVL_INLINE ConcurrentDisjointSet::ConcurrentDisjointSet(const Size size)
+{
+    resize(size);
+}
+
+/**
+ * @brief Get the number of elements
+ * @return Number of elements
+ */
+NVL_INLINE Size ConcurrentDisjointSet::size() const
+{
+    return vParent.size();
+}
+
+/**
+ * @brief Reset the data structure with a given number of elements,
+ * each one in its own set. It is not thread-safe.
+ * @param size Number of elements
+ */
+NVL_INLINE void ConcurrentDisjointSet::resize(const Size size)
+{
+    std::vector<std::atomic<Index>> parent(size);
+
+    #pragma omp parallel for
+    for (Index i = 0; i < size; ++i) {
+        parent[i].store(i, std::memory_order_relaxed);
+    }
+
+    vParent.swap(parent);
+}
+
+/**
+ * @brief Find the set in which an element is belonging. It can be called
+ * concurrently with other find and merge operations.
+ * @param id Element
+ * @return Id of the set, which is the smallest element in the set
+ */
+NVL_INLINE Index ConcurrentDisjointSet::find(const Index& id)
+{
+    assert(id < vParent.size());
+
+    Index current = id;
+    while (true) {
+        Index parent = vParent[current].load(std::memory_order_relaxed);
+        if (parent == current) {
+            return current;
+        }
+
+        Index grandParent = vParent[parent].load(std::memory_order_relaxed);
+        if (grandParent != parent) {
+            //Path halving: a failure means that another thread already updated it
+            vParent[current].compare_exchange_weak(parent, grandParent, std::memory_order_relaxed);
+        }
+
+        current = grandParent;
+    }
+}
+
+/**
+ * @brief Merge (union of) the sets of two elements. It can be called
+ * concurrently with other find and merge operations.
+ * @param a First element
+ * @param b Second element
+ * @return True if the sets have been merged, false if they were already the same set
+ */
+NVL_INLINE bool ConcurrentDisjointSet::merge(const Index& a, const Index& b)
+{
+    Index rootA = a;
+    Index rootB = b;
+
+    while (true) {
+        rootA = find(rootA);
+        rootB = find(rootB);
+
+        if (rootA == rootB) {
+            return false;
+        }
+
+        if (rootA < rootB) {
+            std::swap(rootA, rootB);
+        }
+
+        //Link the greater root to the smaller one, retry if it is no longer a root
+        Index expected = rootA;
+        if (vParent[rootA].compare_exchange_strong(expected, rootB, std::memory_order_relaxed)) {
+            return true;
+        }
+    }
+}
+
+/**
+ * @brief Compute a compact id for each set. Sets are numbered in the order
+ * of their smallest active element. It must be called after all the merge operations.
+ * @param active Flag for each element, inactive elements get NULL_ID.
+ * If empty, all the elements are considered active.
+ * @param setNumber Output number of sets
+ * @return Id of the set for each element
+ */
+NVL_INLINE std::vector<Index> ConcurrentDisjointSet::computeSetIds(
+        const std::vector<bool>& active,
+        Size& setNumber)
+{
+    assert(active.empty() || active.size() == vParent.size());
+
+    std::vector<Index> roots(vParent.size());
+
+    #pragma omp parallel for
+    for (Index i = 0; i < vParent.size(); ++i) {
+        roots[i] = find(i);
+    }
+
+    std::vector<Index> setIds(vParent.size(), NULL_ID);
+    std::vector<Index> rootSetIds(vParent.size(), NULL_ID);
+
+    setNumber = 0;
+    for (Index i = 0; i < vParent.size(); ++i) {
+        if (!active.empty() && !active[i])
+            continue;
+
+        Index& rootSetId = rootSetIds[roots[i]];
+        if (rootSetId == NULL_ID) {
+            rootSetId = setNumber;
+            ++setNumber;
+        }
+
+        setIds[i] = rootSetId;
+    }
+
+    return setIds;
+}
+
+/**
+ * @brief Clear the data structure
+ */
+NVL_INLINE void ConcurrentDisjointSet::clear()
+{
+    vParent.clear();
+}
+
+}
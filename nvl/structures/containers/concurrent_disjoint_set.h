@@ -0,0 +1,55 @@
+/*
+ * This file is part of nuvolib: https://github.com/stefanonuvoli/nuvolib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Stefano Nuvoli (stefano.nuvoli@gmail.com)
+ */
+#ifndef NVL_STRUCTURES_CONCURRENT_DISJOINT_SET_H
+#define NVL_STRUCTURES_CONCURRENT_DISJOINT_SET_H
+
+#include <nvl/nuvolib.h>
+
+#include <atomic>
+#include <vector>
+
+namespace nvl {
+
+/**
+ * @brief Disjoint set on the indices [0, n) that supports concurrent find-union
+ * operations. It is lock-free: the roots are linked with a compare-and-swap, always
+ * from the greater to the smaller index, and paths are compressed by halving.
+ * The root of each set is therefore its smallest index.
+ */
+class ConcurrentDisjointSet
+{
+
+public:
+
+    ConcurrentDisjointSet();
+    ConcurrentDisjointSet(const Size size);
+
+    Size size() const;
+    void resize(const Size size);
+
+    Index find(const Index& id);
+
+    bool merge(const Index& a, const Index& b);
+
+    std::vector<Index> computeSetIds(
+            const std::vector<bool>& active,
+            Size& setNumber);
+
+    void clear();
+
+
+protected:
+
+    std::vector<std::atomic<Index>> vParent;
+
+};
+
+}
+
+#include "concurrent_disjoint_set.cpp"
+
+#endif // NVL_STRUCTURES_CONCURRENT_DISJOINT_SET_H
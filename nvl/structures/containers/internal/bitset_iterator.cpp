@@ -0,0 +1,72 @@
+/*
+ * This file is part of nuvolib: https://github.com/stefanonuvoli/nuvolib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Stefano Nuvoli (stefano.nuvoli@gmail.com)
+ */
+#include "bitset_iterator.h"
+
+namespace nvl {
+
+namespace internal {
+
+template<class C>
+BitSetIterator<C>::BitSetIterator() :
+    vBitSet(nullptr),
+    vId(NULL_ID)
+{
+
+}
+
+template<class C>
+BitSetIterator<C>::BitSetIterator(
+        const C* bitset,
+        const Index id) :
+    vBitSet(bitset),
+    vId(id)
+{
+
+}
+
+template<class C>
+bool BitSetIterator<C>::operator==(const BitSetIterator<C>& otherIterator) const
+{
+    return (vId == otherIterator.vId);
+}
+
+template<class C>
+bool BitSetIterator<C>::operator!=(const BitSetIterator<C>& otherIterator) const
+{
+    return !(*this == otherIterator);
+}
+
+template<class C>
+BitSetIterator<C> BitSetIterator<C>::operator++()
+{
+    vId = vBitSet->nextId(vId + 1);
+    return *this;
+}
+
+template<class C>
+BitSetIterator<C> BitSetIterator<C>::operator++(int)
+{
+    BitSetIterator<C> oldIt = *this;
+    vId = vBitSet->nextId(vId + 1);
+    return oldIt;
+}
+
+template<class C>
+const Index& BitSetIterator<C>::operator*() const
+{
+    return vId;
+}
+
+template<class C>
+const Index* BitSetIterator<C>::operator->() const
+{
+    return &vId;
+}
+
+}
+
+}
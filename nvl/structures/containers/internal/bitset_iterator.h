@@ -0,0 +1,65 @@
+/*
+ * This file is part of nuvolib: https://github.com/stefanonuvoli/nuvolib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Stefano Nuvoli (stefano.nuvoli@gmail.com)
+ */
+#ifndef NVL_STRUCTURES_BITSET_ITERATOR_H
+#define NVL_STRUCTURES_BITSET_ITERATOR_H
+
+#include <nvl/nuvolib.h>
+
+#include <iterator>
+
+namespace nvl {
+
+namespace internal {
+
+/**
+ * @brief Iterator for the bitset, it visits the indices of the set bits
+ * @tparam C Container used
+ */
+template<class C>
+class BitSetIterator
+{
+
+public:
+
+    using difference_type = std::ptrdiff_t;
+    using value_type = Index;
+    using pointer = const Index*;
+    using reference = const Index&;
+    using iterator_category = std::forward_iterator_tag;
+
+
+    /* Constructors */
+
+    BitSetIterator();
+    BitSetIterator(
+            const C* bitset,
+            const Index id);
+
+    /* Methods */
+
+    bool operator==(const BitSetIterator& otherIterator) const;
+    bool operator!=(const BitSetIterator& otherIterator) const;
+
+    BitSetIterator operator++();
+    BitSetIterator operator++(int);
+
+    const Index& operator*() const;
+    const Index* operator->() const;
+
+private:
+
+    const C* vBitSet;
+    Index vId;
+};
+
+}
+
+}
+
+#include "bitset_iterator.cpp"
+
+#endif // NVL_STRUCTURES_BITSET_ITERATOR_H
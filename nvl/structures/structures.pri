@@ -1,12 +1,18 @@
 #Containers
 
 HEADERS += \
+    $$PWD/containers/bitset.h \
+    $$PWD/containers/concurrent_disjoint_set.h \
     $$PWD/containers/disjoint_set.h \
+    $$PWD/containers/internal/bitset_iterator.h \
     $$PWD/containers/internal/vector_with_delete_iterator.h \
     $$PWD/containers/vector_with_delete.h
 
 SOURCES += \
+    $$PWD/containers/bitset.cpp \
+    $$PWD/containers/concurrent_disjoint_set.cpp \
     $$PWD/containers/disjoint_set.cpp \
+    $$PWD/containers/internal/bitset_iterator.cpp \
     $$PWD/containers/internal/vector_with_delete_iterator.cpp \
     $$PWD/containers/vector_with_delete.cpp
 
@@ -58,7 +64,11 @@ HEADERS += \
     $$PWD/trees/avlinner.h \
     $$PWD/trees/avlleaf.h \
     $$PWD/trees/rangetree.h \
+    $$PWD/trees/rangetreestatic.h \
     $$PWD/trees/aabbtree.h \
+    $$PWD/trees/aabbtreestatic.h \
+    $$PWD/trees/bvh.h \
+    $$PWD/trees/kdtree.h \
     $$PWD/trees/octree.h
 
 
@@ -82,5 +92,9 @@ SOURCES += \
     $$PWD/trees/avlinner.cpp \
     $$PWD/trees/avlleaf.cpp \
     $$PWD/trees/rangetree.cpp \
+    $$PWD/trees/rangetreestatic.cpp \
     $$PWD/trees/aabbtree.cpp \
+    $$PWD/trees/aabbtreestatic.cpp \
+    $$PWD/trees/bvh.cpp \
+    $$PWD/trees/kdtree.cpp \
     $$PWD/trees/octree.cpp
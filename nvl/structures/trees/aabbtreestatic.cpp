@@ -0,0 +1,575 @@
+/*
+ * This file is part of nuvolib: https://github.com/stefanonuvoli/nuvolib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Stefano Nuvoli (stefano.nuvoli@gmail.com)
+ */
+#include "aabbtreestatic.h"
+
+#include <algorithm>
+#include <limits>
+#include <cmath>
+
+namespace nvl {
+
+namespace internal {
+
+/**
+ * @brief Largest float not greater than a double value
+ * @param value Value
+ * @return Float value
+ */
+NVL_INLINE float aabbTreeStaticFloorFloat(const double& value)
+{
+    float result = static_cast<float>(value);
+    if (result > value) {
+        result = std::nextafter(result, -std::numeric_limits<float>::infinity());
+    }
+    return result;
+}
+
+/**
+ * @brief Smallest float not less than a double value
+ * @param value Value
+ * @return Float value
+ */
+NVL_INLINE float aabbTreeStaticCeilFloat(const double& value)
+{
+    float result = static_cast<float>(value);
+    if (result < value) {
+        result = std::nextafter(result, std::numeric_limits<float>::infinity());
+    }
+    return result;
+}
+
+}
+
+
+/* --------- CONSTRUCTORS --------- */
+
+/**
+ * @brief Default constructor
+ *
+ * @param customAABBExtractor Functor to extract AABB coordinates from a key
+ * @param customOverlapChecker Functor to filter the keys whose AABBs overlap
+ */
+template<int D, class K, class T, class E, class O>
+AABBTreeStatic<D,K,T,E,O>::AABBTreeStatic(
+        const E& customAABBExtractor,
+        const O& customOverlapChecker) :
+    vMaxLeafElements(NVL_AABBTREESTATIC_DEFAULT_LEAF_ELEMENTS),
+    vAABBExtractor(customAABBExtractor),
+    vOverlapChecker(customOverlapChecker)
+{
+
+}
+
+/**
+ * @brief Constructor with a vector of entries (key/value pairs)
+ *
+ * @param vec Vector of pairs of keys/values
+ * @param customAABBExtractor Functor to extract AABB coordinates from a key
+ * @param customOverlapChecker Functor to filter the keys whose AABBs overlap
+ */
+template<int D, class K, class T, class E, class O>
+AABBTreeStatic<D,K,T,E,O>::AABBTreeStatic(
+        const std::vector<std::pair<K,T>>& vec,
+        const E& customAABBExtractor,
+        const O& customOverlapChecker) :
+    vMaxLeafElements(NVL_AABBTREESTATIC_DEFAULT_LEAF_ELEMENTS),
+    vAABBExtractor(customAABBExtractor),
+    vOverlapChecker(customOverlapChecker)
+{
+    this->construction(vec);
+}
+
+
+
+/* --------- PUBLIC METHODS --------- */
+
+/**
+ * @brief Construction of the AABB tree given the keys, which are also used
+ * as values
+ *
+ * A clear operation is performed before the construction
+ *
+ * @param vec Vector of keys
+ */
+template<int D, class K, class T, class E, class O>
+void AABBTreeStatic<D,K,T,E,O>::construction(const std::vector<K>& vec)
+{
+    std::vector<std::pair<K,T>> pairVec;
+    pairVec.reserve(vec.size());
+
+    for (const K& entry : vec) {
+        pairVec.push_back(std::make_pair(entry, entry));
+    }
+
+    construction(pairVec);
+}
+
+/**
+ * @brief Construction of the AABB tree given the entries (pairs of
+ * keys/values). Each node splits its entries on the median of the AABB
+ * centers along the dimension of largest extent.
+ *
+ * A clear operation is performed before the construction
+ *
+ * @param vec Vector of pairs of keys/values
+ */
+template<int D, class K, class T, class E, class O>
+void AABBTreeStatic<D,K,T,E,O>::construction(const std::vector<std::pair<K,T>>& vec)
+{
+    this->clear();
+
+    if (vec.empty())
+        return;
+
+    std::vector<AABB> aabbs(vec.size());
+
+    #pragma omp parallel for
+    for (Index i = 0; i < vec.size(); ++i) {
+        this->setAABBFromKeyHelper(vec[i].first, aabbs[i]);
+    }
+
+    std::vector<Index> order(vec.size());
+    for (Index i = 0; i < vec.size(); ++i) {
+        order[i] = i;
+    }
+
+    vNodes.reserve(2 * (vec.size() / vMaxLeafElements) + 1);
+    buildNode(aabbs, order, 0, vec.size());
+
+    vKeys.resize(vec.size());
+    vValues.resize(vec.size());
+    vAABBs.resize(vec.size());
+    vOrder = order;
+
+    #pragma omp parallel for
+    for (Index i = 0; i < order.size(); ++i) {
+        vKeys[i] = vec[order[i]].first;
+        vValues[i] = vec[order[i]].second;
+        vAABBs[i] = aabbs[order[i]];
+    }
+
+    refitNodes();
+}
+
+/**
+ * @brief Update the AABBs extracting them again from the stored keys,
+ * keeping the structure of the tree. It is useful when the keys refer
+ * to objects that have been moved.
+ */
+template<int D, class K, class T, class E, class O>
+void AABBTreeStatic<D,K,T,E,O>::refit()
+{
+    #pragma omp parallel for
+    for (Index i = 0; i < vKeys.size(); ++i) {
+        this->setAABBFromKeyHelper(vKeys[i], vAABBs[i]);
+    }
+
+    refitNodes();
+}
+
+/**
+ * @brief Replace the keys and update the AABBs, keeping the structure of
+ * the tree
+ *
+ * @param vec Vector of the new keys, in the same order of the entries
+ * given in the construction
+ */
+template<int D, class K, class T, class E, class O>
+void AABBTreeStatic<D,K,T,E,O>::refit(const std::vector<K>& vec)
+{
+    assert(vec.size() == vKeys.size());
+
+    #pragma omp parallel for
+    for (Index i = 0; i < vKeys.size(); ++i) {
+        vKeys[i] = vec[vOrder[i]];
+        this->setAABBFromKeyHelper(vKeys[i], vAABBs[i]);
+    }
+
+    refitNodes();
+}
+
+/**
+ * @brief Find entries for which the input bounding box overlaps with the
+ * one of their keys, filtered by the key overlap checker
+ *
+ * @param key Input key
+ * @param out Output iterator for the values of the overlapping entries
+ */
+template<int D, class K, class T, class E, class O> template<class OutputIterator>
+void AABBTreeStatic<D,K,T,E,O>::aabbOverlapQuery(
+        const K& key,
+        OutputIterator out) const
+{
+    if (vNodes.empty())
+        return;
+
+    AABB aabb;
+    this->setAABBFromKeyHelper(key, aabb);
+
+    std::vector<Index> stack;
+    stack.push_back(0);
+
+    while (!stack.empty()) {
+        const Node& node = vNodes[stack.back()];
+        stack.pop_back();
+
+        if (!aabbOverlapsHelper(aabb, node.aabb))
+            continue;
+
+        if (node.isLeaf()) {
+            for (Index j = node.begin; j < node.end; ++j) {
+                if (aabbOverlapsHelper(aabb, vAABBs[j]) && vOverlapChecker(key, vKeys[j])) {
+                    *out = vValues[j];
+                    out++;
+                }
+            }
+        }
+        else {
+            stack.push_back(node.right);
+            stack.push_back(node.left);
+        }
+    }
+}
+
+/**
+ * @brief Check if the given bounding box overlaps with the one of an entry,
+ * accepted by the key overlap checker
+ *
+ * @param key Input key
+ * @return True if there is an overlapping entry
+ */
+template<int D, class K, class T, class E, class O>
+bool AABBTreeStatic<D,K,T,E,O>::aabbOverlapCheck(
+        const K& key) const
+{
+    if (vNodes.empty())
+        return false;
+
+    AABB aabb;
+    this->setAABBFromKeyHelper(key, aabb);
+
+    std::vector<Index> stack;
+    stack.push_back(0);
+
+    while (!stack.empty()) {
+        const Node& node = vNodes[stack.back()];
+        stack.pop_back();
+
+        if (!aabbOverlapsHelper(aabb, node.aabb))
+            continue;
+
+        if (node.isLeaf()) {
+            for (Index j = node.begin; j < node.end; ++j) {
+                if (aabbOverlapsHelper(aabb, vAABBs[j]) && vOverlapChecker(key, vKeys[j])) {
+                    return true;
+                }
+            }
+        }
+        else {
+            stack.push_back(node.right);
+            stack.push_back(node.left);
+        }
+    }
+
+    return false;
+}
+
+/**
+ * @brief Find all the pairs of entries whose AABBs overlap, filtered by the
+ * key overlap checker. Each pair is reported once. The entries are processed
+ * in parallel, and the result does not depend on the number of threads.
+ *
+ * @param pairs Pairs of values of the overlapping entries
+ */
+template<int D, class K, class T, class E, class O>
+void AABBTreeStatic<D,K,T,E,O>::aabbOverlapPairs(
+        std::vector<std::pair<T,T>>& pairs) const
+{
+    pairs.clear();
+
+    if (vNodes.empty())
+        return;
+
+    const Size blockSize = 1024;
+    const Size blockNumber = (vKeys.size() + blockSize - 1) / blockSize;
+
+    std::vector<std::vector<std::pair<T,T>>> blockPairs(blockNumber);
+
+    #pragma omp parallel for schedule(dynamic)
+    for (Index b = 0; b < blockNumber; ++b) {
+        std::vector<Index> stack;
+
+        for (Index i = b * blockSize; i < std::min((b + 1) * blockSize, vKeys.size()); ++i) {
+            const AABB& aabb = vAABBs[i];
+
+            stack.clear();
+            stack.push_back(0);
+
+            while (!stack.empty()) {
+                const Node& node = vNodes[stack.back()];
+                stack.pop_back();
+
+                //Only the entries after the current one are checked
+                if (node.end <= i + 1 || !aabbOverlapsHelper(aabb, node.aabb))
+                    continue;
+
+                if (node.isLeaf()) {
+                    for (Index j = std::max(node.begin, i + 1); j < node.end; ++j) {
+                        if (aabbOverlapsHelper(aabb, vAABBs[j]) && vOverlapChecker(vKeys[i], vKeys[j])) {
+                            blockPairs[b].push_back(std::make_pair(vValues[i], vValues[j]));
+                        }
+                    }
+                }
+                else {
+                    stack.push_back(node.right);
+                    stack.push_back(node.left);
+                }
+            }
+        }
+    }
+
+    Size pairNumber = 0;
+    for (const std::vector<std::pair<T,T>>& block : blockPairs) {
+        pairNumber += block.size();
+    }
+
+    pairs.reserve(pairNumber);
+    for (const std::vector<std::pair<T,T>>& block : blockPairs) {
+        pairs.insert(pairs.end(), block.begin(), block.end());
+    }
+}
+
+/**
+ * @brief Clear the AABB tree
+ */
+template<int D, class K, class T, class E, class O>
+void AABBTreeStatic<D,K,T,E,O>::clear()
+{
+    vNodes.clear();
+    vKeys.clear();
+    vValues.clear();
+    vAABBs.clear();
+    vOrder.clear();
+}
+
+/**
+ * @brief Get the number of entries
+ *
+ * @return Number of entries
+ */
+template<int D, class K, class T, class E, class O>
+Size AABBTreeStatic<D,K,T,E,O>::size() const
+{
+    return vKeys.size();
+}
+
+/**
+ * @brief Check if the AABB tree is empty
+ *
+ * @return True if the AABB tree is empty
+ */
+template<int D, class K, class T, class E, class O>
+bool AABBTreeStatic<D,K,T,E,O>::empty() const
+{
+    return vKeys.empty();
+}
+
+/**
+ * @brief Get the max number of entries in each leaf
+ *
+ * @return Max number of entries in each leaf
+ */
+template<int D, class K, class T, class E, class O>
+Size AABBTreeStatic<D,K,T,E,O>::maxLeafElements() const
+{
+    return vMaxLeafElements;
+}
+
+/**
+ * @brief Set the max number of entries in each leaf, used by the
+ * next construction
+ *
+ * @param maxLeafElements Max number of entries in each leaf
+ */
+template<int D, class K, class T, class E, class O>
+void AABBTreeStatic<D,K,T,E,O>::setMaxLeafElements(const Size& maxLeafElements)
+{
+    vMaxLeafElements = std::max(maxLeafElements, static_cast<Size>(1));
+}
+
+/**
+ * @brief Nodes of the AABB tree, the root is the first node
+ *
+ * @return Nodes
+ */
+template<int D, class K, class T, class E, class O>
+const std::vector<typename AABBTreeStatic<D,K,T,E,O>::Node>& AABBTreeStatic<D,K,T,E,O>::nodes() const
+{
+    return vNodes;
+}
+
+/**
+ * @brief Keys, ordered as referenced by the leaves
+ *
+ * @return Keys
+ */
+template<int D, class K, class T, class E, class O>
+const std::vector<K>& AABBTreeStatic<D,K,T,E,O>::keys() const
+{
+    return vKeys;
+}
+
+/**
+ * @brief Values, ordered as referenced by the leaves
+ *
+ * @return Values
+ */
+template<int D, class K, class T, class E, class O>
+const std::vector<T>& AABBTreeStatic<D,K,T,E,O>::values() const
+{
+    return vValues;
+}
+
+
+
+/* --------- PROTECTED METHODS --------- */
+
+/**
+ * @brief Build a node and its subtree
+ *
+ * @param aabbs AABB of each entry
+ * @param order Order of the entries
+ * @param begin First entry of the node
+ * @param end Last entry of the node (excluded)
+ * @return Id of the node
+ */
+template<int D, class K, class T, class E, class O>
+Index AABBTreeStatic<D,K,T,E,O>::buildNode(
+        const std::vector<AABB>& aabbs,
+        std::vector<Index>& order,
+        const Index begin,
+        const Index end)
+{
+    const Index nodeId = vNodes.size();
+    vNodes.push_back(Node());
+
+    vNodes[nodeId].left = NULL_ID;
+    vNodes[nodeId].right = NULL_ID;
+    vNodes[nodeId].begin = begin;
+    vNodes[nodeId].end = end;
+
+    if (end - begin <= vMaxLeafElements)
+        return nodeId;
+
+    //Extent of the centers (doubled, it does not change the comparisons)
+    std::array<float, D> minCenter;
+    std::array<float, D> maxCenter;
+    minCenter.fill(std::numeric_limits<float>::max());
+    maxCenter.fill(std::numeric_limits<float>::lowest());
+    for (Index j = begin; j < end; ++j) {
+        const AABB& aabb = aabbs[order[j]];
+        for (int i = 0; i < D; i++) {
+            const float center = aabb.min[i] + aabb.max[i];
+            minCenter[i] = std::min(minCenter[i], center);
+            maxCenter[i] = std::max(maxCenter[i], center);
+        }
+    }
+
+    int dim = 0;
+    for (int i = 1; i < D; i++) {
+        if (maxCenter[i] - minCenter[i] > maxCenter[dim] - minCenter[dim]) {
+            dim = i;
+        }
+    }
+
+    const Index mid = begin + (end - begin) / 2;
+    std::nth_element(
+        order.begin() + begin,
+        order.begin() + mid,
+        order.begin() + end,
+        [&aabbs, &dim](const Index& a, const Index& b) {
+            return aabbs[a].min[dim] + aabbs[a].max[dim] < aabbs[b].min[dim] + aabbs[b].max[dim];
+        });
+
+    const Index left = buildNode(aabbs, order, begin, mid);
+    const Index right = buildNode(aabbs, order, mid, end);
+
+    vNodes[nodeId].left = left;
+    vNodes[nodeId].right = right;
+
+    return nodeId;
+}
+
+/**
+ * @brief Update the AABBs of the nodes from the ones of the entries
+ */
+template<int D, class K, class T, class E, class O>
+void AABBTreeStatic<D,K,T,E,O>::refitNodes()
+{
+    //Children are always stored after their parent
+    for (Index n = vNodes.size(); n-- > 0; ) {
+        Node& node = vNodes[n];
+
+        if (node.isLeaf()) {
+            node.aabb = vAABBs[node.begin];
+            for (Index j = node.begin + 1; j < node.end; ++j) {
+                for (int i = 0; i < D; i++) {
+                    node.aabb.min[i] = std::min(node.aabb.min[i], vAABBs[j].min[i]);
+                    node.aabb.max[i] = std::max(node.aabb.max[i], vAABBs[j].max[i]);
+                }
+            }
+        }
+        else {
+            const AABB& leftAABB = vNodes[node.left].aabb;
+            const AABB& rightAABB = vNodes[node.right].aabb;
+            for (int i = 0; i < D; i++) {
+                node.aabb.min[i] = std::min(leftAABB.min[i], rightAABB.min[i]);
+                node.aabb.max[i] = std::max(leftAABB.max[i], rightAABB.max[i]);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Set the AABB of a key, rounding its coordinates outwards
+ *
+ * @param key Input key
+ * @param aabb AABB to be updated
+ */
+template<int D, class K, class T, class E, class O>
+void AABBTreeStatic<D,K,T,E,O>::setAABBFromKeyHelper(
+        const K& key,
+        AABB& aabb) const
+{
+    for (int i = 0; i < D; i++) {
+        aabb.min[i] = internal::aabbTreeStaticFloorFloat(vAABBExtractor(key, MIN, i+1));
+        aabb.max[i] = internal::aabbTreeStaticCeilFloat(vAABBExtractor(key, MAX, i+1));
+    }
+}
+
+/**
+ * @brief Check if two AABBs overlap
+ *
+ * @param a First AABB
+ * @param b Second AABB
+ * @return True if the AABBs overlap, false otherwise
+ */
+template<int D, class K, class T, class E, class O>
+bool AABBTreeStatic<D,K,T,E,O>::aabbOverlapsHelper(
+        const AABB& a,
+        const AABB& b)
+{
+    bool overlaps = true;
+
+    for (int i = 0; i < D; i++) {
+        overlaps &= !(a.min[i] > b.max[i] || b.min[i] > a.max[i]);
+    }
+
+    return overlaps;
+}
+
+}
@@ -0,0 +1,159 @@
+/*
+ * This file is part of nuvolib: https://github.com/stefanonuvoli/nuvolib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Stefano Nuvoli (stefano.nuvoli@gmail.com)
+ */
+#ifndef NVL_AABBTREESTATIC_H
+#define NVL_AABBTREESTATIC_H
+
+#include <nvl/nuvolib.h>
+
+#include <vector>
+#include <array>
+#include <utility>
+
+#include "aabbtree.h"
+
+#define NVL_AABBTREESTATIC_DEFAULT_LEAF_ELEMENTS 4
+
+namespace nvl {
+
+namespace internal {
+
+/**
+ * @brief Key overlap checker which accepts every pair of keys
+ */
+template<class K>
+struct AABBTreeStaticDefaultOverlapChecker {
+    inline bool operator()(const K& key1, const K& key2) const
+    {
+        NVL_SUPPRESS_UNUSEDVARIABLE(key1);
+        NVL_SUPPRESS_UNUSEDVARIABLE(key2);
+        return true;
+    }
+};
+
+}
+
+/**
+ * @brief A static AABB tree, built top-down from a set of entries
+ *
+ * The AABB extractor and the key overlap checker are template functors, so
+ * that they can be inlined. The extractor is called as the AABBValueExtractor
+ * of the AABBTree: extractor(key, valueType, dim), with dim starting from 1.
+ * Nodes are stored in a flat vector in depth-first order and the entries are
+ * reordered so that each leaf refers to a contiguous range of them. The AABBs
+ * are cached in float, rounded outwards so that no overlap is missed.
+ * The tree cannot be modified after the construction, but the AABBs can be
+ * updated with refit() when the keys move.
+ */
+template<int D, class K, class T, class E, class O = internal::AABBTreeStaticDefaultOverlapChecker<K>>
+class AABBTreeStatic
+{
+
+public:
+
+    /* Typedefs */
+
+    struct AABB {
+        std::array<float, D> min;
+        std::array<float, D> max;
+    };
+
+    struct Node {
+        AABB aabb;
+        Index left;
+        Index right;
+        Index begin;
+        Index end;
+
+        bool isLeaf() const { return left == NULL_ID; }
+    };
+
+
+    /* Constructors */
+
+    explicit AABBTreeStatic(
+            const E& customAABBExtractor = E(),
+            const O& customOverlapChecker = O());
+    explicit AABBTreeStatic(
+            const std::vector<std::pair<K,T>>& vec,
+            const E& customAABBExtractor = E(),
+            const O& customOverlapChecker = O());
+
+
+    /* Public methods */
+
+    void construction(const std::vector<K>& vec);
+    void construction(const std::vector<std::pair<K,T>>& vec);
+
+    void refit();
+    void refit(const std::vector<K>& vec);
+
+    template<class OutputIterator>
+    void aabbOverlapQuery(
+            const K& key,
+            OutputIterator out) const;
+
+    bool aabbOverlapCheck(
+            const K& key) const;
+
+    void aabbOverlapPairs(
+            std::vector<std::pair<T,T>>& pairs) const;
+
+    void clear();
+
+    Size size() const;
+    bool empty() const;
+
+    Size maxLeafElements() const;
+    void setMaxLeafElements(const Size& maxLeafElements);
+
+    const std::vector<Node>& nodes() const;
+    const std::vector<K>& keys() const;
+    const std::vector<T>& values() const;
+
+
+protected:
+
+    /* Protected fields */
+
+    std::vector<Node> vNodes;
+
+    std::vector<K> vKeys;
+    std::vector<T> vValues;
+    std::vector<AABB> vAABBs;
+    std::vector<Index> vOrder;
+
+    Size vMaxLeafElements;
+
+    E vAABBExtractor;
+    O vOverlapChecker;
+
+
+    /* Protected methods */
+
+    Index buildNode(
+            const std::vector<AABB>& aabbs,
+            std::vector<Index>& order,
+            const Index begin,
+            const Index end);
+
+    void refitNodes();
+
+    inline void setAABBFromKeyHelper(
+            const K& key,
+            AABB& aabb) const;
+
+    inline static bool aabbOverlapsHelper(
+            const AABB& a,
+            const AABB& b);
+
+};
+
+}
+
+#include "aabbtreestatic.cpp"
+
+#endif // NVL_AABBTREESTATIC_H
@@ -0,0 +1,415 @@
+/*
+ * This file is part of nuvolib: https://github.com/stefanonuvoli/nuvolib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Stefano Nuvoli (stefano.nuvoli@gmail.com)
+ */
+#include "bvh.h"
+
+#ifdef NVL_EIGEN_LOADED
+
+#include <nvl/math/numeric_limits.h>
+
+#include <algorithm>
+#include <utility>
+
+namespace nvl {
+
+/**
+ * @brief Default constructor
+ */
+template<class S, EigenId D>
+BVH<S,D>::BVH()
+{
+
+}
+
+/**
+ * @brief Constructor which builds the hierarchy
+ * @param boxes Bounding box of each primitive, empty boxes are skipped
+ * @param maxLeafElements Max number of primitives in each leaf
+ */
+template<class S, EigenId D>
+BVH<S,D>::BVH(const std::vector<Box>& boxes, const Size maxLeafElements)
+{
+    build(boxes, maxLeafElements);
+}
+
+/**
+ * @brief Build the hierarchy, splitting the primitives on the median of
+ * their centers along the largest dimension
+ * @param boxes Bounding box of each primitive, empty boxes are skipped
+ * @param maxLeafElements Max number of primitives in each leaf
+ */
+template<class S, EigenId D>
+void BVH<S,D>::build(const std::vector<Box>& boxes, const Size maxLeafElements)
+{
+    clear();
+
+    std::vector<PointType> centers(boxes.size());
+
+    #pragma omp parallel for
+    for (Index i = 0; i < boxes.size(); ++i) {
+        if (!boxes[i].isEmpty()) {
+            centers[i] = boxes[i].center();
+        }
+    }
+
+    vPrimitives.reserve(boxes.size());
+    for (Index i = 0; i < boxes.size(); ++i) {
+        if (!boxes[i].isEmpty()) {
+            vPrimitives.push_back(i);
+        }
+    }
+
+    if (vPrimitives.empty())
+        return;
+
+    vNodes.reserve(2 * (vPrimitives.size() / std::max(maxLeafElements, static_cast<Size>(1))) + 1);
+
+    buildNode(boxes, centers, 0, vPrimitives.size(), std::max(maxLeafElements, static_cast<Size>(1)));
+}
+
+/**
+ * @brief Update the boxes of the nodes, keeping the structure of the hierarchy
+ * @param boxes Bounding box of each primitive
+ */
+template<class S, EigenId D>
+void BVH<S,D>::refit(const std::vector<Box>& boxes)
+{
+    //Children are always stored after their parent
+    for (Index i = vNodes.size(); i-- > 0; ) {
+        Node& node = vNodes[i];
+
+        node.box.setEmpty();
+
+        if (node.isLeaf()) {
+            for (Index j = node.begin; j < node.end; ++j) {
+                node.box.extend(boxes[vPrimitives[j]]);
+            }
+        }
+        else {
+            node.box.extend(vNodes[node.left].box);
+            node.box.extend(vNodes[node.right].box);
+        }
+    }
+}
+
+/**
+ * @brief Find the closest primitive to a point
+ * @param point Query point
+ * @param squaredDistanceFunction Function that, given a primitive id and the point,
+ * returns the squared distance between them
+ * @param squaredDistance Squared distance of the closest primitive
+ * @return Id of the closest primitive, NULL_ID if the hierarchy is empty
+ */
+template<class S, EigenId D>
+template<class F>
+Index BVH<S,D>::closest(const PointType& point, const F& squaredDistanceFunction, Scalar& squaredDistance) const
+{
+    return closestLeaf(
+        point,
+        [&squaredDistanceFunction](const Index* primitiveIds, const Size number, const PointType& p, Index& leafClosestId) {
+            Scalar leafDistance = maxLimitValue<Scalar>();
+            leafClosestId = NULL_ID;
+
+            for (Index j = 0; j < number; ++j) {
+                const Scalar distance = squaredDistanceFunction(primitiveIds[j], p);
+                if (distance < leafDistance) {
+                    leafDistance = distance;
+                    leafClosestId = primitiveIds[j];
+                }
+            }
+
+            return leafDistance;
+        },
+        squaredDistance);
+}
+
+/**
+ * @brief Find the closest primitive to a point, evaluating the primitives
+ * of each leaf together (e.g. in SIMD packets)
+ * @param point Query point
+ * @param leafSquaredDistanceFunction Function that, given the primitive ids of
+ * a leaf, their number, the point and an output primitive id, sets the id to
+ * the closest primitive of the leaf and returns its squared distance
+ * @param squaredDistance Squared distance of the closest primitive
+ * @return Id of the closest primitive, NULL_ID if the hierarchy is empty
+ */
+template<class S, EigenId D>
+template<class F>
+Index BVH<S,D>::closestLeaf(const PointType& point, const F& leafSquaredDistanceFunction, Scalar& squaredDistance) const
+{
+    Index closestId = NULL_ID;
+    squaredDistance = maxLimitValue<Scalar>();
+
+    if (vNodes.empty())
+        return closestId;
+
+    std::vector<std::pair<Scalar, Index>> stack;
+    stack.push_back(std::make_pair(vNodes[0].box.squaredExteriorDistance(point), 0));
+
+    while (!stack.empty()) {
+        const std::pair<Scalar, Index> current = stack.back();
+        stack.pop_back();
+
+        if (current.first >= squaredDistance)
+            continue;
+
+        const Node& node = vNodes[current.second];
+
+        if (node.isLeaf()) {
+            Index leafClosestId;
+            const Scalar distance = leafSquaredDistanceFunction(vPrimitives.data() + node.begin, node.end - node.begin, point, leafClosestId);
+            if (leafClosestId != NULL_ID && distance < squaredDistance) {
+                squaredDistance = distance;
+                closestId = leafClosestId;
+            }
+        }
+        else {
+            const Scalar leftDistance = vNodes[node.left].box.squaredExteriorDistance(point);
+            const Scalar rightDistance = vNodes[node.right].box.squaredExteriorDistance(point);
+
+            //The nearest child is visited first
+            if (leftDistance < rightDistance) {
+                stack.push_back(std::make_pair(rightDistance, node.right));
+                stack.push_back(std::make_pair(leftDistance, node.left));
+            }
+            else {
+                stack.push_back(std::make_pair(leftDistance, node.left));
+                stack.push_back(std::make_pair(rightDistance, node.right));
+            }
+        }
+    }
+
+    return closestId;
+}
+
+/**
+ * @brief Find the first primitive hit by a ray
+ * @param origin Origin of the ray
+ * @param direction Direction of the ray, it does not need to be normalized
+ * @param intersectionFunction Function that, given a primitive id, the origin
+ * and the direction of the ray, returns the ray parameter of the intersection
+ * (maxLimitValue if the primitive is not hit)
+ * @param t Ray parameter of the intersection (origin + t * direction)
+ * @return Id of the first primitive hit, NULL_ID if no primitive is hit
+ */
+template<class S, EigenId D>
+template<class F>
+Index BVH<S,D>::raycast(const PointType& origin, const PointType& direction, const F& intersectionFunction, Scalar& t) const
+{
+    Index hitId = NULL_ID;
+    t = maxLimitValue<Scalar>();
+
+    if (vNodes.empty())
+        return hitId;
+
+    PointType inverseDirection;
+    for (EigenId d = 0; d < D; ++d) {
+        inverseDirection(d) = direction(d) != 0 ? 1 / direction(d) : maxLimitValue<Scalar>();
+    }
+
+    std::vector<std::pair<Scalar, Index>> stack;
+
+    const Scalar rootEntry = rayBoxEntry(vNodes[0].box, origin, inverseDirection);
+    if (rootEntry < maxLimitValue<Scalar>()) {
+        stack.push_back(std::make_pair(rootEntry, 0));
+    }
+
+    while (!stack.empty()) {
+        const std::pair<Scalar, Index> current = stack.back();
+        stack.pop_back();
+
+        if (current.first >= t)
+            continue;
+
+        const Node& node = vNodes[current.second];
+
+        if (node.isLeaf()) {
+            for (Index j = node.begin; j < node.end; ++j) {
+                const Index& primitiveId = vPrimitives[j];
+
+                const Scalar primitiveT = intersectionFunction(primitiveId, origin, direction);
+                if (primitiveT < t) {
+                    t = primitiveT;
+                    hitId = primitiveId;
+                }
+            }
+        }
+        else {
+            const Scalar leftEntry = rayBoxEntry(vNodes[node.left].box, origin, inverseDirection);
+            const Scalar rightEntry = rayBoxEntry(vNodes[node.right].box, origin, inverseDirection);
+
+            //The nearest child is visited first
+            if (leftEntry < rightEntry) {
+                if (rightEntry < t)
+                    stack.push_back(std::make_pair(rightEntry, node.right));
+                if (leftEntry < t)
+                    stack.push_back(std::make_pair(leftEntry, node.left));
+            }
+            else {
+                if (leftEntry < t)
+                    stack.push_back(std::make_pair(leftEntry, node.left));
+                if (rightEntry < t)
+                    stack.push_back(std::make_pair(rightEntry, node.right));
+            }
+        }
+    }
+
+    return hitId;
+}
+
+/**
+ * @brief Number of primitives in the hierarchy
+ * @return Number of primitives
+ */
+template<class S, EigenId D>
+Size BVH<S,D>::size() const
+{
+    return vPrimitives.size();
+}
+
+/**
+ * @brief Check if the hierarchy is empty
+ * @return True if the hierarchy is empty
+ */
+template<class S, EigenId D>
+bool BVH<S,D>::empty() const
+{
+    return vPrimitives.empty();
+}
+
+/**
+ * @brief Clear the hierarchy
+ */
+template<class S, EigenId D>
+void BVH<S,D>::clear()
+{
+    vNodes.clear();
+    vPrimitives.clear();
+}
+
+/**
+ * @brief Nodes of the hierarchy, the root is the first node
+ * @return Nodes
+ */
+template<class S, EigenId D>
+const std::vector<typename BVH<S,D>::Node>& BVH<S,D>::nodes() const
+{
+    return vNodes;
+}
+
+/**
+ * @brief Primitive ids, ordered as referenced by the leaves
+ * @return Primitive ids
+ */
+template<class S, EigenId D>
+const std::vector<Index>& BVH<S,D>::primitives() const
+{
+    return vPrimitives;
+}
+
+/**
+ * @brief Build a node and its subtree
+ * @param boxes Bounding box of each primitive
+ * @param centers Center of each primitive
+ * @param begin First primitive of the node
+ * @param end Last primitive of the node (excluded)
+ * @param maxLeafElements Max number of primitives in each leaf
+ * @return Id of the node
+ */
+template<class S, EigenId D>
+Index BVH<S,D>::buildNode(
+        const std::vector<Box>& boxes,
+        const std::vector<PointType>& centers,
+        const Index begin,
+        const Index end,
+        const Size maxLeafElements)
+{
+    const Index nodeId = vNodes.size();
+    vNodes.push_back(Node());
+
+    Box box;
+    Box centerBox;
+    for (Index j = begin; j < end; ++j) {
+        box.extend(boxes[vPrimitives[j]]);
+        centerBox.extend(centers[vPrimitives[j]]);
+    }
+
+    vNodes[nodeId].box = box;
+    vNodes[nodeId].begin = begin;
+    vNodes[nodeId].end = end;
+    vNodes[nodeId].left = NULL_ID;
+    vNodes[nodeId].right = NULL_ID;
+
+    if (end - begin <= maxLeafElements)
+        return nodeId;
+
+    Eigen::Index dim;
+    centerBox.diagonal().maxCoeff(&dim);
+
+    const Index mid = begin + (end - begin) / 2;
+    std::nth_element(
+        vPrimitives.begin() + begin,
+        vPrimitives.begin() + mid,
+        vPrimitives.begin() + end,
+        [&centers, &dim](const Index& a, const Index& b) { return centers[a](dim) < centers[b](dim); });
+
+    const Index left = buildNode(boxes, centers, begin, mid, maxLeafElements);
+    const Index right = buildNode(boxes, centers, mid, end, maxLeafElements);
+
+    vNodes[nodeId].left = left;
+    vNodes[nodeId].right = right;
+
+    return nodeId;
+}
+
+/**
+ * @brief Entry parameter of a ray in a box (slab test)
+ * @param box Box
+ * @param origin Origin of the ray
+ * @param inverseDirection Component-wise inverse of the direction of the ray
+ * (maxLimitValue for null components)
+ * @return Ray parameter in which the ray enters the box (0 if the origin is
+ * inside the box), maxLimitValue if the box is not hit
+ */
+template<class S, EigenId D>
+typename BVH<S,D>::Scalar BVH<S,D>::rayBoxEntry(
+        const Box& box,
+        const PointType& origin,
+        const PointType& inverseDirection)
+{
+    if (box.isEmpty())
+        return maxLimitValue<Scalar>();
+
+    Scalar tMin = 0;
+    Scalar tMax = maxLimitValue<Scalar>();
+
+    for (EigenId d = 0; d < D; ++d) {
+        //Ray parallel to the slab
+        if (inverseDirection(d) == maxLimitValue<Scalar>()) {
+            if (origin(d) < box.min()(d) || origin(d) > box.max()(d))
+                return maxLimitValue<Scalar>();
+            continue;
+        }
+
+        Scalar t1 = (box.min()(d) - origin(d)) * inverseDirection(d);
+        Scalar t2 = (box.max()(d) - origin(d)) * inverseDirection(d);
+
+        if (t1 > t2)
+            std::swap(t1, t2);
+
+        tMin = std::max(tMin, t1);
+        tMax = std::min(tMax, t2);
+
+        if (tMin > tMax)
+            return maxLimitValue<Scalar>();
+    }
+
+    return tMin;
+}
+
+}
+
+#endif
@@ -0,0 +1,107 @@
+/*
+ * This file is part of nuvolib: https://github.com/stefanonuvoli/nuvolib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Stefano Nuvoli (stefano.nuvoli@gmail.com)
+ */
+#ifndef NVL_STRUCTURES_BVH_H
+#define NVL_STRUCTURES_BVH_H
+
+#include <nvl/nuvolib.h>
+
+#ifdef NVL_EIGEN_LOADED
+
+#include <nvl/math/alignedbox.h>
+#include <nvl/math/point.h>
+
+#include <vector>
+
+#define NVL_BVH_DEFAULT_LEAF_ELEMENTS 4
+
+namespace nvl {
+
+/**
+ * @brief Static bounding volume hierarchy over a set of primitives, each
+ * given by its bounding box. The nodes are stored in a flat vector in
+ * depth-first order, and each leaf refers to a contiguous range of the
+ * reordered primitive ids.
+ * @tparam S Scalar
+ * @tparam D Dimension
+ */
+template<class S, EigenId D = 3>
+class BVH
+{
+
+public:
+
+    /* Typedefs */
+
+    typedef S Scalar;
+    typedef AlignedBox<S,D> Box;
+    typedef Point<S,D> PointType;
+
+    struct Node {
+        Box box;
+        Index left;
+        Index right;
+        Index begin;
+        Index end;
+
+        bool isLeaf() const { return left == NULL_ID; }
+    };
+
+
+    /* Constructors */
+
+    BVH();
+    BVH(const std::vector<Box>& boxes, const Size maxLeafElements = NVL_BVH_DEFAULT_LEAF_ELEMENTS);
+
+
+    /* Methods */
+
+    void build(const std::vector<Box>& boxes, const Size maxLeafElements = NVL_BVH_DEFAULT_LEAF_ELEMENTS);
+    void refit(const std::vector<Box>& boxes);
+
+    template<class F>
+    Index closest(const PointType& point, const F& squaredDistanceFunction, Scalar& squaredDistance) const;
+
+    template<class F>
+    Index closestLeaf(const PointType& point, const F& leafSquaredDistanceFunction, Scalar& squaredDistance) const;
+
+    template<class F>
+    Index raycast(const PointType& origin, const PointType& direction, const F& intersectionFunction, Scalar& t) const;
+
+    Size size() const;
+    bool empty() const;
+    void clear();
+
+    const std::vector<Node>& nodes() const;
+    const std::vector<Index>& primitives() const;
+
+
+protected:
+
+    std::vector<Node> vNodes;
+    std::vector<Index> vPrimitives;
+
+    Index buildNode(
+            const std::vector<Box>& boxes,
+            const std::vector<PointType>& centers,
+            const Index begin,
+            const Index end,
+            const Size maxLeafElements);
+
+    static Scalar rayBoxEntry(
+            const Box& box,
+            const PointType& origin,
+            const PointType& inverseDirection);
+
+};
+
+}
+
+#endif
+
+#include "bvh.cpp"
+
+#endif // NVL_STRUCTURES_BVH_H
@@ -64,15 +64,13 @@ void OctreeNode<K,T,R>::split()
         this->children[i] = new OctreeNode<K,T,R>(c,r);
         this->children[i]->parent = this;
         this->children[i]->position = static_cast<OctreeNodePosition>(i);
+    }
 
-        for (const std::pair<K,T>& v : values) {
-            if (this->children[i]->contains(v.first)) {
-                this->children[i]->values.push_back(std::make_pair(v.first, v.second));
+    for (const std::pair<K,T>& v : values) {
+        this->children[childPosition(v.first)]->values.push_back(std::make_pair(v.first, v.second));
 #ifndef NDEBUG
-                inserted++;
+        inserted++;
 #endif
-            }
-        }
     }
 
 #ifndef NDEBUG
@@ -112,6 +110,24 @@ bool OctreeNode<K,T,R>::contains(const K& key) const
     return true;
 }
 
+/**
+ * @brief Position of the child containing the key. The keys on the split
+ * planes belong to the upper child, as in contains(). The comparison is
+ * with the center of the node, so it does not depend on the rounding of the
+ * boxes of the children.
+ * @param key Key
+ * @return Position of the child
+ */
+template<class K, class T, class R>
+typename OctreeNode<K,T,R>::OctreeNodePosition OctreeNode<K,T,R>::childPosition(const K& key) const
+{
+    const int x1 = key.x() >= center.x() ? 1 : 0;
+    const int y1 = key.y() >= center.y() ? 1 : 0;
+    const int z1 = key.z() >= center.z() ? 1 : 0;
+
+    return static_cast<OctreeNodePosition>((x1 << 2) | (y1 << 1) | z1);
+}
+
 /**
  * @brief Check if the node is a leaf
  *
@@ -51,6 +51,7 @@ public:
 
     void split();
     bool contains(const K& key) const;
+    OctreeNodePosition childPosition(const K& key) const;
     std::vector<const OctreeNode<K,T,R>*> neighbors(
             const OctreeDirection& direction) const;
     std::vector<const OctreeNode<K,T,R>*> neighbors() const;
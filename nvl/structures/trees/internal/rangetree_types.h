@@ -5,6 +5,7 @@
 
 #include <nvl/math/point.h>
 #include <nvl/structures/trees/rangetree.h>
+#include <nvl/structures/trees/rangetreestatic.h>
 
 namespace nvl {
 
@@ -49,6 +50,28 @@ public:
         : RangeTree<Point3d>(3, vec, internal::getComparatorsForPoint3D()) {}
 };
 
+/**
+ * Static range tree of 2D points (double components)
+ */
+class RangeTreeStatic2D : public RangeTreeStatic<Point2d> {
+public:
+    RangeTreeStatic2D()
+        : RangeTreeStatic<Point2d>(2, internal::getComparatorsForPoint2D()) {}
+    RangeTreeStatic2D(const std::vector<Point2d>& vec)
+        : RangeTreeStatic<Point2d>(2, vec, internal::getComparatorsForPoint2D()) {}
+};
+
+/**
+ * Static range tree of 3D points (double components)
+ */
+class RangeTreeStatic3D : public RangeTreeStatic<Point3d> {
+public:
+    RangeTreeStatic3D()
+        : RangeTreeStatic<Point3d>(3, internal::getComparatorsForPoint3D()) {}
+    RangeTreeStatic3D(const std::vector<Point3d>& vec)
+        : RangeTreeStatic<Point3d>(3, vec, internal::getComparatorsForPoint3D()) {}
+};
+
 } //namespace nvl
 
 #include "rangetree_types.cpp"
@@ -0,0 +1,594 @@
+/*
+ * This file is part of nuvolib: https://github.com/stefanonuvoli/nuvolib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Stefano Nuvoli (stefano.nuvoli@gmail.com)
+ */
+#include "kdtree.h"
+
+#ifdef NVL_EIGEN_LOADED
+
+#include <nvl/math/numeric_limits.h>
+
+#include <algorithm>
+#include <utility>
+#include <tuple>
+
+namespace nvl {
+
+/**
+ * @brief Default constructor
+ */
+template<class S, EigenId D>
+KDTree<S,D>::KDTree()
+{
+
+}
+
+/**
+ * @brief Constructor which builds the tree, the id of each point is its
+ * index
+ * @param points Points
+ * @param maxLeafElements Max number of points in each leaf
+ */
+template<class S, EigenId D>
+KDTree<S,D>::KDTree(const std::vector<PointType>& points, const Size maxLeafElements)
+{
+    build(points, maxLeafElements);
+}
+
+/**
+ * @brief Constructor which builds the tree
+ * @param points Points
+ * @param ids Id of each point, returned by the queries
+ * @param maxLeafElements Max number of points in each leaf
+ */
+template<class S, EigenId D>
+KDTree<S,D>::KDTree(const std::vector<PointType>& points, const std::vector<Index>& ids, const Size maxLeafElements)
+{
+    build(points, ids, maxLeafElements);
+}
+
+/**
+ * @brief Build the tree, the id of each point is its index
+ * @param points Points
+ * @param maxLeafElements Max number of points in each leaf
+ */
+template<class S, EigenId D>
+void KDTree<S,D>::build(const std::vector<PointType>& points, const Size maxLeafElements)
+{
+    std::vector<Index> ids(points.size());
+    for (Index i = 0; i < points.size(); ++i) {
+        ids[i] = i;
+    }
+
+    build(points, ids, maxLeafElements);
+}
+
+/**
+ * @brief Build the tree. The first levels are split sequentially, then the
+ * subtrees are built in parallel.
+ * @param points Points
+ * @param ids Id of each point, returned by the queries
+ * @param maxLeafElements Max number of points in each leaf
+ */
+template<class S, EigenId D>
+void KDTree<S,D>::build(const std::vector<PointType>& points, const std::vector<Index>& ids, const Size maxLeafElements)
+{
+    assert(points.size() == ids.size());
+
+    clear();
+
+    if (points.empty())
+        return;
+
+    const Size leafElements = std::max(maxLeafElements, static_cast<Size>(1));
+
+    std::vector<Index> order(points.size());
+    for (Index i = 0; i < points.size(); ++i) {
+        order[i] = i;
+    }
+
+    //The id of each node is known in advance, so the subtrees can be built independently
+    vNodes.resize(nodeNumber(points.size(), leafElements));
+
+    std::vector<std::tuple<Index, Index, Index>> subtrees;
+    subtrees.push_back(std::make_tuple(0, 0, points.size()));
+
+    for (Index depth = 0; depth < 6; ++depth) {
+        std::vector<std::tuple<Index, Index, Index>> nextSubtrees;
+
+        for (const std::tuple<Index, Index, Index>& subtree : subtrees) {
+            const Index& nodeId = std::get<0>(subtree);
+            const Index& begin = std::get<1>(subtree);
+            const Index& end = std::get<2>(subtree);
+
+            if (splitNode(points, order, nodeId, begin, end, leafElements)) {
+                const Index mid = begin + (end - begin) / 2;
+                nextSubtrees.push_back(std::make_tuple(vNodes[nodeId].left, begin, mid));
+                nextSubtrees.push_back(std::make_tuple(vNodes[nodeId].right, mid, end));
+            }
+        }
+
+        subtrees = nextSubtrees;
+    }
+
+    #pragma omp parallel for schedule(dynamic)
+    for (Index i = 0; i < subtrees.size(); ++i) {
+        buildNode(points, order, std::get<0>(subtrees[i]), std::get<1>(subtrees[i]), std::get<2>(subtrees[i]), leafElements);
+    }
+
+    vPoints.resize(points.size());
+    vIds.resize(points.size());
+
+    #pragma omp parallel for
+    for (Index i = 0; i < order.size(); ++i) {
+        vPoints[i] = points[order[i]];
+        vIds[i] = ids[order[i]];
+    }
+}
+
+/**
+ * @brief Find the nearest point
+ * @param point Query point
+ * @param squaredDistance Squared distance of the nearest point
+ * @return Id of the nearest point, NULL_ID if the tree is empty
+ */
+template<class S, EigenId D>
+Index KDTree<S,D>::nearest(const PointType& point, Scalar& squaredDistance) const
+{
+    std::vector<Index> ids;
+    std::vector<Scalar> squaredDistances;
+    knn(point, 1, ids, squaredDistances);
+
+    if (ids.empty()) {
+        squaredDistance = maxLimitValue<Scalar>();
+        return NULL_ID;
+    }
+
+    squaredDistance = squaredDistances[0];
+    return ids[0];
+}
+
+/**
+ * @brief Find the k nearest points
+ * @param point Query point
+ * @param k Number of points
+ * @param ids Ids of the nearest points, sorted by distance. They are less
+ * than k if the tree has less than k points.
+ * @param squaredDistances Squared distance of each point
+ */
+template<class S, EigenId D>
+void KDTree<S,D>::knn(const PointType& point, const Size k, std::vector<Index>& ids, std::vector<Scalar>& squaredDistances) const
+{
+    ids.clear();
+    squaredDistances.clear();
+
+    if (vNodes.empty() || k == 0)
+        return;
+
+    std::vector<std::pair<Scalar, Index>> heap;
+    heap.reserve(k);
+
+    PointType offsets = PointType::Zero();
+    knnHelper(0, point, offsets, 0, k, heap);
+
+    std::sort_heap(heap.begin(), heap.end());
+
+    ids.resize(heap.size());
+    squaredDistances.resize(heap.size());
+    for (Index i = 0; i < heap.size(); ++i) {
+        ids[i] = vIds[heap[i].second];
+        squaredDistances[i] = heap[i].first;
+    }
+}
+
+/**
+ * @brief Find the points in a given radius
+ * @param point Query point
+ * @param radius Radius
+ * @param ids Ids of the points, sorted by distance
+ * @param squaredDistances Squared distance of each point
+ */
+template<class S, EigenId D>
+void KDTree<S,D>::radiusSearch(const PointType& point, const Scalar& radius, std::vector<Index>& ids, std::vector<Scalar>& squaredDistances) const
+{
+    ids.clear();
+    squaredDistances.clear();
+
+    if (vNodes.empty())
+        return;
+
+    std::vector<std::pair<Scalar, Index>> result;
+
+    PointType offsets = PointType::Zero();
+    radiusSearchHelper(0, point, offsets, 0, radius * radius, result);
+
+    std::sort(result.begin(), result.end());
+
+    ids.resize(result.size());
+    squaredDistances.resize(result.size());
+    for (Index i = 0; i < result.size(); ++i) {
+        ids[i] = vIds[result[i].second];
+        squaredDistances[i] = result[i].first;
+    }
+}
+
+/**
+ * @brief Find the nearest point of each query point, in parallel
+ * @param points Query points
+ * @param ids Id of the nearest point of each query point, NULL_ID if the
+ * tree is empty
+ * @param squaredDistances Squared distance of each nearest point
+ */
+template<class S, EigenId D>
+void KDTree<S,D>::nearest(const std::vector<PointType>& points, std::vector<Index>& ids, std::vector<Scalar>& squaredDistances) const
+{
+    knn(points, 1, ids, squaredDistances);
+}
+
+/**
+ * @brief Find the k nearest points of each query point, in parallel
+ * @param points Query points
+ * @param k Number of points
+ * @param ids Ids of the nearest points: the ones of the query point i, sorted
+ * by distance, are in the range [i * k, (i + 1) * k). The range is filled with
+ * NULL_ID if the tree has less than k points.
+ * @param squaredDistances Squared distance of each point (maxLimitValue for
+ * the missing points)
+ */
+template<class S, EigenId D>
+void KDTree<S,D>::knn(const std::vector<PointType>& points, const Size k, std::vector<Index>& ids, std::vector<Scalar>& squaredDistances) const
+{
+    ids.assign(points.size() * k, NULL_ID);
+    squaredDistances.assign(points.size() * k, maxLimitValue<Scalar>());
+
+    if (vNodes.empty() || k == 0)
+        return;
+
+    #pragma omp parallel
+    {
+        std::vector<std::pair<Scalar, Index>> heap;
+        heap.reserve(k);
+
+        #pragma omp for
+        for (Index i = 0; i < points.size(); ++i) {
+            heap.clear();
+
+            PointType offsets = PointType::Zero();
+            knnHelper(0, points[i], offsets, 0, k, heap);
+
+            std::sort_heap(heap.begin(), heap.end());
+
+            for (Index j = 0; j < heap.size(); ++j) {
+                ids[i * k + j] = vIds[heap[j].second];
+                squaredDistances[i * k + j] = heap[j].first;
+            }
+        }
+    }
+}
+
+/**
+ * @brief Find the points in a given radius of each query point, in parallel
+ * @param points Query points
+ * @param radius Radius
+ * @param ids Ids of the points of each query point, sorted by distance
+ * @param squaredDistances Squared distance of each point
+ */
+template<class S, EigenId D>
+void KDTree<S,D>::radiusSearch(const std::vector<PointType>& points, const Scalar& radius, std::vector<std::vector<Index>>& ids, std::vector<std::vector<Scalar>>& squaredDistances) const
+{
+    ids.resize(points.size());
+    squaredDistances.resize(points.size());
+
+    #pragma omp parallel for
+    for (Index i = 0; i < points.size(); ++i) {
+        radiusSearch(points[i], radius, ids[i], squaredDistances[i]);
+    }
+}
+
+/**
+ * @brief Number of points in the tree
+ * @return Number of points
+ */
+template<class S, EigenId D>
+Size KDTree<S,D>::size() const
+{
+    return vPoints.size();
+}
+
+/**
+ * @brief Check if the tree is empty
+ * @return True if the tree is empty
+ */
+template<class S, EigenId D>
+bool KDTree<S,D>::empty() const
+{
+    return vPoints.empty();
+}
+
+/**
+ * @brief Clear the tree
+ */
+template<class S, EigenId D>
+void KDTree<S,D>::clear()
+{
+    vNodes.clear();
+    vPoints.clear();
+    vIds.clear();
+}
+
+/**
+ * @brief Nodes of the tree, the root is the first node
+ * @return Nodes
+ */
+template<class S, EigenId D>
+const std::vector<typename KDTree<S,D>::Node>& KDTree<S,D>::nodes() const
+{
+    return vNodes;
+}
+
+/**
+ * @brief Points, ordered as referenced by the leaves
+ * @return Points
+ */
+template<class S, EigenId D>
+const std::vector<typename KDTree<S,D>::PointType>& KDTree<S,D>::points() const
+{
+    return vPoints;
+}
+
+/**
+ * @brief Point ids, ordered as referenced by the leaves
+ * @return Point ids
+ */
+template<class S, EigenId D>
+const std::vector<Index>& KDTree<S,D>::ids() const
+{
+    return vIds;
+}
+
+/**
+ * @brief Build a node and its subtree
+ * @param points Points
+ * @param order Order of the points
+ * @param nodeId Id of the node
+ * @param begin First point of the node
+ * @param end Last point of the node (excluded)
+ * @param maxLeafElements Max number of points in each leaf
+ */
+template<class S, EigenId D>
+void KDTree<S,D>::buildNode(
+        const std::vector<PointType>& points,
+        std::vector<Index>& order,
+        const Index nodeId,
+        const Index begin,
+        const Index end,
+        const Size maxLeafElements)
+{
+    if (!splitNode(points, order, nodeId, begin, end, maxLeafElements))
+        return;
+
+    const Index mid = begin + (end - begin) / 2;
+
+    buildNode(points, order, vNodes[nodeId].left, begin, mid, maxLeafElements);
+    buildNode(points, order, vNodes[nodeId].right, mid, end, maxLeafElements);
+}
+
+/**
+ * @brief Initialize a node, splitting its points on the median along the
+ * dimension of largest extent. The left child is the next node, the right
+ * child follows the subtree of the left child.
+ * @param points Points
+ * @param order Order of the points
+ * @param nodeId Id of the node
+ * @param begin First point of the node
+ * @param end Last point of the node (excluded)
+ * @param maxLeafElements Max number of points in each leaf
+ * @return True if the node has been split, false if it is a leaf
+ */
+template<class S, EigenId D>
+bool KDTree<S,D>::splitNode(
+        const std::vector<PointType>& points,
+        std::vector<Index>& order,
+        const Index nodeId,
+        const Index begin,
+        const Index end,
+        const Size maxLeafElements)
+{
+    Node& node = vNodes[nodeId];
+    node.begin = begin;
+    node.end = end;
+    node.left = NULL_ID;
+    node.right = NULL_ID;
+    node.dimension = 0;
+    node.split = 0;
+
+    if (end - begin <= maxLeafElements)
+        return false;
+
+    PointType minPoint = points[order[begin]];
+    PointType maxPoint = points[order[begin]];
+    for (Index j = begin + 1; j < end; ++j) {
+        minPoint = minPoint.cwiseMin(points[order[j]]);
+        maxPoint = maxPoint.cwiseMax(points[order[j]]);
+    }
+
+    Eigen::Index dim;
+    (maxPoint - minPoint).maxCoeff(&dim);
+
+    const Index mid = begin + (end - begin) / 2;
+    std::nth_element(
+        order.begin() + begin,
+        order.begin() + mid,
+        order.begin() + end,
+        [&points, &dim](const Index& a, const Index& b) { return points[a](dim) < points[b](dim); });
+
+    node.dimension = static_cast<EigenId>(dim);
+    node.split = points[order[mid]](dim);
+    node.left = nodeId + 1;
+    node.right = nodeId + 1 + nodeNumber(mid - begin, maxLeafElements);
+
+    return true;
+}
+
+/**
+ * @brief Visit a subtree for the k nearest points. The offsets are the
+ * distances, along each dimension, between the point and the region of the
+ * node, so the squared distance of the region is their squared norm.
+ * @param nodeId Id of the node
+ * @param point Query point
+ * @param offsets Offsets between the point and the region of the node
+ * @param offsetDistance Squared distance between the point and the region
+ * @param k Number of points
+ * @param heap Max-heap of the k nearest points found
+ */
+template<class S, EigenId D>
+void KDTree<S,D>::knnHelper(
+        const Index nodeId,
+        const PointType& point,
+        PointType& offsets,
+        const Scalar offsetDistance,
+        const Size k,
+        std::vector<std::pair<Scalar, Index>>& heap) const
+{
+    const Node& node = vNodes[nodeId];
+
+    if (node.isLeaf()) {
+        for (Index j = node.begin; j < node.end; ++j) {
+            const Scalar distance = (vPoints[j] - point).squaredNorm();
+
+            if (heap.size() < k) {
+                heap.push_back(std::make_pair(distance, j));
+                std::push_heap(heap.begin(), heap.end());
+            }
+            else if (distance < heap.front().first) {
+                std::pop_heap(heap.begin(), heap.end());
+                heap.back() = std::make_pair(distance, j);
+                std::push_heap(heap.begin(), heap.end());
+            }
+        }
+
+        return;
+    }
+
+    const Scalar difference = point(node.dimension) - node.split;
+    const Index nearChild = difference <= 0 ? node.left : node.right;
+    const Index farChild = difference <= 0 ? node.right : node.left;
+
+    knnHelper(nearChild, point, offsets, offsetDistance, k, heap);
+
+    const Scalar oldOffset = offsets(node.dimension);
+    const Scalar farDistance = offsetDistance - oldOffset * oldOffset + difference * difference;
+
+    if (heap.size() < k || farDistance < heap.front().first) {
+        offsets(node.dimension) = difference;
+        knnHelper(farChild, point, offsets, farDistance, k, heap);
+        offsets(node.dimension) = oldOffset;
+    }
+}
+
+/**
+ * @brief Visit a subtree for the points in a radius
+ * @param nodeId Id of the node
+ * @param point Query point
+ * @param offsets Offsets between the point and the region of the node
+ * @param offsetDistance Squared distance between the point and the region
+ * @param squaredRadius Squared radius
+ * @param result Points found
+ */
+template<class S, EigenId D>
+void KDTree<S,D>::radiusSearchHelper(
+        const Index nodeId,
+        const PointType& point,
+        PointType& offsets,
+        const Scalar offsetDistance,
+        const Scalar& squaredRadius,
+        std::vector<std::pair<Scalar, Index>>& result) const
+{
+    const Node& node = vNodes[nodeId];
+
+    if (node.isLeaf()) {
+        for (Index j = node.begin; j < node.end; ++j) {
+            const Scalar distance = (vPoints[j] - point).squaredNorm();
+
+            if (distance <= squaredRadius) {
+                result.push_back(std::make_pair(distance, j));
+            }
+        }
+
+        return;
+    }
+
+    const Scalar difference = point(node.dimension) - node.split;
+    const Index nearChild = difference <= 0 ? node.left : node.right;
+    const Index farChild = difference <= 0 ? node.right : node.left;
+
+    radiusSearchHelper(nearChild, point, offsets, offsetDistance, squaredRadius, result);
+
+    const Scalar oldOffset = offsets(node.dimension);
+    const Scalar farDistance = offsetDistance - oldOffset * oldOffset + difference * difference;
+
+    if (farDistance <= squaredRadius) {
+        offsets(node.dimension) = difference;
+        radiusSearchHelper(farChild, point, offsets, farDistance, squaredRadius, result);
+        offsets(node.dimension) = oldOffset;
+    }
+}
+
+/**
+ * @brief Number of nodes of a tree. The sizes of the nodes of each level
+ * differ at most by one, so they are counted level by level.
+ * @param size Number of points
+ * @param maxLeafElements Max number of points in each leaf
+ * @return Number of nodes
+ */
+template<class S, EigenId D>
+Size KDTree<S,D>::nodeNumber(const Size size, const Size maxLeafElements)
+{
+    Size result = 0;
+
+    //Number of nodes of the level with smallSize and smallSize + 1 points
+    Size smallSize = size;
+    Size smallNumber = 1;
+    Size largeNumber = 0;
+
+    while (smallNumber + largeNumber > 0) {
+        if (smallSize + 1 <= maxLeafElements) {
+            result += smallNumber + largeNumber;
+            break;
+        }
+
+        if (smallSize <= maxLeafElements) {
+            result += smallNumber;
+            smallNumber = 0;
+        }
+
+        result += smallNumber + largeNumber;
+
+        //A node with n points has children with n / 2 and n - n / 2 points
+        const Size childSmallSize = smallSize / 2;
+
+        Size childSmallNumber = 0;
+        Size childLargeNumber = 0;
+
+        if (smallSize % 2 == 0) {
+            childSmallNumber += 2 * smallNumber + largeNumber;
+            childLargeNumber += largeNumber;
+        }
+        else {
+            childSmallNumber += smallNumber;
+            childLargeNumber += smallNumber + 2 * largeNumber;
+        }
+
+        smallSize = childSmallSize;
+        smallNumber = childSmallNumber;
+        largeNumber = childLargeNumber;
+    }
+
+    return result;
+}
+
+}
+
+#endif
@@ -0,0 +1,132 @@
+/*
+ * This file is part of nuvolib: https://github.com/stefanonuvoli/nuvolib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Stefano Nuvoli (stefano.nuvoli@gmail.com)
+ */
+#ifndef NVL_STRUCTURES_KDTREE_H
+#define NVL_STRUCTURES_KDTREE_H
+
+#include <nvl/nuvolib.h>
+
+#ifdef NVL_EIGEN_LOADED
+
+#include <nvl/math/point.h>
+
+#include <vector>
+
+#define NVL_KDTREE_DEFAULT_LEAF_ELEMENTS 8
+
+namespace nvl {
+
+/**
+ * @brief Static kd-tree over a set of points. Each node splits its points on
+ * the median along the dimension of largest extent, so the tree is balanced
+ * also on anisotropic point sets. The nodes are stored in a flat vector in
+ * depth-first order, and the points are reordered so that each leaf refers to
+ * a contiguous range of them.
+ * @tparam S Scalar
+ * @tparam D Dimension
+ */
+template<class S, EigenId D = 3>
+class KDTree
+{
+
+public:
+
+    /* Typedefs */
+
+    typedef S Scalar;
+    typedef Point<S,D> PointType;
+
+    struct Node {
+        Index left;
+        Index right;
+        Index begin;
+        Index end;
+        EigenId dimension;
+        Scalar split;
+
+        bool isLeaf() const { return left == NULL_ID; }
+    };
+
+
+    /* Constructors */
+
+    KDTree();
+    KDTree(const std::vector<PointType>& points, const Size maxLeafElements = NVL_KDTREE_DEFAULT_LEAF_ELEMENTS);
+    KDTree(const std::vector<PointType>& points, const std::vector<Index>& ids, const Size maxLeafElements = NVL_KDTREE_DEFAULT_LEAF_ELEMENTS);
+
+
+    /* Methods */
+
+    void build(const std::vector<PointType>& points, const Size maxLeafElements = NVL_KDTREE_DEFAULT_LEAF_ELEMENTS);
+    void build(const std::vector<PointType>& points, const std::vector<Index>& ids, const Size maxLeafElements = NVL_KDTREE_DEFAULT_LEAF_ELEMENTS);
+
+    Index nearest(const PointType& point, Scalar& squaredDistance) const;
+    void knn(const PointType& point, const Size k, std::vector<Index>& ids, std::vector<Scalar>& squaredDistances) const;
+    void radiusSearch(const PointType& point, const Scalar& radius, std::vector<Index>& ids, std::vector<Scalar>& squaredDistances) const;
+
+    void nearest(const std::vector<PointType>& points, std::vector<Index>& ids, std::vector<Scalar>& squaredDistances) const;
+    void knn(const std::vector<PointType>& points, const Size k, std::vector<Index>& ids, std::vector<Scalar>& squaredDistances) const;
+    void radiusSearch(const std::vector<PointType>& points, const Scalar& radius, std::vector<std::vector<Index>>& ids, std::vector<std::vector<Scalar>>& squaredDistances) const;
+
+    Size size() const;
+    bool empty() const;
+
+    void clear();
+
+    const std::vector<Node>& nodes() const;
+    const std::vector<PointType>& points() const;
+    const std::vector<Index>& ids() const;
+
+
+protected:
+
+    std::vector<Node> vNodes;
+    std::vector<PointType> vPoints;
+    std::vector<Index> vIds;
+
+    void buildNode(
+            const std::vector<PointType>& points,
+            std::vector<Index>& order,
+            const Index nodeId,
+            const Index begin,
+            const Index end,
+            const Size maxLeafElements);
+
+    bool splitNode(
+            const std::vector<PointType>& points,
+            std::vector<Index>& order,
+            const Index nodeId,
+            const Index begin,
+            const Index end,
+            const Size maxLeafElements);
+
+    void knnHelper(
+            const Index nodeId,
+            const PointType& point,
+            PointType& offsets,
+            const Scalar offsetDistance,
+            const Size k,
+            std::vector<std::pair<Scalar, Index>>& heap) const;
+
+    void radiusSearchHelper(
+            const Index nodeId,
+            const PointType& point,
+            PointType& offsets,
+            const Scalar offsetDistance,
+            const Scalar& squaredRadius,
+            std::vector<std::pair<Scalar, Index>>& result) const;
+
+    static Size nodeNumber(const Size size, const Size maxLeafElements);
+
+};
+
+}
+
+#endif
+
+#include "kdtree.cpp"
+
+#endif // NVL_STRUCTURES_KDTREE_H
@@ -6,12 +6,36 @@
 
 #include <limits>
 #include <algorithm>
-#include <limits>
+#include <array>
 
 #define NVL_OCTREE_DEFAULT_BOX_ELEMENTS 10
 
 namespace nvl {
 
+template<class K, class T, class R>
+constexpr int Octree<K,T,R>::MAX_DEPTH;
+
+namespace internal {
+
+template<class K, class T, class R>
+void octreeMortonCodes(
+        const K& center,
+        const R& radius,
+        const std::vector<std::pair<K,T>>& vec,
+        std::vector<std::pair<unsigned long long, size_t>>& codes);
+
+NVL_INLINE void octreeMortonSort(
+        std::vector<std::pair<unsigned long long, size_t>>& codes);
+
+NVL_INLINE void octreeMortonSortHelper(
+        std::vector<std::pair<unsigned long long, size_t>>& codes,
+        std::vector<std::pair<unsigned long long, size_t>>& buffer,
+        size_t begin,
+        size_t end,
+        int shift);
+
+}
+
 /**
  * @brief Default constructor
  */
@@ -112,6 +136,7 @@ template<class K, class T, class R>
 void Octree<K,T,R>::construction(const std::vector<K>& vec)
 {
     std::vector<std::pair<K,T>> pairVec;
+    pairVec.reserve(vec.size());
 
     for (const K& entry : vec) {
         pairVec.push_back(std::make_pair(entry, entry));
@@ -121,9 +146,19 @@ void Octree<K,T,R>::construction(const std::vector<K>& vec)
 }
 
 /**
- * @brief Construction of the AABB tree given the initial values (pairs of
+ * @brief Construction of the octree given the initial values (pairs of
  * keys/values)
- * A clear operation is performed before the construction
+ * A clear operation is performed before the construction.
+ * The keys are sorted by their Morton code and the nodes are built top-down,
+ * each one on a contiguous range of the sorted keys: the resulting octree is
+ * the same obtained by inserting the values one by one, with the same
+ * maximum box elements and radius, but the nodes are not deeper than
+ * MAX_DEPTH. The values of each leaf keep the input order.
+ * Keys outside the box of the octree are stored in the nearest leaf, but
+ * they are not found by the search.
+ * The nodes keep their own vectors of values, so the cost of the
+ * construction is still dominated by the allocation of the nodes and by the
+ * copy of the values in them.
  * @param vec Vector of pairs of keys/values
  */
 template<class K, class T, class R>
@@ -134,8 +169,59 @@ void Octree<K,T,R>::construction(const std::vector<std::pair<K,T>>& vec)
     if (vec.size() == 0)
         return;
 
-    for (const std::pair<K,T>& v : vec) {
-        this->insert(v);
+    std::vector<std::pair<unsigned long long, size_t>> codes;
+    internal::octreeMortonCodes(this->center, this->radius, vec, codes);
+    internal::octreeMortonSort(codes);
+
+    this->root = new Node(this->center, this->radius);
+    this->entries = vec.size();
+
+    //The first levels are split sequentially, then the subtrees are built in parallel
+    std::vector<std::pair<Node*, std::pair<size_t, size_t>>> subtrees;
+    subtrees.push_back(std::make_pair(this->root, std::make_pair(0, vec.size())));
+
+    for (size_t depth = 0; depth < 2; ++depth) {
+        std::vector<std::pair<Node*, std::pair<size_t, size_t>>> nextSubtrees;
+
+        for (const std::pair<Node*, std::pair<size_t, size_t>>& subtree : subtrees) {
+            Node* node = subtree.first;
+            const size_t& begin = subtree.second.first;
+            const size_t& end = subtree.second.second;
+
+            if (!this->needsSplitHelper(node, end - begin, depth)) {
+                nextSubtrees.push_back(subtree);
+                continue;
+            }
+
+            node->split();
+
+            const int shift = 3 * (MAX_DEPTH - 1 - static_cast<int>(depth));
+
+            size_t childBegin = begin;
+            for (int i = Node::X0Y0Z0; i <= Node::X1Y1Z1; ++i) {
+                size_t childEnd = childBegin;
+                while (childEnd < end && static_cast<int>((codes[childEnd].first >> shift) & 7) == i) {
+                    ++childEnd;
+                }
+
+                nextSubtrees.push_back(std::make_pair(node->children[i], std::make_pair(childBegin, childEnd)));
+
+                childBegin = childEnd;
+            }
+        }
+
+        subtrees = nextSubtrees;
+    }
+
+    #pragma omp parallel for schedule(dynamic)
+    for (size_t i = 0; i < subtrees.size(); ++i) {
+        Node* node = subtrees[i].first;
+        size_t depth = 0;
+        for (const Node* n = node; n->parent != nullptr; n = n->parent) {
+            ++depth;
+        }
+
+        this->constructionHelper(vec, codes, node, subtrees[i].second.first, subtrees[i].second.second, depth);
     }
 }
 
@@ -278,6 +364,7 @@ void Octree<K,T,R>::clear()
 {
     //Clear
     this->clearHelper(this->root);
+    this->root = nullptr;
 
     //Clear entries
     this->entries = 0;
@@ -437,6 +524,78 @@ void Octree<K,T,R>::initialize()
     this->entries = 0;
 }
 
+/**
+ * @brief Build a subtree on a range of the keys sorted by Morton code
+ * @param vec Vector of pairs of keys/values
+ * @param codes Sorted Morton codes and indices of the keys, the ranges of
+ * the leaves are sorted by index
+ * @param node Root of the subtree
+ * @param begin First key of the range
+ * @param end Last key of the range (excluded)
+ * @param depth Depth of the root of the subtree
+ */
+template<class K, class T, class R>
+void Octree<K,T,R>::constructionHelper(
+        const std::vector<std::pair<K,T>>& vec,
+        std::vector<std::pair<unsigned long long, size_t>>& codes,
+        Node* node,
+        size_t begin,
+        size_t end,
+        size_t depth)
+{
+    if (!this->needsSplitHelper(node, end - begin, depth)) {
+        //The values of the leaf are in the input order, as if they were inserted
+        std::sort(codes.begin() + begin, codes.begin() + end,
+                  [](const std::pair<unsigned long long, size_t>& a, const std::pair<unsigned long long, size_t>& b) {
+            return a.second < b.second;
+        });
+
+        node->values.resize(end - begin);
+        for (size_t i = begin; i < end; ++i) {
+            node->values[i - begin] = vec[codes[i].second];
+        }
+
+        return;
+    }
+
+    node->split();
+
+    //The children are contiguous in the range, ordered by position
+    const int shift = 3 * (MAX_DEPTH - 1 - static_cast<int>(depth));
+
+    size_t childBegin = begin;
+    for (int i = Node::X0Y0Z0; i <= Node::X1Y1Z1; ++i) {
+        size_t childEnd = childBegin;
+        while (childEnd < end && static_cast<int>((codes[childEnd].first >> shift) & 7) == i) {
+            ++childEnd;
+        }
+
+        this->constructionHelper(vec, codes, node->children[i], childBegin, childEnd, depth + 1);
+
+        childBegin = childEnd;
+    }
+}
+
+/**
+ * @brief Check if a node has to be split, with the same criteria of the
+ * insertion
+ * @param node Node
+ * @param size Number of values in the node
+ * @param depth Depth of the node
+ * @return True if the node has to be split
+ */
+template<class K, class T, class R>
+bool Octree<K,T,R>::needsSplitHelper(
+        const Node* node,
+        size_t size,
+        size_t depth) const
+{
+    if (depth >= static_cast<size_t>(MAX_DEPTH))
+        return false;
+
+    return node->radius > maxBoxRadius || size > maxBoxElements;
+}
+
 /**
  * @brief Create a copy of a given octree, having as root
  * the rootNode
@@ -481,61 +640,18 @@ typename Octree<K,T,R>::Node* Octree<K,T,R>::findContainingNodeHelper(
     if (rootNode == nullptr)
         return nullptr;
 
-    if (!rootNode->contains(key)) {
+    //Only the box of the root is checked: the children are chosen with the
+    //same comparisons used when the nodes are split
+    if (rootNode->parent == nullptr && !rootNode->contains(key)) {
         return nullptr;
     }
 
-    const K& center = rootNode->center;
-
-    Node* child = nullptr;
-    if (key.y() > center.y()) {
-        //North (N1, N2, N3, N4)
-        if (key.x() > center.x()) {
-            //North east (N1, N2)
-            if (key.z() > center.z()) {
-                child = rootNode->children[Node::X1Y1Z1];
-            }
-            else {
-                child = rootNode->children[Node::X1Y1Z0];
-            }
-        }
-        else {
-            //North west (N3, N4)
-            if (key.z() > center.z()) {
-                child = rootNode->children[Node::X0Y1Z1];
-            }
-            else {
-                child = rootNode->children[Node::X0Y1Z0];
-            }
-        }
-    }
-    else {
-        //South (S1, S2, S3, S4)
-        if (key.x() > center.x()) {
-            //South east (S1, S2)
-            if (key.z() > center.z()) {
-                child = rootNode->children[Node::X1Y0Z1];
-            }
-            else {
-                child = rootNode->children[Node::X1Y0Z0];
-            }
-        }
-        else {
-            //South west (S3, S4)
-            if (key.z() > center.z()) {
-                child = rootNode->children[Node::X0Y0Z1];
-            }
-            else {
-                child = rootNode->children[Node::X0Y0Z0];
-            }
-        }
-    }
+    Node* child = rootNode->children[rootNode->childPosition(key)];
 
     if (child != nullptr) {
         return this->findContainingNodeHelper(child, key);
     }
 
-    assert(rootNode == nullptr || rootNode->contains(key));
     return rootNode;
 }
 
@@ -553,61 +669,18 @@ const typename Octree<K,T,R>::Node* Octree<K,T,R>::findContainingNodeHelper(
     if (rootNode == nullptr)
         return nullptr;
 
-    if (!rootNode->contains(key)) {
+    //Only the box of the root is checked: the children are chosen with the
+    //same comparisons used when the nodes are split
+    if (rootNode->parent == nullptr && !rootNode->contains(key)) {
         return nullptr;
     }
 
-    const K& center = rootNode->center;
-
-    Node* child = nullptr;
-    if (key.y() > center.y()) {
-        //North (N1, N2, N3, N4)
-        if (key.x() > center.x()) {
-            //North east (N1, N2)
-            if (key.z() > center.z()) {
-                child = rootNode->children[Node::X1Y1Z1];
-            }
-            else {
-                child = rootNode->children[Node::X1Y1Z0];
-            }
-        }
-        else {
-            //North west (N3, N4)
-            if (key.z() > center.z()) {
-                child = rootNode->children[Node::X0Y1Z1];
-            }
-            else {
-                child = rootNode->children[Node::X0Y1Z0];
-            }
-        }
-    }
-    else {
-        //South (S1, S2, S3, S4)
-        if (key.x() > center.x()) {
-            //South east (S1, S2)
-            if (key.z() > center.z()) {
-                child = rootNode->children[Node::X1Y0Z1];
-            }
-            else {
-                child = rootNode->children[Node::X1Y0Z0];
-            }
-        }
-        else {
-            //South west (S3, S4)
-            if (key.z() > center.z()) {
-                child = rootNode->children[Node::X0Y0Z1];
-            }
-            else {
-                child = rootNode->children[Node::X0Y0Z0];
-            }
-        }
-    }
+    const Node* child = rootNode->children[rootNode->childPosition(key)];
 
     if (child != nullptr) {
         return this->findContainingNodeHelper(child, key);
     }
 
-    assert(rootNode == nullptr || rootNode->contains(key));
     return rootNode;
 }
 
@@ -633,4 +706,140 @@ void Octree<K,T,R>::clearHelper(
     rootNode = nullptr;
 }
 
+namespace internal {
+
+/**
+ * @brief Morton codes of the keys in an octree: the three bits of each level,
+ * from the root, are the position of the child containing the key. The
+ * children are chosen with the same comparisons and the same centers used by
+ * the octree, so the codes are consistent with the search of the nodes.
+ * The keys are processed in blocks, one level at a time.
+ * @param center Center of the octree
+ * @param radius Radius of the octree
+ * @param vec Vector of pairs of keys/values
+ * @param codes Morton codes, with 3 * Octree::MAX_DEPTH bits, and indices
+ * of the keys
+ */
+template<class K, class T, class R>
+void octreeMortonCodes(
+        const K& center,
+        const R& radius,
+        const std::vector<std::pair<K,T>>& vec,
+        std::vector<std::pair<unsigned long long, size_t>>& codes)
+{
+    typedef typename K::Scalar Scalar;
+
+    const size_t blockSize = 64;
+    const size_t blockNumber = (vec.size() + blockSize - 1) / blockSize;
+
+    codes.resize(vec.size());
+
+    #pragma omp parallel for
+    for (size_t b = 0; b < blockNumber; ++b) {
+        const size_t begin = b * blockSize;
+        const size_t size = std::min(blockSize, vec.size() - begin);
+
+        Scalar kx[blockSize], ky[blockSize], kz[blockSize];
+        Scalar cx[blockSize], cy[blockSize], cz[blockSize];
+        unsigned long long code[blockSize];
+
+        for (size_t i = 0; i < size; ++i) {
+            kx[i] = vec[begin + i].first.x();
+            ky[i] = vec[begin + i].first.y();
+            kz[i] = vec[begin + i].first.z();
+            cx[i] = center.x();
+            cy[i] = center.y();
+            cz[i] = center.z();
+            code[i] = 0;
+        }
+
+        //The coordinates are updated as the centers of the children in OctreeNode::split
+        R r = radius;
+        for (int depth = 0; depth < Octree<K,T,R>::MAX_DEPTH; ++depth) {
+            r = 0.5 * r;
+
+            #pragma omp simd
+            for (size_t i = 0; i < size; ++i) {
+                const bool x1 = kx[i] >= cx[i];
+                const bool y1 = ky[i] >= cy[i];
+                const bool z1 = kz[i] >= cz[i];
+
+                code[i] = (code[i] << 3) | (static_cast<unsigned long long>(x1) << 2) | (static_cast<unsigned long long>(y1) << 1) | static_cast<unsigned long long>(z1);
+
+                //Multiplying by the sign is exact, and it avoids branches
+                cx[i] = cx[i] + static_cast<Scalar>(2 * static_cast<int>(x1) - 1) * r;
+                cy[i] = cy[i] + static_cast<Scalar>(2 * static_cast<int>(y1) - 1) * r;
+                cz[i] = cz[i] + static_cast<Scalar>(2 * static_cast<int>(z1) - 1) * r;
+            }
+        }
+
+        for (size_t i = 0; i < size; ++i) {
+            codes[begin + i] = std::make_pair(code[i], begin + i);
+        }
+    }
+}
+
+/**
+ * @brief Stable sort of Morton codes, with a most significant digit radix
+ * sort on bytes. The buckets of the first byte are sorted in parallel.
+ * @param codes Morton codes and indices
+ */
+NVL_INLINE void octreeMortonSort(
+        std::vector<std::pair<unsigned long long, size_t>>& codes)
+{
+    std::vector<std::pair<unsigned long long, size_t>> buffer(codes.size());
+
+    octreeMortonSortHelper(codes, buffer, 0, codes.size(), 56);
+}
+
+NVL_INLINE void octreeMortonSortHelper(
+        std::vector<std::pair<unsigned long long, size_t>>& codes,
+        std::vector<std::pair<unsigned long long, size_t>>& buffer,
+        size_t begin,
+        size_t end,
+        int shift)
+{
+    //Small ranges are sorted directly: the indices make the order stable
+    if (end - begin <= 64 || shift < 0) {
+        std::sort(codes.begin() + begin, codes.begin() + end);
+        return;
+    }
+
+    std::array<size_t, 257> offsets;
+    offsets.fill(0);
+
+    for (size_t i = begin; i < end; ++i) {
+        offsets[((codes[i].first >> shift) & 255) + 1]++;
+    }
+
+    //Skip the byte if it is the same for all the codes
+    for (size_t b = 1; b <= 256; ++b) {
+        if (offsets[b] == end - begin) {
+            octreeMortonSortHelper(codes, buffer, begin, end, shift - 8);
+            return;
+        }
+    }
+
+    offsets[0] = begin;
+    for (size_t b = 1; b <= 256; ++b) {
+        offsets[b] += offsets[b - 1];
+    }
+
+    std::array<size_t, 256> positions;
+    std::copy(offsets.begin(), offsets.begin() + 256, positions.begin());
+
+    for (size_t i = begin; i < end; ++i) {
+        buffer[positions[(codes[i].first >> shift) & 255]++] = codes[i];
+    }
+
+    std::copy(buffer.begin() + begin, buffer.begin() + end, codes.begin() + begin);
+
+    #pragma omp parallel for schedule(dynamic) if(begin == 0 && end == codes.size())
+    for (size_t b = 0; b < 256; ++b) {
+        octreeMortonSortHelper(codes, buffer, offsets[b], offsets[b + 1], shift - 8);
+    }
+}
+
+}
+
 }
@@ -1,6 +1,8 @@
 #ifndef NVL_OCTREE_H
 #define NVL_OCTREE_H
 
+#include <nvl/nuvolib.h>
+
 #include "internal/nodes/octree_node.h"
 
 #include <vector>
@@ -23,6 +25,12 @@ public:
 
     typedef internal::OctreeNode<K,T,R> Node;
 
+
+    /* Constants */
+
+    static constexpr int MAX_DEPTH = 21;
+
+
     explicit Octree(const K& center, const R& radius);
     explicit Octree(const K& center, const R& radius, const std::vector<std::pair<K,T>>& vec);
     explicit Octree(const K& center, const R& radius, const std::vector<K>& vec);
@@ -86,6 +94,18 @@ protected:
 
     void initialize();
 
+    void constructionHelper(
+            const std::vector<std::pair<K,T>>& vec,
+            std::vector<std::pair<unsigned long long, size_t>>& codes,
+            Node* node,
+            size_t begin,
+            size_t end,
+            size_t depth);
+    bool needsSplitHelper(
+            const Node* node,
+            size_t size,
+            size_t depth) const;
+
     Node* copySubtreeHelper(
             const Node* rootNode,
             Node* parent = nullptr);
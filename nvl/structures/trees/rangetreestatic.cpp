@@ -0,0 +1,529 @@
+/*
+ * This file is part of nuvolib: https://github.com/stefanonuvoli/nuvolib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Stefano Nuvoli (stefano.nuvoli@gmail.com)
+ */
+#include "rangetreestatic.h"
+
+#include <algorithm>
+#include <limits>
+#include <tuple>
+
+namespace nvl {
+
+
+/* --------- CONSTRUCTORS --------- */
+
+/**
+ * @brief Default constructor
+ *
+ * @param dimension Dimension of the range tree
+ * @param customComparators Vector of comparators for each
+ * dimension of the range tree
+ */
+template<class K, class T, class C>
+RangeTreeStatic<K,T,C>::RangeTreeStatic(
+        const unsigned int dimension,
+        const std::vector<C>& customComparators) :
+    dim(dimension),
+    customComparators(customComparators)
+{
+    assert(dimension > 0 && customComparators.size() >= dimension);
+    this->clear();
+}
+
+/**
+ * @brief Constructor with a vector of entries (key/value pairs)
+ *
+ * @param dimension Dimension of the range tree
+ * @param vec Vector of pairs of keys/values
+ * @param customComparators Vector of comparators for each
+ * dimension of the range tree
+ */
+template<class K, class T, class C>
+RangeTreeStatic<K,T,C>::RangeTreeStatic(
+        const unsigned int dimension,
+        const std::vector<std::pair<K,T>>& vec,
+        const std::vector<C>& customComparators) :
+    dim(dimension),
+    customComparators(customComparators)
+{
+    assert(dimension > 0 && customComparators.size() >= dimension);
+    this->construction(vec);
+}
+
+/**
+ * @brief Constructor with a vector of keys, which are also used as values
+ *
+ * @param dimension Dimension of the range tree
+ * @param vec Vector of keys
+ * @param customComparators Vector of comparators for each
+ * dimension of the range tree
+ */
+template<class K, class T, class C>
+RangeTreeStatic<K,T,C>::RangeTreeStatic(
+        const unsigned int dimension,
+        const std::vector<K>& vec,
+        const std::vector<C>& customComparators) :
+    dim(dimension),
+    customComparators(customComparators)
+{
+    assert(dimension > 0 && customComparators.size() >= dimension);
+    this->construction(vec);
+}
+
+
+
+/* --------- PUBLIC METHODS --------- */
+
+/**
+ * @brief Construction of the range tree given the keys, which are also used
+ * as values
+ *
+ * A clear operation is performed before the construction
+ *
+ * @param vec Vector of keys
+ */
+template<class K, class T, class C>
+void RangeTreeStatic<K,T,C>::construction(const std::vector<K>& vec)
+{
+    std::vector<std::pair<K,T>> pairVec;
+    pairVec.reserve(vec.size());
+
+    for (const K& entry : vec) {
+        pairVec.push_back(std::make_pair(entry, entry));
+    }
+
+    construction(pairVec);
+}
+
+/**
+ * @brief Construction of the range tree given the entries (pairs of
+ * keys/values)
+ *
+ * A clear operation is performed before the construction
+ *
+ * @param vec Vector of pairs of keys/values
+ */
+template<class K, class T, class C>
+void RangeTreeStatic<K,T,C>::construction(const std::vector<std::pair<K,T>>& vec)
+{
+    this->clear();
+
+    assert(vec.size() < std::numeric_limits<LayerIndex>::max());
+
+    vKeys.resize(vec.size());
+    vValues.resize(vec.size());
+    for (Index i = 0; i < vec.size(); ++i) {
+        vKeys[i] = vec[i].first;
+        vValues[i] = vec[i].second;
+    }
+
+    std::vector<LayerIndex> ids(vec.size());
+    for (Index i = 0; i < vec.size(); ++i) {
+        ids[i] = static_cast<LayerIndex>(i);
+    }
+
+    buildLayerHelper(vRoot, dim, ids);
+}
+
+/**
+ * @brief Clear the range tree
+ */
+template<class K, class T, class C>
+void RangeTreeStatic<K,T,C>::clear()
+{
+    vKeys.clear();
+    vValues.clear();
+
+    vRoot = Layer();
+    vRoot.dimension = dim;
+    vRoot.levelNumber = 0;
+}
+
+/**
+ * @brief Get the number of entries
+ *
+ * @return Number of entries
+ */
+template<class K, class T, class C>
+Size RangeTreeStatic<K,T,C>::size() const
+{
+    return vKeys.size();
+}
+
+/**
+ * @brief Check if the range tree is empty
+ *
+ * @return True if the range tree is empty
+ */
+template<class K, class T, class C>
+bool RangeTreeStatic<K,T,C>::empty() const
+{
+    return vKeys.empty();
+}
+
+/**
+ * @brief Range query, the extremes of the range are included
+ *
+ * @param start Starting value of the range
+ * @param end End value of the range
+ * @param out Output iterator for the values of the entries which have keys
+ * enclosed in the input range
+ */
+template<class K, class T, class C> template<class OutputIterator>
+void RangeTreeStatic<K,T,C>::rangeQuery(
+        const K& start, const K& end,
+        OutputIterator out) const
+{
+    if (vKeys.empty())
+        return;
+
+    this->rangeQueryLayerHelper(vRoot, start, end, out);
+}
+
+/**
+ * @brief Keys of the entries, in the order of the construction
+ *
+ * @return Keys
+ */
+template<class K, class T, class C>
+const std::vector<K>& RangeTreeStatic<K,T,C>::keys() const
+{
+    return vKeys;
+}
+
+/**
+ * @brief Values of the entries, in the order of the construction
+ *
+ * @return Values
+ */
+template<class K, class T, class C>
+const std::vector<T>& RangeTreeStatic<K,T,C>::values() const
+{
+    return vValues;
+}
+
+
+
+/* --------- CONSTRUCTION HELPERS --------- */
+
+/**
+ * @brief Build a layer of the range tree over a set of entries. The ids
+ * are sorted by the comparator of the dimension of the layer. The internal
+ * nodes of the implicit tree are numbered in preorder: the left child of the
+ * node with range [begin, end) is the next node, the right one follows the
+ * mid - begin - 1 internal nodes of the left subtree.
+ *
+ * @param layer Layer
+ * @param dimension Number of dimensions of the layer
+ * @param ids Ids of the entries, they are moved into the layer
+ */
+template<class K, class T, class C>
+void RangeTreeStatic<K,T,C>::buildLayerHelper(
+        Layer& layer,
+        const unsigned int dimension,
+        std::vector<LayerIndex>& ids)
+{
+    layer.dimension = dimension;
+    layer.levelNumber = 0;
+
+    const C& comparator = customComparators[dimension - 1];
+    std::sort(ids.begin(), ids.end(), [&](const LayerIndex& a, const LayerIndex& b) {
+        return comparator(vKeys[a], vKeys[b]);
+    });
+    layer.ids.swap(ids);
+
+    const Size n = layer.ids.size();
+
+    if (dimension == 2) {
+        //Number of levels of the implicit tree
+        layer.levelNumber = 1;
+        for (Size s = n; s > 1; s = s - s / 2) {
+            layer.levelNumber++;
+        }
+
+        layer.levelPositions.resize(layer.levelNumber * n);
+        layer.levelLeftCounts.resize(layer.levelNumber * n);
+
+        //First level: positions sorted by the last comparator
+        const C& lastComparator = customComparators[0];
+        for (Index i = 0; i < n; ++i) {
+            layer.levelPositions[i] = static_cast<LayerIndex>(i);
+        }
+        std::stable_sort(layer.levelPositions.begin(), layer.levelPositions.begin() + n, [&](const LayerIndex& a, const LayerIndex& b) {
+            return lastComparator(vKeys[layer.ids[a]], vKeys[layer.ids[b]]);
+        });
+
+        buildCascadeLevelHelper(layer, 0, 0, n);
+    }
+    else if (dimension > 2) {
+        //Internal nodes of the implicit tree in preorder
+        std::vector<std::tuple<Index, Index, Index>> nodes;
+        std::vector<std::tuple<Index, Index, Index>> stack;
+        if (n > 1) {
+            stack.push_back(std::make_tuple(0, 0, n));
+        }
+        while (!stack.empty()) {
+            const std::tuple<Index, Index, Index> node = stack.back();
+            stack.pop_back();
+
+            nodes.push_back(node);
+
+            const Index nodeId = std::get<0>(node);
+            const Index begin = std::get<1>(node);
+            const Index end = std::get<2>(node);
+            const Index mid = begin + (end - begin) / 2;
+
+            if (end - mid > 1) {
+                stack.push_back(std::make_tuple(nodeId + (mid - begin), mid, end));
+            }
+            if (mid - begin > 1) {
+                stack.push_back(std::make_tuple(nodeId + 1, begin, mid));
+            }
+        }
+
+        layer.associatedLayers.resize(nodes.size());
+
+        #pragma omp parallel for schedule(dynamic)
+        for (Index i = 0; i < nodes.size(); ++i) {
+            const Index nodeId = std::get<0>(nodes[i]);
+            const Index begin = std::get<1>(nodes[i]);
+            const Index end = std::get<2>(nodes[i]);
+
+            std::vector<LayerIndex> nodeIds(layer.ids.begin() + begin, layer.ids.begin() + end);
+            buildLayerHelper(layer.associatedLayers[nodeId], dimension - 1, nodeIds);
+        }
+    }
+}
+
+/**
+ * @brief Build the fractional cascading of a node of a two-dimensional layer.
+ * The positions of the node in the level are stably partitioned in the next
+ * level between the children, and for each of them the number of the
+ * previous positions going to the left child is stored.
+ *
+ * @param layer Layer
+ * @param level Level of the node
+ * @param begin First position of the node
+ * @param end Last position of the node (excluded)
+ */
+template<class K, class T, class C>
+void RangeTreeStatic<K,T,C>::buildCascadeLevelHelper(
+        Layer& layer,
+        const Index level,
+        const Index begin,
+        const Index end)
+{
+    if (end - begin <= 1)
+        return;
+
+    const Size n = layer.ids.size();
+    const Index mid = begin + (end - begin) / 2;
+
+    LayerIndex* positions = layer.levelPositions.data() + level * n;
+    LayerIndex* leftCounts = layer.levelLeftCounts.data() + level * n;
+    LayerIndex* nextPositions = layer.levelPositions.data() + (level + 1) * n;
+
+    Index leftCount = 0;
+    for (Index i = begin; i < end; ++i) {
+        leftCounts[i] = static_cast<LayerIndex>(leftCount);
+
+        if (positions[i] < mid) {
+            nextPositions[begin + leftCount] = positions[i];
+            leftCount++;
+        }
+        else {
+            nextPositions[mid + (i - begin - leftCount)] = positions[i];
+        }
+    }
+
+    buildCascadeLevelHelper(layer, level + 1, begin, mid);
+    buildCascadeLevelHelper(layer, level + 1, mid, end);
+}
+
+
+
+/* --------- RANGE QUERY HELPERS --------- */
+
+/**
+ * @brief Range query in a layer
+ *
+ * @param layer Layer
+ * @param start Starting value of the range
+ * @param end End value of the range
+ * @param out Output iterator
+ */
+template<class K, class T, class C> template<class OutputIterator>
+void RangeTreeStatic<K,T,C>::rangeQueryLayerHelper(
+        const Layer& layer,
+        const K& start, const K& end,
+        OutputIterator& out) const
+{
+    const C& comparator = customComparators[layer.dimension - 1];
+
+    //Range of the entries in the dimension of the layer
+    const Index rangeStart = std::lower_bound(layer.ids.begin(), layer.ids.end(), start,
+        [&](const LayerIndex& id, const K& key) { return comparator(vKeys[id], key); }) - layer.ids.begin();
+    const Index rangeEnd = std::upper_bound(layer.ids.begin(), layer.ids.end(), end,
+        [&](const K& key, const LayerIndex& id) { return comparator(key, vKeys[id]); }) - layer.ids.begin();
+
+    if (rangeStart >= rangeEnd)
+        return;
+
+    if (layer.dimension == 1) {
+        for (Index i = rangeStart; i < rangeEnd; ++i) {
+            *out = vValues[layer.ids[i]];
+            out++;
+        }
+    }
+    else if (layer.dimension == 2) {
+        //Range of the entries in the last dimension, in the first level
+        const C& lastComparator = customComparators[0];
+        const Size n = layer.ids.size();
+
+        const Index positionStart = std::lower_bound(layer.levelPositions.begin(), layer.levelPositions.begin() + n, start,
+            [&](const LayerIndex& p, const K& key) { return lastComparator(vKeys[layer.ids[p]], key); }) - layer.levelPositions.begin();
+        const Index positionEnd = std::upper_bound(layer.levelPositions.begin(), layer.levelPositions.begin() + n, end,
+            [&](const K& key, const LayerIndex& p) { return lastComparator(key, vKeys[layer.ids[p]]); }) - layer.levelPositions.begin();
+
+        this->rangeQueryCascadeHelper(layer, 0, 0, n, positionStart, positionEnd, rangeStart, rangeEnd, out);
+    }
+    else {
+        this->rangeQueryAssociatedHelper(layer, 0, 0, layer.ids.size(), rangeStart, rangeEnd, start, end, out);
+    }
+}
+
+/**
+ * @brief Range query in a node of a two-dimensional layer, following the
+ * fractional cascading. The positions in the level which are in the range
+ * of the last dimension are [positionStart, positionEnd).
+ *
+ * @param layer Layer
+ * @param level Level of the node
+ * @param begin First position of the node
+ * @param end Last position of the node (excluded)
+ * @param positionStart First position in the range of the last dimension
+ * @param positionEnd Last position in the range of the last dimension (excluded)
+ * @param rangeStart First entry in the range of the layer dimension
+ * @param rangeEnd Last entry in the range of the layer dimension (excluded)
+ * @param out Output iterator
+ */
+template<class K, class T, class C> template<class OutputIterator>
+void RangeTreeStatic<K,T,C>::rangeQueryCascadeHelper(
+        const Layer& layer,
+        const Index level,
+        const Index begin,
+        const Index end,
+        const Index positionStart,
+        const Index positionEnd,
+        const Index rangeStart,
+        const Index rangeEnd,
+        OutputIterator& out) const
+{
+    if (positionStart >= positionEnd || end <= rangeStart || begin >= rangeEnd)
+        return;
+
+    const Size n = layer.ids.size();
+
+    //Canonical node: report the positions
+    if (rangeStart <= begin && end <= rangeEnd) {
+        const LayerIndex* positions = layer.levelPositions.data() + level * n;
+        for (Index i = positionStart; i < positionEnd; ++i) {
+            *out = vValues[layer.ids[positions[i]]];
+            out++;
+        }
+        return;
+    }
+
+    const Index mid = begin + (end - begin) / 2;
+    const LayerIndex* leftCounts = layer.levelLeftCounts.data() + level * n;
+
+    const Index leftStart = positionStart < end ? leftCounts[positionStart] : mid - begin;
+    const Index leftEnd = positionEnd < end ? leftCounts[positionEnd] : mid - begin;
+
+    this->rangeQueryCascadeHelper(
+                layer, level + 1, begin, mid,
+                begin + leftStart, begin + leftEnd,
+                rangeStart, rangeEnd, out);
+    this->rangeQueryCascadeHelper(
+                layer, level + 1, mid, end,
+                mid + (positionStart - begin - leftStart), mid + (positionEnd - begin - leftEnd),
+                rangeStart, rangeEnd, out);
+}
+
+/**
+ * @brief Range query in a node of a layer with more than two dimensions,
+ * the query continues in the associated layer of the canonical nodes
+ *
+ * @param layer Layer
+ * @param nodeId Preorder id of the node, if internal
+ * @param nodeBegin First entry of the node
+ * @param nodeEnd Last entry of the node (excluded)
+ * @param rangeStart First entry in the range of the layer dimension
+ * @param rangeEnd Last entry in the range of the layer dimension (excluded)
+ * @param start Starting value of the range
+ * @param end End value of the range
+ * @param out Output iterator
+ */
+template<class K, class T, class C> template<class OutputIterator>
+void RangeTreeStatic<K,T,C>::rangeQueryAssociatedHelper(
+        const Layer& layer,
+        const Index nodeId,
+        const Index nodeBegin,
+        const Index nodeEnd,
+        const Index rangeStart,
+        const Index rangeEnd,
+        const K& start, const K& end,
+        OutputIterator& out) const
+{
+    if (nodeEnd <= rangeStart || nodeBegin >= rangeEnd)
+        return;
+
+    //Canonical node
+    if (rangeStart <= nodeBegin && nodeEnd <= rangeEnd) {
+        if (nodeEnd - nodeBegin == 1) {
+            const LayerIndex& id = layer.ids[nodeBegin];
+            if (this->isInRangeHelper(vKeys[id], start, end, layer.dimension - 1)) {
+                *out = vValues[id];
+                out++;
+            }
+        }
+        else {
+            this->rangeQueryLayerHelper(layer.associatedLayers[nodeId], start, end, out);
+        }
+        return;
+    }
+
+    const Index mid = nodeBegin + (nodeEnd - nodeBegin) / 2;
+
+    this->rangeQueryAssociatedHelper(layer, nodeId + 1, nodeBegin, mid, rangeStart, rangeEnd, start, end, out);
+    this->rangeQueryAssociatedHelper(layer, nodeId + (mid - nodeBegin), mid, nodeEnd, rangeStart, rangeEnd, start, end, out);
+}
+
+/**
+ * @brief Check if a key is in the range for the first dimensions
+ *
+ * @param key Key
+ * @param start Starting value of the range
+ * @param end End value of the range
+ * @param dimension Number of dimensions to be checked
+ * @return True if the key is in the range
+ */
+template<class K, class T, class C>
+bool RangeTreeStatic<K,T,C>::isInRangeHelper(
+        const K& key,
+        const K& start, const K& end,
+        const unsigned int dimension) const
+{
+    for (unsigned int d = 0; d < dimension; ++d) {
+        if (customComparators[d](key, start) || customComparators[d](end, key)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+}
@@ -0,0 +1,157 @@
+/*
+ * This file is part of nuvolib: https://github.com/stefanonuvoli/nuvolib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Stefano Nuvoli (stefano.nuvoli@gmail.com)
+ */
+#ifndef NVL_RANGETREESTATIC_H
+#define NVL_RANGETREESTATIC_H
+
+#include <nvl/nuvolib.h>
+
+#include <vector>
+#include <utility>
+
+#include "internal/tree_common.h"
+
+namespace nvl {
+
+/**
+ * @brief Static multi-dimensional range tree
+ *
+ * The tree is built once from the entries and cannot be modified. Keys and
+ * values are stored only once: each layer of the tree refers to them by
+ * index. The tree of a dimension is implicit in the array of the entries
+ * sorted by its comparator, and each internal node has an associated layer
+ * for the next dimension. The layers of the last two dimensions are flat
+ * per-level arrays, sorted by the last comparator, linked by fractional
+ * cascading: a range query costs O(log^(d-1) n + k).
+ * The comparators have the same meaning as in RangeTree: the comparator
+ * dim-1 is used for the first layer and the comparator 0 for the last one.
+ * Duplicates are allowed.
+ */
+template<class K, class T = K, class C = DefaultComparatorType<K>>
+class RangeTreeStatic
+{
+
+public:
+
+    /* Typedefs */
+
+    typedef unsigned int LayerIndex;
+
+    struct Layer {
+        unsigned int dimension;
+        std::vector<LayerIndex> ids;
+        Size levelNumber;
+        std::vector<LayerIndex> levelPositions;
+        std::vector<LayerIndex> levelLeftCounts;
+        std::vector<Layer> associatedLayers;
+    };
+
+
+    /* Constructors */
+
+    explicit RangeTreeStatic(const unsigned int dim,
+              const std::vector<C>& customComparators);
+    explicit RangeTreeStatic(const unsigned int dim,
+              const std::vector<std::pair<K,T>>& vec,
+              const std::vector<C>& customComparators);
+    explicit RangeTreeStatic(const unsigned int dim,
+              const std::vector<K>& vec,
+              const std::vector<C>& customComparators);
+
+
+    /* Public methods */
+
+    void construction(const std::vector<K>& vec);
+    void construction(const std::vector<std::pair<K,T>>& vec);
+
+    void clear();
+
+    Size size() const;
+    bool empty() const;
+
+    template<class OutputIterator>
+    void rangeQuery(
+            const K& start, const K& end,
+            OutputIterator out) const;
+
+    const std::vector<K>& keys() const;
+    const std::vector<T>& values() const;
+
+
+protected:
+
+    /* Protected fields */
+
+    unsigned int dim;
+
+    std::vector<C> customComparators;
+
+    std::vector<K> vKeys;
+    std::vector<T> vValues;
+
+    Layer vRoot;
+
+
+    /* Construction helpers */
+
+    void buildLayerHelper(
+            Layer& layer,
+            const unsigned int dimension,
+            std::vector<LayerIndex>& ids);
+
+    void buildCascadeLevelHelper(
+            Layer& layer,
+            const Index level,
+            const Index begin,
+            const Index end);
+
+
+    /* Range query helpers */
+
+    template<class OutputIterator>
+    inline void rangeQueryLayerHelper(
+            const Layer& layer,
+            const K& start, const K& end,
+            OutputIterator& out) const;
+
+    template<class OutputIterator>
+    inline void rangeQueryCascadeHelper(
+            const Layer& layer,
+            const Index level,
+            const Index begin,
+            const Index end,
+            const Index positionStart,
+            const Index positionEnd,
+            const Index rangeStart,
+            const Index rangeEnd,
+            OutputIterator& out) const;
+
+    template<class OutputIterator>
+    inline void rangeQueryAssociatedHelper(
+            const Layer& layer,
+            const Index nodeId,
+            const Index nodeBegin,
+            const Index nodeEnd,
+            const Index rangeStart,
+            const Index rangeEnd,
+            const K& start, const K& end,
+            OutputIterator& out) const;
+
+    inline bool isInRangeHelper(
+            const K& key,
+            const K& start, const K& end,
+            const unsigned int dimension) const;
+
+};
+
+}
+
+
+#include "rangetreestatic.cpp"
+
+#include "internal/rangetree_types.h"
+
+#endif // NVL_RANGETREESTATIC_H
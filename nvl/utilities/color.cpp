@@ -240,7 +240,7 @@ NVL_INLINE void Color::setHsv(const int h, const int s, const int v, const int a
     assert(v >= 0 && v <= 255);
     assert(alpha >= 0 && alpha <= 255);
 
-    vAlpha = alpha;
+    vAlpha = alpha / 255.0f;
     if (s == 0) {
         vRed = v / 255.0f;
         vGreen = v / 255.0f;
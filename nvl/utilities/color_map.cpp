@@ -0,0 +1,521 @@
+/*
+ * This file is part of nuvolib: https://github.com/stefanonuvoli/nuvolib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Stefano Nuvoli (stefano.nuvoli@gmail.com)
+ */
+#include "color_map.h"
+
+#include <nvl/utilities/color_utils.h>
+
+#include <algorithm>
+#include <cstring>
+
+namespace nvl {
+
+namespace internal {
+
+template<class T>
+void colorMapBlockIds(
+        const T* values,
+        const Size size,
+        const T& minValue,
+        const float scale,
+        const float maxId,
+        std::uint32_t* ids);
+
+template<class T>
+void colorMapLabelBlockIds(
+        const T* labels,
+        const Size size,
+        const Size mapSize,
+        std::uint32_t* ids);
+
+}
+
+/**
+ * @brief Default constructor. Empty color map.
+ */
+NVL_INLINE ColorMap::ColorMap()
+{
+
+}
+
+/**
+ * @brief Constructor with a color ramp
+ * @param colors Colors of the ramp, evenly spaced from the min to the max value
+ * @param size Number of entries of the table
+ */
+NVL_INLINE ColorMap::ColorMap(const std::vector<Color>& colors, const Size size)
+{
+    setColors(colors, size);
+}
+
+/**
+ * @brief Color map blending from red to green, sampled from colorRampRedGreen
+ * @param minIntensity Min intensity color
+ * @param maxIntensity Max intensity color
+ * @param size Number of entries of the table
+ * @return Color map
+ */
+NVL_INLINE ColorMap ColorMap::redGreen(const float minIntensity, const float maxIntensity, const Size size)
+{
+    std::vector<Color> entries(size);
+    for (Index i = 0; i < size; ++i) {
+        const double value = size > 1 ? static_cast<double>(i) / (size - 1) : 0.0;
+        entries[i] = colorRampRedGreen(value, 0.0, 1.0, minIntensity, maxIntensity);
+    }
+
+    ColorMap colorMap;
+    colorMap.setEntries(entries);
+    return colorMap;
+}
+
+/**
+ * @brief Color map blending from red to blue, sampled from colorRampRedBlue
+ * @param minIntensity Min intensity color
+ * @param maxIntensity Max intensity color
+ * @param size Number of entries of the table
+ * @return Color map
+ */
+NVL_INLINE ColorMap ColorMap::redBlue(const float minIntensity, const float maxIntensity, const Size size)
+{
+    std::vector<Color> entries(size);
+    for (Index i = 0; i < size; ++i) {
+        const double value = size > 1 ? static_cast<double>(i) / (size - 1) : 0.0;
+        entries[i] = colorRampRedBlue(value, 0.0, 1.0, minIntensity, maxIntensity);
+    }
+
+    ColorMap colorMap;
+    colorMap.setEntries(entries);
+    return colorMap;
+}
+
+/**
+ * @brief Color map blending from green to blue, sampled from colorRampGreenBlue
+ * @param minIntensity Min intensity color
+ * @param maxIntensity Max intensity color
+ * @param size Number of entries of the table
+ * @return Color map
+ */
+NVL_INLINE ColorMap ColorMap::greenBlue(const float minIntensity, const float maxIntensity, const Size size)
+{
+    std::vector<Color> entries(size);
+    for (Index i = 0; i < size; ++i) {
+        const double value = size > 1 ? static_cast<double>(i) / (size - 1) : 0.0;
+        entries[i] = colorRampGreenBlue(value, 0.0, 1.0, minIntensity, maxIntensity);
+    }
+
+    ColorMap colorMap;
+    colorMap.setEntries(entries);
+    return colorMap;
+}
+
+/**
+ * @brief Perceptually uniform viridis color map. It is interpolated from
+ * ten evenly spaced samples of the original map.
+ * @param size Number of entries of the table
+ * @return Color map
+ */
+NVL_INLINE ColorMap ColorMap::viridis(const Size size)
+{
+    const std::vector<Color> colors = {
+        Color(68, 1, 84),
+        Color(72, 40, 120),
+        Color(62, 74, 137),
+        Color(49, 104, 142),
+        Color(38, 130, 142),
+        Color(31, 158, 137),
+        Color(53, 183, 121),
+        Color(109, 205, 89),
+        Color(181, 222, 43),
+        Color(253, 231, 37)
+    };
+
+    return ColorMap(colors, size);
+}
+
+/**
+ * @brief Color map for labels, blending from red to blue as colorRange
+ * @param number Number of labels
+ * @param saturation Saturation
+ * @param value Value
+ * @return Color map
+ */
+NVL_INLINE ColorMap ColorMap::range(const Size number, const int saturation, const int value)
+{
+    ColorMap colorMap;
+    colorMap.setEntries(colorRange(number, saturation, value));
+    return colorMap;
+}
+
+/**
+ * @brief Color map for labels, maximizing the difference between similar
+ * labels as colorDifferent
+ * @param number Number of labels
+ * @param saturation Saturation
+ * @param value Value
+ * @return Color map
+ */
+NVL_INLINE ColorMap ColorMap::different(const Size number, const int saturation, const int value)
+{
+    ColorMap colorMap;
+    colorMap.setEntries(colorDifferent(number, saturation, value));
+    return colorMap;
+}
+
+/**
+ * @brief Sample the table from a color ramp, interpolating linearly between
+ * the colors
+ * @param colors Colors of the ramp, evenly spaced from the min to the max value
+ * @param size Number of entries of the table
+ */
+NVL_INLINE void ColorMap::setColors(const std::vector<Color>& colors, const Size size)
+{
+    std::vector<Color> entries(colors.empty() ? 0 : size);
+
+    for (Index i = 0; i < entries.size(); ++i) {
+        if (colors.size() == 1 || size == 1) {
+            entries[i] = colors[0];
+            continue;
+        }
+
+        const double position = static_cast<double>(i) * (colors.size() - 1) / (size - 1);
+        const Index colorId = std::min(static_cast<Index>(position), colors.size() - 2);
+
+        entries[i] = colorInterpolation(colors[colorId], colors[colorId + 1], position - colorId);
+    }
+
+    setEntries(entries);
+}
+
+/**
+ * @brief Set the entries of the table
+ * @param entries Colors of the entries
+ */
+NVL_INLINE void ColorMap::setEntries(const std::vector<Color>& entries)
+{
+    vEntriesF.resize(entries.size() * 4);
+    vEntriesI.resize(entries.size());
+
+    for (Index i = 0; i < entries.size(); ++i) {
+        const float channels[4] = { entries[i].redF(), entries[i].greenF(), entries[i].blueF(), entries[i].alphaF() };
+
+        unsigned char bytes[4];
+        for (Index c = 0; c < 4; ++c) {
+            const float channel = std::min(std::max(channels[c], 0.0f), 1.0f);
+            vEntriesF[i * 4 + c] = channel;
+            bytes[c] = static_cast<unsigned char>(channel * 255.0f + 0.5f);
+        }
+
+        std::memcpy(&vEntriesI[i], bytes, 4);
+    }
+}
+
+/**
+ * @brief Number of entries of the table
+ * @return Size
+ */
+NVL_INLINE Size ColorMap::size() const
+{
+    return vEntriesI.size();
+}
+
+/**
+ * @brief Check if the table has no entries
+ * @return True if the table is empty
+ */
+NVL_INLINE bool ColorMap::empty() const
+{
+    return vEntriesI.empty();
+}
+
+/**
+ * @brief Color of an entry
+ * @param id Entry id
+ * @return Color
+ */
+NVL_INLINE Color ColorMap::color(const Index& id) const
+{
+    const float* entry = colorF(id);
+    return Color(entry[0], entry[1], entry[2], entry[3]);
+}
+
+/**
+ * @brief Float RGBA channels of an entry
+ * @param id Entry id
+ * @return Pointer to the four channels
+ */
+NVL_INLINE const float* ColorMap::colorF(const Index& id) const
+{
+    assert(id < size());
+    return &vEntriesF[id * 4];
+}
+
+/**
+ * @brief Byte RGBA channels of an entry
+ * @param id Entry id
+ * @return Pointer to the four channels
+ */
+NVL_INLINE const unsigned char* ColorMap::colorI(const Index& id) const
+{
+    assert(id < size());
+    return reinterpret_cast<const unsigned char*>(&vEntriesI[id]);
+}
+
+/**
+ * @brief Float RGBA channels of all the entries
+ * @return Entries, four floats for each one
+ */
+NVL_INLINE const std::vector<float>& ColorMap::entriesF() const
+{
+    return vEntriesF;
+}
+
+/**
+ * @brief Byte RGBA channels of all the entries, packed in memory order
+ * @return Entries, four bytes for each one
+ */
+NVL_INLINE const std::vector<std::uint32_t>& ColorMap::entriesI() const
+{
+    return vEntriesI;
+}
+
+/**
+ * @brief Map values to float RGBA colors. Each value is mapped to the nearest
+ * entry of the table, values out of the range are clamped. The values are
+ * processed in parallel blocks: the entry ids of a block are computed in a
+ * branch-free loop and then the entries are copied.
+ * @param colorMap Color map
+ * @param values Values
+ * @param number Number of values
+ * @param minValue Value mapped to the first entry
+ * @param maxValue Value mapped to the last entry
+ * @param colors Output buffer of 4 * number floats
+ */
+template<class T>
+void colorMapF(const ColorMap& colorMap, const T* values, const Size number, const T& minValue, const T& maxValue, float* colors)
+{
+    if (colorMap.empty())
+        return;
+
+    const float* entries = colorMap.entriesF().data();
+    const float maxId = static_cast<float>(colorMap.size() - 1);
+    const float scale = maxValue > minValue ? maxId / static_cast<float>(maxValue - minValue) : 0.0f;
+
+    const Size blockNumber = (number + NVL_COLOR_MAP_BLOCK_SIZE - 1) / NVL_COLOR_MAP_BLOCK_SIZE;
+
+    #pragma omp parallel for
+    for (Index bId = 0; bId < blockNumber; ++bId) {
+        const Index begin = bId * NVL_COLOR_MAP_BLOCK_SIZE;
+        const Size size = std::min(static_cast<Size>(NVL_COLOR_MAP_BLOCK_SIZE), number - begin);
+
+        std::uint32_t ids[NVL_COLOR_MAP_BLOCK_SIZE];
+        internal::colorMapBlockIds(values + begin, size, minValue, scale, maxId, ids);
+
+        float* blockColors = colors + begin * 4;
+        for (Index i = 0; i < size; ++i) {
+            std::memcpy(blockColors + i * 4, entries + ids[i] * 4, 4 * sizeof(float));
+        }
+    }
+}
+
+/**
+ * @brief Map values to byte RGBA colors. Each value is mapped to the nearest
+ * entry of the table, values out of the range are clamped.
+ * @param colorMap Color map
+ * @param values Values
+ * @param number Number of values
+ * @param minValue Value mapped to the first entry
+ * @param maxValue Value mapped to the last entry
+ * @param colors Output buffer of 4 * number bytes
+ */
+template<class T>
+void colorMapI(const ColorMap& colorMap, const T* values, const Size number, const T& minValue, const T& maxValue, unsigned char* colors)
+{
+    if (colorMap.empty())
+        return;
+
+    const std::uint32_t* entries = colorMap.entriesI().data();
+    const float maxId = static_cast<float>(colorMap.size() - 1);
+    const float scale = maxValue > minValue ? maxId / static_cast<float>(maxValue - minValue) : 0.0f;
+
+    const Size blockNumber = (number + NVL_COLOR_MAP_BLOCK_SIZE - 1) / NVL_COLOR_MAP_BLOCK_SIZE;
+
+    #pragma omp parallel for
+    for (Index bId = 0; bId < blockNumber; ++bId) {
+        const Index begin = bId * NVL_COLOR_MAP_BLOCK_SIZE;
+        const Size size = std::min(static_cast<Size>(NVL_COLOR_MAP_BLOCK_SIZE), number - begin);
+
+        std::uint32_t ids[NVL_COLOR_MAP_BLOCK_SIZE];
+        internal::colorMapBlockIds(values + begin, size, minValue, scale, maxId, ids);
+
+        unsigned char* blockColors = colors + begin * 4;
+        for (Index i = 0; i < size; ++i) {
+            std::memcpy(blockColors + i * 4, entries + ids[i], 4);
+        }
+    }
+}
+
+/**
+ * @brief Map values to float RGBA colors
+ * @param colorMap Color map
+ * @param values Values
+ * @param minValue Value mapped to the first entry
+ * @param maxValue Value mapped to the last entry
+ * @param colors Output colors, four floats for each value
+ */
+template<class T>
+void colorMapF(const ColorMap& colorMap, const std::vector<T>& values, const T& minValue, const T& maxValue, std::vector<float>& colors)
+{
+    colors.resize(values.size() * 4);
+    colorMapF(colorMap, values.data(), values.size(), minValue, maxValue, colors.data());
+}
+
+/**
+ * @brief Map values to byte RGBA colors
+ * @param colorMap Color map
+ * @param values Values
+ * @param minValue Value mapped to the first entry
+ * @param maxValue Value mapped to the last entry
+ * @param colors Output colors, four bytes for each value
+ */
+template<class T>
+void colorMapI(const ColorMap& colorMap, const std::vector<T>& values, const T& minValue, const T& maxValue, std::vector<unsigned char>& colors)
+{
+    colors.resize(values.size() * 4);
+    colorMapI(colorMap, values.data(), values.size(), minValue, maxValue, colors.data());
+}
+
+/**
+ * @brief Map non-negative labels to float RGBA colors. Each label is mapped
+ * to the entry with the same id, modulo the size of the table.
+ * @param colorMap Color map
+ * @param labels Labels
+ * @param number Number of labels
+ * @param colors Output buffer of 4 * number floats
+ */
+template<class T>
+void colorMapLabelsF(const ColorMap& colorMap, const T* labels, const Size number, float* colors)
+{
+    if (colorMap.empty())
+        return;
+
+    const float* entries = colorMap.entriesF().data();
+
+    const Size blockNumber = (number + NVL_COLOR_MAP_BLOCK_SIZE - 1) / NVL_COLOR_MAP_BLOCK_SIZE;
+
+    #pragma omp parallel for
+    for (Index bId = 0; bId < blockNumber; ++bId) {
+        const Index begin = bId * NVL_COLOR_MAP_BLOCK_SIZE;
+        const Size size = std::min(static_cast<Size>(NVL_COLOR_MAP_BLOCK_SIZE), number - begin);
+
+        std::uint32_t ids[NVL_COLOR_MAP_BLOCK_SIZE];
+        internal::colorMapLabelBlockIds(labels + begin, size, colorMap.size(), ids);
+
+        float* blockColors = colors + begin * 4;
+        for (Index i = 0; i < size; ++i) {
+            std::memcpy(blockColors + i * 4, entries + ids[i] * 4, 4 * sizeof(float));
+        }
+    }
+}
+
+/**
+ * @brief Map non-negative labels to byte RGBA colors. Each label is mapped
+ * to the entry with the same id, modulo the size of the table.
+ * @param colorMap Color map
+ * @param labels Labels
+ * @param number Number of labels
+ * @param colors Output buffer of 4 * number bytes
+ */
+template<class T>
+void colorMapLabelsI(const ColorMap& colorMap, const T* labels, const Size number, unsigned char* colors)
+{
+    if (colorMap.empty())
+        return;
+
+    const std::uint32_t* entries = colorMap.entriesI().data();
+
+    const Size blockNumber = (number + NVL_COLOR_MAP_BLOCK_SIZE - 1) / NVL_COLOR_MAP_BLOCK_SIZE;
+
+    #pragma omp parallel for
+    for (Index bId = 0; bId < blockNumber; ++bId) {
+        const Index begin = bId * NVL_COLOR_MAP_BLOCK_SIZE;
+        const Size size = std::min(static_cast<Size>(NVL_COLOR_MAP_BLOCK_SIZE), number - begin);
+
+        std::uint32_t ids[NVL_COLOR_MAP_BLOCK_SIZE];
+        internal::colorMapLabelBlockIds(labels + begin, size, colorMap.size(), ids);
+
+        unsigned char* blockColors = colors + begin * 4;
+        for (Index i = 0; i < size; ++i) {
+            std::memcpy(blockColors + i * 4, entries + ids[i], 4);
+        }
+    }
+}
+
+/**
+ * @brief Map non-negative labels to float RGBA colors
+ * @param colorMap Color map
+ * @param labels Labels
+ * @param colors Output colors, four floats for each label
+ */
+template<class T>
+void colorMapLabelsF(const ColorMap& colorMap, const std::vector<T>& labels, std::vector<float>& colors)
+{
+    colors.resize(labels.size() * 4);
+    colorMapLabelsF(colorMap, labels.data(), labels.size(), colors.data());
+}
+
+/**
+ * @brief Map non-negative labels to byte RGBA colors
+ * @param colorMap Color map
+ * @param labels Labels
+ * @param colors Output colors, four bytes for each label
+ */
+template<class T>
+void colorMapLabelsI(const ColorMap& colorMap, const std::vector<T>& labels, std::vector<unsigned char>& colors)
+{
+    colors.resize(labels.size() * 4);
+    colorMapLabelsI(colorMap, labels.data(), labels.size(), colors.data());
+}
+
+namespace internal {
+
+/*
+ * The ids are computed with min/max only, so the loop has no branches and can
+ * be vectorized. The order of the arguments of std::max maps NaN values to
+ * the first entry.
+ */
+template<class T>
+void colorMapBlockIds(
+        const T* values,
+        const Size size,
+        const T& minValue,
+        const float scale,
+        const float maxId,
+        std::uint32_t* ids)
+{
+    for (Index i = 0; i < size; ++i) {
+        float position = static_cast<float>(values[i] - minValue) * scale;
+        position = std::max(0.0f, position);
+        position = std::min(position, maxId);
+        ids[i] = static_cast<std::uint32_t>(position + 0.5f);
+    }
+}
+
+template<class T>
+void colorMapLabelBlockIds(
+        const T* labels,
+        const Size size,
+        const Size mapSize,
+        std::uint32_t* ids)
+{
+    for (Index i = 0; i < size; ++i) {
+        assert(labels[i] >= 0);
+        ids[i] = static_cast<std::uint32_t>(static_cast<Index>(labels[i]) % mapSize);
+    }
+}
+
+}
+
+}
@@ -0,0 +1,92 @@
+/*
+ * This file is part of nuvolib: https://github.com/stefanonuvoli/nuvolib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Stefano Nuvoli (stefano.nuvoli@gmail.com)
+ */
+#ifndef NVL_UTILITIES_COLOR_MAP_H
+#define NVL_UTILITIES_COLOR_MAP_H
+
+#include <nvl/nuvolib.h>
+
+#include <nvl/utilities/color.h>
+
+#include <vector>
+#include <cstdint>
+
+#define NVL_COLOR_MAP_DEFAULT_SIZE 1024
+#define NVL_COLOR_MAP_BLOCK_SIZE 256
+
+namespace nvl {
+
+/**
+ * @brief Color lookup table that maps scalar values to colors. The table is
+ * sampled once from a color ramp, and then values are mapped to the nearest
+ * entry, without building a Color for each value. Each entry is stored both
+ * as four floats and as four bytes (RGBA), so the mapping is a copy in both
+ * output formats.
+ */
+class ColorMap
+{
+
+public:
+
+    /* Constructors */
+
+    ColorMap();
+    ColorMap(const std::vector<Color>& colors, const Size size = NVL_COLOR_MAP_DEFAULT_SIZE);
+
+    static ColorMap redGreen(const float minIntensity = 0.0, const float maxIntensity = 1.0, const Size size = NVL_COLOR_MAP_DEFAULT_SIZE);
+    static ColorMap redBlue(const float minIntensity = 0.0, const float maxIntensity = 1.0, const Size size = NVL_COLOR_MAP_DEFAULT_SIZE);
+    static ColorMap greenBlue(const float minIntensity = 0.0, const float maxIntensity = 1.0, const Size size = NVL_COLOR_MAP_DEFAULT_SIZE);
+    static ColorMap viridis(const Size size = NVL_COLOR_MAP_DEFAULT_SIZE);
+    static ColorMap range(const Size number, const int saturation = 131, const int value = 223);
+    static ColorMap different(const Size number, const int saturation = 131, const int value = 223);
+
+
+    /* Methods */
+
+    void setColors(const std::vector<Color>& colors, const Size size = NVL_COLOR_MAP_DEFAULT_SIZE);
+    void setEntries(const std::vector<Color>& entries);
+
+    Size size() const;
+    bool empty() const;
+
+    Color color(const Index& id) const;
+    const float* colorF(const Index& id) const;
+    const unsigned char* colorI(const Index& id) const;
+
+    const std::vector<float>& entriesF() const;
+    const std::vector<std::uint32_t>& entriesI() const;
+
+
+private:
+
+    std::vector<float> vEntriesF;
+    std::vector<std::uint32_t> vEntriesI;
+
+};
+
+template<class T>
+void colorMapF(const ColorMap& colorMap, const T* values, const Size number, const T& minValue, const T& maxValue, float* colors);
+template<class T>
+void colorMapI(const ColorMap& colorMap, const T* values, const Size number, const T& minValue, const T& maxValue, unsigned char* colors);
+template<class T>
+void colorMapF(const ColorMap& colorMap, const std::vector<T>& values, const T& minValue, const T& maxValue, std::vector<float>& colors);
+template<class T>
+void colorMapI(const ColorMap& colorMap, const std::vector<T>& values, const T& minValue, const T& maxValue, std::vector<unsigned char>& colors);
+
+template<class T>
+void colorMapLabelsF(const ColorMap& colorMap, const T* labels, const Size number, float* colors);
+template<class T>
+void colorMapLabelsI(const ColorMap& colorMap, const T* labels, const Size number, unsigned char* colors);
+template<class T>
+void colorMapLabelsF(const ColorMap& colorMap, const std::vector<T>& labels, std::vector<float>& colors);
+template<class T>
+void colorMapLabelsI(const ColorMap& colorMap, const std::vector<T>& labels, std::vector<unsigned char>& colors);
+
+}
+
+#include "color_map.cpp"
+
+#endif // NVL_UTILITIES_COLOR_MAP_H
@@ -0,0 +1,411 @@
+/*
+ * This file is part of nuvolib: https://github.com/stefanonuvoli/nuvolib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Stefano Nuvoli (stefano.nuvoli@gmail.com)
+ */
+#include "profiler.h"
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <cmath>
+
+namespace nvl {
+
+namespace internal {
+
+NVL_INLINE std::string profilerJSONEscape(const char* string)
+{
+    std::string result;
+
+    for (const char* c = string; *c != '\0'; ++c) {
+        if (*c == '"' || *c == '\\') {
+            result.push_back('\\');
+            result.push_back(*c);
+        }
+        else if (static_cast<unsigned char>(*c) < 0x20) {
+            result.push_back(' ');
+        }
+        else {
+            result.push_back(*c);
+        }
+    }
+
+    return result;
+}
+
+NVL_INLINE double profilerPercentile(const std::vector<double>& sortedSamples, const double& percentile)
+{
+    if (sortedSamples.empty())
+        return 0.0;
+
+    const Index id = static_cast<Index>(std::ceil(percentile * sortedSamples.size())) - 1;
+
+    return sortedSamples[std::min(std::max(id, static_cast<Index>(0)), sortedSamples.size() - 1)];
+}
+
+}
+
+/**
+ * @brief Global profiler instance
+ * @return Profiler
+ */
+NVL_INLINE Profiler& Profiler::instance()
+{
+    static Profiler profiler;
+    return profiler;
+}
+
+/**
+ * @brief Default constructor
+ */
+NVL_INLINE Profiler::Profiler() :
+    vEnabled(true),
+    vSampleCapacity(512),
+    vEventCapacity(65536),
+    vNextEvent(0),
+    vEventCount(0),
+    vEpoch(Clock::now()),
+    vFrameStarted(false)
+{
+
+}
+
+/**
+ * @brief Check if the samples are recorded
+ * @return True if the profiler is enabled
+ */
+NVL_INLINE bool Profiler::isEnabled() const
+{
+    return vEnabled;
+}
+
+/**
+ * @brief Enable or disable the recording of the samples
+ * @param enabled Enabled
+ */
+NVL_INLINE void Profiler::setEnabled(const bool enabled)
+{
+    std::lock_guard<std::mutex> lock(vMutex);
+
+    if (enabled && !vEnabled) {
+        vFrameStarted = false;
+    }
+
+    vEnabled = enabled;
+}
+
+/**
+ * @brief Number of samples kept for each zone
+ * @return Capacity
+ */
+NVL_INLINE Size Profiler::sampleCapacity() const
+{
+    return vSampleCapacity;
+}
+
+/**
+ * @brief Set the number of samples kept for each zone. The samples
+ * are cleared.
+ * @param capacity Capacity
+ */
+NVL_INLINE void Profiler::setSampleCapacity(const Size capacity)
+{
+    std::lock_guard<std::mutex> lock(vMutex);
+
+    vSampleCapacity = std::max(capacity, static_cast<Size>(1));
+    vZones.clear();
+}
+
+/**
+ * @brief Number of events kept for the trace
+ * @return Capacity
+ */
+NVL_INLINE Size Profiler::eventCapacity() const
+{
+    return vEventCapacity;
+}
+
+/**
+ * @brief Set the number of events kept for the trace. The events are cleared.
+ * @param capacity Capacity
+ */
+NVL_INLINE void Profiler::setEventCapacity(const Size capacity)
+{
+    std::lock_guard<std::mutex> lock(vMutex);
+
+    vEventCapacity = capacity;
+    vEvents.clear();
+    vNextEvent = 0;
+    vEventCount = 0;
+}
+
+/**
+ * @brief Add a sample to a zone and an event to the trace
+ * @param name Name of the zone, with static storage duration
+ * @param start Start time
+ * @param end End time
+ */
+NVL_INLINE void Profiler::addSample(const char* name, const TimePoint& start, const TimePoint& end)
+{
+    if (!vEnabled)
+        return;
+
+    const double duration = std::chrono::duration<double, std::milli>(end - start).count();
+    const double startMicroseconds = std::chrono::duration<double, std::micro>(start - vEpoch).count();
+    const std::thread::id threadId = std::this_thread::get_id();
+
+    std::lock_guard<std::mutex> lock(vMutex);
+
+    addSampleToZone(name, duration);
+
+    if (vEventCapacity > 0) {
+        if (vEvents.size() < vEventCapacity) {
+            vEvents.resize(vEventCapacity);
+        }
+
+        Event& event = vEvents[vNextEvent];
+        event.name = name;
+        event.start = startMicroseconds;
+        event.duration = duration * 1000.0;
+        event.thread = threadIndex(threadId);
+
+        vNextEvent = (vNextEvent + 1) % vEventCapacity;
+        vEventCount = std::min(vEventCount + 1, vEventCapacity);
+    }
+}
+
+/**
+ * @brief Mark the end of a frame. The time elapsed since the previous mark
+ * is added to the "Frame" zone.
+ */
+NVL_INLINE void Profiler::frameMark()
+{
+    if (!vEnabled)
+        return;
+
+    const TimePoint now = Clock::now();
+
+    std::lock_guard<std::mutex> lock(vMutex);
+
+    if (vFrameStarted) {
+        addSampleToZone("Frame", std::chrono::duration<double, std::milli>(now - vLastFrame).count());
+    }
+
+    vLastFrame = now;
+    vFrameStarted = true;
+}
+
+/**
+ * @brief Statistics of all the zones, sorted by name
+ * @return Summaries
+ */
+NVL_INLINE std::vector<ProfilerSummary> Profiler::summaries() const
+{
+    std::lock_guard<std::mutex> lock(vMutex);
+
+    std::vector<ProfilerSummary> result;
+    result.reserve(vZones.size());
+
+    for (const std::pair<const std::string, Zone>& zone : vZones) {
+        result.push_back(computeSummary(zone.first, zone.second));
+    }
+
+    return result;
+}
+
+/**
+ * @brief Statistics of a zone
+ * @param name Name of the zone
+ * @return Summary, with zero count if the zone has no samples
+ */
+NVL_INLINE ProfilerSummary Profiler::summary(const std::string& name) const
+{
+    std::lock_guard<std::mutex> lock(vMutex);
+
+    std::map<std::string, Zone, std::less<>>::const_iterator it = vZones.find(name);
+    if (it == vZones.end()) {
+        return computeSummary(name, Zone{std::vector<double>(), 0, 0});
+    }
+
+    return computeSummary(name, it->second);
+}
+
+/**
+ * @brief Samples kept for a zone, from the oldest to the newest
+ * @param name Name of the zone
+ * @return Durations in milliseconds
+ */
+NVL_INLINE std::vector<double> Profiler::samples(const std::string& name) const
+{
+    std::lock_guard<std::mutex> lock(vMutex);
+
+    std::map<std::string, Zone, std::less<>>::const_iterator it = vZones.find(name);
+    if (it == vZones.end()) {
+        return std::vector<double>();
+    }
+
+    return orderedSamples(it->second);
+}
+
+/**
+ * @brief Events kept for the trace, in the Chrome trace event format
+ * (chrome://tracing, Perfetto)
+ * @return JSON string
+ */
+NVL_INLINE std::string Profiler::chromeTrace() const
+{
+    std::lock_guard<std::mutex> lock(vMutex);
+
+    std::ostringstream stream;
+    stream << std::fixed << std::setprecision(3);
+
+    stream << "{\"traceEvents\":[";
+
+    const Size firstEvent = vEventCount < vEventCapacity ? 0 : vNextEvent;
+    for (Index i = 0; i < vEventCount; ++i) {
+        const Event& event = vEvents[(firstEvent + i) % vEventCapacity];
+
+        if (i > 0)
+            stream << ",";
+
+        stream << "\n{\"name\":\"" << internal::profilerJSONEscape(event.name) << "\"," <<
+                  "\"cat\":\"nvl\",\"ph\":\"X\"," <<
+                  "\"ts\":" << event.start << "," <<
+                  "\"dur\":" << event.duration << "," <<
+                  "\"pid\":0,\"tid\":" << event.thread << "}";
+    }
+
+    stream << "\n],\"displayTimeUnit\":\"ms\"}\n";
+
+    return stream.str();
+}
+
+/**
+ * @brief Save the events kept for the trace in the Chrome trace event format
+ * @param filename Name of the file
+ * @return True if the file has been written
+ */
+NVL_INLINE bool Profiler::exportChromeTrace(const std::string& filename) const
+{
+    std::ofstream file(filename);
+    if (!file.is_open())
+        return false;
+
+    file << chromeTrace();
+
+    return file.good();
+}
+
+/**
+ * @brief Remove all the samples and the events
+ */
+NVL_INLINE void Profiler::clear()
+{
+    std::lock_guard<std::mutex> lock(vMutex);
+
+    vZones.clear();
+    vEvents.clear();
+    vNextEvent = 0;
+    vEventCount = 0;
+    vFrameStarted = false;
+}
+
+NVL_INLINE void Profiler::addSampleToZone(const char* name, const double& duration)
+{
+    std::map<std::string, Zone, std::less<>>::iterator it = vZones.find(name);
+    if (it == vZones.end()) {
+        it = vZones.emplace(name, Zone{std::vector<double>(vSampleCapacity, 0.0), 0, 0}).first;
+    }
+
+    Zone& zone = it->second;
+    zone.samples[zone.next] = duration;
+    zone.next = (zone.next + 1) % zone.samples.size();
+    zone.count = std::min(zone.count + 1, zone.samples.size());
+}
+
+NVL_INLINE Size Profiler::threadIndex(const std::thread::id& threadId)
+{
+    std::unordered_map<std::thread::id, Size>::iterator it = vThreads.find(threadId);
+    if (it == vThreads.end()) {
+        it = vThreads.emplace(threadId, vThreads.size()).first;
+    }
+
+    return it->second;
+}
+
+NVL_INLINE ProfilerSummary Profiler::computeSummary(const std::string& name, const Zone& zone)
+{
+    ProfilerSummary summary;
+    summary.name = name;
+    summary.count = zone.count;
+    summary.last = 0.0;
+    summary.mean = 0.0;
+    summary.min = 0.0;
+    summary.max = 0.0;
+    summary.p50 = 0.0;
+    summary.p90 = 0.0;
+    summary.p99 = 0.0;
+
+    if (zone.count == 0)
+        return summary;
+
+    std::vector<double> sortedSamples = orderedSamples(zone);
+    summary.last = sortedSamples.back();
+
+    std::sort(sortedSamples.begin(), sortedSamples.end());
+
+    double sum = 0.0;
+    for (const double& sample : sortedSamples) {
+        sum += sample;
+    }
+
+    summary.mean = sum / sortedSamples.size();
+    summary.min = sortedSamples.front();
+    summary.max = sortedSamples.back();
+    summary.p50 = internal::profilerPercentile(sortedSamples, 0.50);
+    summary.p90 = internal::profilerPercentile(sortedSamples, 0.90);
+    summary.p99 = internal::profilerPercentile(sortedSamples, 0.99);
+
+    return summary;
+}
+
+NVL_INLINE std::vector<double> Profiler::orderedSamples(const Zone& zone)
+{
+    std::vector<double> result(zone.count);
+
+    const Size first = zone.count < zone.samples.size() ? 0 : zone.next;
+    for (Index i = 0; i < zone.count; ++i) {
+        result[i] = zone.samples[(first + i) % zone.samples.size()];
+    }
+
+    return result;
+}
+
+
+/**
+ * @brief Constructor, the zone starts
+ * @param name Name of the zone, with static storage duration
+ */
+NVL_INLINE ProfilerZone::ProfilerZone(const char* name) :
+    vName(name),
+    vEnabled(Profiler::instance().isEnabled())
+{
+    if (vEnabled) {
+        vStart = Profiler::Clock::now();
+    }
+}
+
+/**
+ * @brief Destructor, the zone ends and it is added to the profiler
+ */
+NVL_INLINE ProfilerZone::~ProfilerZone()
+{
+    if (vEnabled) {
+        Profiler::instance().addSample(vName, vStart, Profiler::Clock::now());
+    }
+}
+
+}
@@ -0,0 +1,172 @@
+/*
+ * This file is part of nuvolib: https://github.com/stefanonuvoli/nuvolib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Stefano Nuvoli (stefano.nuvoli@gmail.com)
+ */
+#ifndef NVL_UTILITIES_PROFILER_H
+#define NVL_UTILITIES_PROFILER_H
+
+#include <nvl/nuvolib.h>
+
+#include <chrono>
+#include <string>
+#include <vector>
+#include <map>
+#include <unordered_map>
+#include <mutex>
+#include <atomic>
+#include <thread>
+
+namespace nvl {
+
+/**
+ * @brief Statistics of the samples of a profiler zone, in milliseconds.
+ */
+struct ProfilerSummary {
+    std::string name;
+    Size count;
+    double last;
+    double mean;
+    double min;
+    double max;
+    double p50;
+    double p90;
+    double p99;
+};
+
+/**
+ * @brief Collector of the timings of the profiler zones. The last samples of
+ * each zone and the last events are kept in ring buffers, so the memory used
+ * is bounded. The zones are usually recorded with the NVL_PROFILE_ZONE and
+ * NVL_PROFILE_FRAME macros, which are removed at compile time if
+ * NVL_PROFILING is not defined.
+ */
+class Profiler
+{
+
+public:
+
+    typedef std::chrono::high_resolution_clock Clock;
+    typedef Clock::time_point TimePoint;
+
+    struct Event {
+        const char* name;
+        double start;
+        double duration;
+        Size thread;
+    };
+
+    static Profiler& instance();
+
+    bool isEnabled() const;
+    void setEnabled(const bool enabled);
+
+    Size sampleCapacity() const;
+    void setSampleCapacity(const Size capacity);
+    Size eventCapacity() const;
+    void setEventCapacity(const Size capacity);
+
+    void addSample(const char* name, const TimePoint& start, const TimePoint& end);
+    void frameMark();
+
+    std::vector<ProfilerSummary> summaries() const;
+    ProfilerSummary summary(const std::string& name) const;
+    std::vector<double> samples(const std::string& name) const;
+
+    std::string chromeTrace() const;
+    bool exportChromeTrace(const std::string& filename) const;
+
+    void clear();
+
+
+protected:
+
+    Profiler();
+    Profiler(const Profiler& other) = delete;
+    Profiler& operator=(const Profiler& other) = delete;
+
+    struct Zone {
+        std::vector<double> samples;
+        Size next;
+        Size count;
+    };
+
+    mutable std::mutex vMutex;
+
+    std::atomic<bool> vEnabled;
+
+    Size vSampleCapacity;
+    std::map<std::string, Zone, std::less<>> vZones;
+
+    Size vEventCapacity;
+    std::vector<Event> vEvents;
+    Size vNextEvent;
+    Size vEventCount;
+
+    std::unordered_map<std::thread::id, Size> vThreads;
+
+    TimePoint vEpoch;
+    TimePoint vLastFrame;
+    bool vFrameStarted;
+
+    void addSampleToZone(const char* name, const double& duration);
+    Size threadIndex(const std::thread::id& threadId);
+
+    static ProfilerSummary computeSummary(const std::string& name, const Zone& zone);
+    static std::vector<double> orderedSamples(const Zone& zone);
+
+};
+
+/**
+ * @brief Scoped profiler zone: the time between its construction and its
+ * destruction is added to the profiler.
+ * The name must be a string with static storage duration (e.g. a literal).
+ */
+class ProfilerZone
+{
+
+public:
+
+    ProfilerZone(const char* name);
+    ~ProfilerZone();
+
+    ProfilerZone(const ProfilerZone& other) = delete;
+    ProfilerZone& operator=(const ProfilerZone& other) = delete;
+
+private:
+
+    const char* vName;
+    Profiler::TimePoint vStart;
+    bool vEnabled;
+
+};
+
+}
+
+#ifdef NVL_PROFILING
+
+#define NVL_PROFILE_CONCAT_IMPL(a, b) a##b
+#define NVL_PROFILE_CONCAT(a, b) NVL_PROFILE_CONCAT_IMPL(a, b)
+
+/**
+ * @brief Profile the rest of the current scope with the given name.
+ */
+#define NVL_PROFILE_ZONE(name) nvl::ProfilerZone NVL_PROFILE_CONCAT(nvlProfilerZone, __LINE__)(name)
+
+/**
+ * @brief Mark the end of a frame, the time between two marks is sampled
+ * in the "Frame" zone.
+ */
+#define NVL_PROFILE_FRAME() nvl::Profiler::instance().frameMark()
+
+#else
+
+#define NVL_PROFILE_ZONE(name)
+#define NVL_PROFILE_FRAME()
+
+#endif
+
+#include "profiler.cpp"
+
+#endif // NVL_UTILITIES_PROFILER_H
@@ -2,11 +2,13 @@
 
 HEADERS += \
     $$PWD/color.h \
+    $$PWD/color_map.h \
     $$PWD/color_utils.h \
     $$PWD/comparators.h \
     $$PWD/file_utils.h \
     $$PWD/iterator_wrapper.h \
     $$PWD/locale_utils.h \
+    $$PWD/profiler.h \
     $$PWD/random.h \
     $$PWD/string_utils.h \
     $$PWD/timer.h \
@@ -14,11 +16,13 @@ HEADERS += \
 
 SOURCES += \
     $$PWD/color.cpp \
+    $$PWD/color_map.cpp \
     $$PWD/color_utils.cpp \
     $$PWD/comparators.cpp \
     $$PWD/file_utils.cpp \
     $$PWD/iterator_wrapper.cpp \
     $$PWD/locale_utils.cpp \
+    $$PWD/profiler.cpp \
     $$PWD/random.cpp \
     $$PWD/string_utils.cpp \
     $$PWD/timer.cpp \
@@ -10,13 +10,18 @@
 
 #include <nvl/viewer/gl/gl_primitives.h>
 #include <nvl/viewer/gl/gl_draw.h>
-#include <nvl/viewer/gl/gl_textures.h>
+#include <nvl/viewer/gl/gl_texture_manager.h>
+#include <nvl/viewer/gl/gl_buffers.h>
 
 #include <nvl/math/constants.h>
 #include <nvl/math/numeric_limits.h>
 
 #include <nvl/models/algorithms/mesh_geometric_information.h>
 
+#include <nvl/utilities/profiler.h>
+
+#include <algorithm>
+
 
 namespace nvl {
 
@@ -30,6 +35,23 @@ template<class M>
 FaceMeshDrawer<M>::FaceMeshDrawer(M* mesh, const bool visible, const bool pickable) :
     FaceMeshDrawerBase(),
     PolylineMeshDrawer<M>(mesh, visible, pickable),
+    LODable(true),
+    vPackedRendering(false),
+    vPackedDataValid(false),
+    vPackedDataMode(-1),
+    vPackedSourcePositions(nullptr),
+    vPackedSourceNormals(nullptr),
+    vPackedSourceDirty(false),
+    vPackedSourceUploaded(false),
+    vPackedPositionBuffer(0),
+    vPackedNormalBuffer(0),
+    vPackedColorBuffer(0),
+    vPackedUVBuffer(0),
+    vPackedIndexBuffer(0),
+    vLODLevel(0),
+    vLODDataValid(false),
+    vLODIndexBuffer(0),
+    vPickingFaceDataValid(false),
     vDefaultFaceColor(0.7, 0.7, 0.7)
 {
     resetRenderingFaceData();
@@ -40,18 +62,29 @@ template<class M>
 FaceMeshDrawer<M>::~FaceMeshDrawer()
 {
     clearTextures();
+    clearPackedBuffers();
 }
 
 template<class M>
 void FaceMeshDrawer<M>::draw() const
 {
+    NVL_PROFILE_ZONE("FaceMeshDrawer::draw");
+
     if (this->vMesh == nullptr)
         return;
 
+    if (!vTextureHandles.empty()) {
+        GLTextureManager::instance().processUploads();
+        updateTextures();
+    }
+
     PolylineMeshDrawer<M>::draw();
 
     if (this->faceVisible()) {
-        if (this->faceShadingMode() == FaceMeshDrawerBase::FACE_SHADING_SMOOTH) {
+        if (vPackedRendering && glBuffersAvailable()) {
+            drawFacePacked();
+        }
+        else if (this->faceShadingMode() == FaceMeshDrawerBase::FACE_SHADING_SMOOTH) {
             drawFaceSmoothShading();
         }
         else if (this->faceShadingMode() == FaceMeshDrawerBase::FACE_SHADING_FLAT) {
@@ -89,12 +122,68 @@ void FaceMeshDrawer<M>::drawWithNames(Canvas* canvas, const Index drawableId) co
     }
 }
 
+template<class M>
+bool FaceMeshDrawer<M>::rayPick(Canvas* canvas, const Index drawableId, const Point3d& rayOrigin, const Vector3d& rayDirection, double& t) const
+{
+    if (this->vMesh == nullptr || !this->isPickable())
+        return false;
+
+    if (!this->faceVisible() && !this->wireframeVisible())
+        return PolylineMeshDrawer<M>::rayPick(canvas, drawableId, rayOrigin, rayDirection, t);
+
+    Index corner, edge;
+    const Index fId = rayPickFace(rayOrigin, rayDirection, t, corner, edge);
+    if (fId == NULL_ID)
+        return PolylineMeshDrawer<M>::rayPick(canvas, drawableId, rayOrigin, rayDirection, t);
+
+    std::vector<Canvas::PickingData>& pickingNameMap = canvas->pickingDataPool();
+
+    if (this->faceVisible()) {
+        Canvas::PickingData pickingData;
+        pickingData.identifier = Canvas::PICKING_MESH_FACE;
+
+        pickingData.addValue(drawableId);
+        pickingData.addValue(fId);
+
+        pickingNameMap.push_back(pickingData);
+    }
+
+    if (this->vertexVisible()) {
+        Canvas::PickingData pickingData;
+        pickingData.identifier = Canvas::PICKING_MESH_VERTEX;
+
+        pickingData.addValue(drawableId);
+        pickingData.addValue(this->vMesh->face(fId).vertexId(corner));
+
+        pickingNameMap.push_back(pickingData);
+    }
+
+    if (this->wireframeVisible()) {
+        Canvas::PickingData pickingData;
+        pickingData.identifier = Canvas::PICKING_MESH_FACE_EDGE;
+
+        pickingData.addValue(drawableId);
+        pickingData.addValue(fId);
+        pickingData.addValue(edge);
+
+        pickingNameMap.push_back(pickingData);
+    }
+
+    return true;
+}
+
 template<class M>
 void FaceMeshDrawer<M>::update()
 {
+    NVL_PROFILE_ZONE("FaceMeshDrawer::update");
+
+    const bool dirtyUpdate = this->dirtyUpdateAvailable();
+
     PolylineMeshDrawer<M>::update();
 
-    resetRenderingFaceData();
+    if (!dirtyUpdate) {
+        resetRenderingFaceData();
+    }
 }
 
 template<class M>
@@ -109,7 +198,7 @@ bool FaceMeshDrawer<M>::hasFaceColors() const {
 
 template<class M>
 bool FaceMeshDrawer<M>::hasTextures() const {
-    return !this->vTextures.empty();
+    return !this->vTextureHandles.empty();
 }
 
 template<class M>
@@ -179,12 +268,14 @@ void FaceMeshDrawer<M>::resetRenderingData()
 template<class M>
 void FaceMeshDrawer<M>::resetRenderingFaceData()
 {
+    NVL_PROFILE_ZONE("FaceMeshDrawer::resetRenderingFaceData");
+
     typedef typename M::Face Face;
 
     if (this->vMesh == nullptr)
         return;
 
-    vFaceMap.resize(this->vMesh->faceNumber(), NULL_ID);
+    vFaceMap.resize(this->vMesh->nextFaceId(), NULL_ID);
 
     Index i = 0;
     for (const Face& face : this->vMesh->faces()) {
@@ -200,6 +291,8 @@ void FaceMeshDrawer<M>::resetRenderingFaceData()
     resetRenderingFaceMaterials();
 
     loadTextures();
+
+    invalidatePackedData();
 }
 
 template<class M>
@@ -216,6 +309,8 @@ void FaceMeshDrawer<M>::resetRenderingFaces()
 
         resetRenderingFace(fId);
     }
+
+    invalidatePickingData();
 }
 
 template<class M>
@@ -413,6 +508,8 @@ template<class M>
 void FaceMeshDrawer<M>::setRenderingFaces(const std::vector<std::vector<unsigned int>>& renderingFaces)
 {
     this->vRenderingFaces = renderingFaces;
+
+    invalidatePickingData();
 }
 
 template<class M>
@@ -497,9 +594,158 @@ void FaceMeshDrawer<M>::setRenderingFaceMaterial(const Index& id, const Index& m
     this->vRenderingFaceMaterials[mappedId] = m;
 }
 
+template<class M>
+void FaceMeshDrawer<M>::markFaceDirty(const Index& id)
+{
+    vDirtyFaces.push_back(id);
+}
+
+template<class M>
+void FaceMeshDrawer<M>::markFacesDirty(const std::vector<Index>& ids)
+{
+    vDirtyFaces.insert(vDirtyFaces.end(), ids.begin(), ids.end());
+}
+
+template<class M>
+bool FaceMeshDrawer<M>::hasDirtyElements() const
+{
+    return PolylineMeshDrawer<M>::hasDirtyElements() || !vDirtyFaces.empty();
+}
+
+template<class M>
+void FaceMeshDrawer<M>::clearDirtyElements()
+{
+    PolylineMeshDrawer<M>::clearDirtyElements();
+    vDirtyFaces.clear();
+}
+
+template<class M>
+bool FaceMeshDrawer<M>::dirtyUpdateAvailable() const
+{
+    typedef typename M::Face Face;
+
+    if (!PolylineMeshDrawer<M>::dirtyUpdateAvailable())
+        return false;
+
+    if (vFaceMap.size() != this->vMesh->nextFaceId() ||
+            this->vRenderingFaces.size() != this->vMesh->faceNumber() ||
+            this->vMesh->hasFaceNormals() == this->vRenderingFaceNormals.empty() ||
+            this->vMesh->hasFaceMaterials() == this->vRenderingFaceColors.empty() ||
+            this->vMesh->hasFaceMaterials() == this->vRenderingFaceMaterials.empty() ||
+            (this->vMesh->hasVertexUVs() || this->vMesh->hasWedgeUVs()) == this->vRenderingFaceUVs.empty())
+        return false;
+
+    //The vertices and the materials of the dirty faces must be unchanged
+    for (const Index& fId : vDirtyFaces) {
+        if (fId >= this->vMesh->nextFaceId() || this->vMesh->isFaceDeleted(fId) || vFaceMap[fId] == NULL_ID)
+            return false;
+
+        const Face& face = this->vMesh->face(fId);
+        const std::vector<unsigned int>& renderingFace = this->vRenderingFaces[vFaceMap[fId]];
+
+        if (face.vertexNumber() != renderingFace.size())
+            return false;
+
+        for (Index j = 0; j < face.vertexNumber(); ++j) {
+            if (this->vVertexMap[face.vertexId(j)] != renderingFace[j])
+                return false;
+        }
+
+        if (!this->vRenderingFaceMaterials.empty() && this->vRenderingFaceMaterials[vFaceMap[fId]] != this->vMesh->faceMaterial(fId))
+            return false;
+    }
+
+    return true;
+}
+
+template<class M>
+void FaceMeshDrawer<M>::updateDirtyRenderingData()
+{
+    NVL_PROFILE_ZONE("FaceMeshDrawer::updateDirtyRenderingData");
+
+    PolylineMeshDrawer<M>::updateDirtyRenderingData();
+
+    std::sort(vDirtyFaces.begin(), vDirtyFaces.end());
+    vDirtyFaces.erase(std::unique(vDirtyFaces.begin(), vDirtyFaces.end()), vDirtyFaces.end());
+
+    #pragma omp parallel for
+    for (Index i = 0; i < vDirtyFaces.size(); ++i) {
+        const Index& fId = vDirtyFaces[i];
+
+        if (!this->vRenderingFaceNormals.empty()) {
+            resetRenderingFaceNormal(fId);
+        }
+        if (!this->vRenderingFaceColors.empty()) {
+            resetRenderingFaceColor(fId);
+        }
+        if (!this->vRenderingFaceUVs.empty()) {
+            resetRenderingFaceUV(fId);
+        }
+        resetRenderingFaceWireframeColor(fId);
+    }
+
+    //The dirty ranges are only tracked when they are drained by the packed rendering
+    if (vPackedRendering && vPackedDataValid) {
+        for (const Index& vId : this->vDirtyVertices) {
+            vPackedDirtyVertices.push_back(this->vVertexMap[vId]);
+        }
+        for (const Index& fId : vDirtyFaces) {
+            vPackedDirtyFaces.push_back(vFaceMap[fId]);
+        }
+    }
+    else {
+        invalidatePackedData();
+    }
+}
+
+template<class M>
+void FaceMeshDrawer<M>::invalidatePickingData()
+{
+    PolylineMeshDrawer<M>::invalidatePickingData();
+
+    vPickingFaceDataValid = false;
+}
+
+template<class M>
+void FaceMeshDrawer<M>::updatePickingFaceData() const
+{
+    std::vector<Index> faceMap(this->vMesh->nextFaceId(), NULL_ID);
+    for (Index fId = 0; fId < this->vMesh->nextFaceId(); ++fId) {
+        if (!this->vMesh->isFaceDeleted(fId)) {
+            faceMap[fId] = vFaceMap[fId];
+        }
+    }
+
+    std::vector<AlignedBox3d> boxes;
+    pickingFaceBoxes(this->vRenderingVertices, this->vRenderingFaces, faceMap, boxes);
+
+    //The hierarchy is refitted if the faces are unchanged, rebuilt otherwise
+    if (!vPickingFaceBVH.empty() && faceMap == vPickingFaceMap) {
+        vPickingFaceBVH.refit(boxes);
+    }
+    else {
+        vPickingFaceBVH.build(boxes);
+        vPickingFaceMap = std::move(faceMap);
+    }
+
+    vPickingFaceDataValid = true;
+}
+
+template<class M>
+Index FaceMeshDrawer<M>::rayPickFace(const Point3d& rayOrigin, const Vector3d& rayDirection, double& t, Index& corner, Index& edge) const
+{
+    if (!vPickingFaceDataValid) {
+        updatePickingFaceData();
+    }
+
+    return pickingRayFace(this->vRenderingVertices, this->vRenderingFaces, vPickingFaceMap, vPickingFaceBVH, rayOrigin, rayDirection, t, corner, edge);
+}
+
 template<class M>
 void FaceMeshDrawer<M>::loadTextures()
 {
+    NVL_PROFILE_ZONE("FaceMeshDrawer::loadTextures");
+
     typedef typename M::FaceId FaceId;
     typedef typename M::MaterialId MaterialId;
     typedef typename M::Material Material;
@@ -518,23 +764,15 @@ void FaceMeshDrawer<M>::loadTextures()
             }
         }
 
-        vTextures.resize(this->vMesh->nextMaterialId());
+        //The images are decoded asynchronously, the textures are updated in the draw
+        vTextureHandles.resize(this->vMesh->nextMaterialId(), NULL_ID);
+        vTextures.resize(this->vMesh->nextMaterialId(), maxLimitValue<unsigned int>());
         for (const MaterialId& mId : usedMaterials) {
             const Material& mat = this->vMesh->material(mId);
 
-            int texture = nvl::maxLimitValue<unsigned int>();
             if (!mat.diffuseMap().empty()) {
-                GLint glTextureMode;
-                if (this->textureMode() == TextureMode::TEXTURE_MODE_MODULATE) {
-                    glTextureMode = GL_MODULATE;
-                }
-                else {
-                    assert(this->textureMode() == TextureMode::TEXTURE_MODE_REPLACE);
-                    glTextureMode = GL_REPLACE;
-                }
-                texture = glLoadTextureImage(mat.diffuseMap(), glTextureMode);
+                vTextureHandles[mId] = GLTextureManager::instance().request(mat.diffuseMap());
             }
-            vTextures[mId] = texture;
         }
     }
 }
@@ -542,12 +780,170 @@ void FaceMeshDrawer<M>::loadTextures()
 template<class M>
 void FaceMeshDrawer<M>::clearTextures()
 {
-    for (const unsigned int& texture : vTextures) {
-        glDeleteTextures(1, &texture);
+    for (const Index& handle : vTextureHandles) {
+        if (handle != NULL_ID) {
+            GLTextureManager::instance().release(handle);
+        }
     }
+    vTextureHandles.clear();
     vTextures.clear();
 }
 
+template<class M>
+void FaceMeshDrawer<M>::updateTextures() const
+{
+    GLTextureManager& textureManager = GLTextureManager::instance();
+
+    for (Index mId = 0; mId < vTextureHandles.size(); ++mId) {
+        vTextures[mId] = vTextureHandles[mId] != NULL_ID ? textureManager.texture(vTextureHandles[mId]) : maxLimitValue<unsigned int>();
+    }
+}
+
+template<class M>
+bool FaceMeshDrawer<M>::packedRendering() const
+{
+    return vPackedRendering;
+}
+
+template<class M>
+void FaceMeshDrawer<M>::setPackedRendering(const bool value)
+{
+    vPackedRendering = value;
+
+    if (!vPackedRendering) {
+        clearPackedBuffers();
+    }
+}
+
+template<class M>
+const FaceMeshPackedData& FaceMeshDrawer<M>::packedData() const
+{
+    return vPackedData;
+}
+
+template<class M>
+void FaceMeshDrawer<M>::invalidatePackedData()
+{
+    vPackedDataValid = false;
+    vPackedDirtyVertices.clear();
+    vPackedDirtyFaces.clear();
+}
+
+template<class M>
+void FaceMeshDrawer<M>::invalidatePackedVertices()
+{
+    //Positions and normals are refreshed in place, triangles and indices are kept
+    if (!vPackedDataValid)
+        return;
+
+    const Size vertexNumber = this->vRenderingVertices.size() / 3;
+
+    vPackedDirtyVertices.resize(vertexNumber);
+    for (Index i = 0; i < vertexNumber; ++i) {
+        vPackedDirtyVertices[i] = i;
+    }
+}
+
+/**
+ * @brief Set external vertex positions and normals that replace the rendering
+ * ones in the packed buffers. The arrays are not copied, they must stay valid
+ * until the source is changed, and they are read at the next draw. The other
+ * drawing modes and picking still use the rendering vertices.
+ * @param positions Vertex positions (3 values for each rendering vertex),
+ * nullptr to use the rendering vertices again
+ * @param normals Vertex normals (3 values for each rendering vertex), can be nullptr
+ */
+template<class M>
+void FaceMeshDrawer<M>::setPackedVertexSource(const float* positions, const float* normals)
+{
+    if (positions == nullptr) {
+        if (vPackedSourcePositions != nullptr) {
+            vPackedSourcePositions = nullptr;
+            vPackedSourceNormals = nullptr;
+            vPackedSourceDirty = false;
+            invalidatePackedVertices();
+        }
+        return;
+    }
+
+    vPackedSourcePositions = positions;
+    vPackedSourceNormals = normals;
+    vPackedSourceDirty = true;
+}
+
+template<class M>
+void FaceMeshDrawer<M>::clearPackedBuffers()
+{
+    if (vPackedIndexBuffer != 0) {
+        glDeleteBuffer(vPackedPositionBuffer);
+        glDeleteBuffer(vPackedNormalBuffer);
+        glDeleteBuffer(vPackedColorBuffer);
+        glDeleteBuffer(vPackedUVBuffer);
+        glDeleteBuffer(vPackedIndexBuffer);
+    }
+
+    glDeleteBuffer(vLODIndexBuffer);
+
+    vPackedData.clear();
+    vPackedDataMode = -1;
+    vPackedSourceUploaded = false;
+
+    invalidateLODData();
+    invalidatePackedData();
+}
+
+template<class M>
+void FaceMeshDrawer<M>::selectLOD(const Matrix44d& modelViewMatrix, const Matrix44d& projectionMatrix, const double& screenHeight)
+{
+    if (!this->isLODEnabled() || !vLODDataValid) {
+        vLODLevel = 0;
+        return;
+    }
+
+    vLODLevel = faceMeshLODSelectLevel(vLODData, modelViewMatrix, projectionMatrix, screenHeight, this->lodPixelError());
+}
+
+template<class M>
+void FaceMeshDrawer<M>::setLODEnabled(bool lodEnabled)
+{
+    LODable::setLODEnabled(lodEnabled);
+
+    if (!lodEnabled) {
+        vLODLevel = 0;
+    }
+}
+
+template<class M>
+Index FaceMeshDrawer<M>::lodLevel() const
+{
+    return vLODLevel;
+}
+
+template<class M>
+void FaceMeshDrawer<M>::setLODLevel(const Index& level)
+{
+    vLODLevel = level;
+}
+
+template<class M>
+Size FaceMeshDrawer<M>::lodLevelNumber() const
+{
+    return vLODDataValid ? vLODData.levelNumber() : 1;
+}
+
+template<class M>
+const FaceMeshLODData& FaceMeshDrawer<M>::lodData() const
+{
+    return vLODData;
+}
+
+template<class M>
+void FaceMeshDrawer<M>::invalidateLODData()
+{
+    vLODDataValid = false;
+    vLODLevel = 0;
+}
+
 template<class M>
 void FaceMeshDrawer<M>::drawFaceSmoothShading() const
 {
@@ -572,6 +968,7 @@ void FaceMeshDrawer<M>::drawFaceSmoothShading() const
 
     if (textureVisible) {
         glEnable(GL_TEXTURE_2D);
+        glTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, this->textureMode() == TextureMode::TEXTURE_MODE_REPLACE ? GL_REPLACE : GL_MODULATE);
     }
 
     glDepthFunc(GL_LESS);
@@ -708,6 +1105,7 @@ void FaceMeshDrawer<M>::drawFaceFlatShading() const
 
     if (textureVisible) {
         glEnable(GL_TEXTURE_2D);
+        glTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, this->textureMode() == TextureMode::TEXTURE_MODE_REPLACE ? GL_REPLACE : GL_MODULATE);
     }
 
     glDepthFunc(GL_LESS);
@@ -820,6 +1218,316 @@ void FaceMeshDrawer<M>::drawFaceFlatShading() const
     }
 }
 
+template<class M>
+void FaceMeshDrawer<M>::drawFacePacked() const
+{
+    updatePackedData();
+
+    if (this->isLODEnabled()) {
+        updateLODData();
+    }
+
+    //The levels of detail share the vertex buffers of the full resolution mesh
+    const bool lodVisible = this->isLODEnabled() && vLODDataValid && vLODLevel > 0 && vLODLevel < vLODData.levelNumber();
+    const std::vector<Size>& batchOffsets = lodVisible ? vLODData.batchOffsets[vLODLevel] : vPackedData.batchOffsets;
+
+    const bool textureVisible = this->textureVisible() && !vPackedData.uvs.empty();
+
+    if (this->faceLighting()) {
+        glEnable(GL_LIGHTING);
+    }
+    else {
+        glDisable(GL_LIGHTING);
+    }
+
+    if (this->faceTransparency()) {
+        glEnable(GL_BLEND);
+        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+        glAlphaFunc(GL_GREATER, EPSILON);
+        glEnable(GL_ALPHA_TEST);
+
+        glEnable(GL_CULL_FACE);
+        glCullFace(GL_BACK);
+    }
+
+    glDepthFunc(GL_LESS);
+    glDepthRange(0.0001, 1.0);
+
+    glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
+
+    if (this->faceShadingMode() == FaceMeshDrawerBase::FACE_SHADING_SMOOTH) {
+        glShadeModel(GL_SMOOTH);
+    }
+    else {
+        glShadeModel(GL_FLAT);
+    }
+
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glBindBuffer(GL_ARRAY_BUFFER, vPackedPositionBuffer);
+    glVertexPointer(3, GL_FLOAT, 0, nullptr);
+
+    if (!vPackedData.normals.empty()) {
+        glEnableClientState(GL_NORMAL_ARRAY);
+        glBindBuffer(GL_ARRAY_BUFFER, vPackedNormalBuffer);
+        glNormalPointer(GL_FLOAT, 0, nullptr);
+    }
+
+    if (this->faceColorMode() == FaceMeshDrawerBase::FACE_COLOR_UNIFORM) {
+        glColor(this->faceUniformColor());
+    }
+    else if (!vPackedData.colors.empty()) {
+        glEnableClientState(GL_COLOR_ARRAY);
+        glBindBuffer(GL_ARRAY_BUFFER, vPackedColorBuffer);
+        glColorPointer(4, GL_FLOAT, 0, nullptr);
+    }
+    else if (this->faceColorMode() == FaceMeshDrawerBase::FACE_COLOR_PER_FACE) {
+        glColor(vDefaultFaceColor);
+    }
+    else {
+        glColor(this->vDefaultVertexColor);
+    }
+
+    if (textureVisible) {
+        glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+        glBindBuffer(GL_ARRAY_BUFFER, vPackedUVBuffer);
+        glTexCoordPointer(2, GL_FLOAT, 0, nullptr);
+    }
+
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, lodVisible ? vLODIndexBuffer : vPackedIndexBuffer);
+
+    for (Index bId = 0; bId < vPackedData.batchNumber(); ++bId) {
+        const Index& mId = vPackedData.batchMaterials[bId];
+        const Size& begin = batchOffsets[bId];
+        const Size& end = batchOffsets[bId + 1];
+
+        const bool textured = textureVisible && mId != NULL_ID && mId < vTextures.size() && vTextures[mId] != maxLimitValue<unsigned int>();
+        if (textured) {
+            glEnable(GL_TEXTURE_2D);
+            glTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, this->textureMode() == TextureMode::TEXTURE_MODE_REPLACE ? GL_REPLACE : GL_MODULATE);
+            glBindTexture(GL_TEXTURE_2D, vTextures[mId]);
+        }
+
+        glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(end - begin), GL_UNSIGNED_INT, reinterpret_cast<const void*>(begin * sizeof(unsigned int)));
+
+        if (textured) {
+            glBindTexture(GL_TEXTURE_2D, 0);
+            glDisable(GL_TEXTURE_2D);
+        }
+    }
+
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    if (textureVisible) {
+        glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+    }
+
+    glDisableClientState(GL_COLOR_ARRAY);
+    glDisableClientState(GL_NORMAL_ARRAY);
+    glDisableClientState(GL_VERTEX_ARRAY);
+
+    if (this->faceTransparency()) {
+        glDisable(GL_BLEND);
+        glDisable(GL_CULL_FACE);
+        glDisable(GL_ALPHA_TEST);
+    }
+}
+
+template<class M>
+void FaceMeshDrawer<M>::updatePackedData() const
+{
+    const int mode = packedDataMode();
+    const bool packedDataDirty = !vPackedDirtyVertices.empty() || !vPackedDirtyFaces.empty() || vPackedSourceDirty;
+
+    if (vPackedDataValid && mode == vPackedDataMode && !packedDataDirty)
+        return;
+
+    const bool flatShading = this->faceShadingMode() == FaceMeshDrawerBase::FACE_SHADING_FLAT;
+    const bool textureVisible = this->textureVisible() && !vRenderingFaceMaterials.empty() && !vRenderingFaceUVs.empty();
+    const bool averageColors = flatShading && this->faceColorMode() == FaceMeshDrawerBase::FACE_COLOR_PER_VERTEX && !this->vRenderingVertexColors.empty();
+
+    std::vector<double> emptyNormals;
+    std::vector<float> emptyColors;
+    std::vector<std::vector<float>> emptyUVs;
+
+    const std::vector<double>& faceNormals = flatShading ? vRenderingFaceNormals : emptyNormals;
+    const std::vector<std::vector<float>>& faceUVs = textureVisible ? vRenderingFaceUVs : emptyUVs;
+    const std::vector<float>& vertexColors =
+            this->faceColorMode() == FaceMeshDrawerBase::FACE_COLOR_PER_VERTEX ? this->vRenderingVertexColors : emptyColors;
+
+    //Flat shading keeps the face normals, the source replaces only the positions
+    const bool sourceVisible = vPackedSourcePositions != nullptr;
+    const float* sourceNormals = flatShading ? nullptr : vPackedSourceNormals;
+
+    //Only the packed vertices of the dirty elements are updated and uploaded
+    if (vPackedDataValid && mode == vPackedDataMode && !averageColors) {
+        const std::vector<float>& faceColors =
+                this->faceColorMode() == FaceMeshDrawerBase::FACE_COLOR_PER_FACE ? vRenderingFaceColors : emptyColors;
+
+        if (!vPackedDirtyVertices.empty() || !vPackedDirtyFaces.empty()) {
+            std::vector<Index> updatedVertices;
+            faceMeshPackUpdate(
+                this->vRenderingVertices,
+                this->vRenderingVertexNormals,
+                vertexColors,
+                vRenderingFaces,
+                faceNormals,
+                faceColors,
+                faceUVs,
+                vPackedDirtyVertices,
+                vPackedDirtyFaces,
+                vPackedData,
+                updatedVertices);
+
+            std::vector<std::pair<Size, Size>> ranges;
+
+            //Positions and normals of the source are uploaded below
+            faceMeshPackedRanges(updatedVertices, 3, ranges);
+            if (!sourceVisible) {
+                glUploadBuffer(vPackedPositionBuffer, GL_ARRAY_BUFFER, vPackedData.positions, ranges, false);
+            }
+            if (!vPackedData.normals.empty() && (!sourceVisible || sourceNormals == nullptr)) {
+                glUploadBuffer(vPackedNormalBuffer, GL_ARRAY_BUFFER, vPackedData.normals, ranges, false);
+            }
+            if (!vPackedData.colors.empty()) {
+                faceMeshPackedRanges(updatedVertices, 4, ranges);
+                glUploadBuffer(vPackedColorBuffer, GL_ARRAY_BUFFER, vPackedData.colors, ranges, false);
+            }
+            if (!vPackedData.uvs.empty()) {
+                faceMeshPackedRanges(updatedVertices, 2, ranges);
+                glUploadBuffer(vPackedUVBuffer, GL_ARRAY_BUFFER, vPackedData.uvs, ranges, false);
+            }
+
+            //The buffers match the packed data again once all the vertices are uploaded
+            if (sourceVisible) {
+                vPackedSourceUploaded = true;
+            }
+            else if (updatedVertices.size() == vPackedData.vertexNumber()) {
+                vPackedSourceUploaded = false;
+            }
+
+            vPackedDirtyVertices.clear();
+            vPackedDirtyFaces.clear();
+        }
+
+        if (sourceVisible && vPackedSourceDirty) {
+            if (vPackedData.perCorner) {
+                faceMeshPackSource(vPackedSourcePositions, sourceNormals, vRenderingFaces, vPackedData);
+                glUploadBuffer(vPackedPositionBuffer, GL_ARRAY_BUFFER, vPackedData.positions.data(), vPackedData.positions.size(), false);
+                if (sourceNormals != nullptr && !vPackedData.normals.empty()) {
+                    glUploadBuffer(vPackedNormalBuffer, GL_ARRAY_BUFFER, vPackedData.normals.data(), vPackedData.normals.size(), false);
+                }
+            }
+            else {
+                //Shared vertices are uploaded directly from the source, without copies
+                glUploadBuffer(vPackedPositionBuffer, GL_ARRAY_BUFFER, vPackedSourcePositions, vPackedData.positions.size(), false);
+                if (sourceNormals != nullptr && !vPackedData.normals.empty()) {
+                    glUploadBuffer(vPackedNormalBuffer, GL_ARRAY_BUFFER, sourceNormals, vPackedData.normals.size(), false);
+                }
+            }
+
+            vPackedSourceDirty = false;
+            vPackedSourceUploaded = true;
+        }
+
+        return;
+    }
+
+    //Flat shading with vertex colors uses the average color of each face
+    std::vector<float> averageFaceColors;
+    if (averageColors) {
+        averageFaceColors.resize(vRenderingFaces.size() * 4, 0.0f);
+
+        #pragma omp parallel for
+        for (Index fId = 0; fId < vRenderingFaces.size(); ++fId) {
+            for (const unsigned int& vId : vRenderingFaces[fId]) {
+                for (Index k = 0; k < 4; ++k) {
+                    averageFaceColors[fId * 4 + k] += this->vRenderingVertexColors[vId * 4 + k];
+                }
+            }
+            for (Index k = 0; k < 4; ++k) {
+                averageFaceColors[fId * 4 + k] /= std::max(vRenderingFaces[fId].size(), static_cast<Size>(1));
+            }
+        }
+    }
+
+    const std::vector<float>& faceColors =
+            this->faceColorMode() == FaceMeshDrawerBase::FACE_COLOR_PER_FACE ? vRenderingFaceColors : averageFaceColors;
+
+    FaceMeshPackedData newData;
+    faceMeshPackData(
+        this->vRenderingVertices,
+        this->vRenderingVertexNormals,
+        vertexColors,
+        vRenderingFaces,
+        faceNormals,
+        faceColors,
+        faceUVs,
+        vRenderingFaceMaterials,
+        newData);
+
+    if (sourceVisible) {
+        faceMeshPackSource(vPackedSourcePositions, sourceNormals, vRenderingFaces, newData);
+    }
+
+    //Upload only the ranges that changed, the whole arrays if the buffers hold source data
+    const Size blockSize = 4096;
+    std::vector<std::pair<Size, Size>> ranges;
+
+    faceMeshPackedDirtyRanges(vPackedData.positions, newData.positions, blockSize, ranges);
+    glUploadBuffer(vPackedPositionBuffer, GL_ARRAY_BUFFER, newData.positions, ranges, vPackedData.positions.size() != newData.positions.size() || vPackedPositionBuffer == 0 || vPackedSourceUploaded);
+    faceMeshPackedDirtyRanges(vPackedData.normals, newData.normals, blockSize, ranges);
+    glUploadBuffer(vPackedNormalBuffer, GL_ARRAY_BUFFER, newData.normals, ranges, vPackedData.normals.size() != newData.normals.size() || vPackedNormalBuffer == 0 || vPackedSourceUploaded);
+    faceMeshPackedDirtyRanges(vPackedData.colors, newData.colors, blockSize, ranges);
+    glUploadBuffer(vPackedColorBuffer, GL_ARRAY_BUFFER, newData.colors, ranges, vPackedData.colors.size() != newData.colors.size() || vPackedColorBuffer == 0);
+    faceMeshPackedDirtyRanges(vPackedData.uvs, newData.uvs, blockSize, ranges);
+    glUploadBuffer(vPackedUVBuffer, GL_ARRAY_BUFFER, newData.uvs, ranges, vPackedData.uvs.size() != newData.uvs.size() || vPackedUVBuffer == 0);
+    faceMeshPackedDirtyRanges(vPackedData.indices, newData.indices, blockSize, ranges);
+    glUploadBuffer(vPackedIndexBuffer, GL_ELEMENT_ARRAY_BUFFER, newData.indices, ranges, vPackedData.indices.size() != newData.indices.size() || vPackedIndexBuffer == 0);
+
+    //The levels of detail depend only on the triangles
+    if (vPackedData.indices != newData.indices || vPackedData.batchOffsets != newData.batchOffsets) {
+        vLODDataValid = false;
+    }
+
+    vPackedData = std::move(newData);
+    vPackedDataValid = true;
+    vPackedDataMode = mode;
+
+    vPackedDirtyVertices.clear();
+    vPackedDirtyFaces.clear();
+    vPackedSourceDirty = false;
+    vPackedSourceUploaded = false;
+}
+
+template<class M>
+int FaceMeshDrawer<M>::packedDataMode() const
+{
+    return static_cast<int>(this->faceShadingMode()) * 6 +
+           static_cast<int>(this->faceColorMode()) * 2 +
+           (this->textureVisible() ? 1 : 0);
+}
+
+template<class M>
+void FaceMeshDrawer<M>::updateLODData() const
+{
+    if (vLODDataValid)
+        return;
+
+    NVL_PROFILE_ZONE("FaceMeshDrawer::updateLODData");
+
+    faceMeshLODBuild(vPackedData.positions, vPackedData.indices, vPackedData.batchOffsets, vLODData);
+
+    if (vLODData.levelNumber() > 1) {
+        glUploadBuffer(vLODIndexBuffer, GL_ELEMENT_ARRAY_BUFFER, vLODData.indices, std::vector<std::pair<Size, Size>>(), true);
+    }
+    else {
+        glDeleteBuffer(vLODIndexBuffer);
+    }
+
+    vLODDataValid = true;
+}
+
 template<class M>
 void FaceMeshDrawer<M>::drawWireframe() const
 {
@@ -11,6 +11,9 @@
 
 #include <nvl/viewer/drawables/polyline_mesh_drawer.h>
 #include <nvl/viewer/drawables/face_mesh_drawer_base.h>
+#include <nvl/viewer/drawables/face_mesh_packing.h>
+#include <nvl/viewer/drawables/face_mesh_lod.h>
+#include <nvl/viewer/interfaces/lodable.h>
 
 #include <nvl/utilities/color.h>
 
@@ -21,7 +24,8 @@ namespace nvl {
 template<class M>
 class FaceMeshDrawer :
         public FaceMeshDrawerBase,
-        public PolylineMeshDrawer<M>
+        public PolylineMeshDrawer<M>,
+        public LODable
 {
 
 public:
@@ -32,6 +36,7 @@ public:
 
     virtual void draw() const override;
     virtual void drawWithNames(Canvas* canvas, const Index drawableId) const override;
+    virtual bool rayPick(Canvas* canvas, const Index drawableId, const Point3d& rayOrigin, const Vector3d& rayDirection, double& t) const override;
 
     virtual void update() override;
 
@@ -78,14 +83,38 @@ public:
     void setRenderingFaceWireframeColor(const Index& id, const Color& c);
     void setRenderingFaceMaterial(const Index& id, const Index& m);
 
+    void markFaceDirty(const Index& id);
+    void markFacesDirty(const std::vector<Index>& ids);
+    virtual bool hasDirtyElements() const override;
+    virtual void clearDirtyElements() override;
+
+    virtual void invalidatePickingData() override;
+
     void loadTextures();
     void clearTextures();
 
+    bool packedRendering() const;
+    void setPackedRendering(const bool value);
+    const FaceMeshPackedData& packedData() const;
+    void invalidatePackedData();
+    void invalidatePackedVertices();
+    void setPackedVertexSource(const float* positions, const float* normals);
+    void clearPackedBuffers();
+
+    virtual void selectLOD(const Matrix44d& modelViewMatrix, const Matrix44d& projectionMatrix, const double& screenHeight) override;
+    virtual void setLODEnabled(bool lodEnabled) override;
+    Index lodLevel() const;
+    void setLODLevel(const Index& level);
+    Size lodLevelNumber() const;
+    const FaceMeshLODData& lodData() const;
+    void invalidateLODData();
+
 protected:
 
     std::vector<Index> vFaceMap;
 
-    std::vector<unsigned int> vTextures;
+    std::vector<Index> vTextureHandles;
+    mutable std::vector<unsigned int> vTextures;
 
     std::vector<std::vector<unsigned int>> vRenderingFaces;
     std::vector<double> vRenderingFaceNormals;
@@ -94,8 +123,47 @@ protected:
     std::vector<float> vRenderingFaceWireframeColors;
     std::vector<Index> vRenderingFaceMaterials;
 
+    std::vector<Index> vDirtyFaces;
+
+    virtual bool dirtyUpdateAvailable() const override;
+    virtual void updateDirtyRenderingData() override;
+
+    bool vPackedRendering;
+    mutable bool vPackedDataValid;
+    mutable int vPackedDataMode;
+    mutable FaceMeshPackedData vPackedData;
+    mutable std::vector<Index> vPackedDirtyVertices;
+    mutable std::vector<Index> vPackedDirtyFaces;
+    const float* vPackedSourcePositions;
+    const float* vPackedSourceNormals;
+    mutable bool vPackedSourceDirty;
+    mutable bool vPackedSourceUploaded;
+    mutable unsigned int vPackedPositionBuffer;
+    mutable unsigned int vPackedNormalBuffer;
+    mutable unsigned int vPackedColorBuffer;
+    mutable unsigned int vPackedUVBuffer;
+    mutable unsigned int vPackedIndexBuffer;
+
+    Index vLODLevel;
+    mutable bool vLODDataValid;
+    mutable FaceMeshLODData vLODData;
+    mutable unsigned int vLODIndexBuffer;
+
+    mutable bool vPickingFaceDataValid;
+    mutable std::vector<Index> vPickingFaceMap;
+    mutable BVH<double,3> vPickingFaceBVH;
+
+    void updateTextures() const;
+
+    void updatePickingFaceData() const;
+    Index rayPickFace(const Point3d& rayOrigin, const Vector3d& rayDirection, double& t, Index& corner, Index& edge) const;
+
     void drawFaceSmoothShading() const;
     void drawFaceFlatShading() const;
+    void drawFacePacked() const;
+    void updatePackedData() const;
+    int packedDataMode() const;
+    void updateLODData() const;
     void drawWireframe() const;
     void drawFaceNormals() const;
 
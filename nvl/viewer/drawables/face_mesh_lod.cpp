@@ -0,0 +1,313 @@
+/*
+ * This file is part of nuvolib: https://github.com/stefanonuvoli/nuvolib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Stefano Nuvoli (stefano.nuvoli@gmail.com)
+ */
+#include "face_mesh_lod.h"
+
+#include <nvl/math/numeric_limits.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+namespace nvl {
+
+NVL_INLINE Size FaceMeshLODData::levelNumber() const
+{
+    return errors.size();
+}
+
+NVL_INLINE Size FaceMeshLODData::triangleNumber(const Index& level) const
+{
+    if (level >= batchOffsets.size() || batchOffsets[level].empty())
+        return 0;
+
+    return (batchOffsets[level].back() - batchOffsets[level].front()) / 3;
+}
+
+NVL_INLINE void FaceMeshLODData::clear()
+{
+    indices.clear();
+    batchOffsets.clear();
+    errors.clear();
+    center = Point3d::Zero();
+    radius = 0.0;
+}
+
+/**
+ * @brief Build the levels of detail of a packed triangle mesh by vertex
+ * clustering. Each level clusters the vertices on a uniform grid, whose cell
+ * size doubles at each level, and replaces the vertices of each cell (and
+ * material batch) with the vertex of the cell nearest to their mean. The
+ * triangles which become degenerate or duplicated are removed.
+ * No new vertex is created, so the levels can be drawn with the vertex
+ * buffers of the full resolution mesh.
+ * @param positions Packed vertex positions
+ * @param indices Packed triangle indices
+ * @param batchOffsets Offsets of the material batches in the indices
+ * @param data Output levels of detail
+ * @param minTriangleNumber Minimum number of triangles to build the levels:
+ * smaller meshes have only the level 0
+ * @param maxLevelNumber Maximum number of levels, including the level 0
+ */
+NVL_INLINE void faceMeshLODBuild(
+        const std::vector<float>& positions,
+        const std::vector<unsigned int>& indices,
+        const std::vector<Size>& batchOffsets,
+        FaceMeshLODData& data,
+        const Size minTriangleNumber,
+        const Size maxLevelNumber)
+{
+    typedef unsigned long long CellKey;
+    typedef std::array<unsigned int, 3> Triangle;
+
+    data.clear();
+
+    //The level 0 is the full resolution mesh
+    data.batchOffsets.push_back(batchOffsets);
+    data.errors.push_back(0.0);
+
+    const Size vertexNumber = positions.size() / 3;
+    const Size triangleNumber = indices.size() / 3;
+
+    if (vertexNumber == 0 || batchOffsets.empty())
+        return;
+
+    Point3d minPoint = Point3d::Constant(maxLimitValue<double>());
+    Point3d maxPoint = Point3d::Constant(-maxLimitValue<double>());
+    for (Index vId = 0; vId < vertexNumber; ++vId) {
+        const Point3d point(positions[vId * 3], positions[vId * 3 + 1], positions[vId * 3 + 2]);
+        minPoint = minPoint.cwiseMin(point);
+        maxPoint = maxPoint.cwiseMax(point);
+    }
+
+    data.center = (minPoint + maxPoint) / 2.0;
+    data.radius = (maxPoint - minPoint).norm() / 2.0;
+
+    if (triangleNumber < minTriangleNumber || data.radius <= 0.0)
+        return;
+
+    //The first cell size is twice the mean edge length
+    double edgeLengthSum = 0.0;
+
+    #pragma omp parallel for reduction(+:edgeLengthSum)
+    for (Index tId = 0; tId < triangleNumber; ++tId) {
+        for (Index j = 0; j < 3; ++j) {
+            const unsigned int& vId1 = indices[tId * 3 + j];
+            const unsigned int& vId2 = indices[tId * 3 + (j + 1) % 3];
+
+            const Point3d p1(positions[vId1 * 3], positions[vId1 * 3 + 1], positions[vId1 * 3 + 2]);
+            const Point3d p2(positions[vId2 * 3], positions[vId2 * 3 + 1], positions[vId2 * 3 + 2]);
+
+            edgeLengthSum += (p2 - p1).norm();
+        }
+    }
+
+    double cellSize = 2.0 * edgeLengthSum / (triangleNumber * 3);
+    if (cellSize <= 0.0)
+        return;
+
+    const CellKey maxCellCoordinate = (1ull << 21) - 1;
+
+    std::vector<CellKey> cellKeys(vertexNumber);
+    std::vector<unsigned int> representatives(vertexNumber);
+    std::vector<Index> vertexStamps(vertexNumber, NULL_ID);
+    Index stamp = 0;
+
+    std::vector<unsigned int> batchVertices;
+    std::vector<Triangle> batchTriangles;
+
+    std::vector<unsigned int> levelIndices;
+    std::vector<Size> levelOffsets;
+
+    Size previousTriangleNumber = triangleNumber;
+
+    while (data.levelNumber() < maxLevelNumber && cellSize < 2.0 * data.radius) {
+        #pragma omp parallel for
+        for (Index vId = 0; vId < vertexNumber; ++vId) {
+            CellKey key = 0;
+            for (Index k = 0; k < 3; ++k) {
+                const double coordinate = std::floor((positions[vId * 3 + k] - minPoint(k)) / cellSize);
+                const CellKey cellCoordinate = std::min(static_cast<CellKey>(std::max(coordinate, 0.0)), maxCellCoordinate);
+                key = (key << 21) | cellCoordinate;
+            }
+            cellKeys[vId] = key;
+        }
+
+        levelIndices.clear();
+        levelOffsets.clear();
+        levelOffsets.push_back(0);
+
+        double error = data.errors.back();
+
+        for (Index bId = 0; bId + 1 < batchOffsets.size(); ++bId) {
+            const Size& begin = batchOffsets[bId];
+            const Size& end = batchOffsets[bId + 1];
+
+            batchVertices.clear();
+            for (Index i = begin; i < end; ++i) {
+                const unsigned int& vId = indices[i];
+                if (vertexStamps[vId] != stamp) {
+                    vertexStamps[vId] = stamp;
+                    batchVertices.push_back(vId);
+                }
+            }
+            ++stamp;
+
+            std::sort(batchVertices.begin(), batchVertices.end(), [&](const unsigned int& a, const unsigned int& b) {
+                return cellKeys[a] < cellKeys[b] || (cellKeys[a] == cellKeys[b] && a < b);
+            });
+
+            //Each cell is replaced by the vertex nearest to the mean of its vertices
+            Index groupBegin = 0;
+            while (groupBegin < batchVertices.size()) {
+                Index groupEnd = groupBegin + 1;
+                while (groupEnd < batchVertices.size() && cellKeys[batchVertices[groupEnd]] == cellKeys[batchVertices[groupBegin]]) {
+                    ++groupEnd;
+                }
+
+                Point3d mean = Point3d::Zero();
+                for (Index i = groupBegin; i < groupEnd; ++i) {
+                    const unsigned int& vId = batchVertices[i];
+                    mean += Point3d(positions[vId * 3], positions[vId * 3 + 1], positions[vId * 3 + 2]);
+                }
+                mean /= static_cast<double>(groupEnd - groupBegin);
+
+                unsigned int representative = batchVertices[groupBegin];
+                double minDistance = maxLimitValue<double>();
+                for (Index i = groupBegin; i < groupEnd; ++i) {
+                    const unsigned int& vId = batchVertices[i];
+                    const double distance = (Point3d(positions[vId * 3], positions[vId * 3 + 1], positions[vId * 3 + 2]) - mean).squaredNorm();
+                    if (distance < minDistance) {
+                        minDistance = distance;
+                        representative = vId;
+                    }
+                }
+
+                const Point3d representativePoint(positions[representative * 3], positions[representative * 3 + 1], positions[representative * 3 + 2]);
+                for (Index i = groupBegin; i < groupEnd; ++i) {
+                    const unsigned int& vId = batchVertices[i];
+                    representatives[vId] = representative;
+                    error = std::max(error, (Point3d(positions[vId * 3], positions[vId * 3 + 1], positions[vId * 3 + 2]) - representativePoint).norm());
+                }
+
+                groupBegin = groupEnd;
+            }
+
+            //Triangles are rotated to begin with their minimum index, preserving the orientation
+            batchTriangles.clear();
+            for (Index i = begin; i + 2 < end; i += 3) {
+                Triangle triangle = {{ representatives[indices[i]], representatives[indices[i + 1]], representatives[indices[i + 2]] }};
+
+                if (triangle[0] == triangle[1] || triangle[1] == triangle[2] || triangle[2] == triangle[0])
+                    continue;
+
+                std::rotate(triangle.begin(), std::min_element(triangle.begin(), triangle.end()), triangle.end());
+
+                batchTriangles.push_back(triangle);
+            }
+
+            std::sort(batchTriangles.begin(), batchTriangles.end());
+            batchTriangles.erase(std::unique(batchTriangles.begin(), batchTriangles.end()), batchTriangles.end());
+
+            for (const Triangle& triangle : batchTriangles) {
+                levelIndices.insert(levelIndices.end(), triangle.begin(), triangle.end());
+            }
+
+            levelOffsets.push_back(levelIndices.size());
+        }
+
+        const Size levelTriangleNumber = levelIndices.size() / 3;
+
+        //Levels with too few triangles are not useful
+        if (levelTriangleNumber < 16)
+            break;
+
+        //Levels which do not reduce enough the triangles are skipped
+        if (levelTriangleNumber * 4 <= previousTriangleNumber * 3) {
+            for (Size& offset : levelOffsets) {
+                offset += data.indices.size();
+            }
+
+            data.indices.insert(data.indices.end(), levelIndices.begin(), levelIndices.end());
+            data.batchOffsets.push_back(levelOffsets);
+            data.errors.push_back(error);
+
+            previousTriangleNumber = levelTriangleNumber;
+        }
+
+        cellSize *= 2.0;
+    }
+}
+
+/**
+ * @brief Size in pixels of an object-space error, measured on the point of a
+ * bounding sphere nearest to the camera
+ * @param error Object-space error
+ * @param center Center of the bounding sphere
+ * @param radius Radius of the bounding sphere
+ * @param modelViewMatrix Model view matrix
+ * @param projectionMatrix Projection matrix (perspective or orthographic)
+ * @param screenHeight Height of the screen in pixels
+ * @return Projected error in pixels, maxLimitValue if the camera is inside
+ * the bounding sphere
+ */
+NVL_INLINE double faceMeshLODProjectedError(
+        const double& error,
+        const Point3d& center,
+        const double& radius,
+        const Matrix44d& modelViewMatrix,
+        const Matrix44d& projectionMatrix,
+        const double& screenHeight)
+{
+    const Eigen::Vector4d viewCenter = modelViewMatrix * Eigen::Vector4d(center.x(), center.y(), center.z(), 1.0);
+
+    const Eigen::Matrix3d linear = modelViewMatrix.block<3,3>(0,0);
+    const double scale = std::max(linear.col(0).norm(), std::max(linear.col(1).norm(), linear.col(2).norm()));
+
+    //The camera looks toward -z: the nearest point of the sphere has the highest z
+    const double nearestZ = viewCenter.z() + radius * scale;
+    const double w = projectionMatrix(3,2) * nearestZ + projectionMatrix(3,3);
+
+    if (w <= std::numeric_limits<double>::epsilon())
+        return maxLimitValue<double>();
+
+    return error * scale * std::fabs(projectionMatrix(1,1)) * screenHeight * 0.5 / w;
+}
+
+/**
+ * @brief Select the coarsest level of detail whose projected error is not
+ * greater than a threshold
+ * @param data Levels of detail
+ * @param modelViewMatrix Model view matrix
+ * @param projectionMatrix Projection matrix
+ * @param screenHeight Height of the screen in pixels
+ * @param pixelError Maximum projected error in pixels
+ * @return Selected level
+ */
+NVL_INLINE Index faceMeshLODSelectLevel(
+        const FaceMeshLODData& data,
+        const Matrix44d& modelViewMatrix,
+        const Matrix44d& projectionMatrix,
+        const double& screenHeight,
+        const double& pixelError)
+{
+    if (data.levelNumber() <= 1)
+        return 0;
+
+    //The projected error is linear in the object-space error
+    const double pixelsPerUnit = faceMeshLODProjectedError(1.0, data.center, data.radius, modelViewMatrix, projectionMatrix, screenHeight);
+    if (pixelsPerUnit == maxLimitValue<double>())
+        return 0;
+
+    for (Index level = data.levelNumber() - 1; level > 0; --level) {
+        if (data.errors[level] * pixelsPerUnit <= pixelError)
+            return level;
+    }
+
+    return 0;
+}
+
+}
@@ -0,0 +1,69 @@
+/*
+ * This file is part of nuvolib: https://github.com/stefanonuvoli/nuvolib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Stefano Nuvoli (stefano.nuvoli@gmail.com)
+ */
+#ifndef NVL_VIEWER_FACE_MESH_LOD_H
+#define NVL_VIEWER_FACE_MESH_LOD_H
+
+#include <nvl/nuvolib.h>
+
+#include <nvl/math/point.h>
+#include <nvl/math/matrix.h>
+
+#include <vector>
+
+namespace nvl {
+
+/**
+ * @brief Levels of detail of a packed triangle mesh. Each level is a triangle
+ * index buffer on the same packed vertices, split in the same material batches:
+ * the triangles of the batch i of the level l are the indices in the range
+ * [batchOffsets[l][i], batchOffsets[l][i+1]). The level 0 is the full
+ * resolution mesh, whose indices are not copied: its offsets refer to the
+ * packed indices. Each level has the maximum object-space distance between a
+ * vertex and the vertex replacing it.
+ */
+struct FaceMeshLODData {
+    std::vector<unsigned int> indices;
+    std::vector<std::vector<Size>> batchOffsets;
+    std::vector<double> errors;
+
+    Point3d center = Point3d::Zero();
+    double radius = 0.0;
+
+    Size levelNumber() const;
+    Size triangleNumber(const Index& level) const;
+
+    void clear();
+};
+
+void faceMeshLODBuild(
+        const std::vector<float>& positions,
+        const std::vector<unsigned int>& indices,
+        const std::vector<Size>& batchOffsets,
+        FaceMeshLODData& data,
+        const Size minTriangleNumber = 65536,
+        const Size maxLevelNumber = 8);
+
+double faceMeshLODProjectedError(
+        const double& error,
+        const Point3d& center,
+        const double& radius,
+        const Matrix44d& modelViewMatrix,
+        const Matrix44d& projectionMatrix,
+        const double& screenHeight);
+
+Index faceMeshLODSelectLevel(
+        const FaceMeshLODData& data,
+        const Matrix44d& modelViewMatrix,
+        const Matrix44d& projectionMatrix,
+        const double& screenHeight,
+        const double& pixelError);
+
+}
+
+#include "face_mesh_lod.cpp"
+
+#endif // NVL_VIEWER_FACE_MESH_LOD_H
@@ -0,0 +1,524 @@
+/*
+ * This file is part of nuvolib: https://github.com/stefanonuvoli/nuvolib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Stefano Nuvoli (stefano.nuvoli@gmail.com)
+ */
+#include "face_mesh_packing.h"
+
+#include <algorithm>
+
+namespace nvl {
+
+namespace internal {
+
+void faceMeshPackVertex(
+        const std::vector<double>& vertices,
+        const std::vector<double>& vertexNormals,
+        const std::vector<float>& vertexColors,
+        const Index& vId,
+        FaceMeshPackedData& data);
+
+void faceMeshPackCorner(
+        const std::vector<double>& vertices,
+        const std::vector<double>& vertexNormals,
+        const std::vector<float>& vertexColors,
+        const std::vector<std::vector<unsigned int>>& faces,
+        const std::vector<double>& faceNormals,
+        const std::vector<float>& faceColors,
+        const std::vector<std::vector<float>>& faceUVs,
+        const Index& cId,
+        FaceMeshPackedData& data);
+
+}
+
+NVL_INLINE Size FaceMeshPackedData::vertexNumber() const
+{
+    return positions.size() / 3;
+}
+
+NVL_INLINE Size FaceMeshPackedData::triangleNumber() const
+{
+    return indices.size() / 3;
+}
+
+NVL_INLINE Size FaceMeshPackedData::batchNumber() const
+{
+    return batchMaterials.size();
+}
+
+NVL_INLINE void FaceMeshPackedData::clear()
+{
+    positions.clear();
+    normals.clear();
+    colors.clear();
+    uvs.clear();
+    indices.clear();
+    batchMaterials.clear();
+    batchOffsets.clear();
+    perCorner = false;
+    cornerFaces.clear();
+    faceCornerOffsets.clear();
+    vertexCornerOffsets.clear();
+    vertexCorners.clear();
+}
+
+/**
+ * @brief Pack the rendering data of a face mesh. Each polygon is triangulated
+ * as a fan and the triangles are sorted by material. If no per-face attribute
+ * is given, the packed vertices are the rendering vertices and they are shared
+ * by the faces. Otherwise, a packed vertex is created for each face corner and
+ * the per-face attributes override the per-vertex ones.
+ * @param vertices Rendering vertices (3 values for each vertex)
+ * @param vertexNormals Rendering vertex normals (3 values for each vertex), can be empty
+ * @param vertexColors Rendering vertex colors (4 values for each vertex), can be empty
+ * @param faces Rendering faces
+ * @param faceNormals Per-face normals (3 values for each face), can be empty
+ * @param faceColors Per-face colors (4 values for each face), can be empty
+ * @param faceUVs Per-corner uvs (2 values for each corner of each face), can be empty
+ * @param faceMaterials Face materials (NULL_ID for no material), can be empty
+ * @param data Output packed data
+ */
+NVL_INLINE void faceMeshPackData(
+        const std::vector<double>& vertices,
+        const std::vector<double>& vertexNormals,
+        const std::vector<float>& vertexColors,
+        const std::vector<std::vector<unsigned int>>& faces,
+        const std::vector<double>& faceNormals,
+        const std::vector<float>& faceColors,
+        const std::vector<std::vector<float>>& faceUVs,
+        const std::vector<Index>& faceMaterials,
+        FaceMeshPackedData& data)
+{
+    data.clear();
+    data.perCorner = !faceNormals.empty() || !faceColors.empty() || !faceUVs.empty();
+
+    const Size faceNumber = faces.size();
+
+    //Counting sort of the faces by material, faces without material at the end
+    Index maxMaterial = 0;
+    bool hasMaterials = false;
+    for (Index fId = 0; fId < faceMaterials.size() && fId < faceNumber; ++fId) {
+        if (faceMaterials[fId] != NULL_ID) {
+            maxMaterial = std::max(maxMaterial, faceMaterials[fId]);
+            hasMaterials = true;
+        }
+    }
+
+    const Size slotNumber = hasMaterials ? maxMaterial + 2 : 1;
+    const Index nullSlot = slotNumber - 1;
+
+    std::vector<Index> faceSlot(faceNumber, nullSlot);
+    if (hasMaterials) {
+        #pragma omp parallel for
+        for (Index fId = 0; fId < faceNumber; ++fId) {
+            if (fId < faceMaterials.size() && faceMaterials[fId] != NULL_ID) {
+                faceSlot[fId] = faceMaterials[fId];
+            }
+        }
+    }
+
+    std::vector<Size> slotFaceOffsets(slotNumber + 1, 0);
+    std::vector<Size> slotTriangleNumber(slotNumber, 0);
+    for (Index fId = 0; fId < faceNumber; ++fId) {
+        slotFaceOffsets[faceSlot[fId] + 1]++;
+        slotTriangleNumber[faceSlot[fId]] += faces[fId].size() >= 3 ? faces[fId].size() - 2 : 0;
+    }
+    for (Index s = 0; s < slotNumber; ++s) {
+        slotFaceOffsets[s + 1] += slotFaceOffsets[s];
+    }
+
+    std::vector<Index> sortedFaces(faceNumber);
+    std::vector<Size> slotPosition(slotFaceOffsets.begin(), slotFaceOffsets.end() - 1);
+    for (Index fId = 0; fId < faceNumber; ++fId) {
+        sortedFaces[slotPosition[faceSlot[fId]]++] = fId;
+    }
+
+    //Batches
+    Size triangleNumber = 0;
+    for (Index s = 0; s < slotNumber; ++s) {
+        if (slotTriangleNumber[s] == 0)
+            continue;
+
+        data.batchMaterials.push_back(s == nullSlot ? NULL_ID : s);
+        data.batchOffsets.push_back(triangleNumber * 3);
+        triangleNumber += slotTriangleNumber[s];
+    }
+    data.batchOffsets.push_back(triangleNumber * 3);
+
+    //First triangle of each sorted face
+    std::vector<Size> sortedTriangleOffsets(faceNumber + 1, 0);
+    for (Index i = 0; i < faceNumber; ++i) {
+        const Size n = faces[sortedFaces[i]].size();
+        sortedTriangleOffsets[i + 1] = sortedTriangleOffsets[i] + (n >= 3 ? n - 2 : 0);
+    }
+
+    //Corners of each face and of each vertex
+    Size vertexNumber = vertices.size() / 3;
+    if (data.perCorner) {
+        data.faceCornerOffsets.resize(faceNumber + 1, 0);
+        for (Index fId = 0; fId < faceNumber; ++fId) {
+            data.faceCornerOffsets[fId + 1] = data.faceCornerOffsets[fId] + static_cast<unsigned int>(faces[fId].size());
+        }
+
+        const Size cornerNumber = data.faceCornerOffsets[faceNumber];
+
+        data.cornerFaces.resize(cornerNumber);
+        data.vertexCornerOffsets.resize(vertexNumber + 1, 0);
+        for (Index fId = 0; fId < faceNumber; ++fId) {
+            for (Index j = 0; j < faces[fId].size(); ++j) {
+                data.cornerFaces[data.faceCornerOffsets[fId] + j] = static_cast<unsigned int>(fId);
+                data.vertexCornerOffsets[faces[fId][j] + 1]++;
+            }
+        }
+        for (Index vId = 0; vId < vertexNumber; ++vId) {
+            data.vertexCornerOffsets[vId + 1] += data.vertexCornerOffsets[vId];
+        }
+
+        data.vertexCorners.resize(cornerNumber);
+        std::vector<unsigned int> vertexPosition(data.vertexCornerOffsets.begin(), data.vertexCornerOffsets.end() - 1);
+        for (Index cId = 0; cId < cornerNumber; ++cId) {
+            const Index fId = data.cornerFaces[cId];
+            const unsigned int& vId = faces[fId][cId - data.faceCornerOffsets[fId]];
+            data.vertexCorners[vertexPosition[vId]++] = static_cast<unsigned int>(cId);
+        }
+
+        vertexNumber = cornerNumber;
+    }
+
+    const bool hasNormals = !faceNormals.empty() || !vertexNormals.empty();
+    const bool hasColors = !faceColors.empty() || !vertexColors.empty();
+    const bool hasUVs = !faceUVs.empty();
+
+    data.positions.resize(vertexNumber * 3);
+    if (hasNormals)
+        data.normals.resize(vertexNumber * 3);
+    if (hasColors)
+        data.colors.resize(vertexNumber * 4);
+    if (hasUVs)
+        data.uvs.resize(vertexNumber * 2, 0.0f);
+
+    //Vertex attributes
+    if (data.perCorner) {
+        #pragma omp parallel for
+        for (Index cId = 0; cId < vertexNumber; ++cId) {
+            internal::faceMeshPackCorner(vertices, vertexNormals, vertexColors, faces, faceNormals, faceColors, faceUVs, cId, data);
+        }
+    }
+    else {
+        #pragma omp parallel for
+        for (Index vId = 0; vId < vertexNumber; ++vId) {
+            internal::faceMeshPackVertex(vertices, vertexNormals, vertexColors, vId, data);
+        }
+    }
+
+    //Triangle indices
+    data.indices.resize(triangleNumber * 3);
+
+    #pragma omp parallel for
+    for (Index i = 0; i < faceNumber; ++i) {
+        const Index& fId = sortedFaces[i];
+        const std::vector<unsigned int>& face = faces[fId];
+
+        Size t = sortedTriangleOffsets[i] * 3;
+        for (Index j = 1; j + 1 < face.size(); ++j) {
+            if (data.perCorner) {
+                const unsigned int& first = data.faceCornerOffsets[fId];
+                data.indices[t++] = first;
+                data.indices[t++] = first + static_cast<unsigned int>(j);
+                data.indices[t++] = first + static_cast<unsigned int>(j + 1);
+            }
+            else {
+                data.indices[t++] = face[0];
+                data.indices[t++] = face[j];
+                data.indices[t++] = face[j + 1];
+            }
+        }
+    }
+}
+
+/**
+ * @brief Update the packed data after some rendering vertices or faces have
+ * changed. The layout of the rendering data (number of vertices, faces and
+ * their vertices, materials and available attributes) must be the same used
+ * to pack the data, only the attributes of the affected packed vertices are
+ * recomputed.
+ * @param vertices Rendering vertices (3 values for each vertex)
+ * @param vertexNormals Rendering vertex normals (3 values for each vertex), can be empty
+ * @param vertexColors Rendering vertex colors (4 values for each vertex), can be empty
+ * @param faces Rendering faces
+ * @param faceNormals Per-face normals (3 values for each face), can be empty
+ * @param faceColors Per-face colors (4 values for each face), can be empty
+ * @param faceUVs Per-corner uvs (2 values for each corner of each face), can be empty
+ * @param dirtyVertices Rendering vertices that have changed
+ * @param dirtyFaces Rendering faces that have changed
+ * @param data Packed data
+ * @param updatedVertices Output sorted packed vertices that have been updated
+ */
+NVL_INLINE void faceMeshPackUpdate(
+        const std::vector<double>& vertices,
+        const std::vector<double>& vertexNormals,
+        const std::vector<float>& vertexColors,
+        const std::vector<std::vector<unsigned int>>& faces,
+        const std::vector<double>& faceNormals,
+        const std::vector<float>& faceColors,
+        const std::vector<std::vector<float>>& faceUVs,
+        const std::vector<Index>& dirtyVertices,
+        const std::vector<Index>& dirtyFaces,
+        FaceMeshPackedData& data,
+        std::vector<Index>& updatedVertices)
+{
+    updatedVertices.clear();
+
+    if (data.perCorner) {
+        for (const Index& vId : dirtyVertices) {
+            for (Index i = data.vertexCornerOffsets[vId]; i < data.vertexCornerOffsets[vId + 1]; ++i) {
+                updatedVertices.push_back(data.vertexCorners[i]);
+            }
+        }
+        for (const Index& fId : dirtyFaces) {
+            for (Index cId = data.faceCornerOffsets[fId]; cId < data.faceCornerOffsets[fId + 1]; ++cId) {
+                updatedVertices.push_back(cId);
+            }
+        }
+    }
+    else {
+        //Shared vertices do not depend on the faces
+        updatedVertices = dirtyVertices;
+    }
+
+    std::sort(updatedVertices.begin(), updatedVertices.end());
+    updatedVertices.erase(std::unique(updatedVertices.begin(), updatedVertices.end()), updatedVertices.end());
+
+    #pragma omp parallel for
+    for (Index i = 0; i < updatedVertices.size(); ++i) {
+        if (data.perCorner) {
+            internal::faceMeshPackCorner(vertices, vertexNormals, vertexColors, faces, faceNormals, faceColors, faceUVs, updatedVertices[i], data);
+        }
+        else {
+            internal::faceMeshPackVertex(vertices, vertexNormals, vertexColors, updatedVertices[i], data);
+        }
+    }
+}
+
+/**
+ * @brief Copy external vertex positions and normals in the packed data. The
+ * layout of the packed data must be the one of the rendering faces, per-corner
+ * vertices take the values of their rendering vertex.
+ * @param positions Vertex positions (3 values for each rendering vertex)
+ * @param normals Vertex normals (3 values for each rendering vertex), nullptr
+ * to keep the packed normals
+ * @param faces Rendering faces
+ * @param data Packed data
+ */
+NVL_INLINE void faceMeshPackSource(
+        const float* positions,
+        const float* normals,
+        const std::vector<std::vector<unsigned int>>& faces,
+        FaceMeshPackedData& data)
+{
+    const Size vertexNumber = data.vertexNumber();
+    const bool copyNormals = normals != nullptr && !data.normals.empty();
+
+    if (!data.perCorner) {
+        std::copy(positions, positions + vertexNumber * 3, data.positions.begin());
+        if (copyNormals) {
+            std::copy(normals, normals + vertexNumber * 3, data.normals.begin());
+        }
+        return;
+    }
+
+    #pragma omp parallel for
+    for (Index cId = 0; cId < vertexNumber; ++cId) {
+        const Index fId = data.cornerFaces[cId];
+        const Index vId = faces[fId][cId - data.faceCornerOffsets[fId]];
+
+        for (Index k = 0; k < 3; ++k) {
+            data.positions[cId * 3 + k] = positions[vId * 3 + k];
+        }
+        if (copyNormals) {
+            for (Index k = 0; k < 3; ++k) {
+                data.normals[cId * 3 + k] = normals[vId * 3 + k];
+            }
+        }
+    }
+}
+
+/**
+ * @brief Compute the ranges of values of a packed array that contain the given
+ * packed vertices. Consecutive vertices are merged in a single range.
+ * @param ids Sorted packed vertices
+ * @param componentNumber Number of values for each vertex
+ * @param ranges Output ranges, each one given by its first value and its last value (excluded)
+ */
+NVL_INLINE void faceMeshPackedRanges(
+        const std::vector<Index>& ids,
+        const Size componentNumber,
+        std::vector<std::pair<Size, Size>>& ranges)
+{
+    ranges.clear();
+
+    for (const Index& id : ids) {
+        const Size begin = id * componentNumber;
+        const Size end = begin + componentNumber;
+
+        if (!ranges.empty() && ranges.back().second == begin) {
+            ranges.back().second = end;
+        }
+        else {
+            ranges.push_back(std::make_pair(begin, end));
+        }
+    }
+}
+
+/**
+ * @brief Compute the ranges of values that differ between two versions of a
+ * packed array. The arrays are compared in blocks, and adjacent dirty blocks
+ * are merged in a single range. If the sizes differ, the whole new array is
+ * considered dirty.
+ * @param oldValues Previous values
+ * @param newValues New values
+ * @param blockSize Number of values in each block
+ * @param ranges Output ranges, each one given by its first value and its last value (excluded)
+ */
+template<class T>
+void faceMeshPackedDirtyRanges(
+        const std::vector<T>& oldValues,
+        const std::vector<T>& newValues,
+        const Size blockSize,
+        std::vector<std::pair<Size, Size>>& ranges)
+{
+    ranges.clear();
+
+    if (oldValues.size() != newValues.size()) {
+        if (!newValues.empty()) {
+            ranges.push_back(std::make_pair(static_cast<Size>(0), newValues.size()));
+        }
+        return;
+    }
+
+    const Size size = std::max(blockSize, static_cast<Size>(1));
+    const Size blockNumber = (newValues.size() + size - 1) / size;
+
+    std::vector<char> dirtyBlocks(blockNumber, false);
+
+    #pragma omp parallel for
+    for (Index b = 0; b < blockNumber; ++b) {
+        const Size begin = b * size;
+        const Size end = std::min(begin + size, newValues.size());
+        dirtyBlocks[b] = !std::equal(oldValues.begin() + begin, oldValues.begin() + end, newValues.begin() + begin);
+    }
+
+    for (Index b = 0; b < blockNumber; ++b) {
+        if (!dirtyBlocks[b])
+            continue;
+
+        const Size begin = b * size;
+        const Size end = std::min(begin + size, newValues.size());
+
+        if (!ranges.empty() && ranges.back().second == begin) {
+            ranges.back().second = end;
+        }
+        else {
+            ranges.push_back(std::make_pair(begin, end));
+        }
+    }
+}
+
+namespace internal {
+
+/**
+ * @brief Pack the attributes of a shared vertex
+ * @param vertices Rendering vertices
+ * @param vertexNormals Rendering vertex normals
+ * @param vertexColors Rendering vertex colors
+ * @param vId Rendering vertex
+ * @param data Packed data
+ */
+NVL_INLINE void faceMeshPackVertex(
+        const std::vector<double>& vertices,
+        const std::vector<double>& vertexNormals,
+        const std::vector<float>& vertexColors,
+        const Index& vId,
+        FaceMeshPackedData& data)
+{
+    for (Index k = 0; k < 3; ++k) {
+        data.positions[vId * 3 + k] = static_cast<float>(vertices[vId * 3 + k]);
+    }
+
+    if (!data.normals.empty()) {
+        for (Index k = 0; k < 3; ++k) {
+            data.normals[vId * 3 + k] = static_cast<float>(vertexNormals[vId * 3 + k]);
+        }
+    }
+
+    if (!data.colors.empty()) {
+        for (Index k = 0; k < 4; ++k) {
+            data.colors[vId * 4 + k] = vertexColors[vId * 4 + k];
+        }
+    }
+}
+
+/**
+ * @brief Pack the attributes of a face corner, the per-face attributes
+ * override the per-vertex ones
+ * @param vertices Rendering vertices
+ * @param vertexNormals Rendering vertex normals
+ * @param vertexColors Rendering vertex colors
+ * @param faces Rendering faces
+ * @param faceNormals Per-face normals
+ * @param faceColors Per-face colors
+ * @param faceUVs Per-corner uvs
+ * @param cId Corner
+ * @param data Packed data
+ */
+NVL_INLINE void faceMeshPackCorner(
+        const std::vector<double>& vertices,
+        const std::vector<double>& vertexNormals,
+        const std::vector<float>& vertexColors,
+        const std::vector<std::vector<unsigned int>>& faces,
+        const std::vector<double>& faceNormals,
+        const std::vector<float>& faceColors,
+        const std::vector<std::vector<float>>& faceUVs,
+        const Index& cId,
+        FaceMeshPackedData& data)
+{
+    const Index fId = data.cornerFaces[cId];
+    const Index j = cId - data.faceCornerOffsets[fId];
+    const Index vId = faces[fId][j];
+
+    for (Index k = 0; k < 3; ++k) {
+        data.positions[cId * 3 + k] = static_cast<float>(vertices[vId * 3 + k]);
+    }
+
+    if (!faceNormals.empty()) {
+        for (Index k = 0; k < 3; ++k) {
+            data.normals[cId * 3 + k] = static_cast<float>(faceNormals[fId * 3 + k]);
+        }
+    }
+    else if (!vertexNormals.empty()) {
+        for (Index k = 0; k < 3; ++k) {
+            data.normals[cId * 3 + k] = static_cast<float>(vertexNormals[vId * 3 + k]);
+        }
+    }
+
+    if (!faceColors.empty()) {
+        for (Index k = 0; k < 4; ++k) {
+            data.colors[cId * 4 + k] = faceColors[fId * 4 + k];
+        }
+    }
+    else if (!vertexColors.empty()) {
+        for (Index k = 0; k < 4; ++k) {
+            data.colors[cId * 4 + k] = vertexColors[vId * 4 + k];
+        }
+    }
+
+    if (!data.uvs.empty() && faceUVs[fId].size() >= (j + 1) * 2) {
+        data.uvs[cId * 2] = faceUVs[fId][j * 2];
+        data.uvs[cId * 2 + 1] = faceUVs[fId][j * 2 + 1];
+    }
+}
+
+}
+
+}
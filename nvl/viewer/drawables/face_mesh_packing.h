@@ -0,0 +1,93 @@
+/*
+ * This file is part of nuvolib: https://github.com/stefanonuvoli/nuvolib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Stefano Nuvoli (stefano.nuvoli@gmail.com)
+ */
+#ifndef NVL_VIEWER_FACE_MESH_PACKING_H
+#define NVL_VIEWER_FACE_MESH_PACKING_H
+
+#include <nvl/nuvolib.h>
+
+#include <vector>
+#include <utility>
+
+namespace nvl {
+
+/**
+ * @brief Rendering data of a face mesh packed in flat float arrays and in a
+ * single triangle index buffer, ready to be uploaded in vertex buffer objects.
+ * The triangles are sorted by material: the triangles of the batch i are the
+ * indices in the range [batchOffsets[i], batchOffsets[i+1]).
+ */
+struct FaceMeshPackedData {
+    std::vector<float> positions;
+    std::vector<float> normals;
+    std::vector<float> colors;
+    std::vector<float> uvs;
+    std::vector<unsigned int> indices;
+
+    std::vector<Index> batchMaterials;
+    std::vector<Size> batchOffsets;
+
+    bool perCorner = false;
+
+    std::vector<unsigned int> cornerFaces;
+    std::vector<unsigned int> faceCornerOffsets;
+    std::vector<unsigned int> vertexCornerOffsets;
+    std::vector<unsigned int> vertexCorners;
+
+    Size vertexNumber() const;
+    Size triangleNumber() const;
+    Size batchNumber() const;
+
+    void clear();
+};
+
+void faceMeshPackData(
+        const std::vector<double>& vertices,
+        const std::vector<double>& vertexNormals,
+        const std::vector<float>& vertexColors,
+        const std::vector<std::vector<unsigned int>>& faces,
+        const std::vector<double>& faceNormals,
+        const std::vector<float>& faceColors,
+        const std::vector<std::vector<float>>& faceUVs,
+        const std::vector<Index>& faceMaterials,
+        FaceMeshPackedData& data);
+
+void faceMeshPackUpdate(
+        const std::vector<double>& vertices,
+        const std::vector<double>& vertexNormals,
+        const std::vector<float>& vertexColors,
+        const std::vector<std::vector<unsigned int>>& faces,
+        const std::vector<double>& faceNormals,
+        const std::vector<float>& faceColors,
+        const std::vector<std::vector<float>>& faceUVs,
+        const std::vector<Index>& dirtyVertices,
+        const std::vector<Index>& dirtyFaces,
+        FaceMeshPackedData& data,
+        std::vector<Index>& updatedVertices);
+
+void faceMeshPackSource(
+        const float* positions,
+        const float* normals,
+        const std::vector<std::vector<unsigned int>>& faces,
+        FaceMeshPackedData& data);
+
+void faceMeshPackedRanges(
+        const std::vector<Index>& ids,
+        const Size componentNumber,
+        std::vector<std::pair<Size, Size>>& ranges);
+
+template<class T>
+void faceMeshPackedDirtyRanges(
+        const std::vector<T>& oldValues,
+        const std::vector<T>& newValues,
+        const Size blockSize,
+        std::vector<std::pair<Size, Size>>& ranges);
+
+}
+
+#include "face_mesh_packing.cpp"
+
+#endif // NVL_VIEWER_FACE_MESH_PACKING_H
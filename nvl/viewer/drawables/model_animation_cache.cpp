@@ -0,0 +1,670 @@
+/*
+ * This file is part of nuvolib: https://github.com/stefanonuvoli/nuvolib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Stefano Nuvoli (stefano.nuvoli@gmail.com)
+ */
+#include "model_animation_cache.h"
+
+#include <nvl/models/algorithms/animation_skinning.h>
+
+#include <nvl/math/alignedbox.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace nvl {
+
+/**
+ * @brief Default constructor
+ */
+template<class M>
+ModelAnimationCache<M>::ModelAnimationCache() :
+    vMemoryBudget(512 * 1024 * 1024)
+{
+
+}
+
+/**
+ * @brief Copy constructor, the clips are not copied
+ * @param other Cache
+ */
+template<class M>
+ModelAnimationCache<M>::ModelAnimationCache(const ModelAnimationCache& other) :
+    vMemoryBudget(other.vMemoryBudget)
+{
+
+}
+
+/**
+ * @brief Destructor, the clips being baked are cancelled
+ */
+template<class M>
+ModelAnimationCache<M>::~ModelAnimationCache()
+{
+    clear();
+}
+
+/**
+ * @brief Assignment, the clips are not copied
+ * @param other Cache
+ * @return Cache
+ */
+template<class M>
+ModelAnimationCache<M>& ModelAnimationCache<M>::operator=(const ModelAnimationCache& other)
+{
+    if (this != &other) {
+        clear();
+        vMemoryBudget = other.vMemoryBudget;
+    }
+
+    return *this;
+}
+
+/**
+ * @brief Find a clip, marking it as the most recently used
+ * @param key Key of the clip
+ * @return Clip, nullptr if the clip is not in the cache
+ */
+template<class M>
+typename ModelAnimationCache<M>::Clip* ModelAnimationCache<M>::clip(const Key& key)
+{
+    for (typename std::list<std::unique_ptr<Clip>>::iterator it = vClips.begin(); it != vClips.end(); ++it) {
+        if ((*it)->key == key) {
+            vClips.splice(vClips.begin(), vClips, it);
+            return vClips.front().get();
+        }
+    }
+
+    return nullptr;
+}
+
+/**
+ * @brief Add a clip to the cache and bake it in background. The least
+ * recently used clips are evicted to keep the memory in the budget.
+ * @param key Key of the clip
+ * @param model Model
+ * @param frames Frames of the animation, with the final deformations
+ * @param dualQuaternionTransformations Transformations of the frames as dual
+ * quaternions (used for dual quaternion skinning)
+ * @return Clip, nullptr if the clip does not fit in the memory budget
+ */
+template<class M>
+typename ModelAnimationCache<M>::Clip* ModelAnimationCache<M>::bake(
+        const Key& key,
+        const M* model,
+        const std::vector<Frame>& frames,
+        const std::vector<std::vector<DualQuaterniond>>& dualQuaternionTransformations)
+{
+    typedef typename M::Mesh::VertexId VertexId;
+
+    Clip* existingClip = clip(key);
+    if (existingClip != nullptr) {
+        vClips.front()->cancelled = true;
+        if (vClips.front()->worker.joinable()) {
+            vClips.front()->worker.join();
+        }
+        vClips.pop_front();
+    }
+
+    std::unique_ptr<Clip> newClip(new Clip());
+
+    newClip->key = key;
+    newClip->frames = frames;
+    newClip->dualQuaternionTransformations = dualQuaternionTransformations;
+
+    for (VertexId vId = 0; vId < model->mesh.nextVertexId(); ++vId) {
+        if (!model->mesh.isVertexDeleted(vId)) {
+            newClip->vertices.push_back(vId);
+        }
+    }
+    newClip->jointNumber = model->skeleton.jointNumber();
+    newClip->hasNormals = model->mesh.hasVertexNormals();
+
+    const Size frameNumber = frames.size();
+    const Size memory = estimateMemory(key, frames, dualQuaternionTransformations, newClip->vertices.size(), newClip->jointNumber, newClip->hasNormals);
+    if (memory > vMemoryBudget)
+        return nullptr;
+
+    evict(vMemoryBudget - memory);
+
+    newClip->frameBaked.resize(frameNumber, false);
+    newClip->frameClaimed.resize(frameNumber, false);
+
+    const Size valueNumber = frameNumber * newClip->vertices.size() * 3;
+    if (key.quantized) {
+        newClip->quantizedPositions.resize(valueNumber);
+        if (newClip->hasNormals) {
+            newClip->quantizedNormals.resize(valueNumber);
+        }
+        newClip->quantizationMin.resize(frameNumber * 3);
+        newClip->quantizationScale.resize(frameNumber * 3);
+    }
+    else {
+        newClip->positions.resize(valueNumber);
+        if (newClip->hasNormals) {
+            newClip->normals.resize(valueNumber);
+        }
+    }
+    newClip->joints.resize(frameNumber * newClip->jointNumber * 3);
+
+    Clip* clipPtr = newClip.get();
+    clipPtr->worker = std::thread(&ModelAnimationCache<M>::bakeClip, clipPtr, model);
+
+    vClips.push_front(std::move(newClip));
+
+    return clipPtr;
+}
+
+/**
+ * @brief Load the rendering data of a baked frame
+ * @param clip Clip
+ * @param frameId Frame id
+ * @param positions Vertex positions, in rendering order
+ * @param normals Vertex normals, in rendering order (empty if the mesh has
+ * no vertex normals)
+ * @param joints Joint positions, for each joint id
+ * @return True if the frame has been baked, false otherwise
+ */
+template<class M>
+bool ModelAnimationCache<M>::loadFrame(
+        const Clip& clip,
+        const Index& frameId,
+        std::vector<double>& positions,
+        std::vector<double>& normals,
+        std::vector<double>& joints) const
+{
+    if (!clip.isFrameBaked(frameId))
+        return false;
+
+    const Size valueNumber = clip.vertices.size() * 3;
+    const Size offset = frameId * valueNumber;
+
+    positions.resize(valueNumber);
+    normals.resize(clip.hasNormals ? valueNumber : 0);
+
+    if (clip.key.quantized) {
+        const double* min = &clip.quantizationMin[frameId * 3];
+        const double* scale = &clip.quantizationScale[frameId * 3];
+
+        #pragma omp parallel for
+        for (Index i = 0; i < valueNumber; ++i) {
+            positions[i] = min[i % 3] + clip.quantizedPositions[offset + i] * scale[i % 3];
+        }
+
+        if (clip.hasNormals) {
+            #pragma omp parallel for
+            for (Index i = 0; i < valueNumber; ++i) {
+                normals[i] = clip.quantizedNormals[offset + i] / 32767.0;
+            }
+        }
+    }
+    else {
+        std::copy(clip.positions.begin() + offset, clip.positions.begin() + offset + valueNumber, positions.begin());
+        if (clip.hasNormals) {
+            std::copy(clip.normals.begin() + offset, clip.normals.begin() + offset + valueNumber, normals.begin());
+        }
+    }
+
+    const Size jointOffset = frameId * clip.jointNumber * 3;
+    joints.assign(clip.joints.begin() + jointOffset, clip.joints.begin() + jointOffset + clip.jointNumber * 3);
+
+    return true;
+}
+
+/**
+ * @brief Get the rendering data of a baked frame without copying it. Float
+ * clips are read in place, quantized clips are decoded in the given buffers.
+ * The data stays valid while the clip is in the cache (and until the buffers
+ * are changed, for quantized clips).
+ * @param clip Clip
+ * @param frameId Frame id
+ * @param positionBuffer Buffer for the decoded positions
+ * @param normalBuffer Buffer for the decoded normals
+ * @param positions Output vertex positions, in rendering order
+ * @param normals Output vertex normals, in rendering order (nullptr if the
+ * mesh has no vertex normals)
+ * @param joints Output joint positions, for each joint id
+ * @return True if the frame has been baked, false otherwise
+ */
+template<class M>
+bool ModelAnimationCache<M>::frameData(
+        const Clip& clip,
+        const Index& frameId,
+        std::vector<float>& positionBuffer,
+        std::vector<float>& normalBuffer,
+        const float*& positions,
+        const float*& normals,
+        const double*& joints) const
+{
+    if (!clip.isFrameBaked(frameId))
+        return false;
+
+    const Size valueNumber = clip.vertices.size() * 3;
+    const Size offset = frameId * valueNumber;
+
+    if (clip.key.quantized) {
+        const double* min = &clip.quantizationMin[frameId * 3];
+        const double* scale = &clip.quantizationScale[frameId * 3];
+
+        positionBuffer.resize(valueNumber);
+
+        #pragma omp parallel for
+        for (Index i = 0; i < valueNumber; ++i) {
+            positionBuffer[i] = static_cast<float>(min[i % 3] + clip.quantizedPositions[offset + i] * scale[i % 3]);
+        }
+
+        if (clip.hasNormals) {
+            normalBuffer.resize(valueNumber);
+
+            #pragma omp parallel for
+            for (Index i = 0; i < valueNumber; ++i) {
+                normalBuffer[i] = clip.quantizedNormals[offset + i] / 32767.0f;
+            }
+        }
+
+        positions = positionBuffer.data();
+        normals = clip.hasNormals ? normalBuffer.data() : nullptr;
+    }
+    else {
+        positions = clip.positions.data() + offset;
+        normals = clip.hasNormals ? clip.normals.data() + offset : nullptr;
+    }
+
+    joints = clip.joints.data() + frameId * clip.jointNumber * 3;
+
+    return true;
+}
+
+/**
+ * @brief Request a frame that has not been baked yet: the baking continues
+ * from it, so that the frames around the playback position are ready first
+ * @param clip Clip
+ * @param frameId Frame id
+ */
+template<class M>
+void ModelAnimationCache<M>::requestFrame(Clip& clip, const Index& frameId)
+{
+    std::lock_guard<std::mutex> lock(clip.mutex);
+
+    if (frameId < clip.frameClaimed.size()) {
+        clip.bakeCursor = frameId;
+    }
+}
+
+/**
+ * @brief Number of clips in the cache
+ * @return Number of clips
+ */
+template<class M>
+Size ModelAnimationCache<M>::clipNumber() const
+{
+    return vClips.size();
+}
+
+/**
+ * @brief Memory used by the clips
+ * @return Memory in bytes
+ */
+template<class M>
+Size ModelAnimationCache<M>::memoryUsage() const
+{
+    Size memory = 0;
+    for (const std::unique_ptr<Clip>& currentClip : vClips) {
+        memory += currentClip->memory();
+    }
+    return memory;
+}
+
+/**
+ * @brief Memory budget of the cache
+ * @return Memory in bytes
+ */
+template<class M>
+Size ModelAnimationCache<M>::memoryBudget() const
+{
+    return vMemoryBudget;
+}
+
+/**
+ * @brief Set the memory budget, evicting the least recently used clips if needed
+ * @param bytes Memory in bytes
+ */
+template<class M>
+void ModelAnimationCache<M>::setMemoryBudget(const Size bytes)
+{
+    vMemoryBudget = bytes;
+    evict(vMemoryBudget);
+}
+
+/**
+ * @brief Remove all the clips, the clips being baked are cancelled
+ */
+template<class M>
+void ModelAnimationCache<M>::clear()
+{
+    for (std::unique_ptr<Clip>& currentClip : vClips) {
+        currentClip->cancelled = true;
+    }
+    for (std::unique_ptr<Clip>& currentClip : vClips) {
+        if (currentClip->worker.joinable()) {
+            currentClip->worker.join();
+        }
+    }
+
+    vClips.clear();
+}
+
+/**
+ * @brief Evict the least recently used clips until the memory is in a limit
+ * @param bytes Memory limit in bytes
+ */
+template<class M>
+void ModelAnimationCache<M>::evict(const Size bytes)
+{
+    Size memory = memoryUsage();
+
+    while (!vClips.empty() && memory > bytes) {
+        std::unique_ptr<Clip>& lastClip = vClips.back();
+
+        lastClip->cancelled = true;
+        if (lastClip->worker.joinable()) {
+            lastClip->worker.join();
+        }
+
+        memory -= lastClip->memory();
+        vClips.pop_back();
+    }
+}
+
+/**
+ * @brief Memory needed by a clip: baked data, frames, dual quaternion
+ * transformations and bookkeeping
+ * @param key Key of the clip
+ * @param frames Frames of the animation
+ * @param dualQuaternionTransformations Transformations of the frames as dual quaternions
+ * @param vertexNumber Number of vertices
+ * @param jointNumber Number of joints
+ * @param hasNormals True if the vertex normals are baked
+ * @return Memory in bytes
+ */
+template<class M>
+Size ModelAnimationCache<M>::estimateMemory(
+        const Key& key,
+        const std::vector<Frame>& frames,
+        const std::vector<std::vector<DualQuaterniond>>& dualQuaternionTransformations,
+        const Size vertexNumber,
+        const Size jointNumber,
+        const bool hasNormals)
+{
+    typedef typename Frame::Transformation Transformation;
+
+    const Size frameNumber = frames.size();
+    const Size valueSize = key.quantized ? sizeof(unsigned short) : sizeof(float);
+    const Size quantizationSize = key.quantized ? 6 * sizeof(double) : 0;
+
+    Size memory = frameNumber * (vertexNumber * 3 * valueSize * (hasNormals ? 2 : 1) + jointNumber * 3 * sizeof(double) + quantizationSize + 2 * sizeof(char));
+
+    for (const Frame& frame : frames) {
+        memory += sizeof(Frame) + frame.transformations().size() * sizeof(Transformation);
+    }
+    for (const std::vector<DualQuaterniond>& transformations : dualQuaternionTransformations) {
+        memory += sizeof(std::vector<DualQuaterniond>) + transformations.size() * sizeof(DualQuaterniond);
+    }
+
+    memory += vertexNumber * sizeof(Index);
+
+    return memory;
+}
+
+/**
+ * @brief Bake all the frames of a clip. The frames are baked in parallel,
+ * each thread takes the next frame from the last requested one.
+ * @param clip Clip
+ * @param model Model
+ */
+template<class M>
+void ModelAnimationCache<M>::bakeClip(Clip* clip, const M* model)
+{
+    const Size vertexNumber = clip->vertices.size();
+
+    #pragma omp parallel
+    {
+        std::vector<double> framePositions(vertexNumber * 3);
+        std::vector<double> frameNormals(clip->hasNormals ? vertexNumber * 3 : 0);
+
+        Index fId = nextBakeFrame(clip);
+        while (fId != NULL_ID && !clip->cancelled) {
+            bakeFrame(clip, model, fId, framePositions, frameNormals);
+
+            {
+                std::lock_guard<std::mutex> lock(clip->mutex);
+                clip->frameBaked[fId] = true;
+            }
+            clip->bakedFrames++;
+
+            fId = nextBakeFrame(clip);
+        }
+    }
+}
+
+/**
+ * @brief Claim the next frame to bake: the first frame not claimed yet from
+ * the bake cursor, wrapping around at the end of the clip
+ * @param clip Clip
+ * @return Frame id, NULL_ID if all the frames have been claimed
+ */
+template<class M>
+Index ModelAnimationCache<M>::nextBakeFrame(Clip* clip)
+{
+    std::lock_guard<std::mutex> lock(clip->mutex);
+
+    const Size frameNumber = clip->frameClaimed.size();
+    for (Index i = 0; i < frameNumber; ++i) {
+        const Index fId = (clip->bakeCursor + i) % frameNumber;
+        if (!clip->frameClaimed[fId]) {
+            clip->frameClaimed[fId] = true;
+            clip->bakeCursor = (fId + 1) % frameNumber;
+            return fId;
+        }
+    }
+
+    return NULL_ID;
+}
+
+/**
+ * @brief Bake a frame of a clip
+ * @param clip Clip
+ * @param model Model
+ * @param fId Frame id
+ * @param framePositions Buffer for the skinned positions of the frame
+ * @param frameNormals Buffer for the skinned normals of the frame
+ */
+template<class M>
+void ModelAnimationCache<M>::bakeFrame(Clip* clip, const M* model, const Index& fId, std::vector<double>& framePositions, std::vector<double>& frameNormals)
+{
+    typedef typename M::Skeleton::JointId JointId;
+    typedef typename M::Mesh::VertexId VertexId;
+    typedef typename Frame::Transformation Transformation;
+
+    const Size vertexNumber = clip->vertices.size();
+
+    const std::vector<Transformation>& transformations = clip->frames[fId].transformations();
+    const bool dualQuaternions = clip->key.skinningMode == ModelDrawerBase::SKINNING_DUAL_QUATERNIONS;
+
+    for (JointId jId = 0; jId < clip->jointNumber; ++jId) {
+        const Point3d p = model->skeleton.jointBindPose(jId) * model->skeleton.originPoint();
+
+        Point3d q;
+        if (dualQuaternions) {
+            q = clip->dualQuaternionTransformations[fId][jId] * p;
+        }
+        else {
+            q = transformations[jId] * p;
+        }
+
+        double* joint = &clip->joints[(fId * clip->jointNumber + jId) * 3];
+        joint[0] = q.x();
+        joint[1] = q.y();
+        joint[2] = q.z();
+    }
+
+    //Frames are already baked in parallel
+    for (Index i = 0; i < vertexNumber; ++i) {
+        const VertexId& vId = clip->vertices[i];
+
+        const Point3d& p = model->mesh.vertexPoint(vId);
+
+        Point3d q;
+        Vector3d n;
+        if (dualQuaternions) {
+            DualQuaterniond dq = animationDualQuaternionSkinningVertex(model->skinningWeights, clip->dualQuaternionTransformations[fId], vId);
+            q = dq * p;
+            if (clip->hasNormals) {
+                n = dq.rotation() * model->mesh.vertexNormal(vId);
+            }
+        }
+        else {
+            Transformation t = animationLinearBlendingSkinningVertex(model->skinningWeights, transformations, vId);
+            q = t * p;
+            if (clip->hasNormals) {
+                n = t.rotation() * model->mesh.vertexNormal(vId);
+            }
+        }
+
+        framePositions[i*3] = q.x();
+        framePositions[i*3+1] = q.y();
+        framePositions[i*3+2] = q.z();
+
+        if (clip->hasNormals) {
+            frameNormals[i*3] = n.x();
+            frameNormals[i*3+1] = n.y();
+            frameNormals[i*3+2] = n.z();
+        }
+    }
+
+    const Size offset = fId * vertexNumber * 3;
+
+    if (clip->key.quantized) {
+        //Positions are quantized in the bounding box of the frame
+        AlignedBox3d box;
+        for (Index i = 0; i < vertexNumber; ++i) {
+            box.extend(Point3d(framePositions[i*3], framePositions[i*3+1], framePositions[i*3+2]));
+        }
+
+        double* min = &clip->quantizationMin[fId * 3];
+        double* scale = &clip->quantizationScale[fId * 3];
+        for (Index d = 0; d < 3; ++d) {
+            min[d] = vertexNumber > 0 ? box.min()(d) : 0.0;
+            scale[d] = vertexNumber > 0 ? (box.max()(d) - box.min()(d)) / 65535.0 : 0.0;
+        }
+
+        for (Index i = 0; i < vertexNumber * 3; ++i) {
+            const Index d = i % 3;
+            const double value = scale[d] > 0 ? (framePositions[i] - min[d]) / scale[d] : 0.0;
+            clip->quantizedPositions[offset + i] = static_cast<unsigned short>(std::min(std::max(std::round(value), 0.0), 65535.0));
+        }
+
+        if (clip->hasNormals) {
+            for (Index i = 0; i < vertexNumber * 3; ++i) {
+                const double value = std::min(std::max(frameNormals[i], -1.0), 1.0) * 32767.0;
+                clip->quantizedNormals[offset + i] = static_cast<short>(std::round(value));
+            }
+        }
+    }
+    else {
+        std::copy(framePositions.begin(), framePositions.end(), clip->positions.begin() + offset);
+        if (clip->hasNormals) {
+            std::copy(frameNormals.begin(), frameNormals.end(), clip->normals.begin() + offset);
+        }
+    }
+}
+
+/**
+ * @brief Check if two keys refer to the same baked data
+ * @param other Key
+ * @return True if the keys are equal
+ */
+template<class M>
+bool ModelAnimationCache<M>::Key::operator==(const Key& other) const
+{
+    return animationId == other.animationId &&
+            skinningMode == other.skinningMode &&
+            blend == other.blend &&
+            keepKeyframes == other.keepKeyframes &&
+            fps == other.fps &&
+            speed == other.speed &&
+            quantized == other.quantized;
+}
+
+/**
+ * @brief Default constructor
+ */
+template<class M>
+ModelAnimationCache<M>::Clip::Clip() :
+    jointNumber(0),
+    hasNormals(false),
+    bakeCursor(0),
+    bakedFrames(0),
+    cancelled(false)
+{
+
+}
+
+/**
+ * @brief Number of frames of the clip
+ * @return Number of frames
+ */
+template<class M>
+Size ModelAnimationCache<M>::Clip::frameNumber() const
+{
+    return frames.size();
+}
+
+/**
+ * @brief Memory used by the clip
+ * @return Memory in bytes
+ */
+template<class M>
+Size ModelAnimationCache<M>::Clip::memory() const
+{
+    return estimateMemory(key, frames, dualQuaternionTransformations, vertices.size(), jointNumber, hasNormals);
+}
+
+/**
+ * @brief Baking progress
+ * @return Fraction of the frames baked, in [0,1]
+ */
+template<class M>
+double ModelAnimationCache<M>::Clip::progress() const
+{
+    if (frames.empty())
+        return 1.0;
+
+    return static_cast<double>(bakedFrames) / frames.size();
+}
+
+/**
+ * @brief Check if all the frames have been baked
+ * @return True if all the frames have been baked
+ */
+template<class M>
+bool ModelAnimationCache<M>::Clip::isBaked() const
+{
+    return bakedFrames == frames.size();
+}
+
+/**
+ * @brief Check if a frame has been baked
+ * @param frameId Frame id
+ * @return True if the frame has been baked
+ */
+template<class M>
+bool ModelAnimationCache<M>::Clip::isFrameBaked(const Index& frameId) const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    return frameId < frameBaked.size() && frameBaked[frameId];
+}
+
+}
@@ -0,0 +1,160 @@
+/*
+ * This file is part of nuvolib: https://github.com/stefanonuvoli/nuvolib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Stefano Nuvoli (stefano.nuvoli@gmail.com)
+ */
+#ifndef NVL_VIEWER_MODEL_ANIMATION_CACHE_H
+#define NVL_VIEWER_MODEL_ANIMATION_CACHE_H
+
+#include <nvl/nuvolib.h>
+
+#include <nvl/viewer/drawables/model_drawer_base.h>
+
+#include <nvl/math/dual_quaternion.h>
+
+#include <vector>
+#include <list>
+#include <memory>
+#include <atomic>
+#include <thread>
+#include <mutex>
+
+namespace nvl {
+
+/**
+ * @brief Cache of the skinned rendering data of the animations of a model.
+ * Each clip is baked in background, for all its frames, in a compact buffer
+ * (floats or 16-bit quantized values). Frames are baked in parallel, starting
+ * from the last requested frame. The clips are evicted in least recently used
+ * order when the memory budget is exceeded.
+ * The model must not be modified while a clip is being baked.
+ * @tparam M Model
+ */
+template<class M>
+class ModelAnimationCache
+{
+
+public:
+
+    /* Typedefs */
+
+    typedef M Model;
+    typedef typename M::Animation Animation;
+    typedef typename Animation::Frame Frame;
+
+    struct Key {
+        Index animationId;
+        ModelDrawerBase::SkinningMode skinningMode;
+        bool blend;
+        bool keepKeyframes;
+        double fps;
+        double speed;
+        bool quantized;
+
+        bool operator==(const Key& other) const;
+    };
+
+    struct Clip {
+        Clip();
+
+        Key key;
+        std::vector<Frame> frames;
+        std::vector<std::vector<DualQuaterniond>> dualQuaternionTransformations;
+
+        std::vector<Index> vertices;
+        Size jointNumber;
+        bool hasNormals;
+
+        std::vector<float> positions;
+        std::vector<float> normals;
+        std::vector<unsigned short> quantizedPositions;
+        std::vector<short> quantizedNormals;
+        std::vector<double> quantizationMin;
+        std::vector<double> quantizationScale;
+        std::vector<double> joints;
+
+        std::vector<char> frameBaked;
+        std::vector<char> frameClaimed;
+        Index bakeCursor;
+        mutable std::mutex mutex;
+
+        std::atomic<Size> bakedFrames;
+        std::atomic<bool> cancelled;
+        std::thread worker;
+
+        Size frameNumber() const;
+        Size memory() const;
+        double progress() const;
+        bool isBaked() const;
+        bool isFrameBaked(const Index& frameId) const;
+    };
+
+
+    /* Constructors */
+
+    ModelAnimationCache();
+    ModelAnimationCache(const ModelAnimationCache& other);
+    ~ModelAnimationCache();
+
+    ModelAnimationCache& operator=(const ModelAnimationCache& other);
+
+
+    /* Methods */
+
+    Clip* clip(const Key& key);
+    Clip* bake(
+            const Key& key,
+            const M* model,
+            const std::vector<Frame>& frames,
+            const std::vector<std::vector<DualQuaterniond>>& dualQuaternionTransformations);
+
+    bool loadFrame(
+            const Clip& clip,
+            const Index& frameId,
+            std::vector<double>& positions,
+            std::vector<double>& normals,
+            std::vector<double>& joints) const;
+    bool frameData(
+            const Clip& clip,
+            const Index& frameId,
+            std::vector<float>& positionBuffer,
+            std::vector<float>& normalBuffer,
+            const float*& positions,
+            const float*& normals,
+            const double*& joints) const;
+    void requestFrame(Clip& clip, const Index& frameId);
+
+    Size clipNumber() const;
+    Size memoryUsage() const;
+    Size memoryBudget() const;
+    void setMemoryBudget(const Size bytes);
+
+    void clear();
+
+
+protected:
+
+    std::list<std::unique_ptr<Clip>> vClips;
+    Size vMemoryBudget;
+
+    void evict(const Size bytes);
+
+    static Size estimateMemory(
+            const Key& key,
+            const std::vector<Frame>& frames,
+            const std::vector<std::vector<DualQuaterniond>>& dualQuaternionTransformations,
+            const Size vertexNumber,
+            const Size jointNumber,
+            const bool hasNormals);
+    static void bakeClip(Clip* clip, const M* model);
+    static Index nextBakeFrame(Clip* clip);
+    static void bakeFrame(Clip* clip, const M* model, const Index& fId, std::vector<double>& framePositions, std::vector<double>& frameNormals);
+
+};
+
+}
+
+#include "model_animation_cache.cpp"
+
+#endif // NVL_VIEWER_MODEL_ANIMATION_CACHE_H
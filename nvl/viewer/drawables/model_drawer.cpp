@@ -14,6 +14,8 @@
 
 #include <nvl/math/constants.h>
 
+#include <nvl/utilities/profiler.h>
+
 #include <chrono>
 
 namespace nvl {
@@ -29,10 +31,13 @@ ModelDrawer<M>::ModelDrawer(M* model, const bool visible, const bool pickable, c
     Drawable(visible),
     Pickable(pickable),
     Animable(animable),
+    LODable(true),
     vModel(model),
     vMeshDrawer(&model->mesh),
     vSkeletonDrawer(&model->skeleton),
     vAnimationLoaded(NULL_ID),
+    vAnimationCacheClip(nullptr),
+    vAnimationCacheSourceVisible(false),
     vAnimationRunning(false),
     vAnimationPaused(false)
 {
@@ -46,6 +51,8 @@ ModelDrawer<M>::ModelDrawer(M* model, const bool visible, const bool pickable, c
 template<class M>
 void ModelDrawer<M>::draw() const
 {
+    NVL_PROFILE_ZONE("ModelDrawer::draw");
+
     if (this->vModel == nullptr)
         return;
 
@@ -70,6 +77,27 @@ void ModelDrawer<M>::drawWithNames(Canvas* canvas, const Index drawableId) const
     glDepthFunc(GL_LESS);
 }
 
+template<class M>
+bool ModelDrawer<M>::rayPick(Canvas* canvas, const Index drawableId, const Point3d& rayOrigin, const Vector3d& rayDirection, double& t) const
+{
+    if (this->vModel == nullptr || !this->isPickable())
+        return false;
+
+    //The skeleton is drawn over the mesh, so it is picked first
+    double skeletonT, meshT;
+    const bool skeletonPicked = vSkeletonDrawer.rayPick(canvas, drawableId, rayOrigin, rayDirection, skeletonT);
+    const bool meshPicked = vMeshDrawer.rayPick(canvas, drawableId, rayOrigin, rayDirection, meshT);
+
+    if (skeletonPicked) {
+        t = skeletonT;
+    }
+    else if (meshPicked) {
+        t = meshT;
+    }
+
+    return skeletonPicked || meshPicked;
+}
+
 template<class M>
 void ModelDrawer<M>::startAnimation()
 {
@@ -92,23 +120,30 @@ void ModelDrawer<M>::pauseAnimation()
     if (this->vAnimable && isAnimationLoaded() && vAnimationRunning) {
         vAnimationPauseTime = std::chrono::system_clock::now();
         vAnimationPaused = true;
+
+        //The paused frame is loaded in the rendering vertices, for picking and the other drawing modes
+        if (vAnimationCacheSourceVisible) {
+            processKeyframePose(vAnimationCurrentFrameId);
+        }
     }
 }
 
 template<class M>
 void ModelDrawer<M>::stopAnimation()
 {
+    vAnimationRunning = false;
+    vAnimationPaused = false;
+
     if (this->vAnimable && isAnimationLoaded()) {
         resetAnimation();
     }
-
-    vAnimationRunning = false;
-    vAnimationPaused = false;
 }
 
 template<class M>
 bool ModelDrawer<M>::animate()
 {
+    NVL_PROFILE_ZONE("ModelDrawer::animate");
+
     if (this->vAnimable && this->vAnimationRunning) {
         if (!this->vAnimationPaused) {
             const Index lastFrameId = vAnimationFrames.size() - 1;
@@ -150,6 +185,20 @@ bool ModelDrawer<M>::animationRunning() const
     return vAnimationRunning;
 }
 
+template<class M>
+void ModelDrawer<M>::selectLOD(const Matrix44d& modelViewMatrix, const Matrix44d& projectionMatrix, const double& screenHeight)
+{
+    vMeshDrawer.setLODPixelError(this->lodPixelError());
+    vMeshDrawer.selectLOD(modelViewMatrix, projectionMatrix, screenHeight);
+}
+
+template<class M>
+void ModelDrawer<M>::setLODEnabled(bool lodEnabled)
+{
+    LODable::setLODEnabled(lodEnabled);
+    vMeshDrawer.setLODEnabled(lodEnabled);
+}
+
 template<class M>
 Point3d ModelDrawer<M>::sceneCenter() const
 {
@@ -186,9 +235,14 @@ void ModelDrawer<M>::resetRenderingData()
 template<class M>
 void ModelDrawer<M>::update()
 {
+    NVL_PROFILE_ZONE("ModelDrawer::update");
+
     if (vModel == nullptr)
         return;
 
+    //The baked clips refer to the previous state of the model
+    clearAnimationCache();
+
     vMeshDrawer.update();
     vSkeletonDrawer.update();
 
@@ -210,6 +264,7 @@ M* ModelDrawer<M>::model() const
 template<class M>
 void ModelDrawer<M>::setModel(M* model)
 {
+    clearAnimationCache();
     vModel = model;
 }
 
@@ -228,37 +283,70 @@ SkeletonDrawer<typename M::Skeleton>& ModelDrawer<M>::skeletonDrawer()
 template<class M>
 void ModelDrawer<M>::loadAnimation(const Index& id)
 {
+    NVL_PROFILE_ZONE("ModelDrawer::loadAnimation");
+
     typedef typename Model::Animation Animation;
     typedef typename Animation::Frame Frame;
     typedef typename Frame::Transformation Transformation;
     typedef typename Transformation::Scalar Scalar;
 
     vAnimationLoaded = id;
-    const Animation3d& animation = vModel->animation(id);
-
-    //Blend frames
-    vAnimationFrames = animation.keyframes();
-    if (this->animationBlend()) {
-        double fps = this->animationTargetFPS() / this->animationSpeed();
-        animationFrameBlend(vAnimationFrames, fps, this->animationSpeed(), this->animationKeepKeyframes());
+    vAnimationCacheClip = nullptr;
+
+    typename ModelAnimationCache<M>::Key cacheKey;
+    cacheKey.animationId = id;
+    cacheKey.skinningMode = this->vAnimationSkinningMode;
+    cacheKey.blend = this->animationBlend();
+    cacheKey.keepKeyframes = this->animationKeepKeyframes();
+    cacheKey.fps = this->animationTargetFPS();
+    cacheKey.speed = this->animationSpeed();
+    cacheKey.quantized = this->animationCacheQuantized();
+
+    if (this->animationCache()) {
+        vAnimationCache.setMemoryBudget(this->animationCacheMemory());
+        vAnimationCacheClip = vAnimationCache.clip(cacheKey);
     }
 
-    //Compute final transformations
-    animationFrameDeformationFromGlobal(*(vSkeletonDrawer.skeleton()), vAnimationFrames);
+    if (vAnimationCacheClip != nullptr) {
+        //Blended frames are reused from the cache
+        vAnimationFrames = vAnimationCacheClip->frames;
+        dualQuaternionTransformations = vAnimationCacheClip->dualQuaternionTransformations;
+    }
+    else {
+        const Animation3d& animation = vModel->animation(id);
 
-    if (this->vAnimationSkinningMode == SkinningMode::SKINNING_DUAL_QUATERNIONS) {
-        dualQuaternionTransformations.resize(vAnimationFrames.size());
-        #pragma omp parallel for
-        for (Index i = 0; i < vAnimationFrames.size(); ++i) {
-            const std::vector<Transformation>& transformations = vAnimationFrames[i].transformations();
+        //Blend frames
+        vAnimationFrames = animation.keyframes();
+        if (this->animationBlend()) {
+            double fps = this->animationTargetFPS() / this->animationSpeed();
+            animationFrameBlend(vAnimationFrames, fps, this->animationSpeed(), this->animationKeepKeyframes());
+        }
 
-            dualQuaternionTransformations[i].resize(transformations.size());
+        //Compute final transformations
+        animationFrameDeformationFromGlobal(*(vSkeletonDrawer.skeleton()), vAnimationFrames);
 
+        if (this->vAnimationSkinningMode == SkinningMode::SKINNING_DUAL_QUATERNIONS) {
+            dualQuaternionTransformations.resize(vAnimationFrames.size());
             #pragma omp parallel for
-            for (Index j = 0; j < transformations.size(); ++j) {
-                dualQuaternionTransformations[i][j] = DualQuaternion<Scalar>(Quaternion<Scalar>(transformations[j].rotation()), transformations[j].translation());
+            for (Index i = 0; i < vAnimationFrames.size(); ++i) {
+                const std::vector<Transformation>& transformations = vAnimationFrames[i].transformations();
+
+                dualQuaternionTransformations[i].resize(transformations.size());
+
+                #pragma omp parallel for
+                for (Index j = 0; j < transformations.size(); ++j) {
+                    dualQuaternionTransformations[i][j] = DualQuaternion<Scalar>(Quaternion<Scalar>(transformations[j].rotation()), transformations[j].translation());
+                }
             }
         }
+        else {
+            dualQuaternionTransformations.clear();
+        }
+
+        //Skinned frames are baked in background, playback uses them when ready
+        if (this->animationCache()) {
+            vAnimationCacheClip = vAnimationCache.bake(cacheKey, vModel, vAnimationFrames, dualQuaternionTransformations);
+        }
     }
 
     resetAnimation();
@@ -270,6 +358,7 @@ void ModelDrawer<M>::resetAnimation()
 {
     this->vMeshDrawer.resetRenderingVertices();
     this->vMeshDrawer.resetRenderingVertexNormals();
+    this->vMeshDrawer.invalidatePackedVertices();
     this->vSkeletonDrawer.resetRenderingJoints();
 
     vAnimationCurrentFrameId = 0;
@@ -280,13 +369,17 @@ template<class M>
 void ModelDrawer<M>::unloadAnimation()
 {
     vAnimationLoaded = NULL_ID;
+    vAnimationCacheClip = nullptr;
+    vAnimationCacheSourceVisible = false;
     vAnimationFrames.clear();
     dualQuaternionTransformations.clear();
     vAnimationCurrentFrameId = NULL_ID;
     vAnimationRunning = false;
 
+    this->vMeshDrawer.setPackedVertexSource(nullptr, nullptr);
     this->vMeshDrawer.resetRenderingVertices();
     this->vMeshDrawer.resetRenderingVertexNormals();
+    this->vMeshDrawer.invalidatePackedVertices();
     this->vSkeletonDrawer.resetRenderingJoints();
 }
 
@@ -351,6 +444,9 @@ std::vector<typename Animation3d::Frame>& ModelDrawer<M>::animationFrames()
 template<class M>
 void ModelDrawer<M>::setAnimationFrames(const std::vector<typename Animation3d::Frame>& animationFrames)
 {
+    vAnimationCacheClip = nullptr;
+    vAnimationCacheSourceVisible = false;
+    vMeshDrawer.setPackedVertexSource(nullptr, nullptr);
     vAnimationFrames = animationFrames;
 }
 
@@ -360,6 +456,25 @@ Size ModelDrawer<M>::frameNumber()
     return vAnimationFrames.size();
 }
 
+template<class M>
+double ModelDrawer<M>::animationCacheProgress() const
+{
+    if (vAnimationCacheClip == nullptr)
+        return 0.0;
+
+    return vAnimationCacheClip->progress();
+}
+
+template<class M>
+void ModelDrawer<M>::clearAnimationCache()
+{
+    //The packed buffers must not read the baked data anymore
+    vAnimationCacheClip = nullptr;
+    vAnimationCacheSourceVisible = false;
+    vMeshDrawer.setPackedVertexSource(nullptr, nullptr);
+    vAnimationCache.clear();
+}
+
 template<class M>
 template<class T>
 void ModelDrawer<M>::renderLinearBlendingSkinning(const std::vector<T>& transformations)
@@ -432,24 +547,79 @@ void ModelDrawer<M>::renderDualQuaternionSkinning(const std::vector<DualQuaterni
 template<class M>
 void ModelDrawer<M>::processKeyframePose(const Index& frameId)
 {
+    NVL_PROFILE_ZONE("ModelDrawer::processKeyframePose");
+
     typedef typename Model::Animation Animation;
     typedef typename Animation::Frame Frame;
     typedef typename Frame::Transformation Transformation;
+    typedef typename Model::Skeleton::JointId JointId;
 
-    if (this->vAnimationSkinningMode == SkinningMode::SKINNING_LINEAR_BLENDING) {
-        const Frame& frame = vAnimationFrames[frameId];
+    if (vAnimationCacheClip != nullptr && !vAnimationCacheClip->isFrameBaked(frameId)) {
+        //The baking continues from this frame, that is skinned now
+        vAnimationCache.requestFrame(*vAnimationCacheClip, frameId);
+    }
 
-        const std::vector<Transformation>& transformations = frame.transformations();
+    const float* cachePositions;
+    const float* cacheNormals;
+    const double* cacheJoints = nullptr;
 
-        this->renderLinearBlendingSkinning(transformations);
+    if (vAnimationCacheClip != nullptr && animationCacheSourceAvailable() &&
+            vAnimationCache.frameData(*vAnimationCacheClip, frameId, vAnimationCacheSourcePositions, vAnimationCacheSourceNormals, cachePositions, cacheNormals, cacheJoints)) {
+        //The packed buffers read the baked frame, the rendering vertices are not updated
+        vMeshDrawer.setPackedVertexSource(cachePositions, cacheNormals);
+        vAnimationCacheSourceVisible = true;
     }
     else {
-        assert(this->vAnimationSkinningMode == SkinningMode::SKINNING_DUAL_QUATERNIONS);
+        vMeshDrawer.setPackedVertexSource(nullptr, nullptr);
+        vAnimationCacheSourceVisible = false;
 
-        const std::vector<DualQuaterniond>& transformations = dualQuaternionTransformations[frameId];
+        if (vAnimationCacheClip != nullptr && vAnimationCache.loadFrame(*vAnimationCacheClip, frameId, vAnimationCachePositions, vAnimationCacheNormals, vAnimationCacheJoints)) {
+            vMeshDrawer.setRenderingVertices(vAnimationCachePositions);
+            if (!vAnimationCacheNormals.empty()) {
+                vMeshDrawer.setRenderingVertexNormals(vAnimationCacheNormals);
+            }
+
+            cacheJoints = vAnimationCacheJoints.data();
+        }
+        else if (this->vAnimationSkinningMode == SkinningMode::SKINNING_LINEAR_BLENDING) {
+            const Frame& frame = vAnimationFrames[frameId];
+
+            const std::vector<Transformation>& transformations = frame.transformations();
+
+            this->renderLinearBlendingSkinning(transformations);
+        }
+        else {
+            assert(this->vAnimationSkinningMode == SkinningMode::SKINNING_DUAL_QUATERNIONS);
+
+            const std::vector<DualQuaterniond>& transformations = dualQuaternionTransformations[frameId];
+
+            this->renderDualQuaternionSkinning(transformations);
+        }
 
-        this->renderDualQuaternionSkinning(transformations);
+        vMeshDrawer.invalidatePackedVertices();
     }
+
+    if (cacheJoints != nullptr) {
+        for (JointId jId = 0; jId < this->vModel->skeleton.jointNumber(); ++jId) {
+            if (!this->vModel->skeleton.jointIsHidden(jId)) {
+                vSkeletonDrawer.setRenderingJoint(jId, Point3d(cacheJoints[jId*3], cacheJoints[jId*3+1], cacheJoints[jId*3+2]));
+            }
+        }
+    }
+
+    vMeshDrawer.invalidatePickingData();
+}
+
+template<class M>
+bool ModelDrawer<M>::animationCacheSourceAvailable() const
+{
+    //The rendering vertices are needed when paused, for picking, and by the drawing modes other than the packed faces
+    return vAnimationRunning && !vAnimationPaused &&
+            vMeshDrawer.packedRendering() && glBuffersAvailable() &&
+            !vMeshDrawer.vertexVisible() &&
+            (!vMeshDrawer.polylineVisible() || vModel->mesh.polylineNumber() == 0) &&
+            !vMeshDrawer.wireframeVisible() && !vMeshDrawer.faceNormalVisible() &&
+            (!vMeshDrawer.faceShaderVisible() || vMeshDrawer.faceShader() == nullptr);
 }
 
 template<class M>
@@ -14,11 +14,13 @@
 #include <nvl/viewer/interfaces/drawable.h>
 #include <nvl/viewer/interfaces/pickable.h>
 #include <nvl/viewer/interfaces/animable.h>
+#include <nvl/viewer/interfaces/lodable.h>
 #include <nvl/viewer/gl/gl_frameable.h>
 
 #include <nvl/viewer/drawables/model_drawer_base.h>
 #include <nvl/viewer/drawables/face_mesh_drawer.h>
 #include <nvl/viewer/drawables/skeleton_drawer.h>
+#include <nvl/viewer/drawables/model_animation_cache.h>
 
 #include <nvl/models/animation_3d.h>
 
@@ -29,7 +31,7 @@
 namespace nvl {
 
 template<class M>
-class ModelDrawer : public Drawable, public Pickable, public Animable, public GLFrameable, public ModelDrawerBase
+class ModelDrawer : public Drawable, public Pickable, public Animable, public LODable, public GLFrameable, public ModelDrawerBase
 {
 
 public:
@@ -50,6 +52,7 @@ public:
 
     void draw() const override;
     void drawWithNames(Canvas* canvas, const Index drawableId) const override;
+    bool rayPick(Canvas* canvas, const Index drawableId, const Point3d& rayOrigin, const Vector3d& rayDirection, double& t) const override;
 
     void startAnimation() override;
     void pauseAnimation() override;
@@ -57,6 +60,9 @@ public:
     bool animate() override;
     bool animationRunning() const override;
 
+    void selectLOD(const Matrix44d& modelViewMatrix, const Matrix44d& projectionMatrix, const double& screenHeight) override;
+    void setLODEnabled(bool lodEnabled) override;
+
     Point3d sceneCenter() const override;
     double sceneRadius() const override;
 
@@ -84,6 +90,9 @@ public:
     void setAnimationFrames(const std::vector<Frame>& animationFrames);
     Size frameNumber();
 
+    double animationCacheProgress() const;
+    void clearAnimationCache();
+
     template<class T>
     void renderLinearBlendingSkinning(const std::vector<T>& transformations);
     void renderDualQuaternionSkinning(const std::vector<DualQuaterniond>& transformations);
@@ -96,6 +105,7 @@ private:
 
     void resetAnimation();
     void processKeyframePose(const Index& frameId);
+    bool animationCacheSourceAvailable() const;
 
 
 protected:
@@ -113,6 +123,15 @@ protected:
 
     Index vAnimationCurrentFrameId;
 
+    ModelAnimationCache<M> vAnimationCache;
+    typename ModelAnimationCache<M>::Clip* vAnimationCacheClip;
+    std::vector<double> vAnimationCachePositions;
+    std::vector<double> vAnimationCacheNormals;
+    std::vector<double> vAnimationCacheJoints;
+    std::vector<float> vAnimationCacheSourcePositions;
+    std::vector<float> vAnimationCacheSourceNormals;
+    bool vAnimationCacheSourceVisible;
+
     bool vAnimationRunning;
     bool vAnimationPaused;
     std::chrono::time_point<std::chrono::system_clock> vAnimationStartTime;
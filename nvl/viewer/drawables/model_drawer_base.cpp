@@ -14,7 +14,10 @@ NVL_INLINE ModelDrawerBase::ModelDrawerBase() :
     vAnimationSkinningMode(SKINNING_DUAL_QUATERNIONS),
     vAnimationBlend(true),
     vAnimationKeepKeyframes(true),
-    vAnimationTargetFPS(30)
+    vAnimationTargetFPS(30),
+    vAnimationCache(false),
+    vAnimationCacheQuantized(false),
+    vAnimationCacheMemory(512 * 1024 * 1024)
 {
 
 }
@@ -79,4 +82,34 @@ NVL_INLINE bool ModelDrawerBase::animationKeepKeyframes()
     return vAnimationKeepKeyframes;
 }
 
+NVL_INLINE void ModelDrawerBase::setAnimationCache(bool cache)
+{
+    vAnimationCache = cache;
+}
+
+NVL_INLINE bool ModelDrawerBase::animationCache() const
+{
+    return vAnimationCache;
+}
+
+NVL_INLINE void ModelDrawerBase::setAnimationCacheQuantized(bool quantized)
+{
+    vAnimationCacheQuantized = quantized;
+}
+
+NVL_INLINE bool ModelDrawerBase::animationCacheQuantized() const
+{
+    return vAnimationCacheQuantized;
+}
+
+NVL_INLINE void ModelDrawerBase::setAnimationCacheMemory(Size bytes)
+{
+    vAnimationCacheMemory = bytes;
+}
+
+NVL_INLINE Size ModelDrawerBase::animationCacheMemory() const
+{
+    return vAnimationCacheMemory;
+}
+
 }
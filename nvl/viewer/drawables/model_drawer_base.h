@@ -41,6 +41,15 @@ public:
     void setAnimationKeepKeyframes(bool keep);
     bool animationKeepKeyframes();
 
+    void setAnimationCache(bool cache);
+    bool animationCache() const;
+
+    void setAnimationCacheQuantized(bool quantized);
+    bool animationCacheQuantized() const;
+
+    void setAnimationCacheMemory(Size bytes);
+    Size animationCacheMemory() const;
+
     virtual void update() = 0;
 
 protected:
@@ -51,6 +60,9 @@ protected:
     bool vAnimationBlend;
     bool vAnimationKeepKeyframes;
     double vAnimationTargetFPS;
+    bool vAnimationCache;
+    bool vAnimationCacheQuantized;
+    Size vAnimationCacheMemory;
 
 };
 
@@ -11,6 +11,10 @@
 #include <nvl/viewer/gl/gl_primitives.h>
 #include <nvl/viewer/gl/gl_draw.h>
 
+#include <nvl/utilities/profiler.h>
+
+#include <algorithm>
+
 namespace nvl {
 
 template<class M>
@@ -32,6 +36,8 @@ PolylineMeshDrawer<M>::PolylineMeshDrawer(M* mesh, const bool visible, const boo
 template<class M>
 void PolylineMeshDrawer<M>::draw() const
 {
+    NVL_PROFILE_ZONE("PolylineMeshDrawer::draw");
+
     if (this->vMesh == nullptr)
         return;
 
@@ -76,9 +82,15 @@ void PolylineMeshDrawer<M>::drawWithNames(Canvas* canvas, const Index drawableId
 template<class M>
 void PolylineMeshDrawer<M>::update()
 {
+    NVL_PROFILE_ZONE("PolylineMeshDrawer::update");
+
+    const bool dirtyUpdate = this->dirtyUpdateAvailable();
+
     VertexMeshDrawer<M>::update();
 
-    resetRenderingPolylineData();
+    if (!dirtyUpdate) {
+        resetRenderingPolylineData();
+    }
 }
 
 template<class M>
@@ -122,6 +134,8 @@ void PolylineMeshDrawer<M>::resetRenderingData()
 template<class M>
 void PolylineMeshDrawer<M>::resetRenderingPolylineData()
 {
+    NVL_PROFILE_ZONE("PolylineMeshDrawer::resetRenderingPolylineData");
+
     typedef typename M::Polyline Polyline;
 
     if (this->vMesh == nullptr)
@@ -230,6 +244,72 @@ void PolylineMeshDrawer<M>::setRenderingPolylineColor(const Index& id, const Col
     this->vRenderingPolylineColors[mappedId*4+3] = c.alphaF();
 }
 
+template<class M>
+void PolylineMeshDrawer<M>::markPolylineDirty(const Index& id)
+{
+    vDirtyPolylines.push_back(id);
+}
+
+template<class M>
+void PolylineMeshDrawer<M>::markPolylinesDirty(const std::vector<Index>& ids)
+{
+    vDirtyPolylines.insert(vDirtyPolylines.end(), ids.begin(), ids.end());
+}
+
+template<class M>
+bool PolylineMeshDrawer<M>::hasDirtyElements() const
+{
+    return VertexMeshDrawer<M>::hasDirtyElements() || !vDirtyPolylines.empty();
+}
+
+template<class M>
+void PolylineMeshDrawer<M>::clearDirtyElements()
+{
+    VertexMeshDrawer<M>::clearDirtyElements();
+    vDirtyPolylines.clear();
+}
+
+template<class M>
+bool PolylineMeshDrawer<M>::dirtyUpdateAvailable() const
+{
+    if (!VertexMeshDrawer<M>::dirtyUpdateAvailable())
+        return false;
+
+    if (vPolylineMap.size() != this->vMesh->nextPolylineId() ||
+            this->vRenderingPolylines.size() != this->vMesh->polylineNumber() ||
+            this->vMesh->hasPolylineColors() == this->vRenderingPolylineColors.empty())
+        return false;
+
+    for (const Index& pId : vDirtyPolylines) {
+        if (pId >= this->vMesh->nextPolylineId() || this->vMesh->isPolylineDeleted(pId) || vPolylineMap[pId] == NULL_ID)
+            return false;
+    }
+
+    return true;
+}
+
+template<class M>
+void PolylineMeshDrawer<M>::updateDirtyRenderingData()
+{
+    NVL_PROFILE_ZONE("PolylineMeshDrawer::updateDirtyRenderingData");
+
+    VertexMeshDrawer<M>::updateDirtyRenderingData();
+
+    std::sort(vDirtyPolylines.begin(), vDirtyPolylines.end());
+    vDirtyPolylines.erase(std::unique(vDirtyPolylines.begin(), vDirtyPolylines.end()), vDirtyPolylines.end());
+
+    #pragma omp parallel for
+    for (Index i = 0; i < vDirtyPolylines.size(); ++i) {
+        const Index& pId = vDirtyPolylines[i];
+
+        resetRenderingPolyline(pId);
+
+        if (!this->vRenderingPolylineColors.empty()) {
+            resetRenderingPolylineColor(pId);
+        }
+    }
+}
+
 template<class M>
 void PolylineMeshDrawer<M>::drawPolylinesLines() const
 {
@@ -55,10 +55,20 @@ public:
     void setRenderingPolyline(const Index& id, const std::vector<unsigned int>& p);
     void setRenderingPolylineColor(const Index& id, const Color& c);
 
+    void markPolylineDirty(const Index& id);
+    void markPolylinesDirty(const std::vector<Index>& ids);
+    virtual bool hasDirtyElements() const override;
+    virtual void clearDirtyElements() override;
+
 protected:
 
     std::vector<Index> vPolylineMap;
 
+    std::vector<Index> vDirtyPolylines;
+
+    virtual bool dirtyUpdateAvailable() const override;
+    virtual void updateDirtyRenderingData() override;
+
     std::vector<std::vector<unsigned int>> vRenderingPolylines;
     std::vector<float> vRenderingPolylineColors;
 
@@ -0,0 +1,342 @@
+/*
+ * This file is part of nuvolib: https://github.com/stefanonuvoli/nuvolib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Stefano Nuvoli (stefano.nuvoli@gmail.com)
+ */
+#include "ray_picking.h"
+
+#include <nvl/math/numeric_limits.h>
+#include <nvl/math/closest_point.h>
+
+#include <cmath>
+
+namespace nvl {
+
+/**
+ * @brief Ray passing through a point of the screen, obtained by unprojecting
+ * the point on the near and on the far plane
+ * @param modelViewProjectionMatrix Model view projection matrix of the camera
+ * @param width Width of the screen
+ * @param height Height of the screen
+ * @param point2D Point of the screen (origin on the top left corner)
+ * @param rayOrigin Origin of the ray, on the near plane
+ * @param rayDirection Direction of the ray, reaching the far plane with
+ * parameter 1
+ */
+NVL_INLINE void pickingRay(
+        const Matrix44d& modelViewProjectionMatrix,
+        const double& width,
+        const double& height,
+        const Point2d& point2D,
+        Point3d& rayOrigin,
+        Vector3d& rayDirection)
+{
+    const Matrix44d inverseMatrix = modelViewProjectionMatrix.inverse();
+
+    const double x = 2.0 * point2D.x() / width - 1.0;
+    const double y = 1.0 - 2.0 * point2D.y() / height;
+
+    Eigen::Vector4d nearPoint = inverseMatrix * Eigen::Vector4d(x, y, -1.0, 1.0);
+    Eigen::Vector4d farPoint = inverseMatrix * Eigen::Vector4d(x, y, 1.0, 1.0);
+    nearPoint /= nearPoint.w();
+    farPoint /= farPoint.w();
+
+    rayOrigin = nearPoint.head<3>();
+    rayDirection = farPoint.head<3>() - nearPoint.head<3>();
+}
+
+/**
+ * @brief Bounding boxes of the rendering faces, to build a picking hierarchy
+ * @param vertices Rendering vertex coordinates
+ * @param faces Rendering faces
+ * @param faceMap Rendering face of each id (NULL_ID for the ids to be skipped)
+ * @param boxes Bounding box of each id (empty for the skipped ids)
+ */
+NVL_INLINE void pickingFaceBoxes(
+        const std::vector<double>& vertices,
+        const std::vector<std::vector<unsigned int>>& faces,
+        const std::vector<Index>& faceMap,
+        std::vector<AlignedBox3d>& boxes)
+{
+    boxes.resize(faceMap.size());
+
+    #pragma omp parallel for
+    for (Index i = 0; i < faceMap.size(); ++i) {
+        boxes[i].setEmpty();
+
+        if (faceMap[i] == NULL_ID)
+            continue;
+
+        for (const unsigned int& vId : faces[faceMap[i]]) {
+            boxes[i].extend(Point3d(vertices[vId*3], vertices[vId*3+1], vertices[vId*3+2]));
+        }
+    }
+}
+
+/**
+ * @brief Bounding boxes of the rendering vertices, to build a picking hierarchy
+ * @param vertices Rendering vertex coordinates
+ * @param vertexMap Rendering vertex of each id (NULL_ID for the ids to be skipped)
+ * @param radius Picking radius of the vertices
+ * @param boxes Bounding box of each id (empty for the skipped ids)
+ */
+NVL_INLINE void pickingPointBoxes(
+        const std::vector<double>& vertices,
+        const std::vector<Index>& vertexMap,
+        const double& radius,
+        std::vector<AlignedBox3d>& boxes)
+{
+    boxes.resize(vertexMap.size());
+
+    const Vector3d offset(radius, radius, radius);
+
+    #pragma omp parallel for
+    for (Index i = 0; i < vertexMap.size(); ++i) {
+        boxes[i].setEmpty();
+
+        if (vertexMap[i] == NULL_ID)
+            continue;
+
+        const Index& vId = vertexMap[i];
+        const Point3d point(vertices[vId*3], vertices[vId*3+1], vertices[vId*3+2]);
+
+        boxes[i].extend(point - offset);
+        boxes[i].extend(point + offset);
+    }
+}
+
+/**
+ * @brief First rendering face hit by a ray. The polygonal faces are
+ * triangulated as fans.
+ * @param vertices Rendering vertex coordinates
+ * @param faces Rendering faces
+ * @param faceMap Rendering face of each id
+ * @param bvh Hierarchy built on the boxes of pickingFaceBoxes
+ * @param rayOrigin Origin of the ray
+ * @param rayDirection Direction of the ray
+ * @param t Ray parameter of the hit point
+ * @param corner Position in the face of the vertex nearest to the hit point
+ * @param edge Position in the face of the edge nearest to the hit point (the
+ * edge j joins the corners j and j+1)
+ * @return Id of the face hit, NULL_ID if no face is hit
+ */
+NVL_INLINE Index pickingRayFace(
+        const std::vector<double>& vertices,
+        const std::vector<std::vector<unsigned int>>& faces,
+        const std::vector<Index>& faceMap,
+        const BVH<double,3>& bvh,
+        const Point3d& rayOrigin,
+        const Vector3d& rayDirection,
+        double& t,
+        Index& corner,
+        Index& edge)
+{
+    corner = NULL_ID;
+    edge = NULL_ID;
+
+    const Index hitId = bvh.raycast(rayOrigin, rayDirection, [&](const Index& id, const Point3d& origin, const Vector3d& direction) {
+        const std::vector<unsigned int>& face = faces[faceMap[id]];
+
+        double faceT = maxLimitValue<double>();
+        if (face.size() < 3)
+            return faceT;
+
+        const Point3d p1(vertices[face[0]*3], vertices[face[0]*3+1], vertices[face[0]*3+2]);
+        for (Index j = 2; j < face.size(); ++j) {
+            const Point3d p2(vertices[face[j-1]*3], vertices[face[j-1]*3+1], vertices[face[j-1]*3+2]);
+            const Point3d p3(vertices[face[j]*3], vertices[face[j]*3+1], vertices[face[j]*3+2]);
+
+            faceT = std::min(faceT, pickingRayTriangle(p1, p2, p3, origin, direction));
+        }
+
+        return faceT;
+    }, t);
+
+    if (hitId == NULL_ID)
+        return hitId;
+
+    const std::vector<unsigned int>& face = faces[faceMap[hitId]];
+    const Point3d hitPoint = rayOrigin + t * rayDirection;
+
+    double minVertexDistance = maxLimitValue<double>();
+    double minEdgeDistance = maxLimitValue<double>();
+    for (Index j = 0; j < face.size(); ++j) {
+        const unsigned int& vId1 = face[j];
+        const unsigned int& vId2 = face[(j + 1) % face.size()];
+
+        const Point3d p1(vertices[vId1*3], vertices[vId1*3+1], vertices[vId1*3+2]);
+        const Point3d p2(vertices[vId2*3], vertices[vId2*3+1], vertices[vId2*3+2]);
+
+        const double vertexDistance = (p1 - hitPoint).squaredNorm();
+        if (vertexDistance < minVertexDistance) {
+            minVertexDistance = vertexDistance;
+            corner = j;
+        }
+
+        const double edgeDistance = (closestPointOnSegment(p1, p2, hitPoint) - hitPoint).squaredNorm();
+        if (edgeDistance < minEdgeDistance) {
+            minEdgeDistance = edgeDistance;
+            edge = j;
+        }
+    }
+
+    return hitId;
+}
+
+/**
+ * @brief Nearest rendering vertex, within a radius, to a ray
+ * @param vertices Rendering vertex coordinates
+ * @param vertexMap Rendering vertex of each id
+ * @param bvh Hierarchy built on the boxes of pickingPointBoxes
+ * @param radius Picking radius of the vertices
+ * @param rayOrigin Origin of the ray
+ * @param rayDirection Direction of the ray
+ * @param t Ray parameter of the point nearest to the vertex
+ * @return Id of the vertex hit, NULL_ID if no vertex is hit
+ */
+NVL_INLINE Index pickingRayPoint(
+        const std::vector<double>& vertices,
+        const std::vector<Index>& vertexMap,
+        const BVH<double,3>& bvh,
+        const double& radius,
+        const Point3d& rayOrigin,
+        const Vector3d& rayDirection,
+        double& t)
+{
+    return bvh.raycast(rayOrigin, rayDirection, [&](const Index& id, const Point3d& origin, const Vector3d& direction) {
+        const Index& vId = vertexMap[id];
+        return pickingRaySphere(Point3d(vertices[vId*3], vertices[vId*3+1], vertices[vId*3+2]), radius, origin, direction);
+    }, t);
+}
+
+/**
+ * @brief Intersection between a ray and a triangle (Moller-Trumbore), both
+ * sides of the triangle are hit
+ * @param p1 First point of the triangle
+ * @param p2 Second point of the triangle
+ * @param p3 Third point of the triangle
+ * @param rayOrigin Origin of the ray
+ * @param rayDirection Direction of the ray
+ * @return Ray parameter of the intersection, maxLimitValue if the triangle is not hit
+ */
+NVL_INLINE double pickingRayTriangle(
+        const Point3d& p1,
+        const Point3d& p2,
+        const Point3d& p3,
+        const Point3d& rayOrigin,
+        const Vector3d& rayDirection)
+{
+    const Vector3d e1 = p2 - p1;
+    const Vector3d e2 = p3 - p1;
+
+    const Vector3d p = rayDirection.cross(e2);
+    const double det = e1.dot(p);
+
+    if (std::fabs(det) <= std::numeric_limits<double>::min())
+        return maxLimitValue<double>();
+
+    const double inverseDet = 1.0 / det;
+
+    const Vector3d s = rayOrigin - p1;
+    const double u = s.dot(p) * inverseDet;
+    if (u < 0.0 || u > 1.0)
+        return maxLimitValue<double>();
+
+    const Vector3d q = s.cross(e1);
+    const double v = rayDirection.dot(q) * inverseDet;
+    if (v < 0.0 || u + v > 1.0)
+        return maxLimitValue<double>();
+
+    const double t = e2.dot(q) * inverseDet;
+    if (t < 0.0)
+        return maxLimitValue<double>();
+
+    return t;
+}
+
+/**
+ * @brief Intersection between a ray and a sphere
+ * @param center Center of the sphere
+ * @param radius Radius of the sphere
+ * @param rayOrigin Origin of the ray
+ * @param rayDirection Direction of the ray
+ * @return Ray parameter of the point of the ray nearest to the center,
+ * maxLimitValue if the sphere is not hit
+ */
+NVL_INLINE double pickingRaySphere(
+        const Point3d& center,
+        const double& radius,
+        const Point3d& rayOrigin,
+        const Vector3d& rayDirection)
+{
+    const double squaredNorm = rayDirection.squaredNorm();
+    if (squaredNorm <= 0.0)
+        return maxLimitValue<double>();
+
+    const double t = (center - rayOrigin).dot(rayDirection) / squaredNorm;
+    if (t < 0.0)
+        return maxLimitValue<double>();
+
+    if ((rayOrigin + t * rayDirection - center).squaredNorm() > radius * radius)
+        return maxLimitValue<double>();
+
+    return t;
+}
+
+/**
+ * @brief Intersection between a ray and a segment with a radius (capsule)
+ * @param p1 First endpoint of the segment
+ * @param p2 Second endpoint of the segment
+ * @param radius Radius of the segment
+ * @param rayOrigin Origin of the ray
+ * @param rayDirection Direction of the ray
+ * @return Ray parameter of the point of the ray nearest to the segment,
+ * maxLimitValue if the segment is not hit
+ */
+NVL_INLINE double pickingRaySegment(
+        const Point3d& p1,
+        const Point3d& p2,
+        const double& radius,
+        const Point3d& rayOrigin,
+        const Vector3d& rayDirection)
+{
+    const Vector3d segmentDirection = p2 - p1;
+    const Vector3d r = rayOrigin - p1;
+
+    const double a = rayDirection.squaredNorm();
+    const double b = rayDirection.dot(segmentDirection);
+    const double c = segmentDirection.squaredNorm();
+    const double d = rayDirection.dot(r);
+    const double e = segmentDirection.dot(r);
+
+    if (a <= 0.0)
+        return maxLimitValue<double>();
+
+    if (c <= 0.0)
+        return pickingRaySphere(p1, radius, rayOrigin, rayDirection);
+
+    //Closest points of the lines, then clamped on the segment and on the ray
+    const double denominator = a * c - b * b;
+
+    double s = 0.0;
+    if (denominator > 0.0) {
+        s = std::min(std::max((a * e - b * d) / denominator, 0.0), 1.0);
+    }
+
+    double t = (b * s - d) / a;
+    if (t < 0.0) {
+        t = 0.0;
+        s = std::min(std::max(e / c, 0.0), 1.0);
+    }
+
+    const Point3d rayPoint = rayOrigin + t * rayDirection;
+    const Point3d segmentPoint = p1 + s * segmentDirection;
+
+    if ((rayPoint - segmentPoint).squaredNorm() > radius * radius)
+        return maxLimitValue<double>();
+
+    return t;
+}
+
+}
@@ -0,0 +1,86 @@
+/*
+ * This file is part of nuvolib: https://github.com/stefanonuvoli/nuvolib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Stefano Nuvoli (stefano.nuvoli@gmail.com)
+ */
+#ifndef NVL_VIEWER_RAY_PICKING_H
+#define NVL_VIEWER_RAY_PICKING_H
+
+#include <nvl/nuvolib.h>
+
+#include <nvl/math/point.h>
+#include <nvl/math/matrix.h>
+#include <nvl/math/alignedbox.h>
+
+#include <nvl/structures/trees/bvh.h>
+
+#include <vector>
+
+namespace nvl {
+
+void pickingRay(
+        const Matrix44d& modelViewProjectionMatrix,
+        const double& width,
+        const double& height,
+        const Point2d& point2D,
+        Point3d& rayOrigin,
+        Vector3d& rayDirection);
+
+void pickingFaceBoxes(
+        const std::vector<double>& vertices,
+        const std::vector<std::vector<unsigned int>>& faces,
+        const std::vector<Index>& faceMap,
+        std::vector<AlignedBox3d>& boxes);
+
+void pickingPointBoxes(
+        const std::vector<double>& vertices,
+        const std::vector<Index>& vertexMap,
+        const double& radius,
+        std::vector<AlignedBox3d>& boxes);
+
+Index pickingRayFace(
+        const std::vector<double>& vertices,
+        const std::vector<std::vector<unsigned int>>& faces,
+        const std::vector<Index>& faceMap,
+        const BVH<double,3>& bvh,
+        const Point3d& rayOrigin,
+        const Vector3d& rayDirection,
+        double& t,
+        Index& corner,
+        Index& edge);
+
+Index pickingRayPoint(
+        const std::vector<double>& vertices,
+        const std::vector<Index>& vertexMap,
+        const BVH<double,3>& bvh,
+        const double& radius,
+        const Point3d& rayOrigin,
+        const Vector3d& rayDirection,
+        double& t);
+
+double pickingRayTriangle(
+        const Point3d& p1,
+        const Point3d& p2,
+        const Point3d& p3,
+        const Point3d& rayOrigin,
+        const Vector3d& rayDirection);
+
+double pickingRaySphere(
+        const Point3d& center,
+        const double& radius,
+        const Point3d& rayOrigin,
+        const Vector3d& rayDirection);
+
+double pickingRaySegment(
+        const Point3d& p1,
+        const Point3d& p2,
+        const double& radius,
+        const Point3d& rayOrigin,
+        const Vector3d& rayDirection);
+
+}
+
+#include "ray_picking.cpp"
+
+#endif // NVL_VIEWER_RAY_PICKING_H
@@ -10,8 +10,14 @@
 
 #include <nvl/viewer/gl/gl_primitives.h>
 #include <nvl/viewer/gl/gl_draw.h>
+#include <nvl/viewer/drawables/ray_picking.h>
 
 #include <nvl/math/constants.h>
+#include <nvl/math/numeric_limits.h>
+
+#include <nvl/utilities/profiler.h>
+
+#include <algorithm>
 
 namespace nvl {
 
@@ -36,6 +42,8 @@ SkeletonDrawer<S>::SkeletonDrawer(S* skeleton, const bool visible, const bool pi
 template<class S>
 void SkeletonDrawer<S>::draw() const
 {
+    NVL_PROFILE_ZONE("SkeletonDrawer::draw");
+
     glDisable(GL_LIGHTING);
 
     if (this->transparency()) {
@@ -190,6 +198,87 @@ void SkeletonDrawer<S>::drawWithNames(Canvas* canvas, const Index drawableId) co
     }
 }
 
+template<class S>
+bool SkeletonDrawer<S>::rayPick(Canvas* canvas, const Index drawableId, const Point3d& rayOrigin, const Vector3d& rayDirection, double& t) const
+{
+    if (vSkeleton == nullptr || !this->vSkeletonVisible || !this->isPickable())
+        return false;
+
+    const double sizeJointBBoxFactor = 0.001;
+    const double jointSize = this->boundingBox().diagonal().norm() * sizeJointBBoxFactor * this->vJointSize;
+    const double sizeBoneBBoxFactor = 0.0005;
+    const double boneSize = this->boundingBox().diagonal().norm() * sizeBoneBBoxFactor * this->vBoneSize;
+
+    std::vector<std::pair<double, Canvas::PickingData>> hits;
+
+    if (this->vJointVisible) {
+        for (Index jId = 0; jId < vSkeleton->jointNumber(); ++jId) {
+            if (vSkeleton->jointIsHidden(jId))
+                continue;
+
+            if (this->transparency() && this->renderingJointColor(jId).alphaF() <= EPSILON)
+                continue;
+
+            const double jointT = pickingRaySphere(this->renderingJoint(jId), jointSize, rayOrigin, rayDirection);
+            if (jointT == maxLimitValue<double>())
+                continue;
+
+            Canvas::PickingData pickingData;
+            pickingData.identifier = Canvas::PICKING_SKELETON_JOINT;
+
+            pickingData.addValue(drawableId);
+            pickingData.addValue(jId);
+
+            hits.push_back(std::make_pair(jointT, pickingData));
+        }
+    }
+
+    if (this->vBoneVisible) {
+        for (Index bId = 0; bId < this->vRenderingBones.size(); ++bId) {
+            if (this->vRenderingBones[bId].size() < 2)
+                continue;
+
+            if (this->transparency() && this->vRenderingBoneColors[bId*4+3] <= EPSILON)
+                continue;
+
+            unsigned int jId1 = this->vRenderingBones[bId][0];
+            unsigned int jId2 = this->vRenderingBones[bId][1];
+
+            Point3d point1(this->vRenderingJoints[jId1*3], this->vRenderingJoints[jId1*3+1], this->vRenderingJoints[jId1*3+2]);
+            Point3d point2(this->vRenderingJoints[jId2*3], this->vRenderingJoints[jId2*3+1], this->vRenderingJoints[jId2*3+2]);
+
+            const double boneT = pickingRaySegment(point1, point2, boneSize, rayOrigin, rayDirection);
+            if (boneT == maxLimitValue<double>())
+                continue;
+
+            Canvas::PickingData pickingData;
+            pickingData.identifier = Canvas::PICKING_SKELETON_BONE;
+
+            pickingData.addValue(drawableId);
+            pickingData.addValue(jId1);
+            pickingData.addValue(jId2);
+
+            hits.push_back(std::make_pair(boneT, pickingData));
+        }
+    }
+
+    if (hits.empty())
+        return false;
+
+    std::stable_sort(hits.begin(), hits.end(), [](const std::pair<double, Canvas::PickingData>& a, const std::pair<double, Canvas::PickingData>& b) {
+        return a.first < b.first;
+    });
+
+    std::vector<Canvas::PickingData>& pickingNameMap = canvas->pickingDataPool();
+    for (const std::pair<double, Canvas::PickingData>& hit : hits) {
+        pickingNameMap.push_back(hit.second);
+    }
+
+    t = hits[0].first;
+
+    return true;
+}
+
 template<class S>
 Point3d SkeletonDrawer<S>::sceneCenter() const
 {
@@ -221,6 +310,8 @@ double SkeletonDrawer<S>::sceneRadius() const
 template<class S>
 void SkeletonDrawer<S>::update()
 {
+    NVL_PROFILE_ZONE("SkeletonDrawer::update");
+
     updateBoundingBox();
 
     resetRenderingData();
@@ -263,6 +354,8 @@ Color SkeletonDrawer<S>::renderingBoneColor(const Index& id) const
 template<class S>
 void SkeletonDrawer<S>::resetRenderingData()
 {
+    NVL_PROFILE_ZONE("SkeletonDrawer::resetRenderingData");
+
     typedef typename S::JointId JointId;
 
     if (vSkeleton == nullptr) {
@@ -33,6 +33,7 @@ public:
 
     void draw() const override;
     void drawWithNames(Canvas* canvas, const Index drawableId) const override;
+    bool rayPick(Canvas* canvas, const Index drawableId, const Point3d& rayOrigin, const Vector3d& rayDirection, double& t) const override;
 
     Point3d sceneCenter() const override;
     double sceneRadius() const override;
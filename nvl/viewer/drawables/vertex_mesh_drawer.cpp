@@ -12,6 +12,10 @@
 #include <nvl/viewer/gl/opengl_headers.h>
 #include <nvl/viewer/gl/gl_draw.h>
 
+#include <nvl/utilities/profiler.h>
+
+#include <algorithm>
+
 namespace nvl {
 
 template<class M>
@@ -24,6 +28,8 @@ template<class M>
 VertexMeshDrawer<M>::VertexMeshDrawer(M* mesh, const bool visible, const bool pickable) :
     VertexMeshDrawerBase(),
     MeshDrawer<M>(mesh, visible, pickable),
+    vPickingVertexDataValid(false),
+    vPickingVertexRadius(0.0),
     vDefaultVertexColor(0.7, 0.7, 0.7)
 {
     resetRenderingVertexData();
@@ -32,6 +38,8 @@ VertexMeshDrawer<M>::VertexMeshDrawer(M* mesh, const bool visible, const bool pi
 template<class M>
 void VertexMeshDrawer<M>::draw() const
 {
+    NVL_PROFILE_ZONE("VertexMeshDrawer::draw");
+
     if (this->vMesh == nullptr)
         return;
 
@@ -67,12 +75,42 @@ void VertexMeshDrawer<M>::drawWithNames(Canvas* canvas, const Index drawableId)
     }
 }
 
+template<class M>
+bool VertexMeshDrawer<M>::rayPick(Canvas* canvas, const Index drawableId, const Point3d& rayOrigin, const Vector3d& rayDirection, double& t) const
+{
+    if (this->vMesh == nullptr || !this->isPickable() || !this->vertexVisible())
+        return false;
+
+    const Index vId = rayPickVertex(rayOrigin, rayDirection, t);
+    if (vId == NULL_ID)
+        return false;
+
+    Canvas::PickingData pickingData;
+    pickingData.identifier = Canvas::PICKING_MESH_VERTEX;
+
+    pickingData.addValue(drawableId);
+    pickingData.addValue(vId);
+
+    canvas->pickingDataPool().push_back(pickingData);
+
+    return true;
+}
+
 template<class M>
 void VertexMeshDrawer<M>::update()
 {
-    MeshDrawer<M>::update();
+    NVL_PROFILE_ZONE("VertexMeshDrawer::update");
 
-    resetRenderingVertexData();
+    if (this->dirtyUpdateAvailable()) {
+        this->updateDirtyRenderingData();
+    }
+    else {
+        MeshDrawer<M>::update();
+
+        resetRenderingVertexData();
+    }
+
+    this->clearDirtyElements();
 }
 
 
@@ -122,6 +160,8 @@ void VertexMeshDrawer<M>::resetRenderingData()
 template<class M>
 void VertexMeshDrawer<M>::resetRenderingVertexData()
 {
+    NVL_PROFILE_ZONE("VertexMeshDrawer::resetRenderingVertexData");
+
     typedef typename M::Vertex Vertex;
 
     if (this->vMesh == nullptr) {
@@ -155,6 +195,8 @@ void VertexMeshDrawer<M>::resetRenderingVertices()
 
         resetRenderingVertex(vId);
     }
+
+    invalidatePickingData();
 }
 
 template<class M>
@@ -225,6 +267,8 @@ template<class M>
 void VertexMeshDrawer<M>::setRenderingVertices(const std::vector<double>& renderingVertices)
 {
     this->vRenderingVertices = renderingVertices;
+
+    invalidatePickingData();
 }
 
 template<class M>
@@ -267,6 +311,125 @@ void VertexMeshDrawer<M>::setRenderingVertexColor(const Index& id, const Color &
     this->vRenderingVertexColors[mappedId*4+3] = c.alphaF();
 }
 
+template<class M>
+void VertexMeshDrawer<M>::markVertexDirty(const Index& id)
+{
+    vDirtyVertices.push_back(id);
+}
+
+template<class M>
+void VertexMeshDrawer<M>::markVerticesDirty(const std::vector<Index>& ids)
+{
+    vDirtyVertices.insert(vDirtyVertices.end(), ids.begin(), ids.end());
+}
+
+template<class M>
+bool VertexMeshDrawer<M>::hasDirtyElements() const
+{
+    return !vDirtyVertices.empty();
+}
+
+template<class M>
+void VertexMeshDrawer<M>::clearDirtyElements()
+{
+    vDirtyVertices.clear();
+}
+
+template<class M>
+bool VertexMeshDrawer<M>::dirtyUpdateAvailable() const
+{
+    if (this->vMesh == nullptr || !this->hasDirtyElements())
+        return false;
+
+    //The dirty entries can be refreshed only if the layout of the rendering data is unchanged
+    if (vVertexMap.size() != this->vMesh->nextVertexId() ||
+            this->vRenderingVertices.size() != this->vMesh->vertexNumber() * 3 ||
+            this->vMesh->hasVertexNormals() == this->vRenderingVertexNormals.empty() ||
+            this->vMesh->hasVertexColors() == this->vRenderingVertexColors.empty())
+        return false;
+
+    for (const Index& vId : vDirtyVertices) {
+        if (vId >= this->vMesh->nextVertexId() || this->vMesh->isVertexDeleted(vId) || vVertexMap[vId] == NULL_ID)
+            return false;
+    }
+
+    return true;
+}
+
+template<class M>
+void VertexMeshDrawer<M>::updateDirtyRenderingData()
+{
+    NVL_PROFILE_ZONE("VertexMeshDrawer::updateDirtyRenderingData");
+
+    std::sort(vDirtyVertices.begin(), vDirtyVertices.end());
+    vDirtyVertices.erase(std::unique(vDirtyVertices.begin(), vDirtyVertices.end()), vDirtyVertices.end());
+
+    #pragma omp parallel for
+    for (Index i = 0; i < vDirtyVertices.size(); ++i) {
+        const Index& vId = vDirtyVertices[i];
+
+        resetRenderingVertex(vId);
+
+        if (!this->vRenderingVertexNormals.empty()) {
+            resetRenderingVertexNormal(vId);
+        }
+        if (!this->vRenderingVertexColors.empty()) {
+            resetRenderingVertexColor(vId);
+        }
+    }
+
+    //The bounding box can only grow, it is recomputed on the next full update
+    for (const Index& vId : vDirtyVertices) {
+        this->vBoundingBox.extend(this->vMesh->vertexPoint(vId));
+    }
+
+    invalidatePickingData();
+}
+
+template<class M>
+void VertexMeshDrawer<M>::invalidatePickingData()
+{
+    vPickingVertexDataValid = false;
+}
+
+template<class M>
+void VertexMeshDrawer<M>::updatePickingVertexData() const
+{
+    const double radius = getVertexSize();
+
+    std::vector<Index> vertexMap(this->vMesh->nextVertexId(), NULL_ID);
+    for (Index vId = 0; vId < this->vMesh->nextVertexId(); ++vId) {
+        if (!this->vMesh->isVertexDeleted(vId)) {
+            vertexMap[vId] = vVertexMap[vId];
+        }
+    }
+
+    std::vector<AlignedBox3d> boxes;
+    pickingPointBoxes(this->vRenderingVertices, vertexMap, radius, boxes);
+
+    //The hierarchy is refitted if the vertices are unchanged, rebuilt otherwise
+    if (!vPickingVertexBVH.empty() && vertexMap == vPickingVertexMap) {
+        vPickingVertexBVH.refit(boxes);
+    }
+    else {
+        vPickingVertexBVH.build(boxes);
+        vPickingVertexMap = std::move(vertexMap);
+    }
+
+    vPickingVertexRadius = radius;
+    vPickingVertexDataValid = true;
+}
+
+template<class M>
+Index VertexMeshDrawer<M>::rayPickVertex(const Point3d& rayOrigin, const Vector3d& rayDirection, double& t) const
+{
+    if (!vPickingVertexDataValid || vPickingVertexRadius != getVertexSize()) {
+        updatePickingVertexData();
+    }
+
+    return pickingRayPoint(this->vRenderingVertices, vPickingVertexMap, vPickingVertexBVH, vPickingVertexRadius, rayOrigin, rayDirection, t);
+}
+
 template<class M>
 void VertexMeshDrawer<M>::drawVerticesPoint() const
 {
@@ -13,6 +13,9 @@
 
 #include <nvl/viewer/drawables/vertex_mesh_drawer_base.h>
 #include <nvl/viewer/drawables/mesh_drawer.h>
+#include <nvl/viewer/drawables/ray_picking.h>
+
+#include <nvl/structures/trees/bvh.h>
 
 #include <nvl/utilities/color.h>
 
@@ -32,6 +35,7 @@ public:
 
     virtual void draw() const override;
     virtual void drawWithNames(Canvas* canvas, const Index drawableId) const override;
+    virtual bool rayPick(Canvas* canvas, const Index drawableId, const Point3d& rayOrigin, const Vector3d& rayDirection, double& t) const override;
 
     virtual void update() override;
 
@@ -60,14 +64,34 @@ public:
     void setRenderingVertexNormal(const Index& id, const Vector3d& n);
     void setRenderingVertexColor(const Index& id, const Color& c);
 
+    void markVertexDirty(const Index& id);
+    void markVerticesDirty(const std::vector<Index>& ids);
+    virtual bool hasDirtyElements() const;
+    virtual void clearDirtyElements();
+
+    virtual void invalidatePickingData();
+
 protected:
 
     std::vector<Index> vVertexMap;
 
+    std::vector<Index> vDirtyVertices;
+
+    virtual bool dirtyUpdateAvailable() const;
+    virtual void updateDirtyRenderingData();
+
     std::vector<double> vRenderingVertices;
     std::vector<double> vRenderingVertexNormals;
     std::vector<float> vRenderingVertexColors;
 
+    mutable bool vPickingVertexDataValid;
+    mutable double vPickingVertexRadius;
+    mutable std::vector<Index> vPickingVertexMap;
+    mutable BVH<double,3> vPickingVertexBVH;
+
+    void updatePickingVertexData() const;
+    Index rayPickVertex(const Point3d& rayOrigin, const Vector3d& rayDirection, double& t) const;
+
     void drawVerticesPoint() const;
     void drawVerticesDot() const;
     void drawVertexNormals() const;
@@ -0,0 +1,78 @@
+/*
+ * This file is part of nuvolib: https://github.com/stefanonuvoli/nuvolib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Stefano Nuvoli (stefano.nuvoli@gmail.com)
+ */
+#include "gl_buffers.h"
+
+#ifdef NVL_OPENGL_LOADED
+
+namespace nvl {
+
+NVL_INLINE bool glBuffersAvailable()
+{
+    return glGenBuffers != nullptr && glBufferData != nullptr && glBufferSubData != nullptr;
+}
+
+template<class T>
+void glUploadBuffer(
+        unsigned int& buffer,
+        const GLenum target,
+        const std::vector<T>& values,
+        const std::vector<std::pair<Size, Size>>& ranges,
+        const bool reallocate)
+{
+    if (buffer == 0) {
+        glGenBuffers(1, &buffer);
+    }
+
+    glBindBuffer(target, buffer);
+
+    if (reallocate) {
+        glBufferData(target, values.size() * sizeof(T), values.data(), GL_STATIC_DRAW);
+    }
+    else {
+        for (const std::pair<Size, Size>& range : ranges) {
+            glBufferSubData(target, range.first * sizeof(T), (range.second - range.first) * sizeof(T), values.data() + range.first);
+        }
+    }
+
+    glBindBuffer(target, 0);
+}
+
+template<class T>
+void glUploadBuffer(
+        unsigned int& buffer,
+        const GLenum target,
+        const T* values,
+        const Size number,
+        const bool reallocate)
+{
+    if (buffer == 0) {
+        glGenBuffers(1, &buffer);
+    }
+
+    glBindBuffer(target, buffer);
+
+    if (reallocate) {
+        glBufferData(target, number * sizeof(T), values, GL_STATIC_DRAW);
+    }
+    else {
+        glBufferSubData(target, 0, number * sizeof(T), values);
+    }
+
+    glBindBuffer(target, 0);
+}
+
+NVL_INLINE void glDeleteBuffer(unsigned int& buffer)
+{
+    if (buffer != 0) {
+        glDeleteBuffers(1, &buffer);
+        buffer = 0;
+    }
+}
+
+}
+
+#endif
@@ -0,0 +1,47 @@
+/*
+ * This file is part of nuvolib: https://github.com/stefanonuvoli/nuvolib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Stefano Nuvoli (stefano.nuvoli@gmail.com)
+ */
+#ifndef NVL_GL_BUFFERS_H
+#define NVL_GL_BUFFERS_H
+
+#include <nvl/nuvolib.h>
+
+#ifdef NVL_OPENGL_LOADED
+
+#include <nvl/viewer/gl/opengl_headers.h>
+
+#include <vector>
+#include <utility>
+
+namespace nvl {
+
+bool glBuffersAvailable();
+
+template<class T>
+void glUploadBuffer(
+        unsigned int& buffer,
+        const GLenum target,
+        const std::vector<T>& values,
+        const std::vector<std::pair<Size, Size>>& ranges,
+        const bool reallocate);
+
+template<class T>
+void glUploadBuffer(
+        unsigned int& buffer,
+        const GLenum target,
+        const T* values,
+        const Size number,
+        const bool reallocate);
+
+void glDeleteBuffer(unsigned int& buffer);
+
+}
+
+#include "gl_buffers.cpp"
+
+#endif
+
+#endif // NVL_GL_BUFFERS_H
@@ -0,0 +1,510 @@
+/*
+ * This file is part of nuvolib: https://github.com/stefanonuvoli/nuvolib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Stefano Nuvoli (stefano.nuvoli@gmail.com)
+ */
+#include "gl_texture_manager.h"
+
+#ifdef NVL_OPENGL_LOADED
+
+#include <nvl/math/numeric_limits.h>
+
+#include <nvl/utilities/profiler.h>
+
+#include <fstream>
+#include <iterator>
+
+namespace nvl {
+
+/**
+ * @brief Global texture manager instance
+ * @return Texture manager
+ */
+NVL_INLINE GLTextureManager& GLTextureManager::instance()
+{
+    static GLTextureManager manager;
+    return manager;
+}
+
+/**
+ * @brief Default constructor, the workers are started at the first request
+ */
+NVL_INLINE GLTextureManager::GLTextureManager() :
+    vDecodingNumber(0),
+    vStopping(false),
+    vPlaceholderTexture(maxLimitValue<unsigned int>()),
+    vNextListenerId(0)
+{
+
+}
+
+/**
+ * @brief Destructor, it stops the workers. The textures are not deleted,
+ * since the OpenGL context may not be available anymore.
+ */
+NVL_INLINE GLTextureManager::~GLTextureManager()
+{
+    {
+        std::lock_guard<std::mutex> lock(vMutex);
+        vStopping = true;
+    }
+    vJobCondition.notify_all();
+
+    for (std::thread& worker : vWorkers) {
+        worker.join();
+    }
+}
+
+/**
+ * @brief Request the texture of an image file. If the file has not been
+ * requested yet, it is queued for decoding. Each request must be paired
+ * with a release.
+ * @param filename Filename of the image
+ * @return Handle of the texture
+ */
+NVL_INLINE Index GLTextureManager::request(const std::string& filename)
+{
+    Index entryId;
+
+    {
+        std::lock_guard<std::mutex> lock(vMutex);
+
+        std::unordered_map<std::string, Index>::iterator it = vFilenameMap.find(filename);
+        if (it != vFilenameMap.end()) {
+            vEntries[it->second].references++;
+            return it->second;
+        }
+
+        Entry entry;
+        entry.filename = filename;
+        entry.state = TEXTURE_STATE_LOADING;
+        entry.texture = maxLimitValue<unsigned int>();
+        entry.references = 1;
+        entry.source = NULL_ID;
+        entry.hash = 0;
+        entry.dataSize = 0;
+
+        entryId = vEntries.size();
+        vEntries.push_back(entry);
+        vFilenameMap[filename] = entryId;
+
+        vJobs.push_back(entryId);
+
+        if (vWorkers.empty()) {
+            startWorkers();
+        }
+    }
+
+    vJobCondition.notify_one();
+
+    return entryId;
+}
+
+/**
+ * @brief Release a texture. When it is not requested anymore, it is deleted:
+ * it must be called from the thread of the OpenGL context.
+ * @param handle Handle of the texture
+ */
+NVL_INLINE void GLTextureManager::release(const Index& handle)
+{
+    std::lock_guard<std::mutex> lock(vMutex);
+    releaseEntry(handle);
+}
+
+/**
+ * @brief State of a texture
+ * @param handle Handle of the texture
+ * @return State
+ */
+NVL_INLINE GLTextureManager::TextureState GLTextureManager::state(const Index& handle) const
+{
+    std::lock_guard<std::mutex> lock(vMutex);
+    return vEntries[resolveSource(handle)].state;
+}
+
+/**
+ * @brief Texture id to be bound for a texture
+ * @param handle Handle of the texture
+ * @return The texture id if it is ready, the placeholder texture id if it
+ * is loading, maxLimitValue<unsigned int>() if it cannot be loaded
+ */
+NVL_INLINE unsigned int GLTextureManager::texture(const Index& handle) const
+{
+    std::lock_guard<std::mutex> lock(vMutex);
+
+    const Entry& entry = vEntries[resolveSource(handle)];
+    if (entry.state == TEXTURE_STATE_READY) {
+        return entry.texture;
+    }
+    if (entry.state == TEXTURE_STATE_FAILED) {
+        return maxLimitValue<unsigned int>();
+    }
+    return vPlaceholderTexture;
+}
+
+/**
+ * @brief Placeholder texture id, available after the first call of
+ * processUploads()
+ * @return Placeholder texture id
+ */
+NVL_INLINE unsigned int GLTextureManager::placeholderTexture() const
+{
+    std::lock_guard<std::mutex> lock(vMutex);
+    return vPlaceholderTexture;
+}
+
+/**
+ * @brief Upload the decoded images. It must be called from the thread of the
+ * OpenGL context. The number of uploads is bounded to keep each frame short.
+ * @param maxUploads Max number of textures to be uploaded
+ * @return Number of uploaded textures
+ */
+NVL_INLINE Size GLTextureManager::processUploads(const Size maxUploads)
+{
+    NVL_PROFILE_ZONE("GLTextureManager::processUploads");
+
+    if (vPlaceholderTexture == maxLimitValue<unsigned int>()) {
+        TextureImage placeholder;
+        placeholder.width = 1;
+        placeholder.height = 1;
+        placeholder.channels = 3;
+        placeholder.levels.push_back(std::vector<unsigned char>(3, 255));
+
+        const unsigned int texture = glUploadTextureImage(placeholder);
+
+        std::lock_guard<std::mutex> lock(vMutex);
+        vPlaceholderTexture = texture;
+    }
+
+    Size uploadNumber = 0;
+    while (uploadNumber < maxUploads) {
+        Index entryId;
+        TextureImage image;
+
+        {
+            std::lock_guard<std::mutex> lock(vMutex);
+
+            if (vUploads.empty())
+                break;
+
+            entryId = vUploads.front();
+            vUploads.pop_front();
+
+            //Released while waiting for the upload
+            if (vEntries[entryId].references == 0)
+                continue;
+
+            image = std::move(vEntries[entryId].image);
+            vEntries[entryId].image = TextureImage();
+        }
+
+        const unsigned int texture = glUploadTextureImage(image);
+
+        {
+            std::lock_guard<std::mutex> lock(vMutex);
+
+            Entry& entry = vEntries[entryId];
+            if (entry.references == 0) {
+                glDeleteTextures(1, &texture);
+            }
+            else {
+                entry.texture = texture;
+                entry.state = TEXTURE_STATE_READY;
+            }
+        }
+
+        uploadNumber++;
+    }
+
+    return uploadNumber;
+}
+
+/**
+ * @brief Check if some textures are still being decoded or uploaded
+ * @return True if there are pending textures
+ */
+NVL_INLINE bool GLTextureManager::hasPendingTextures() const
+{
+    std::lock_guard<std::mutex> lock(vMutex);
+    return !vJobs.empty() || !vUploads.empty() || vDecodingNumber > 0;
+}
+
+/**
+ * @brief Add a listener, called from the worker threads each time a texture
+ * has been decoded. It is usually used to schedule a redraw, which then
+ * calls processUploads().
+ * @param listener Listener
+ * @return Id of the listener
+ */
+NVL_INLINE Index GLTextureManager::addListener(const std::function<void()>& listener)
+{
+    std::lock_guard<std::mutex> lock(vListenerMutex);
+
+    const Index listenerId = vNextListenerId++;
+    vListeners[listenerId] = listener;
+
+    return listenerId;
+}
+
+/**
+ * @brief Remove a listener
+ * @param listenerId Id of the listener
+ */
+NVL_INLINE void GLTextureManager::removeListener(const Index& listenerId)
+{
+    std::lock_guard<std::mutex> lock(vListenerMutex);
+    vListeners.erase(listenerId);
+}
+
+/**
+ * @brief Start the worker threads, leaving a core to the thread of the
+ * OpenGL context. The mutex must be locked.
+ */
+NVL_INLINE void GLTextureManager::startWorkers()
+{
+    const unsigned int cores = std::thread::hardware_concurrency();
+    const Size workerNumber = cores > 2 ? cores - 1 : 1;
+
+    for (Index i = 0; i < workerNumber; ++i) {
+        vWorkers.push_back(std::thread(&GLTextureManager::workerLoop, this));
+    }
+}
+
+/**
+ * @brief Loop of a worker thread
+ */
+NVL_INLINE void GLTextureManager::workerLoop()
+{
+    while (true) {
+        Index entryId;
+
+        {
+            std::unique_lock<std::mutex> lock(vMutex);
+            vJobCondition.wait(lock, [this]() { return vStopping || !vJobs.empty(); });
+
+            if (vStopping)
+                return;
+
+            entryId = vJobs.front();
+            vJobs.pop_front();
+
+            vDecodingNumber++;
+        }
+
+        decodeEntry(entryId);
+
+        notifyListeners();
+    }
+}
+
+/**
+ * @brief Read, decode and mipmap the image of an entry. If an entry with the
+ * same content already exists, the entry becomes an alias of it: the hashes
+ * are compared first, then the sizes and the bytes of the files.
+ * @param entryId Entry id
+ */
+NVL_INLINE void GLTextureManager::decodeEntry(const Index& entryId)
+{
+    NVL_PROFILE_ZONE("GLTextureManager::decodeEntry");
+
+    std::string filename;
+
+    {
+        std::lock_guard<std::mutex> lock(vMutex);
+
+        if (vEntries[entryId].references == 0) {
+            vDecodingNumber--;
+            return;
+        }
+
+        filename = vEntries[entryId].filename;
+    }
+
+    std::vector<unsigned char> data;
+    readFile(filename, data);
+
+    const std::uint64_t hash = contentHash(data);
+
+    Index candidateId = NULL_ID;
+    std::string candidateFilename;
+
+    {
+        std::lock_guard<std::mutex> lock(vMutex);
+
+        Entry& entry = vEntries[entryId];
+
+        if (entry.references == 0) {
+            vDecodingNumber--;
+            return;
+        }
+
+        if (data.empty()) {
+            entry.state = TEXTURE_STATE_FAILED;
+            vDecodingNumber--;
+            return;
+        }
+
+        entry.hash = hash;
+        entry.dataSize = data.size();
+
+        std::unordered_map<std::uint64_t, Index>::iterator it = vContentMap.find(hash);
+        if (it == vContentMap.end()) {
+            vContentMap[hash] = entryId;
+        }
+        else if (vEntries[it->second].dataSize == data.size()) {
+            candidateId = it->second;
+            candidateFilename = vEntries[candidateId].filename;
+        }
+    }
+
+    //The hash can collide: the entry becomes an alias only if the content is the same
+    if (candidateId != NULL_ID) {
+        std::vector<unsigned char> candidateData;
+        readFile(candidateFilename, candidateData);
+
+        if (candidateData == data) {
+            std::lock_guard<std::mutex> lock(vMutex);
+
+            Entry& entry = vEntries[entryId];
+
+            std::unordered_map<std::uint64_t, Index>::iterator it = vContentMap.find(hash);
+            if (entry.references > 0 && it != vContentMap.end() && it->second == candidateId) {
+                entry.source = candidateId;
+                vEntries[candidateId].references++;
+                vDecodingNumber--;
+                return;
+            }
+        }
+    }
+
+    TextureImage image;
+    const bool decoded = textureImageDecode(data, image);
+    if (decoded) {
+        textureImageGenerateMipmaps(image);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(vMutex);
+
+        Entry& entry = vEntries[entryId];
+
+        vDecodingNumber--;
+
+        if (entry.references == 0)
+            return;
+
+        if (decoded) {
+            entry.image = std::move(image);
+            vUploads.push_back(entryId);
+        }
+        else {
+            entry.state = TEXTURE_STATE_FAILED;
+        }
+    }
+}
+
+/**
+ * @brief Get the entry which stores the texture of an entry, following
+ * the aliases. The mutex must be locked.
+ * @param entryId Entry id
+ * @return Source entry id
+ */
+NVL_INLINE Index GLTextureManager::resolveSource(Index entryId) const
+{
+    while (vEntries[entryId].source != NULL_ID) {
+        entryId = vEntries[entryId].source;
+    }
+    return entryId;
+}
+
+/**
+ * @brief Decrease the references of an entry, deleting its texture if it is
+ * not referenced anymore. The mutex must be locked.
+ * @param entryId Entry id
+ */
+NVL_INLINE void GLTextureManager::releaseEntry(const Index& entryId)
+{
+    Entry& entry = vEntries[entryId];
+
+    assert(entry.references > 0);
+    entry.references--;
+
+    if (entry.references > 0)
+        return;
+
+    std::unordered_map<std::string, Index>::iterator filenameIt = vFilenameMap.find(entry.filename);
+    if (filenameIt != vFilenameMap.end() && filenameIt->second == entryId) {
+        vFilenameMap.erase(filenameIt);
+    }
+
+    std::unordered_map<std::uint64_t, Index>::iterator contentIt = vContentMap.find(entry.hash);
+    if (contentIt != vContentMap.end() && contentIt->second == entryId) {
+        vContentMap.erase(contentIt);
+    }
+
+    if (entry.texture != maxLimitValue<unsigned int>()) {
+        glDeleteTextures(1, &entry.texture);
+        entry.texture = maxLimitValue<unsigned int>();
+    }
+
+    entry.image = TextureImage();
+
+    if (entry.source != NULL_ID) {
+        releaseEntry(entry.source);
+    }
+}
+
+/**
+ * @brief Call the listeners
+ */
+NVL_INLINE void GLTextureManager::notifyListeners()
+{
+    std::lock_guard<std::mutex> lock(vListenerMutex);
+
+    for (const std::pair<const Index, std::function<void()>>& listener : vListeners) {
+        listener.second();
+    }
+}
+
+/**
+ * @brief Read the content of a file
+ * @param filename Filename
+ * @param data Content of the file, empty if it cannot be read
+ * @return True if the file has been read
+ */
+NVL_INLINE bool GLTextureManager::readFile(const std::string& filename, std::vector<unsigned char>& data)
+{
+    data.clear();
+
+    std::ifstream file(filename, std::ios::binary);
+    if (!file.is_open())
+        return false;
+
+    data.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+
+    return true;
+}
+
+/**
+ * @brief FNV-1a hash of the content of a file
+ * @param data Content of the file
+ * @return Hash
+ */
+NVL_INLINE std::uint64_t GLTextureManager::contentHash(const std::vector<unsigned char>& data)
+{
+    std::uint64_t hash = 14695981039346656037ULL;
+    for (const unsigned char& byte : data) {
+        hash ^= byte;
+        hash *= 1099511628211ULL;
+    }
+
+    hash ^= data.size();
+    hash *= 1099511628211ULL;
+
+    return hash;
+}
+
+}
+
+#endif
@@ -0,0 +1,120 @@
+/*
+ * This file is part of nuvolib: https://github.com/stefanonuvoli/nuvolib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Stefano Nuvoli (stefano.nuvoli@gmail.com)
+ */
+#ifndef NVL_GL_TEXTURE_MANAGER_H
+#define NVL_GL_TEXTURE_MANAGER_H
+
+#include <nvl/nuvolib.h>
+
+#ifdef NVL_OPENGL_LOADED
+
+#include <nvl/viewer/gl/gl_textures.h>
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <map>
+#include <unordered_map>
+#include <functional>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <cstdint>
+
+#define NVL_GL_TEXTURE_MANAGER_DEFAULT_UPLOADS 4
+
+namespace nvl {
+
+/**
+ * @brief Shared cache of the textures loaded from image files. The images are
+ * read, decoded and mipmapped by a pool of worker threads, then uploaded by
+ * processUploads(), which must be called from the thread of the OpenGL
+ * context (e.g. at the beginning of each draw). Textures are shared between
+ * the requests of the same file and between files with the same content.
+ * Until a texture is ready, a 1x1 white placeholder texture is returned.
+ */
+class GLTextureManager
+{
+
+public:
+
+    enum TextureState { TEXTURE_STATE_LOADING, TEXTURE_STATE_READY, TEXTURE_STATE_FAILED };
+
+    static GLTextureManager& instance();
+
+    ~GLTextureManager();
+
+    Index request(const std::string& filename);
+    void release(const Index& handle);
+
+    TextureState state(const Index& handle) const;
+    unsigned int texture(const Index& handle) const;
+    unsigned int placeholderTexture() const;
+
+    Size processUploads(const Size maxUploads = NVL_GL_TEXTURE_MANAGER_DEFAULT_UPLOADS);
+    bool hasPendingTextures() const;
+
+    Index addListener(const std::function<void()>& listener);
+    void removeListener(const Index& listenerId);
+
+
+protected:
+
+    GLTextureManager();
+    GLTextureManager(const GLTextureManager& other) = delete;
+    GLTextureManager& operator=(const GLTextureManager& other) = delete;
+
+    struct Entry {
+        std::string filename;
+        TextureState state;
+        unsigned int texture;
+        Size references;
+        Index source;
+        std::uint64_t hash;
+        Size dataSize;
+        TextureImage image;
+    };
+
+    mutable std::mutex vMutex;
+    std::condition_variable vJobCondition;
+
+    std::vector<Entry> vEntries;
+    std::unordered_map<std::string, Index> vFilenameMap;
+    std::unordered_map<std::uint64_t, Index> vContentMap;
+
+    std::deque<Index> vJobs;
+    std::deque<Index> vUploads;
+    Size vDecodingNumber;
+
+    std::vector<std::thread> vWorkers;
+    bool vStopping;
+
+    unsigned int vPlaceholderTexture;
+
+    std::mutex vListenerMutex;
+    std::map<Index, std::function<void()>> vListeners;
+    Index vNextListenerId;
+
+    void startWorkers();
+    void workerLoop();
+    void decodeEntry(const Index& entryId);
+
+    Index resolveSource(Index entryId) const;
+    void releaseEntry(const Index& entryId);
+    void notifyListeners();
+
+    static std::uint64_t contentHash(const std::vector<unsigned char>& data);
+    static bool readFile(const std::string& filename, std::vector<unsigned char>& data);
+
+};
+
+}
+
+#include "gl_texture_manager.cpp"
+
+#endif
+
+#endif // NVL_GL_TEXTURE_MANAGER_H
@@ -10,8 +10,11 @@
 
 #include <nvl/math/numeric_limits.h>
 
+#include <fstream>
+#include <iterator>
+#include <algorithm>
+
 #ifdef NVL_QGLVIEWER_LOADED
-#include <QGLViewer/qglviewer.h>
 #include <QImage>
 #else
 #ifdef NVL_STB_LOADED
@@ -25,96 +28,232 @@
 
 namespace nvl {
 
-NVL_INLINE int glLoadTextureImage(const std::string& filename, const GLint textureMode)
+/**
+ * @brief Default constructor: empty image
+ */
+NVL_INLINE TextureImage::TextureImage() :
+    width(0),
+    height(0),
+    channels(0)
+{
+
+}
+
+/**
+ * @brief Width of a level
+ * @param level Level
+ * @return Width
+ */
+NVL_INLINE int TextureImage::levelWidth(const Index& level) const
+{
+    return std::max(width >> level, 1);
+}
+
+/**
+ * @brief Height of a level
+ * @param level Level
+ * @return Height
+ */
+NVL_INLINE int TextureImage::levelHeight(const Index& level) const
+{
+    return std::max(height >> level, 1);
+}
+
+/**
+ * @brief Check if the image is empty
+ * @return True if the image has no levels
+ */
+NVL_INLINE bool TextureImage::isEmpty() const
+{
+    return levels.empty();
+}
+
+/**
+ * @brief Decode an image file from memory. It does not use OpenGL, so it can
+ * be called from any thread.
+ * @param data Content of the image file
+ * @param image Decoded image, with only the first level
+ * @return True if the image has been decoded
+ */
+NVL_INLINE bool textureImageDecode(const std::vector<unsigned char>& data, TextureImage& image)
 {
-    int textureId = maxLimitValue<unsigned int>();
+    image = TextureImage();
+
+    if (data.empty())
+        return false;
 
 #ifdef NVL_QGLVIEWER_LOADED
 
     QImage img;
-    bool imageLoaded = img.load(filename.c_str());
-    if (imageLoaded) {
-        QImage GL_formatted_image;
-        GL_formatted_image = QGLWidget::convertToGLFormat(img);
+    if (!img.loadFromData(data.data(), static_cast<int>(data.size())))
+        return false;
+
+    const bool hasAlpha = img.hasAlphaChannel();
+    img = img.convertToFormat(hasAlpha ? QImage::Format_RGBA8888 : QImage::Format_RGB888).mirrored();
+
+    image.width = img.width();
+    image.height = img.height();
+    image.channels = hasAlpha ? 4 : 3;
+
+    //QImage rows are aligned to 4 bytes
+    const Size rowSize = static_cast<Size>(image.width) * image.channels;
+    image.levels.resize(1);
+    image.levels[0].resize(rowSize * image.height);
+    for (int y = 0; y < image.height; ++y) {
+        std::copy(img.constScanLine(y), img.constScanLine(y) + rowSize, image.levels[0].begin() + y * rowSize);
+    }
 
-        glEnable(GL_BLEND);
-        glEnable(GL_TEXTURE_2D);
+    return true;
 
-        unsigned int texture;
-        glGenTextures(1, &texture);
-        glBindTexture(GL_TEXTURE_2D, texture);
+#else
 
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP);
+#ifdef NVL_STB_LOADED
 
-        if (GL_formatted_image.hasAlphaChannel()) {
-            glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, GL_formatted_image.width(), GL_formatted_image.height(), 0, GL_RGBA, GL_UNSIGNED_BYTE, GL_formatted_image.bits());
-        }
-        else {
-            glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, GL_formatted_image.width(), GL_formatted_image.height(), 0, GL_RGB, GL_UNSIGNED_BYTE, GL_formatted_image.bits());
-        }
+    int width, height, nrChannels;
+    if (!stbi_info_from_memory(data.data(), static_cast<int>(data.size()), &width, &height, &nrChannels))
+        return false;
 
-        glTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, textureMode);
+    //Gray images are expanded to RGB, gray-alpha images to RGBA
+    const int channels = (nrChannels == 2 || nrChannels == 4) ? 4 : 3;
 
-        glBindTexture(GL_TEXTURE_2D, 0);
+    stbi_set_flip_vertically_on_load_thread(true);
 
-        glDisable(GL_TEXTURE_2D);
-        glDisable(GL_BLEND);
+    unsigned char* pixels = stbi_load_from_memory(data.data(), static_cast<int>(data.size()), &width, &height, &nrChannels, channels);
+    if (pixels == nullptr)
+        return false;
 
-        textureId = texture;
+    image.width = width;
+    image.height = height;
+    image.channels = channels;
+    image.levels.resize(1);
+    image.levels[0].assign(pixels, pixels + static_cast<Size>(width) * height * channels);
 
-        GL_formatted_image = QImage();
-        img = QImage();
-    }
+    stbi_image_free(pixels);
+
+    return true;
 
 #else
 
-#ifdef NVL_STB_LOADED
-    int width, height, nrChannels;
+    return false;
+
+#endif
 
-    stbi_set_flip_vertically_on_load(true);
+#endif
+}
 
-    unsigned char *data = stbi_load(mat.diffuseMap().c_str(), &width, &height, &nrChannels, 0);
+/**
+ * @brief Generate the mipmaps of an image down to 1x1, averaging each 2x2
+ * block of the previous level. It does not use OpenGL, so it can be called
+ * from any thread.
+ * @param image Image, its first level is kept
+ */
+NVL_INLINE void textureImageGenerateMipmaps(TextureImage& image)
+{
+    if (image.isEmpty())
+        return;
 
-    if (data != nullptr) {
-        glEnable(GL_BLEND);
-        glEnable(GL_TEXTURE_2D);
+    image.levels.resize(1);
 
-        unsigned int texture;
-        glGenTextures(1, &texture);
-        glBindTexture(GL_TEXTURE_2D, texture);
+    const int& channels = image.channels;
 
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP);
+    Index level = 0;
+    while (image.levelWidth(level) > 1 || image.levelHeight(level) > 1) {
+        const int width = image.levelWidth(level);
+        const int height = image.levelHeight(level);
+        const int nextWidth = image.levelWidth(level + 1);
+        const int nextHeight = image.levelHeight(level + 1);
 
-        if (nrChannels == 4) {
-            glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, data);
-        }
-        else {
-            glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, width, height, 0, GL_RGB, GL_UNSIGNED_BYTE, data);
+        std::vector<unsigned char> nextLevel(static_cast<Size>(nextWidth) * nextHeight * channels);
+        const std::vector<unsigned char>& currentLevel = image.levels[level];
+
+        for (int y = 0; y < nextHeight; ++y) {
+            const int y0 = std::min(2 * y, height - 1);
+            const int y1 = std::min(2 * y + 1, height - 1);
+
+            for (int x = 0; x < nextWidth; ++x) {
+                const int x0 = std::min(2 * x, width - 1);
+                const int x1 = std::min(2 * x + 1, width - 1);
+
+                for (int c = 0; c < channels; ++c) {
+                    const unsigned int sum =
+                            currentLevel[(static_cast<Size>(y0) * width + x0) * channels + c] +
+                            currentLevel[(static_cast<Size>(y0) * width + x1) * channels + c] +
+                            currentLevel[(static_cast<Size>(y1) * width + x0) * channels + c] +
+                            currentLevel[(static_cast<Size>(y1) * width + x1) * channels + c];
+
+                    nextLevel[(static_cast<Size>(y) * nextWidth + x) * channels + c] = static_cast<unsigned char>((sum + 2) / 4);
+                }
+            }
         }
 
-        glTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, textureMode);
+        image.levels.push_back(std::move(nextLevel));
+        ++level;
+    }
+}
+
+/**
+ * @brief Upload an image and its mipmaps in a new texture. It must be called
+ * from the thread of the OpenGL context. If the image has mipmaps, they are
+ * used for the minification, otherwise the nearest texel is used.
+ * @param image Image
+ * @return Texture id, maxLimitValue<unsigned int>() if the image is empty
+ */
+NVL_INLINE unsigned int glUploadTextureImage(const TextureImage& image)
+{
+    if (image.isEmpty())
+        return maxLimitValue<unsigned int>();
 
-        glBindTexture(GL_TEXTURE_2D, 0);
+    unsigned int texture;
+    glGenTextures(1, &texture);
+    glBindTexture(GL_TEXTURE_2D, texture);
 
-        glDisable(GL_TEXTURE_2D);
-        glDisable(GL_BLEND);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, image.levels.size() > 1 ? GL_LINEAR_MIPMAP_LINEAR : GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP);
 
-        vTextures[mId] = texture;
+    GLint alignment;
+    glGetIntegerv(GL_UNPACK_ALIGNMENT, &alignment);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
 
-        stbi_image_free(data);
+    const GLenum format = image.channels == 4 ? GL_RGBA : GL_RGB;
+    for (Index level = 0; level < image.levels.size(); ++level) {
+        glTexImage2D(GL_TEXTURE_2D, static_cast<GLint>(level), format, image.levelWidth(level), image.levelHeight(level), 0, format, GL_UNSIGNED_BYTE, image.levels[level].data());
     }
 
-#endif
+    glPixelStorei(GL_UNPACK_ALIGNMENT, alignment);
 
-#endif
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    return texture;
+}
+
+/**
+ * @brief Load an image file in a new texture, synchronously. It must be
+ * called from the thread of the OpenGL context.
+ * @param filename Filename of the image
+ * @param textureMode Texture environment mode
+ * @return Texture id, maxLimitValue<unsigned int>() if the image cannot be loaded
+ */
+NVL_INLINE int glLoadTextureImage(const std::string& filename, const GLint textureMode)
+{
+    std::ifstream file(filename, std::ios::binary);
+    if (!file.is_open())
+        return maxLimitValue<unsigned int>();
+
+    std::vector<unsigned char> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    TextureImage image;
+    if (!textureImageDecode(data, image))
+        return maxLimitValue<unsigned int>();
+
+    textureImageGenerateMipmaps(image);
+
+    const unsigned int texture = glUploadTextureImage(image);
+
+    glTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, textureMode);
 
-    return textureId;
+    return texture;
 }
 
 }
@@ -14,9 +14,33 @@
 #include <nvl/viewer/gl/opengl_headers.h>
 
 #include <string>
+#include <vector>
 
 namespace nvl {
 
+/**
+ * @brief Decoded texture image, flipped vertically as expected by OpenGL.
+ * Each level stores tightly packed rows of 3 (RGB) or 4 (RGBA) channels:
+ * the first level is the image, the next ones are its mipmaps.
+ */
+struct TextureImage {
+    int width;
+    int height;
+    int channels;
+    std::vector<std::vector<unsigned char>> levels;
+
+    TextureImage();
+
+    int levelWidth(const Index& level) const;
+    int levelHeight(const Index& level) const;
+    bool isEmpty() const;
+};
+
+bool textureImageDecode(const std::vector<unsigned char>& data, TextureImage& image);
+void textureImageGenerateMipmaps(TextureImage& image);
+
+unsigned int glUploadTextureImage(const TextureImage& image);
+
 int glLoadTextureImage(const std::string& filename, const GLint textureMode = GL_MODULATE);
 
 }
@@ -0,0 +1,38 @@
+/*
+ * This file is part of nuvolib: https://github.com/stefanonuvoli/nuvolib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Stefano Nuvoli (stefano.nuvoli@gmail.com)
+ */
+#include "lodable.h"
+
+namespace nvl {
+
+NVL_INLINE LODable::LODable(bool lodEnabled) :
+    vLODEnabled(lodEnabled),
+    vLODPixelError(1.0)
+{
+
+}
+
+NVL_INLINE bool LODable::isLODEnabled() const
+{
+    return vLODEnabled;
+}
+
+NVL_INLINE void LODable::setLODEnabled(bool lodEnabled)
+{
+    vLODEnabled = lodEnabled;
+}
+
+NVL_INLINE double LODable::lodPixelError() const
+{
+    return vLODPixelError;
+}
+
+NVL_INLINE void LODable::setLODPixelError(const double pixelError)
+{
+    vLODPixelError = pixelError;
+}
+
+}
@@ -0,0 +1,44 @@
+/*
+ * This file is part of nuvolib: https://github.com/stefanonuvoli/nuvolib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Stefano Nuvoli (stefano.nuvoli@gmail.com)
+ */
+#ifndef NVL_VIEWER_LODABLE_H
+#define NVL_VIEWER_LODABLE_H
+
+#include <nvl/nuvolib.h>
+
+#include <nvl/math/matrix.h>
+
+namespace nvl {
+
+class LODable
+{
+
+public:
+
+    LODable(bool lodEnabled = true);
+    virtual ~LODable() = default;
+
+    virtual void selectLOD(const Matrix44d& modelViewMatrix, const Matrix44d& projectionMatrix, const double& screenHeight) = 0;
+
+    virtual bool isLODEnabled() const;
+    virtual void setLODEnabled(bool lodEnabled);
+
+    double lodPixelError() const;
+    void setLODPixelError(const double pixelError);
+
+
+protected:
+
+    bool vLODEnabled;
+    double vLODPixelError;
+
+};
+
+}
+
+#include "lodable.cpp"
+
+#endif // NVL_VIEWER_LODABLE_H
@@ -16,6 +16,17 @@ NVL_INLINE Pickable::Pickable(bool pickingEnabled) :
 
 }
 
+NVL_INLINE bool Pickable::rayPick(Canvas* canvas, const Index drawableId, const Point3d& rayOrigin, const Vector3d& rayDirection, double& t) const
+{
+    NVL_SUPPRESS_UNUSEDVARIABLE(canvas);
+    NVL_SUPPRESS_UNUSEDVARIABLE(drawableId);
+    NVL_SUPPRESS_UNUSEDVARIABLE(rayOrigin);
+    NVL_SUPPRESS_UNUSEDVARIABLE(rayDirection);
+    NVL_SUPPRESS_UNUSEDVARIABLE(t);
+
+    return false;
+}
+
 NVL_INLINE bool Pickable::isPickable() const
 {
     return vPickable;
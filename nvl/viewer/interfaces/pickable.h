@@ -26,6 +26,7 @@ public:
     virtual ~Pickable() = default;
 
     virtual void drawWithNames(Canvas* canvas, const Index drawableId) const = 0;
+    virtual bool rayPick(Canvas* canvas, const Index drawableId, const Point3d& rayOrigin, const Vector3d& rayDirection, double& t) const;
 
     virtual bool isPickable() const;
     virtual void setPickable(bool pickable);
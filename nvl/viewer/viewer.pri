@@ -11,6 +11,7 @@ contains(DEFINES, NVL_QT) {
         $$PWD/widgets/model_animation_widget.h \
         $$PWD/widgets/model_drawer_widget.h \
         $$PWD/widgets/model_loader_widget.h \
+        $$PWD/widgets/profiler_widget.h \
         $$PWD/widgets/skeleton_joint_list_widget.h \
         $$PWD/widgets/face_mesh_drawer_widget.h \
         $$PWD/widgets/polyline_mesh_drawer_widget.h \
@@ -27,6 +28,7 @@ contains(DEFINES, NVL_QT) {
         $$PWD/widgets/model_animation_widget.cpp \
         $$PWD/widgets/model_drawer_widget.cpp \
         $$PWD/widgets/model_loader_widget.cpp \
+        $$PWD/widgets/profiler_widget.cpp \
         $$PWD/widgets/skeleton_joint_list_widget.cpp \
         $$PWD/widgets/face_mesh_drawer_widget.cpp \
         $$PWD/widgets/polyline_mesh_drawer_widget.cpp \
@@ -42,6 +44,7 @@ contains(DEFINES, NVL_QT) {
         $$PWD/widgets/model_animation_widget.ui \
         $$PWD/widgets/model_drawer_widget.ui \
         $$PWD/widgets/model_loader_widget.ui \
+        $$PWD/widgets/profiler_widget.ui \
         $$PWD/widgets/skeleton_joint_list_widget.ui \
         $$PWD/widgets/face_mesh_drawer_widget.ui \
         $$PWD/widgets/polyline_mesh_drawer_widget.ui \
@@ -76,51 +79,65 @@ contains(DEFINES, NVL_OPENGL_LOADED) {
     HEADERS +=  \
         $$PWD/drawables/face_mesh_drawer.h \
         $$PWD/drawables/face_mesh_drawer_base.h \
+        $$PWD/drawables/face_mesh_lod.h \
+        $$PWD/drawables/face_mesh_packing.h \
         $$PWD/drawables/mesh_drawer.h \
         $$PWD/drawables/mesh_drawer_base.h \
+        $$PWD/drawables/model_animation_cache.h \
         $$PWD/drawables/model_drawer.h \
         $$PWD/drawables/model_drawer_base.h \
         $$PWD/drawables/polyline_mesh_drawer.h \
         $$PWD/drawables/polyline_mesh_drawer_base.h \
         $$PWD/drawables/principal_curvature_drawer.h \
+        $$PWD/drawables/ray_picking.h \
         $$PWD/drawables/skeleton_drawer.h \
         $$PWD/drawables/skeleton_drawer_base.h \
         $$PWD/drawables/vertex_mesh_drawer.h \
         $$PWD/drawables/vertex_mesh_drawer_base.h \
+        $$PWD/gl/gl_buffers.h \
         $$PWD/gl/gl_draw.h \
         $$PWD/gl/gl_frameable.h \
         $$PWD/gl/gl_primitives.h \
+        $$PWD/gl/gl_texture_manager.h \
         $$PWD/gl/gl_textures.h \
         $$PWD/gl/opengl_headers.h \
         $$PWD/shaders/gl_shader.h \
         $$PWD/interfaces/animable.h \
         $$PWD/interfaces/drawable.h \
         $$PWD/interfaces/frameable.h \
+        $$PWD/interfaces/lodable.h \
         $$PWD/interfaces/pickable.h \
         $$PWD/widgets/canvas.h
 
     SOURCES += \
         $$PWD/drawables/face_mesh_drawer.cpp \
         $$PWD/drawables/face_mesh_drawer_base.cpp \
+        $$PWD/drawables/face_mesh_lod.cpp \
+        $$PWD/drawables/face_mesh_packing.cpp \
         $$PWD/drawables/mesh_drawer.cpp \
         $$PWD/drawables/mesh_drawer_base.cpp \
+        $$PWD/drawables/model_animation_cache.cpp \
         $$PWD/drawables/model_drawer.cpp \
         $$PWD/drawables/model_drawer_base.cpp \
         $$PWD/drawables/polyline_mesh_drawer.cpp \
         $$PWD/drawables/polyline_mesh_drawer_base.cpp \
         $$PWD/drawables/principal_curvature_drawer.cpp \
+        $$PWD/drawables/ray_picking.cpp \
         $$PWD/drawables/skeleton_drawer.cpp \
         $$PWD/drawables/skeleton_drawer_base.cpp \
         $$PWD/drawables/vertex_mesh_drawer.cpp \
         $$PWD/drawables/vertex_mesh_drawer_base.cpp \
+        $$PWD/gl/gl_buffers.cpp \
         $$PWD/gl/gl_draw.cpp \
         $$PWD/gl/gl_frameable.cpp \
         $$PWD/gl/gl_primitives.cpp \
+        $$PWD/gl/gl_texture_manager.cpp \
         $$PWD/gl/gl_textures.cpp \
         $$PWD/shaders/gl_shader.cpp \
         $$PWD/interfaces/animable.cpp \
         $$PWD/interfaces/drawable.cpp \
         $$PWD/interfaces/frameable.cpp \
+        $$PWD/interfaces/lodable.cpp \
         $$PWD/interfaces/pickable.cpp \
         $$PWD/widgets/canvas.cpp
 
@@ -9,11 +9,18 @@
 #ifdef NVL_QT
 
 #include <nvl/utilities/vector_utils.h>
+#include <nvl/utilities/profiler.h>
+
+#include <nvl/viewer/drawables/ray_picking.h>
+
+#include <algorithm>
+#include <tuple>
 
 namespace nvl {
 
 NVL_INLINE Canvas::Canvas() :
     vMovableFrame(Affine3d::Identity()),
+    vRayPicking(false),
     vAnimationsRunning(false),
     vAnimationsPaused(false)
 {
@@ -51,6 +58,9 @@ NVL_INLINE Index Canvas::addDrawable(Drawable* drawable, const std::string& name
     Frameable* frameable = dynamic_cast<Frameable*>(drawable);
     vFrameables.push_back(frameable);
 
+    LODable* lodable = dynamic_cast<LODable*>(drawable);
+    vLODables.push_back(lodable);
+
     vListable.push_back(listable);
 
     return id;
@@ -65,6 +75,7 @@ NVL_INLINE bool Canvas::removeDrawable(const Index& id)
     vectorRemoveElement(vAnimables, id);
     vectorRemoveElement(vPickables, id);
     vectorRemoveElement(vFrameables, id);
+    vectorRemoveElement(vLODables, id);
     vectorRemoveElement(vNames, id);
     vectorRemoveElement(vListable, id);
 
@@ -107,6 +118,11 @@ NVL_INLINE Frameable *Canvas::frameable(const Index& id)
     return vFrameables[id];
 }
 
+NVL_INLINE LODable* Canvas::lodable(const Index& id)
+{
+    return vLODables[id];
+}
+
 NVL_INLINE bool Canvas::isAnimable(const Index& id) const
 {
     return vAnimables[id] != nullptr;
@@ -122,6 +138,11 @@ NVL_INLINE bool Canvas::isFrameable(const Index& id) const
     return vFrameables[id] != nullptr;
 }
 
+NVL_INLINE bool Canvas::isLODable(const Index& id) const
+{
+    return vLODables[id] != nullptr;
+}
+
 NVL_INLINE bool Canvas::isListable(const Index &id) const
 {
     return vListable[id];
@@ -219,6 +240,81 @@ NVL_INLINE Canvas::PickingData& Canvas::pickingData(const int name)
     return vPickingDataPool.at(static_cast<Index>(name));
 }
 
+NVL_INLINE bool Canvas::rayPicking() const
+{
+    return vRayPicking;
+}
+
+NVL_INLINE void Canvas::setRayPicking(const bool rayPicking)
+{
+    vRayPicking = rayPicking;
+}
+
+NVL_INLINE bool Canvas::rayPick(
+        const Point3d& rayOrigin,
+        const Vector3d& rayDirection,
+        std::vector<int>& names,
+        Point3d& point3D)
+{
+    NVL_PROFILE_ZONE("Canvas::rayPick");
+
+    //Each pickable fills a range of the pool, ranges are sorted by distance
+    std::vector<std::tuple<double, Index, Index>> ranges;
+
+    names.clear();
+    vPickingDataPool.clear();
+
+    for (Index i = 0; i < drawableNumber(); ++i) {
+        if (!drawable(i)->isVisible() || !isPickable(i))
+            continue;
+
+        Point3d localOrigin = rayOrigin;
+        Vector3d localDirection = rayDirection;
+        if (isFrameable(i)) {
+            const Affine3d inverseFrame = frameable(i)->frame().inverse();
+            localOrigin = inverseFrame * rayOrigin;
+            localDirection = inverseFrame.linear() * rayDirection;
+        }
+
+        const Index begin = vPickingDataPool.size();
+
+        double t;
+        if (pickable(i)->rayPick(this, i, localOrigin, localDirection, t)) {
+            ranges.push_back(std::make_tuple(t, begin, vPickingDataPool.size()));
+        }
+    }
+
+    if (ranges.empty())
+        return false;
+
+    std::stable_sort(ranges.begin(), ranges.end(), [](const std::tuple<double, Index, Index>& a, const std::tuple<double, Index, Index>& b) {
+        return std::get<0>(a) < std::get<0>(b);
+    });
+
+    for (const std::tuple<double, Index, Index>& range : ranges) {
+        for (Index j = std::get<1>(range); j < std::get<2>(range); ++j) {
+            names.push_back(static_cast<int>(j));
+        }
+    }
+
+    //The ray parameter is preserved by the affine frames
+    point3D = rayOrigin + std::get<0>(ranges[0]) * rayDirection;
+
+    return true;
+}
+
+NVL_INLINE bool Canvas::rayPick(
+        const Point2d& point2D,
+        std::vector<int>& names,
+        Point3d& point3D,
+        Point3d& rayOrigin,
+        Vector3d& rayDirection)
+{
+    pickingRay(cameraModelViewProjectionMatrix(), screenWidth(), screenHeight(), point2D, rayOrigin, rayDirection);
+
+    return rayPick(rayOrigin, rayDirection, names, point3D);
+}
+
 NVL_INLINE Canvas::PickingData::PickingData():
     identifier(PICKING_NONE)
 {
@@ -21,6 +21,7 @@
 #include <nvl/viewer/interfaces/animable.h>
 #include <nvl/viewer/interfaces/pickable.h>
 #include <nvl/viewer/interfaces/frameable.h>
+#include <nvl/viewer/interfaces/lodable.h>
 
 #include <unordered_set>
 
@@ -78,10 +79,12 @@ public:
     Animable* animable(const Index& id);
     Pickable* pickable(const Index& id);
     Frameable* frameable(const Index& id);
+    LODable* lodable(const Index& id);
 
     bool isAnimable(const Index& id) const;
     bool isPickable(const Index& id) const;
     bool isFrameable(const Index& id) const;
+    bool isLODable(const Index& id) const;
 
     bool isListable(const Index& id) const;
     void setListable(const Index& id, const bool listable);
@@ -142,18 +145,34 @@ public:
     const PickingData& pickingData(const int name) const;
     PickingData& pickingData(const int name);
 
+    bool rayPicking() const;
+    void setRayPicking(const bool rayPicking);
+    bool rayPick(
+            const Point3d& rayOrigin,
+            const Vector3d& rayDirection,
+            std::vector<int>& names,
+            Point3d& point3D);
+    bool rayPick(
+            const Point2d& point2D,
+            std::vector<int>& names,
+            Point3d& point3D,
+            Point3d& rayOrigin,
+            Vector3d& rayDirection);
+
 protected:
 
     std::vector<Drawable*> vDrawables;
     std::vector<Pickable*> vPickables;
     std::vector<Animable*> vAnimables;
     std::vector<Frameable*> vFrameables;
+    std::vector<LODable*> vLODables;
     std::vector<std::string> vNames;
     std::vector<bool> vListable;
 
     Affine3d vMovableFrame;
 
     std::vector<PickingData> vPickingDataPool;
+    bool vRayPicking;
 
     bool vAnimationsRunning;
     bool vAnimationsPaused;
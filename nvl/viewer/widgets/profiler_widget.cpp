@@ -0,0 +1,113 @@
+/*
+ * This file is part of nuvolib: https://github.com/stefanonuvoli/nuvolib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Stefano Nuvoli (stefano.nuvoli@gmail.com)
+ */
+#include "profiler_widget.h"
+
+#ifdef NVL_QT
+
+#include "ui_profiler_widget.h"
+
+#include <QFileDialog>
+#include <QMessageBox>
+
+namespace nvl {
+
+NVL_INLINE ProfilerWidget::ProfilerWidget(QWidget* parent) :
+    QFrame(parent),
+    ui(new Ui::ProfilerWidget),
+    vHandleUpdate(true)
+{
+    ui->setupUi(this);
+
+#ifndef NVL_PROFILING
+    ui->profilerTreeWidget->setToolTip(tr("Zones are recorded only if NVL_PROFILING is defined."));
+#endif
+
+    vTimer.setInterval(500);
+    vTimer.start();
+
+    updateView();
+
+    connectSignals();
+}
+
+NVL_INLINE ProfilerWidget::~ProfilerWidget()
+{
+    delete ui;
+}
+
+NVL_INLINE void ProfilerWidget::slot_refresh()
+{
+    if (isVisible()) {
+        updateView();
+    }
+}
+
+NVL_INLINE void ProfilerWidget::updateView()
+{
+    vHandleUpdate = false;
+
+    Profiler& profiler = Profiler::instance();
+
+    ui->enabledCheckBox->setChecked(profiler.isEnabled());
+
+    ui->profilerTreeWidget->clear();
+
+    const std::vector<ProfilerSummary> summaries = profiler.summaries();
+    for (const ProfilerSummary& summary : summaries) {
+        QTreeWidgetItem* item = new QTreeWidgetItem();
+        item->setText(0, QString::fromStdString(summary.name));
+        item->setText(1, QString::number(summary.count));
+        item->setText(2, QString::number(summary.last, 'f', 3));
+        item->setText(3, QString::number(summary.mean, 'f', 3));
+        item->setText(4, QString::number(summary.p50, 'f', 3));
+        item->setText(5, QString::number(summary.p90, 'f', 3));
+        item->setText(6, QString::number(summary.p99, 'f', 3));
+        item->setText(7, QString::number(summary.max, 'f', 3));
+
+        ui->profilerTreeWidget->addTopLevelItem(item);
+    }
+
+    vHandleUpdate = true;
+}
+
+NVL_INLINE void ProfilerWidget::connectSignals()
+{
+    connect(&vTimer, &QTimer::timeout, this, &ProfilerWidget::slot_refresh);
+}
+
+NVL_INLINE void ProfilerWidget::on_enabledCheckBox_stateChanged(int arg1)
+{
+    if (vHandleUpdate) {
+        Profiler::instance().setEnabled(arg1 == Qt::Checked);
+    }
+}
+
+NVL_INLINE void ProfilerWidget::on_clearButton_clicked()
+{
+    Profiler::instance().clear();
+
+    updateView();
+}
+
+NVL_INLINE void ProfilerWidget::on_exportButton_clicked()
+{
+    QString filename = QFileDialog::getSaveFileName(this,
+        tr("Export trace"), QDir::homePath(),
+        tr("Chrome trace (*.json *.JSON);;Any file (*)")
+    );
+
+    if (!filename.isEmpty()) {
+        bool success = Profiler::instance().exportChromeTrace(filename.toStdString());
+        if (!success) {
+            QMessageBox::warning(this, tr("Error"), tr("Error: impossible to export trace!"));
+        }
+    }
+}
+
+}
+
+#endif
@@ -0,0 +1,68 @@
+/*
+ * This file is part of nuvolib: https://github.com/stefanonuvoli/nuvolib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Stefano Nuvoli (stefano.nuvoli@gmail.com)
+ */
+#ifndef NVL_VIEWER_PROFILER_WIDGET_H
+#define NVL_VIEWER_PROFILER_WIDGET_H
+
+#include <nvl/nuvolib.h>
+
+#ifdef NVL_QT
+
+#include <QFrame>
+#include <QTimer>
+
+#include <nvl/utilities/profiler.h>
+
+namespace Ui {
+class ProfilerWidget;
+}
+
+namespace nvl {
+
+class ProfilerWidget : public QFrame
+{
+    Q_OBJECT
+
+public:
+
+    explicit ProfilerWidget(
+            QWidget* parent = nullptr);
+    ~ProfilerWidget();
+
+
+public Q_SLOTS:
+
+    void slot_refresh();
+
+
+private Q_SLOTS:
+
+    void on_enabledCheckBox_stateChanged(int arg1);
+    void on_clearButton_clicked();
+    void on_exportButton_clicked();
+
+
+private:
+
+    void updateView();
+
+    void connectSignals();
+
+    Ui::ProfilerWidget *ui;
+
+    QTimer vTimer;
+
+    bool vHandleUpdate;
+
+};
+
+}
+
+#endif
+
+#include "profiler_widget.cpp"
+
+#endif // NVL_VIEWER_PROFILER_WIDGET_H
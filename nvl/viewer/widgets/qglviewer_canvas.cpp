@@ -12,6 +12,8 @@
 #include <nvl/math/quaternion.h>
 #include <nvl/math/constants.h>
 
+#include <nvl/viewer/gl/gl_texture_manager.h>
+
 #define NVL_QGLCANVAS_DEFAULT_SCALING_SENSITIVITY 1.05
 
 namespace nvl {
@@ -28,10 +30,17 @@ NVL_INLINE QGLViewerCanvas::QGLViewerCanvas(QWidget* parent) :
     setTargetFPS(30);
 
     connectSignals();
+
+    //Schedule a redraw when a texture has been decoded, so that it is uploaded
+    vTextureListener = GLTextureManager::instance().addListener([this]() {
+        QMetaObject::invokeMethod(this, [this]() { vQGLViewerObject->update(); }, Qt::QueuedConnection);
+    });
 }
 
 NVL_INLINE QGLViewerCanvas::~QGLViewerCanvas()
 {
+    GLTextureManager::instance().removeListener(vTextureListener);
+
     delete vLayout;
     delete vQGLViewerObject;
 }
@@ -253,21 +262,21 @@ NVL_INLINE Matrix44d QGLViewerCanvas::cameraProjectionMatrix() const
 {
     GLdouble m[16];
     vQGLViewerObject->camera()->getProjectionMatrix(m);
-    return Matrix44d(m).transpose();
+    return Matrix44d(m);
 }
 
 NVL_INLINE Matrix44d QGLViewerCanvas::cameraModelViewMatrix() const
 {
     GLdouble m[16];
     vQGLViewerObject->camera()->getModelViewMatrix(m);
-    return Matrix44d(m).transpose();
+    return Matrix44d(m);
 }
 
 NVL_INLINE Matrix44d QGLViewerCanvas::cameraModelViewProjectionMatrix() const
 {
     GLdouble m[16];
     vQGLViewerObject->camera()->getModelViewProjectionMatrix(m);
-    return Matrix44d(m).transpose();
+    return Matrix44d(m);
 }
 
 NVL_INLINE void QGLViewerCanvas::connectSignals()
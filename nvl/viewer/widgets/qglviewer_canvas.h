@@ -89,6 +89,8 @@ private:
     double vTargetFps;
     double scaleSensitivity;
 
+    Index vTextureListener;
+
 protected:
 
     void wheelEvent(QWheelEvent *event) override;
@@ -13,6 +13,7 @@
 #include <nvl/math/alignedbox.h>
 
 #include <nvl/utilities/vector_utils.h>
+#include <nvl/utilities/profiler.h>
 
 namespace nvl {
 
@@ -52,10 +53,25 @@ NVL_INLINE void QGLViewerObject::init()
 
 NVL_INLINE void QGLViewerObject::draw()
 {
+    NVL_PROFILE_ZONE("Canvas::draw");
+
     QGLViewer::setBackgroundColor(vBackgroundColor.toQColor());
 
+    const Matrix44d modelViewMatrix = vCanvas->cameraModelViewMatrix();
+    const Matrix44d projectionMatrix = vCanvas->cameraProjectionMatrix();
+    const double screenHeight = vCanvas->screenHeight();
+
     for (Index i = 0; i < vCanvas->drawableNumber(); ++i) {
         if (vCanvas->drawable(i)->isVisible()) {
+            if (vCanvas->isLODable(i) && vCanvas->lodable(i)->isLODEnabled()) {
+                if (vCanvas->isFrameable(i)) {
+                    vCanvas->lodable(i)->selectLOD(modelViewMatrix * vCanvas->frameable(i)->frame().matrix(), projectionMatrix, screenHeight);
+                }
+                else {
+                    vCanvas->lodable(i)->selectLOD(modelViewMatrix, projectionMatrix, screenHeight);
+                }
+            }
+
             if (vCanvas->isFrameable(i)) {
                 vCanvas->frameable(i)->loadFrame();
                 vCanvas->drawable(i)->draw();
@@ -66,10 +82,14 @@ NVL_INLINE void QGLViewerObject::draw()
             }
         }
     }
+
+    NVL_PROFILE_FRAME();
 }
 
 NVL_INLINE void QGLViewerObject::drawWithNames()
 {
+    NVL_PROFILE_ZONE("Canvas::drawWithNames");
+
     for (Index i = 0; i < vCanvas->drawableNumber(); ++i) {
         if (vCanvas->drawable(i)->isVisible() && vCanvas->isPickable(i)) {
             if (vCanvas->isFrameable(i)) {
@@ -86,6 +106,8 @@ NVL_INLINE void QGLViewerObject::drawWithNames()
 
 NVL_INLINE void QGLViewerObject::animate()
 {
+    NVL_PROFILE_ZONE("Canvas::animate");
+
     bool animationExecuted = false;
     for (Index i = 0; i < vCanvas->drawableNumber(); ++i) {
         if (vCanvas->isAnimable(i)) {
@@ -113,6 +135,35 @@ NVL_INLINE const Color& QGLViewerObject::backgroundColor() const
     return vBackgroundColor;
 }
 
+NVL_INLINE void QGLViewerObject::select(const QPoint& qglPoint2D)
+{
+    NVL_PROFILE_ZONE("Canvas::select");
+
+    if (!vCanvas->rayPicking()) {
+        QGLViewer::select(qglPoint2D);
+        return;
+    }
+
+    qglviewer::Vec qglOrigin, qglDirection;
+    camera()->convertClickToLine(qglPoint2D, qglOrigin, qglDirection);
+
+    Point3d lineOrigin(qglOrigin.x, qglOrigin.y, qglOrigin.z);
+    Vector3d lineDirection(qglDirection.x, qglDirection.y, qglDirection.z);
+    Point2d point2D(qglPoint2D.x(), qglPoint2D.y());
+    Point3d point3D(0, 0, 0);
+
+    std::vector<int> names;
+
+    const bool found = vCanvas->rayPick(lineOrigin, lineDirection, names, point3D);
+
+    if (!names.empty()) {
+        setSelectedName(names[0]);
+    }
+
+    emit postSelection(qglPoint2D);
+    emit signal_canvasPicking(names, point2D, found, point3D, lineOrigin, lineDirection);
+}
+
 NVL_INLINE void QGLViewerObject::endSelection(const QPoint& qglPoint2D)
 {
     glFlush();
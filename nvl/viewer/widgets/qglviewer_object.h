@@ -57,6 +57,8 @@ public:
 
     qglviewer::ManipulatedFrame& movableFrame();
 
+    using QGLViewer::select;
+    void select(const QPoint& qglPoint) override;
     void endSelection(const QPoint& qglPoint) override;
 
 
@@ -0,0 +1,66 @@
+/*
+ * This file is part of nuvolib: https://github.com/stefanonuvoli/nuvolib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Stefano Nuvoli (stefano.nuvoli@gmail.com)
+ */
+#include <nvl/nuvolib.h>
+
+#include <nvl/utilities/color_map.h>
+
+#include <iostream>
+#include <cmath>
+
+int main()
+{
+    std::cout << "------ Color map sample ------" << std::endl << std::endl;
+
+    const nvl::Size size = 256;
+    const nvl::ColorMap colorMap = nvl::ColorMap::viridis(size);
+
+    //Reference viridis palette of 8 colors, evenly spaced from 0 to 1
+    const int reference[8][3] = {
+        { 68, 1, 84 },
+        { 70, 50, 126 },
+        { 54, 92, 141 },
+        { 39, 127, 142 },
+        { 31, 161, 135 },
+        { 74, 193, 109 },
+        { 160, 218, 57 },
+        { 253, 231, 37 }
+    };
+    const int tolerance = 4;
+
+    nvl::Size mismatches = 0;
+    for (nvl::Index k = 0; k < 8; ++k) {
+        const nvl::Index entryId = static_cast<nvl::Index>(std::round(k * (size - 1) / 7.0));
+        const unsigned char* color = colorMap.colorI(entryId);
+
+        bool equal = true;
+        for (nvl::Index c = 0; c < 3; ++c) {
+            if (std::abs(static_cast<int>(color[c]) - reference[k][c]) > tolerance) {
+                equal = false;
+            }
+        }
+
+        std::cout << "Entry " << entryId << ": (" <<
+                     static_cast<int>(color[0]) << ", " << static_cast<int>(color[1]) << ", " << static_cast<int>(color[2]) << "), reference (" <<
+                     reference[k][0] << ", " << reference[k][1] << ", " << reference[k][2] << ")" <<
+                     (equal ? "" : " MISMATCH") << std::endl;
+
+        if (!equal) {
+            mismatches++;
+        }
+    }
+
+    std::cout << std::endl;
+
+    if (mismatches > 0) {
+        std::cout << "Error: " << mismatches << " entries differ from viridis." << std::endl;
+        return 1;
+    }
+
+    std::cout << "The viridis table matches the reference." << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,60 @@
+############################ TARGET AND FLAGS ############################
+
+#App config
+TARGET = color_map
+TEMPLATE = app
+CONFIG += c++17
+CONFIG += console
+CONFIG -= qt
+CONFIG -= app_bundle
+
+#Debug/release optimization flags
+CONFIG(debug, debug|release){
+    DEFINES += DEBUG
+}
+CONFIG(release, debug|release){
+    DEFINES -= DEBUG
+    #just uncomment next line if you want to ignore asserts and got a more optimized binary
+    CONFIG += FINAL_RELEASE
+}
+
+#Final release optimization flag
+FINAL_RELEASE {
+    unix:!macx{
+        QMAKE_CXXFLAGS_RELEASE -= -g -O2
+        QMAKE_CXXFLAGS += -O3 -DNDEBUG
+    }
+}
+
+macx {
+    QMAKE_MACOSX_DEPLOYMENT_TARGET = 10.13
+    QMAKE_MAC_SDK = macosx10.13
+}
+
+
+############################ LIBRARIES ############################
+
+NUVOLIB_PATH = $$PWD/../../..
+EIGEN_PATH = /usr/include/eigen3
+
+#nuvolib (it includes eigen)
+include($$NUVOLIB_PATH/nuvolib.pri)
+
+#Parallel computation
+unix:!mac {
+    QMAKE_CXXFLAGS += -fopenmp
+    LIBS += -fopenmp
+}
+macx{
+    QMAKE_CXXFLAGS += -Xpreprocessor -fopenmp -lomp -I/usr/local/include
+    QMAKE_LFLAGS += -lomp
+    LIBS += -L /usr/local/lib /usr/local/lib/libomp.dylib
+}
+
+
+############################ PROJECT FILES ############################
+
+#Project files
+SOURCES += \
+    color_map.cpp
+
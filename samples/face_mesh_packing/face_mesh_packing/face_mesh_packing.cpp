@@ -0,0 +1,338 @@
+/*
+ * This file is part of nuvolib: https://github.com/stefanonuvoli/nuvolib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Stefano Nuvoli (stefano.nuvoli@gmail.com)
+ */
+#include <nvl/nuvolib.h>
+
+#include <nvl/viewer/drawables/face_mesh_packing.h>
+
+#include <iostream>
+#include <vector>
+#include <array>
+#include <map>
+#include <algorithm>
+
+//Rendering data of a grid of quads, some quads are split in two triangles
+struct RenderingData {
+    std::vector<double> vertices;
+    std::vector<double> vertexNormals;
+    std::vector<std::vector<unsigned int>> faces;
+    std::vector<float> faceColors;
+    std::vector<std::vector<float>> faceUVs;
+    std::vector<nvl::Index> faceMaterials;
+};
+
+RenderingData createGrid(const nvl::Size n);
+nvl::Size checkSharedPacking(const RenderingData& rendering, const nvl::FaceMeshPackedData& data);
+nvl::Size checkCornerPacking(const RenderingData& rendering, const nvl::FaceMeshPackedData& data);
+template<class T>
+nvl::Size checkDirtyRanges(const std::vector<T>& oldValues, const std::vector<T>& newValues, const nvl::Size blockSize);
+
+int main()
+{
+    std::cout << "------ Face mesh packing sample ------" << std::endl << std::endl;
+
+    const std::vector<float> noColors;
+    const std::vector<double> noNormals;
+    const std::vector<std::vector<float>> noUVs;
+
+    const nvl::Size blockSize = 4096;
+
+    RenderingData rendering = createGrid(300);
+    std::cout << "Grid: " << rendering.vertices.size() / 3 << " vertices, " << rendering.faces.size() << " faces." << std::endl << std::endl;
+
+    nvl::Size errors = 0;
+
+    //Shared vertices
+    nvl::FaceMeshPackedData sharedData;
+    nvl::faceMeshPackData(rendering.vertices, rendering.vertexNormals, noColors, rendering.faces, noNormals, noColors, noUVs, rendering.faceMaterials, sharedData);
+
+    nvl::Size sharedErrors = checkSharedPacking(rendering, sharedData);
+    std::cout << "Shared packing: " << sharedData.vertexNumber() << " vertices, " << sharedData.triangleNumber() << " triangles, " <<
+                 sharedData.batchNumber() << " batches, " << sharedErrors << " errors." << std::endl;
+    errors += sharedErrors;
+
+    //Per-corner vertices
+    nvl::FaceMeshPackedData cornerData;
+    nvl::faceMeshPackData(rendering.vertices, rendering.vertexNormals, noColors, rendering.faces, noNormals, rendering.faceColors, rendering.faceUVs, rendering.faceMaterials, cornerData);
+
+    nvl::Size cornerErrors = checkCornerPacking(rendering, cornerData);
+    std::cout << "Per-corner packing: " << cornerData.vertexNumber() << " vertices, " << cornerData.triangleNumber() << " triangles, " <<
+                 cornerData.batchNumber() << " batches, " << cornerErrors << " errors." << std::endl;
+    errors += cornerErrors;
+
+    //Move some vertices and recolor some faces
+    std::vector<nvl::Index> dirtyVertices;
+    for (nvl::Index vId = 40000; vId < 40100; ++vId) {
+        rendering.vertices[vId * 3 + 2] += 0.25;
+        dirtyVertices.push_back(vId);
+    }
+    std::vector<nvl::Index> dirtyFaces;
+    for (nvl::Index fId = 1000; fId < 1050; ++fId) {
+        rendering.faceColors[fId * 4] = 1.0f;
+        dirtyFaces.push_back(fId);
+    }
+
+    //Incremental update against a full packing of the new data
+    nvl::FaceMeshPackedData updatedData = cornerData;
+    std::vector<nvl::Index> updatedVertices;
+    nvl::faceMeshPackUpdate(rendering.vertices, rendering.vertexNormals, noColors, rendering.faces, noNormals, rendering.faceColors, rendering.faceUVs, dirtyVertices, dirtyFaces, updatedData, updatedVertices);
+
+    nvl::FaceMeshPackedData newData;
+    nvl::faceMeshPackData(rendering.vertices, rendering.vertexNormals, noColors, rendering.faces, noNormals, rendering.faceColors, rendering.faceUVs, rendering.faceMaterials, newData);
+
+    const bool updateEqual =
+            updatedData.positions == newData.positions &&
+            updatedData.normals == newData.normals &&
+            updatedData.colors == newData.colors &&
+            updatedData.uvs == newData.uvs &&
+            updatedData.indices == newData.indices;
+    std::cout << "Incremental update: " << updatedVertices.size() << " packed vertices updated, " <<
+                 (updateEqual ? "equal to" : "DIFFERENT from") << " the full packing." << std::endl;
+    if (!updateEqual) {
+        errors++;
+    }
+
+    //Dirty ranges, with the block size used by the face mesh drawer
+    nvl::Size rangeErrors = 0;
+    rangeErrors += checkDirtyRanges(cornerData.positions, newData.positions, blockSize);
+    rangeErrors += checkDirtyRanges(cornerData.colors, newData.colors, blockSize);
+    rangeErrors += checkDirtyRanges(cornerData.uvs, newData.uvs, blockSize);
+    rangeErrors += checkDirtyRanges(cornerData.indices, newData.indices, blockSize);
+    rangeErrors += checkDirtyRanges(sharedData.positions, cornerData.positions, blockSize);
+    rangeErrors += checkDirtyRanges(std::vector<float>(), cornerData.positions, blockSize);
+    rangeErrors += checkDirtyRanges(cornerData.positions, std::vector<float>(), blockSize);
+
+    std::vector<std::pair<nvl::Size, nvl::Size>> ranges;
+    nvl::faceMeshPackedDirtyRanges(cornerData.positions, newData.positions, blockSize, ranges);
+    std::cout << "Dirty ranges of the positions: " << ranges.size() << " ranges";
+    for (const std::pair<nvl::Size, nvl::Size>& range : ranges) {
+        std::cout << " [" << range.first << ", " << range.second << ")";
+    }
+    std::cout << ", " << rangeErrors << " errors." << std::endl;
+    errors += rangeErrors;
+
+    std::cout << std::endl;
+
+    if (errors > 0) {
+        std::cout << "Error: " << errors << " checks failed." << std::endl;
+        return 1;
+    }
+
+    std::cout << "The packed data is consistent with the rendering data." << std::endl;
+
+    return 0;
+}
+
+RenderingData createGrid(const nvl::Size n)
+{
+    RenderingData rendering;
+
+    for (nvl::Index i = 0; i <= n; ++i) {
+        for (nvl::Index j = 0; j <= n; ++j) {
+            rendering.vertices.push_back(static_cast<double>(i) / n);
+            rendering.vertices.push_back(static_cast<double>(j) / n);
+            rendering.vertices.push_back(0.0);
+
+            rendering.vertexNormals.push_back(0.0);
+            rendering.vertexNormals.push_back(0.0);
+            rendering.vertexNormals.push_back(1.0);
+        }
+    }
+
+    for (nvl::Index i = 0; i < n; ++i) {
+        for (nvl::Index j = 0; j < n; ++j) {
+            const unsigned int v0 = static_cast<unsigned int>(i * (n + 1) + j);
+            const unsigned int v1 = static_cast<unsigned int>((i + 1) * (n + 1) + j);
+            const unsigned int v2 = v1 + 1;
+            const unsigned int v3 = v0 + 1;
+
+            if ((i + j) % 7 == 0) {
+                rendering.faces.push_back(std::vector<unsigned int>{ v0, v1, v2 });
+                rendering.faces.push_back(std::vector<unsigned int>{ v0, v2, v3 });
+            }
+            else {
+                rendering.faces.push_back(std::vector<unsigned int>{ v0, v1, v2, v3 });
+            }
+        }
+    }
+
+    for (nvl::Index fId = 0; fId < rendering.faces.size(); ++fId) {
+        const std::vector<unsigned int>& face = rendering.faces[fId];
+
+        rendering.faceColors.push_back(static_cast<float>(fId % 5) / 4.0f);
+        rendering.faceColors.push_back(0.5f);
+        rendering.faceColors.push_back(static_cast<float>(fId % 3) / 2.0f);
+        rendering.faceColors.push_back(1.0f);
+
+        std::vector<float> uvs;
+        for (const unsigned int& vId : face) {
+            uvs.push_back(static_cast<float>(rendering.vertices[vId * 3]));
+            uvs.push_back(static_cast<float>(rendering.vertices[vId * 3 + 1]));
+        }
+        rendering.faceUVs.push_back(uvs);
+
+        //Two materials, one third of the faces without material
+        rendering.faceMaterials.push_back(fId % 3 == 2 ? nvl::NULL_ID : fId % 3);
+    }
+
+    return rendering;
+}
+
+nvl::Size checkSharedPacking(const RenderingData& rendering, const nvl::FaceMeshPackedData& data)
+{
+    nvl::Size errors = 0;
+
+    if (data.perCorner || data.vertexNumber() * 3 != rendering.vertices.size()) {
+        return 1;
+    }
+
+    for (nvl::Index i = 0; i < rendering.vertices.size(); ++i) {
+        if (data.positions[i] != static_cast<float>(rendering.vertices[i]) || data.normals[i] != static_cast<float>(rendering.vertexNormals[i])) {
+            errors++;
+        }
+    }
+
+    //Material of each fan triangle
+    std::map<std::array<unsigned int, 3>, nvl::Index> triangleMaterials;
+    for (nvl::Index fId = 0; fId < rendering.faces.size(); ++fId) {
+        const std::vector<unsigned int>& face = rendering.faces[fId];
+        for (nvl::Index j = 1; j + 1 < face.size(); ++j) {
+            std::array<unsigned int, 3> key = { face[0], face[j], face[j + 1] };
+            std::sort(key.begin(), key.end());
+            triangleMaterials[key] = rendering.faceMaterials[fId];
+        }
+    }
+
+    if (data.triangleNumber() != triangleMaterials.size() || data.batchOffsets.size() != data.batchNumber() + 1) {
+        return errors + 1;
+    }
+
+    //Each triangle is in the batch of its material
+    for (nvl::Index b = 0; b < data.batchNumber(); ++b) {
+        for (nvl::Index t = data.batchOffsets[b]; t < data.batchOffsets[b + 1]; t += 3) {
+            std::array<unsigned int, 3> key = { data.indices[t], data.indices[t + 1], data.indices[t + 2] };
+            std::sort(key.begin(), key.end());
+
+            std::map<std::array<unsigned int, 3>, nvl::Index>::const_iterator it = triangleMaterials.find(key);
+            if (it == triangleMaterials.end() || it->second != data.batchMaterials[b]) {
+                errors++;
+            }
+        }
+    }
+
+    return errors;
+}
+
+nvl::Size checkCornerPacking(const RenderingData& rendering, const nvl::FaceMeshPackedData& data)
+{
+    nvl::Size errors = 0;
+
+    if (!data.perCorner || data.faceCornerOffsets.size() != rendering.faces.size() + 1) {
+        return 1;
+    }
+
+    //Corner attributes
+    for (nvl::Index fId = 0; fId < rendering.faces.size(); ++fId) {
+        const std::vector<unsigned int>& face = rendering.faces[fId];
+
+        for (nvl::Index j = 0; j < face.size(); ++j) {
+            const nvl::Index cId = data.faceCornerOffsets[fId] + j;
+            const nvl::Index vId = face[j];
+
+            if (data.cornerFaces[cId] != fId) {
+                errors++;
+            }
+            for (nvl::Index k = 0; k < 3; ++k) {
+                if (data.positions[cId * 3 + k] != static_cast<float>(rendering.vertices[vId * 3 + k])) {
+                    errors++;
+                }
+            }
+            for (nvl::Index k = 0; k < 4; ++k) {
+                if (data.colors[cId * 4 + k] != rendering.faceColors[fId * 4 + k]) {
+                    errors++;
+                }
+            }
+            for (nvl::Index k = 0; k < 2; ++k) {
+                if (data.uvs[cId * 2 + k] != rendering.faceUVs[fId][j * 2 + k]) {
+                    errors++;
+                }
+            }
+        }
+    }
+
+    //Corners of each vertex
+    for (nvl::Index vId = 0; vId + 1 < data.vertexCornerOffsets.size(); ++vId) {
+        for (nvl::Index i = data.vertexCornerOffsets[vId]; i < data.vertexCornerOffsets[vId + 1]; ++i) {
+            const nvl::Index cId = data.vertexCorners[i];
+            const nvl::Index fId = data.cornerFaces[cId];
+            if (rendering.faces[fId][cId - data.faceCornerOffsets[fId]] != vId) {
+                errors++;
+            }
+        }
+    }
+
+    //Each triangle is made of corners of the same face, in the batch of its material
+    for (nvl::Index b = 0; b < data.batchNumber(); ++b) {
+        for (nvl::Index t = data.batchOffsets[b]; t < data.batchOffsets[b + 1]; t += 3) {
+            const nvl::Index fId = data.cornerFaces[data.indices[t]];
+            if (data.cornerFaces[data.indices[t + 1]] != fId || data.cornerFaces[data.indices[t + 2]] != fId ||
+                    rendering.faceMaterials[fId] != data.batchMaterials[b]) {
+                errors++;
+            }
+        }
+    }
+
+    return errors;
+}
+
+template<class T>
+nvl::Size checkDirtyRanges(const std::vector<T>& oldValues, const std::vector<T>& newValues, const nvl::Size blockSize)
+{
+    std::vector<std::pair<nvl::Size, nvl::Size>> ranges;
+    nvl::faceMeshPackedDirtyRanges(oldValues, newValues, blockSize, ranges);
+
+    //Different sizes: the whole new array, if any
+    if (oldValues.size() != newValues.size()) {
+        if (newValues.empty()) {
+            return ranges.empty() ? 0 : 1;
+        }
+        return ranges.size() == 1 && ranges[0].first == 0 && ranges[0].second == newValues.size() ? 0 : 1;
+    }
+
+    //Dirty state of each block
+    const nvl::Size blockNumber = (newValues.size() + blockSize - 1) / blockSize;
+    std::vector<bool> expectedDirty(blockNumber, false);
+    for (nvl::Index i = 0; i < newValues.size(); ++i) {
+        if (oldValues[i] != newValues[i]) {
+            expectedDirty[i / blockSize] = true;
+        }
+    }
+
+    nvl::Size errors = 0;
+
+    //Ranges are sorted, disjoint, not adjacent and made of whole blocks
+    std::vector<bool> rangeDirty(blockNumber, false);
+    for (nvl::Index r = 0; r < ranges.size(); ++r) {
+        const std::pair<nvl::Size, nvl::Size>& range = ranges[r];
+
+        if (range.first % blockSize != 0 || range.first >= range.second ||
+                (range.second % blockSize != 0 && range.second != newValues.size()) ||
+                (r > 0 && ranges[r - 1].second >= range.first)) {
+            errors++;
+            continue;
+        }
+
+        for (nvl::Index b = range.first / blockSize; b * blockSize < range.second; ++b) {
+            rangeDirty[b] = true;
+        }
+    }
+
+    if (rangeDirty != expectedDirty) {
+        errors++;
+    }
+
+    return errors;
+}
@@ -0,0 +1,130 @@
+/*
+ * This file is part of nuvolib: https://github.com/stefanonuvoli/nuvolib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Stefano Nuvoli (stefano.nuvoli@gmail.com)
+ */
+#include <nvl/nuvolib.h>
+
+#include <nvl/models/mesh_3d.h>
+#include <nvl/models/algorithms/mesh_adjacencies.h>
+#include <nvl/models/algorithms/mesh_morphological_operations.h>
+
+#include <nvl/structures/containers/bitset.h>
+
+#include <nvl/utilities/timer.h>
+
+#include <iostream>
+#include <string>
+#include <unordered_set>
+#include <random>
+
+int main(int argc, char *argv[])
+{
+    typedef nvl::TriangleMesh3d Mesh;
+    typedef Mesh::VertexId VertexId;
+    typedef Mesh::FaceId FaceId;
+
+    //Grid size, number of repetitions and comparison with the std::unordered_set selection
+    const nvl::Size gridSize = argc > 1 ? std::stoul(argv[1]) : 2237;
+    const nvl::Size repetitions = argc > 2 ? std::stoul(argv[2]) : 10;
+    const bool compareLegacy = argc > 3 ? std::stoi(argv[3]) != 0 : true;
+
+    std::cout << "------ Mesh morphological operations sample ------" << std::endl << std::endl;
+
+    //Grid of gridSize x gridSize quads, each one split in two triangles
+    Mesh mesh;
+    for (nvl::Index i = 0; i <= gridSize; ++i) {
+        for (nvl::Index j = 0; j <= gridSize; ++j) {
+            mesh.addVertex(nvl::Point3d(i, j, 0.0));
+        }
+    }
+    for (nvl::Index i = 0; i < gridSize; ++i) {
+        for (nvl::Index j = 0; j < gridSize; ++j) {
+            const VertexId v00 = i * (gridSize + 1) + j;
+            const VertexId v01 = v00 + 1;
+            const VertexId v10 = v00 + gridSize + 1;
+            const VertexId v11 = v10 + 1;
+            mesh.addFace(v00, v10, v11);
+            mesh.addFace(v00, v11, v01);
+        }
+    }
+
+    std::cout << "Mesh: " << mesh.vertexNumber() << " vertices, " << mesh.faceNumber() << " faces." << std::endl;
+
+    nvl::Timer adjacenciesTimer("Adjacencies");
+    const std::vector<std::vector<FaceId>> vfAdj = nvl::meshVertexFaceAdjacencies(mesh);
+    const std::vector<std::vector<FaceId>> ffAdj = nvl::meshFaceFaceAdjacencies(mesh, vfAdj);
+    adjacenciesTimer.print();
+
+    //Noisy selection: a disk with random holes and random islands around it
+    std::mt19937 generator(0);
+    std::uniform_real_distribution<double> distribution(0.0, 1.0);
+
+    nvl::BitSet initialSelection(mesh.nextFaceId());
+    const double radius = gridSize / 3.0;
+    for (FaceId fId = 0; fId < mesh.nextFaceId(); ++fId) {
+        const nvl::Index quadId = fId / 2;
+        const double x = static_cast<double>(quadId / gridSize) - gridSize / 2.0;
+        const double y = static_cast<double>(quadId % gridSize) - gridSize / 2.0;
+        const bool inside = x * x + y * y < radius * radius;
+        const double random = distribution(generator);
+
+        if ((inside && random > 0.05) || (!inside && random < 0.05)) {
+            initialSelection.insert(fId);
+        }
+    }
+
+    std::cout << "Selection: " << initialSelection.size() << " faces." << std::endl << std::endl;
+
+    //BitSet selection with frontier-based operators
+    nvl::BitSet bitsetSelection = initialSelection;
+
+    nvl::Timer bitsetTimer("BitSet open/close");
+    for (nvl::Index r = 0; r < repetitions; ++r) {
+        nvl::meshOpenFaceSelection(mesh, bitsetSelection, vfAdj, ffAdj);
+        nvl::meshCloseFaceSelection(mesh, bitsetSelection, vfAdj, ffAdj);
+    }
+    const double bitsetTime = bitsetTimer.elapsed();
+    bitsetTimer.print();
+
+    std::cout << "Result: " << bitsetSelection.size() << " faces." << std::endl;
+    std::cout << "Time per open/close: " << bitsetTime / repetitions << " ms" << std::endl << std::endl;
+
+    if (compareLegacy) {
+        //Hash set selection with the operators visiting the whole selection
+        std::unordered_set<FaceId> setSelection(initialSelection.begin(), initialSelection.end());
+
+        nvl::Timer setTimer("std::unordered_set open/close");
+        for (nvl::Index r = 0; r < repetitions; ++r) {
+            nvl::meshOpenFaceSelection(mesh, setSelection, ffAdj);
+            nvl::meshCloseFaceSelection(mesh, setSelection, ffAdj);
+        }
+        const double setTime = setTimer.elapsed();
+        setTimer.print();
+
+        std::cout << "Result: " << setSelection.size() << " faces." << std::endl;
+        std::cout << "Time per open/close: " << setTime / repetitions << " ms" << std::endl;
+        std::cout << "Speedup: " << setTime / bitsetTime << "x" << std::endl << std::endl;
+
+        //The two selections have to contain the same faces
+        nvl::Size mismatches = 0;
+        for (FaceId fId = 0; fId < mesh.nextFaceId(); ++fId) {
+            if (bitsetSelection.contains(fId) != (setSelection.find(fId) != setSelection.end())) {
+                if (mismatches == 0) {
+                    std::cout << "First mismatch: face " << fId << "." << std::endl;
+                }
+                mismatches++;
+            }
+        }
+
+        if (mismatches > 0) {
+            std::cout << "Error: the selections differ in " << mismatches << " faces." << std::endl;
+            return 1;
+        }
+
+        std::cout << "The selections are equal." << std::endl;
+    }
+
+    return 0;
+}